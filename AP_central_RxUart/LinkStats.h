@@ -0,0 +1,41 @@
+#ifndef LINKSTATS_H
+#define LINKSTATS_H
+
+#include <stdint.h>
+
+/*
+ * Delivery accounting of a radio link from the 8 bit sequence numbers of its
+ * packets: tag beacons (see Beacon.h) at the AP and AP uplinks (see Uplink.h)
+ * at the central. LinkStats.h and LinkStats.c are kept identical in
+ * AP_peripheral_RxTx and AP_central_RxUart.
+ *
+ * A jump of LINKSTATS_RESYNC_GAP or more is taken as a restarted or
+ * duplicated sender rather than a loss, the count restarts from that packet.
+ */
+
+#define LINKSTATS_RESYNC_GAP    128
+#define LINKSTATS_GAP_BUCKETS   6   // Gaps of 1, 2, 3-4, 5-8, 9-16, 17 or more
+
+typedef struct
+{
+    uint32_t received;
+    uint32_t lost;
+    uint32_t resyncs;
+    uint32_t gaps[LINKSTATS_GAP_BUCKETS];  // Histogram of runs of lost packets
+} LinkStats;
+
+void LinkStats_init(LinkStats* stats);
+
+/* Counts the first packet heard from a sender */
+void LinkStats_first(LinkStats* stats);
+
+/*
+ * Counts a packet with sequence number seq from a sender whose previous packet
+ * had lastSeq, returns the packets lost in between
+ */
+uint8_t LinkStats_next(LinkStats* stats, uint8_t lastSeq, uint8_t seq);
+
+/* Packets delivered per 1000 sent, 1000 before any loss */
+uint16_t LinkStats_deliveryPermille(const LinkStats* stats);
+
+#endif /* LINKSTATS_H */
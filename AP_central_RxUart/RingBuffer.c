@@ -0,0 +1,71 @@
+/*
+ *  ======== RingBuffer.c ========
+ */
+#include <stddef.h>
+
+#include "RingBuffer.h"
+#include "Trace.h"
+
+/***** Function definitions *****/
+
+void RingBuffer_init(RingBuffer* ring, uint8_t* storage, uint16_t* lengths,
+        uint16_t slotSize, uint16_t slotCount) {
+    ring->storage = storage;
+    ring->lengths = lengths;
+    ring->slotSize = slotSize;
+    ring->slotCount = slotCount;
+    ring->head = 0;
+    ring->tail = 0;
+    ring->drops = 0;
+}
+
+uint8_t* RingBuffer_reserve(RingBuffer* ring) {
+    uint32_t head = ring->head;
+
+    if(head - ring->tail >= ring->slotCount) {
+        ring->drops++;
+        return NULL;
+    }
+
+    //Slot contents must not be written before the consumer released it
+    RingBuffer_barrier();
+
+    return &ring->storage[(head & (ring->slotCount - 1)) * ring->slotSize];
+}
+
+void RingBuffer_commit(RingBuffer* ring, uint16_t len) {
+    uint32_t head = ring->head;
+
+    ring->lengths[head & (ring->slotCount - 1)] = len;
+
+    //Slot contents must be visible before the new head
+    RingBuffer_barrier();
+    ring->head = head + 1;
+    TRACE(TRACE_RING_PUT, head + 1 - ring->tail);
+}
+
+uint8_t* RingBuffer_peek(RingBuffer* ring, uint16_t* len) {
+    uint32_t tail = ring->tail;
+    uint32_t index = tail & (ring->slotCount - 1);
+
+    if(ring->head == tail) {
+        return NULL;
+    }
+
+    //Slot contents must not be read before the head that published them
+    RingBuffer_barrier();
+    *len = ring->lengths[index];
+
+    return &ring->storage[index * ring->slotSize];
+}
+
+void RingBuffer_release(RingBuffer* ring) {
+    //Slot contents must be fully read before handing it back
+    RingBuffer_barrier();
+    ring->tail = ring->tail + 1;
+    TRACE(TRACE_RING_GET, ring->head - ring->tail);
+}
+
+uint32_t RingBuffer_count(RingBuffer* ring) {
+    return ring->head - ring->tail;
+}
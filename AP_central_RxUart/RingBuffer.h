@@ -0,0 +1,56 @@
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include <stdint.h>
+
+/*
+ * Single producer / single consumer ring of fixed size slots.
+ *
+ * The producer (rxDoneCb, RF callback context) only writes head and the
+ * consumer (UART task) only writes tail, so no lock is needed. Both are free
+ * running counters, the slot index is the counter modulo slotCount, which
+ * must be a power of two. When the ring is full the producer drops the new
+ * record and counts it instead of overwriting slots not yet sent.
+ */
+
+#if defined(__TI_COMPILER_VERSION__)
+    #define RingBuffer_barrier()    __asm(" dmb")
+#elif defined(__IAR_SYSTEMS_ICC__)
+    #include <intrinsics.h>
+    #define RingBuffer_barrier()    __DMB()
+#elif defined(__GNUC__)
+    #define RingBuffer_barrier()    __sync_synchronize()
+#else
+    #error This compiler is not supported.
+#endif
+
+typedef struct
+{
+    uint8_t* storage;           // slotCount * slotSize bytes
+    uint16_t* lengths;          // Used length of each slot
+    uint16_t slotSize;
+    uint16_t slotCount;
+    volatile uint32_t head;     // Written by the producer only
+    volatile uint32_t tail;     // Written by the consumer only
+    volatile uint32_t drops;    // Records dropped because the ring was full
+} RingBuffer;
+
+void RingBuffer_init(RingBuffer* ring, uint8_t* storage, uint16_t* lengths,
+        uint16_t slotSize, uint16_t slotCount);
+
+/* Producer: returns the next free slot, or NULL (and counts a drop) if full */
+uint8_t* RingBuffer_reserve(RingBuffer* ring);
+
+/* Producer: publishes the slot returned by RingBuffer_reserve */
+void RingBuffer_commit(RingBuffer* ring, uint16_t len);
+
+/* Consumer: returns the oldest published slot, or NULL if empty */
+uint8_t* RingBuffer_peek(RingBuffer* ring, uint16_t* len);
+
+/* Consumer: hands the slot returned by RingBuffer_peek back to the producer */
+void RingBuffer_release(RingBuffer* ring);
+
+/* Number of published slots not yet released */
+uint32_t RingBuffer_count(RingBuffer* ring);
+
+#endif /* RINGBUFFER_H */
@@ -0,0 +1,74 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+
+/*
+ * Hot path trace, a flight recorder of timestamped events along the path of a
+ * beacon: the RF callbacks in EasyLink, the app callbacks, the central's ring
+ * and its UART writes. Trace.h and Trace.c are kept identical in the three
+ * projects.
+ *
+ * Define TRACE_ENABLE to record, otherwise the TRACE probes compile to
+ * nothing and trace takes no RAM. Events are kept in a ring of TRACE_SIZE,
+ * the newest overwriting the oldest. To dump it, halt the target and save
+ * trace from the debugger (it is visible in ROV too): the oldest event is at
+ * trace.count % TRACE_SIZE once trace.count reaches TRACE_SIZE.
+ *
+ * Times are RAT ticks (4 MHz) from RF_getCurrentTime, the clock of
+ * EasyLink's absTime. Trace_init records two TRACE_MARK events back to back
+ * and keeps their distance in trace.overhead, so the cost of the trace over
+ * a dump is about trace.overhead ticks per event, to compare with the time
+ * the dump covers. host/tools/simios_trace decodes a dump.
+ */
+
+//#define TRACE_ENABLE // Define to record the trace events
+
+#define TRACE_SIZE 256 // Events kept, power of two
+
+/* Event ids, arg in brackets */
+#define TRACE_MARK              0x00 // Trace_init calibration [0]
+#define TRACE_RF_RX_DONE        0x01 // EasyLink Rx callback entered [0]
+#define TRACE_RF_TX_DONE        0x02 // EasyLink Tx callback entered [0]
+#define TRACE_APP_RX            0x03 // App Rx callback entered [absTime, see below]
+#define TRACE_APP_RX_DONE       0x04 // App Rx callback done with the packet [len]
+#define TRACE_APP_TX            0x05 // App hands a packet to EasyLink [len]
+#define TRACE_RING_PUT          0x06 // Record published to the ring [records queued]
+#define TRACE_RING_GET          0x07 // Record taken from the ring [records queued]
+#define TRACE_UART_WRITE        0x08 // UART_write started [bytes]
+#define TRACE_UART_WRITE_DONE   0x09 // UART write callback [bytes]
+
+/*
+ * TRACE_APP_RX carries the low 16 bits of the packet's EasyLink absTime, the
+ * RAT time it was received at: it is the latest time before the event with
+ * those low bits, as long as the callback runs within 16 ms.
+ */
+
+typedef struct
+{
+    uint32_t time;
+    uint8_t id;
+    uint8_t reserved;
+    uint16_t arg;
+} Trace_Event;
+
+typedef struct
+{
+    Trace_Event events[TRACE_SIZE];
+    uint32_t count;             // Events recorded since Trace_init
+    uint32_t overhead;          // RAT ticks one event takes to record
+} Trace;
+
+#ifdef TRACE_ENABLE
+#define TRACE(id, arg) Trace_record((id), (uint16_t)(arg))
+#else
+#define TRACE(id, arg)
+#endif
+
+/* Clears the trace and measures its overhead */
+void Trace_init(void);
+
+/* Records an event, from any context */
+void Trace_record(uint8_t id, uint16_t arg);
+
+#endif /* TRACE_H */
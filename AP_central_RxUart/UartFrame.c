@@ -0,0 +1,143 @@
+/*
+ *  ======== UartFrame.c ========
+ */
+#include <stddef.h>
+#include <string.h>
+
+#include "UartFrame.h"
+
+/***** Defines *****/
+
+#define UART_FRAME_CRC_INIT     0xFFFF
+#define UART_FRAME_CRC_POLY     0x1021
+
+/***** Function definitions *****/
+
+uint16_t UartFrame_crc16(uint16_t crc, const uint8_t* data, uint16_t len) {
+    uint16_t i;
+    uint8_t bit;
+
+    for(i = 0; i < len; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for(bit = 0; bit < 8; bit++) {
+            if(crc & 0x8000) {
+                crc = (crc << 1) ^ UART_FRAME_CRC_POLY;
+            } else {
+                crc = crc << 1;
+            }
+        }
+    }
+
+    return crc;
+}
+
+uint16_t UartFrame_encode(uint8_t* frame, uint8_t type, uint8_t seq,
+        const uint8_t* payload, uint8_t len) {
+    return UartFrame_encodePrefixed(frame, type, seq, NULL, 0, payload, len);
+}
+
+uint16_t UartFrame_encodePrefixed(uint8_t* frame, uint8_t type, uint8_t seq,
+        const uint8_t* prefix, uint8_t prefixLen,
+        const uint8_t* payload, uint8_t len) {
+    uint16_t i;
+    uint16_t crc;
+    uint16_t size = 0;
+
+    frame[size++] = UART_FRAME_SOF;
+    frame[size++] = prefixLen + len;
+    frame[size++] = type;
+    frame[size++] = seq;
+    for(i = 0; i < prefixLen; i++) {
+        frame[size++] = prefix[i];
+    }
+    for(i = 0; i < len; i++) {
+        frame[size++] = payload[i];
+    }
+
+    //CRC skips the SOF byte
+    crc = UartFrame_crc16(UART_FRAME_CRC_INIT, &frame[1], size - 1);
+    frame[size++] = (uint8_t)(crc & 0xFF);
+    frame[size++] = (uint8_t)(crc >> 8);
+
+    return size;
+}
+
+void UartFrame_decoderInit(UartFrame_Decoder* decoder) {
+    decoder->size = 0;
+    decoder->candidates = 0;
+    decoder->crcErrors = 0;
+}
+
+/* Checks the CRC of the candidate frame starting at offset start of the
+ * window and ending at its last byte, keeps its fields if valid */
+static uint8_t checkFrame(UartFrame_Decoder* decoder, uint16_t start) {
+    const uint8_t* frame = &decoder->window[start];
+    uint16_t size = decoder->size - start;
+    uint16_t crc;
+
+    //CRC skips the SOF byte
+    crc = UartFrame_crc16(UART_FRAME_CRC_INIT, &frame[1], size - 1 - UART_FRAME_CRC_SIZE);
+    if((uint8_t)(crc & 0xFF) != frame[size - 2] || (uint8_t)(crc >> 8) != frame[size - 1]) {
+        return 0;
+    }
+
+    decoder->len = frame[1];
+    decoder->type = frame[2];
+    decoder->seq = frame[3];
+    memcpy(decoder->payload, &frame[UART_FRAME_HEADER_SIZE], decoder->len);
+
+    return 1;
+}
+
+uint8_t UartFrame_decode(UartFrame_Decoder* decoder, uint8_t byte) {
+    uint16_t start;
+    uint16_t kept = 0;
+    uint16_t i;
+
+    if(decoder->size == 0 && byte != UART_FRAME_SOF) {
+        return 0;
+    }
+
+    //The oldest candidate ends UART_FRAME_MAX_SIZE bytes in at the latest,
+    //so the window never overflows
+    decoder->window[decoder->size++] = byte;
+
+    for(i = 0; i < decoder->candidates; i++) {
+        start = decoder->sof[i];
+        if(start + decoder->window[start + 1] + UART_FRAME_OVERHEAD != decoder->size) {
+            decoder->sof[kept++] = start;
+            continue;
+        }
+
+        //Candidate complete, the bytes before a valid frame are dropped
+        if(checkFrame(decoder, start)) {
+            decoder->size = 0;
+            decoder->candidates = 0;
+            return 1;
+        }
+        //The decoder was in this frame, a later SOF was only a candidate
+        if(i == 0) {
+            decoder->crcErrors++;
+        }
+    }
+    decoder->candidates = kept;
+
+    //Length of a candidate starting here is the next byte
+    if(byte == UART_FRAME_SOF) {
+        decoder->sof[decoder->candidates++] = decoder->size - 1;
+    }
+
+    //Rescan from the next candidate once the oldest is done with
+    if(decoder->candidates == 0) {
+        decoder->size = 0;
+    } else if(decoder->sof[0] > 0) {
+        start = decoder->sof[0];
+        decoder->size -= start;
+        memmove(decoder->window, &decoder->window[start], decoder->size);
+        for(i = 0; i < decoder->candidates; i++) {
+            decoder->sof[i] -= start;
+        }
+    }
+
+    return 0;
+}
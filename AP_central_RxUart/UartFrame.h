@@ -0,0 +1,113 @@
+#ifndef UARTFRAME_H
+#define UARTFRAME_H
+
+#include <stdint.h>
+
+/*
+ * Binary UART frame, used instead of the ASCII records when
+ * RFEASYLINKRX_UART_BINARY is defined in main.c:
+ *
+ *  ______________________________________________________________
+ * |     |     |      |     |                     |               |
+ * | SOF | len | type | seq | payload (len bytes) | CRC16 (LSB 1st)|
+ * |_____|_____|______|_____|_____________________|_______________|
+ *
+ * The CRC-16/CCITT (poly 0x1021, init 0xFFFF) covers len, type, seq and
+ * payload. A 30 byte radio packet takes 36 bytes on the wire instead of the
+ * 110 bytes of the ASCII record.
+ *
+ * This module has no TI-RTOS dependencies so the decoder can be built as is
+ * into host side tools.
+ */
+
+#define UART_FRAME_SOF              0x7E
+#define UART_FRAME_HEADER_SIZE      4
+#define UART_FRAME_CRC_SIZE         2
+#define UART_FRAME_OVERHEAD         (UART_FRAME_HEADER_SIZE + UART_FRAME_CRC_SIZE)
+#define UART_FRAME_MAX_PAYLOAD      255
+#define UART_FRAME_MAX_SIZE         (UART_FRAME_OVERHEAD + UART_FRAME_MAX_PAYLOAD)
+
+/* Frame types */
+#define UART_FRAME_TYPE_AP_REPORT   0x01 // Payload is the raw AP uplink packet
+#define UART_FRAME_TYPE_AP_REPORT_TIMED 0x02 // Rx time then the raw AP uplink packet
+#define UART_FRAME_TYPE_STATUS      0x03 // Central counters, see below
+#define UART_FRAME_TYPE_RADIO_STATS 0x04 // Central radio counters, see below
+#define UART_FRAME_TYPE_LINK_STATS  0x05 // Uplink delivery of one AP, see below
+
+/*
+ * UART_FRAME_TYPE_AP_REPORT_TIMED prefixes the uplink packet (see Uplink.h)
+ * with the central's radio time (RAT, 4 MHz, LSB first) at which it was
+ * received. Subtracting each measure's delta time gives the time the AP took
+ * the measure on the central's clock, so measures of the same tag from
+ * different APs can be grouped by time window.
+ */
+#define UART_FRAME_RX_TIME_SIZE     4
+
+/*
+ * UART_FRAME_TYPE_STATUS is sent periodically by the central, its payload is
+ * four 32 bit counters (LSB first) since start-up: uplink packets received,
+ * packets dropped because the UART fell behind, bytes written to the UART and
+ * uplinks lost on the air (gaps in the uplink seq of every AP, see Uplink.h).
+ * seq counts the frames of each type separately, so a gap in the seq of the
+ * reports is lost on the serial link while drops were lost on the central.
+ */
+#define UART_FRAME_STATUS_SIZE      16
+
+/*
+ * UART_FRAME_TYPE_RADIO_STATS follows every status frame, its payload is the
+ * central's EasyLink_Stats counters (32 bit, LSB first) in declaration order,
+ * rxOk to busyErrors, then lastRssi as a signed byte. The APs send theirs in
+ * the uplink telemetry (see Uplink.h).
+ */
+#define UART_FRAME_RADIO_STATS_SIZE 45
+
+/*
+ * UART_FRAME_TYPE_LINK_STATS follows the radio stats frame, once per AP the
+ * central has heard. Its payload is the AP id, the uplinks delivered per 1000
+ * sent (16 bit) then the AP's LinkStats counters (32 bit) received, lost,
+ * resyncs and the LINKSTATS_GAP_BUCKETS gap histogram buckets, all LSB first.
+ */
+#define UART_FRAME_LINK_STATS_SIZE  39
+
+/*
+ * The decoder keeps the bytes from the oldest SOF that may still start a
+ * frame. Every SOF byte in them starts a candidate frame, so a stray SOF
+ * (or one in the payload of a damaged frame) does not hide the frame that
+ * follows it: that frame is completed at its last byte all the same.
+ */
+typedef struct
+{
+    uint8_t len;
+    uint8_t type;
+    uint8_t seq;
+    uint16_t size;                          // Bytes in window
+    uint16_t candidates;                    // Offsets in sof
+    uint32_t crcErrors;                     // Frames with a bad CRC, not counting candidates inside another
+    uint16_t sof[UART_FRAME_MAX_SIZE];
+    uint8_t window[UART_FRAME_MAX_SIZE];
+    uint8_t payload[UART_FRAME_MAX_PAYLOAD];
+} UartFrame_Decoder;
+
+/* Updates crc with len bytes of data */
+uint16_t UartFrame_crc16(uint16_t crc, const uint8_t* data, uint16_t len);
+
+/* Writes a complete frame to frame and returns its size in bytes */
+uint16_t UartFrame_encode(uint8_t* frame, uint8_t type, uint8_t seq,
+        const uint8_t* payload, uint8_t len);
+
+/* Same as UartFrame_encode with prefix and payload concatenated, which must
+ * not exceed UART_FRAME_MAX_PAYLOAD bytes together */
+uint16_t UartFrame_encodePrefixed(uint8_t* frame, uint8_t type, uint8_t seq,
+        const uint8_t* prefix, uint8_t prefixLen,
+        const uint8_t* payload, uint8_t len);
+
+void UartFrame_decoderInit(UartFrame_Decoder* decoder);
+
+/*
+ * Feeds one received byte to the decoder. Returns 1 when a frame with a valid
+ * CRC has been completed, its fields are then available in decoder until the
+ * next call. Bytes before the frame that do not form one are dropped.
+ */
+uint8_t UartFrame_decode(UartFrame_Decoder* decoder, uint8_t byte);
+
+#endif /* UARTFRAME_H */
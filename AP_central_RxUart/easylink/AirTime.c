@@ -0,0 +1,64 @@
+/*
+ *  ======== AirTime.c ========
+ */
+#include "AirTime.h"
+
+/***** Function definitions *****/
+
+uint32_t AirTime_bitRate(uint32_t rateWord, uint8_t preScale, uint8_t symbolsPerBit)
+{
+    uint32_t symbolRate;
+
+    if (preScale == 0)
+    {
+        return 0;
+    }
+    symbolRate = (uint32_t)(((uint64_t)AIRTIME_SYMBOL_RATE_REF_HZ * rateWord) /
+            ((uint64_t)preScale << 20));
+
+    return symbolRate / symbolsPerBit;
+}
+
+uint16_t AirTime_overheadBits(uint8_t nPreamBytes, uint8_t nSwBits, bool varLen,
+        bool crc)
+{
+    uint16_t bits;
+
+    //Whitening adds no bits
+    if (nPreamBytes == AIRTIME_PREAMBLE_1_BIT)
+    {
+        bits = 1;
+    }
+    else if (nPreamBytes == AIRTIME_PREAMBLE_4_BITS)
+    {
+        bits = 4;
+    }
+    else
+    {
+        bits = nPreamBytes * 8;
+    }
+    bits += nSwBits;
+    if (varLen)
+    {
+        bits += 8;
+    }
+    if (crc)
+    {
+        bits += AIRTIME_CRC_BITS;
+    }
+
+    return bits;
+}
+
+uint32_t AirTime_us(uint32_t bitRate, uint16_t overheadBits, uint16_t len)
+{
+    uint32_t bits = overheadBits + (uint32_t)len * 8;
+
+    if (bitRate == 0)
+    {
+        return 0;
+    }
+
+    //Rounded up, the largest packet is far from overflowing
+    return (bits * 1000000 + bitRate - 1) / bitRate;
+}
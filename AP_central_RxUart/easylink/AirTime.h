@@ -0,0 +1,39 @@
+#ifndef AIRTIME_H
+#define AIRTIME_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Time on air of a proprietary mode packet, worked out from the fields of the
+ * radio setup command, see EasyLink_getAirTimeUs(). The easylink directory,
+ * this module included, is kept identical in the three projects.
+ *
+ * This module has no TI-RTOS dependencies so it can be built as is into host
+ * side tools and tests.
+ */
+
+/* Symbol rate is AIRTIME_SYMBOL_RATE_REF_HZ * rateWord / (preScale * 2^20) */
+#define AIRTIME_SYMBOL_RATE_REF_HZ      24000000
+
+/* Symbols per bit of the coded (fecMode != 0) PHYs, FEC 1/2 with DSSS 8 or 2 */
+#define AIRTIME_LRM_SYMBOLS_PER_BIT     16
+#define AIRTIME_SL_LR_SYMBOLS_PER_BIT   4
+
+/* nPreamBytes values that are not a byte count */
+#define AIRTIME_PREAMBLE_1_BIT          0
+#define AIRTIME_PREAMBLE_4_BITS         31
+
+#define AIRTIME_CRC_BITS                16
+
+/* Information bit rate of a PHY, in bit/s */
+uint32_t AirTime_bitRate(uint32_t rateWord, uint8_t preScale, uint8_t symbolsPerBit);
+
+/* Bits sent around the packet: preamble, sync word, length byte and CRC */
+uint16_t AirTime_overheadBits(uint8_t nPreamBytes, uint8_t nSwBits, bool varLen,
+        bool crc);
+
+/* Time on air in us, rounded up, of a packet of len bytes (address included) */
+uint32_t AirTime_us(uint32_t bitRate, uint16_t overheadBits, uint16_t len);
+
+#endif /* AIRTIME_H */
@@ -32,6 +32,7 @@
 
 /***** Includes *****/
 #include "EasyLink.h"
+#include "AirTime.h"
 
 /* TI Drivers */
 #include <smartrf_settings/smartrf_settings_predefined.h>
@@ -42,13 +43,16 @@
 #include <ti/sysbios/knl/Semaphore.h>
 #include <ti/sysbios/BIOS.h>
 #include <ti/sysbios/knl/Task.h>
+#include <ti/sysbios/knl/Swi.h>
 
 #ifndef USE_DMM
 #include <ti/drivers/rf/RF.h>
 #include "Board.h"
+#include "Trace.h"
 #else
 #include <dmm/dmm_rfmap.h>
 #include "board.h"
+#include "Trace.h"
 #endif //USE_DMM
 
 
@@ -57,6 +61,7 @@
 
 #include <ti/devices/DeviceFamily.h>
 #include DeviceFamily_constructPath(driverlib/rf_data_entry.h)
+#include DeviceFamily_constructPath(driverlib/rf_common_cmd.h)
 #include DeviceFamily_constructPath(driverlib/rf_prop_mailbox.h)
 #include DeviceFamily_constructPath(driverlib/rf_prop_cmd.h)
 #include DeviceFamily_constructPath(driverlib/chipinfo.h)
@@ -79,11 +84,26 @@ union setupCmd_t{
 
 #define EASYLINK_RF_CMD_HANDLE_INVALID -1
 
+//Continuous Rx data entries hold hdr (len=1byte), dst addr (max of 8 bytes),
+//data and the appended RSSI (1 byte) and timestamp (4 bytes), rounded up to
+//keep every entry 4B aligned
+#define EASYLINK_RX_ENTRY_DATA_LENGTH   (1 + EASYLINK_MAX_ADDR_SIZE + \
+             EASYLINK_MAX_DATA_LENGTH + 1 + 4)
+#define EASYLINK_RX_ENTRY_SIZE          ((sizeof(rfc_dataEntryGeneral_t) + \
+             EASYLINK_RX_ENTRY_DATA_LENGTH + 3) & ~3)
+
 #define EasyLink_CmdHandle_isValid(handle) (handle >= 0)
 
+//CCA Tx requests with a context of their own: the one whose callback is
+//running and the one it sets up from it
+#define EASYLINK_CCA_CONTEXTS   2
+
 /***** Prototypes *****/
 static EasyLink_TxDoneCb txCb;
 static EasyLink_ReceiveCb rxCb;
+static EasyLink_ReceiveViewCb rxViewCb;
+static bool suspendContinuousRx(void);
+static void resumeContinuousRx(void);
 #if (defined(DeviceFamily_CC13X0) || defined(DeviceFamily_CC13X2))
 static EasyLink_GetRandomNumber getRN;
 #endif // (defined(DeviceFamily_CC13X0) || defined(DeviceFamily_CC13X2))
@@ -107,8 +127,71 @@ static RF_Handle rfHandle;
     #error This compiler is not supported.
 #endif
 
+//Rx data entries used by EasyLink_receiveContinuousAsync()
+#if defined(__TI_COMPILER_VERSION__)
+    #pragma DATA_ALIGN (rxQueueBuffer, 4);
+        static uint8_t rxQueueBuffer[EASYLINK_RX_QUEUE_ENTRIES * EASYLINK_RX_ENTRY_SIZE];
+#elif defined(__IAR_SYSTEMS_ICC__)
+    #pragma data_alignment = 4
+        static uint8_t rxQueueBuffer[EASYLINK_RX_QUEUE_ENTRIES * EASYLINK_RX_ENTRY_SIZE];
+#elif defined(__GNUC__)
+        static uint8_t rxQueueBuffer[EASYLINK_RX_QUEUE_ENTRIES * EASYLINK_RX_ENTRY_SIZE]
+            __attribute__ ((aligned (4)));
+#else
+    #error This compiler is not supported.
+#endif
+
+//Entries queued to the RF core, in the order it fills them. Entries lent to
+//the application are out of the RF core queue and not in this list
+static uint8_t rxQueueOrder[EASYLINK_RX_QUEUE_ENTRIES];
+static uint8_t rxQueueHead = 0;
+static uint8_t rxQueueCount = 0;
+//Entries handed to the application and not yet released
+static bool rxQueueLent[EASYLINK_RX_QUEUE_ENTRIES];
+//Continuous Rx ended with all entries lent, it restarts on the next release
+static volatile bool rxQueueStarved = false;
+//RF core queue of the continuous Rx, kept apart from the single Rx one
+static dataQueue_t rxContinuousQueue;
+//Packet handed to the continuous Rx callback, static so that the large
+//payload buffer is not allocated from the stack
+static EasyLink_RxPacket rxQueuePacket;
+//View handed to the continuous Rx view callback
+static EasyLink_RxView rxQueueView;
+#if (defined(DeviceFamily_CC13X0) || defined(DeviceFamily_CC13X2))
+//State of one CCA Tx request, from EasyLink_transmitCcaAsync() until its
+//callback returns. The carrier sense command comes first so that the RF
+//callback finds the request from the command it ran
+typedef struct
+{
+    rfc_CMD_PROP_CS_t csCmd;    //Carrier sense chained to the Tx
+    uint8_t be;                 //Back-off exponent of the next retry
+    uint8_t retries;            //Back-offs done for this Tx
+    bool inUse;
+} EasyLink_CcaContext;
+
+static EasyLink_CcaContext ccaContexts[EASYLINK_CCA_CONTEXTS];
+//Request waiting out a back-off with continuous Rx listening, NULL if none
+static EasyLink_CcaContext* volatile ccaBackOffCtx = NULL;
+//The back-off is over, the carrier sense runs once continuous Rx has stopped
+static volatile bool ccaRetryDue = false;
+//Ends the back-off of ccaBackOffCtx
+static Clock_Struct ccaBackOffClock;
+static EasyLink_CcaStats ccaStats;
+//Channel busy rate scaled by 8, keeps the fraction the average would lose
+static uint16_t ccaBusyRateAcc;
+#endif // (defined(DeviceFamily_CC13X0) || defined(DeviceFamily_CC13X2))
+
+//Continuous Rx is on for the application, even while paused for a Tx
+static volatile bool rxContinuous = false;
+//Continuous Rx was paused by EasyLink_transmitAsync() and resumes after the Tx
+static volatile bool rxResumeAfterTx = false;
+
 static dataQueue_t dataQueue;
 static rfc_propRxOutput_t rxStatistics;
+//Part of rxStatistics already added to radioStats
+static rfc_propRxOutput_t rxStatisticsFolded;
+//Counters kept across commands, see EasyLink_getStats()
+static EasyLink_Stats radioStats;
 
 //Tx buffer includes hdr (len=1byte), dst addr (max of 8 bytes) and data
 static uint8_t txBuffer[1 + EASYLINK_MAX_ADDR_SIZE + EASYLINK_MAX_DATA_LENGTH];
@@ -134,6 +217,11 @@ static bool rfModeMultiClient = false;
 //Async Rx timeout value
 static uint32_t asyncRxTimeOut = 0;
 
+//Information bit rate and bits sent around the packet with the PHY in use,
+//see EasyLink_getAirTimeUs()
+static uint32_t phyBitRate = 0;
+static uint16_t phyOverheadBits = 0;
+
 //local commands, contents will be defined by modulation type
 static union setupCmd_t EasyLink_cmdPropRadioSetup;
 static rfc_CMD_FS_t EasyLink_cmdFs;
@@ -141,6 +229,7 @@ static RF_Mode EasyLink_RF_prop;
 static rfc_CMD_PROP_TX_t EasyLink_cmdPropTx;
 static rfc_CMD_PROP_RX_ADV_t EasyLink_cmdPropRxAdv;
 #if (defined(DeviceFamily_CC13X0) || defined(DeviceFamily_CC13X2))
+//Carrier sense every CCA Tx request starts from
 static rfc_CMD_PROP_CS_t EasyLink_cmdPropCs;
 #endif // (defined(DeviceFamily_CC13X0) || defined(DeviceFamily_CC13X2))
 
@@ -169,11 +258,93 @@ void EasyLink_Params_init(EasyLink_Params *params)
     *params = EasyLink_defaultParams;
 }
 
+//Adds what the RF core counted since the last call to radioStats, the RF core
+//counters are only 8 or 16 bits wide and restart with every Rx command
+static void foldRxStatistics(void)
+{
+    radioStats.rxOk += (uint16_t)(rxStatistics.nRxOk - rxStatisticsFolded.nRxOk);
+    radioStats.rxNok += (uint16_t)(rxStatistics.nRxNok - rxStatisticsFolded.nRxNok);
+    radioStats.rxIgnored += (uint8_t)(rxStatistics.nRxIgnored - rxStatisticsFolded.nRxIgnored);
+    radioStats.rxBufFull += (uint8_t)(rxStatistics.nRxBufFull - rxStatisticsFolded.nRxBufFull);
+    if (rxStatistics.nRxOk != rxStatisticsFolded.nRxOk)
+    {
+        radioStats.lastRssi = rxStatistics.lastRssi;
+    }
+    rxStatisticsFolded = rxStatistics;
+}
+
+//Clears the Rx statistics structure for a new Rx command
+static void resetRxStatistics(void)
+{
+    UInt key = Swi_disable();
+    foldRxStatistics();
+    memset(&rxStatistics, 0, sizeof(rfc_propRxOutput_t));
+    memset(&rxStatisticsFolded, 0, sizeof(rfc_propRxOutput_t));
+    Swi_restore(key);
+}
+
+//Counts how an Rx operation ended, packets are counted by foldRxStatistics()
+static void countRxStatus(EasyLink_Status status)
+{
+    if (status == EasyLink_Status_Rx_Timeout)
+    {
+        radioStats.rxTimeouts++;
+    }
+    else if (status == EasyLink_Status_Aborted)
+    {
+        radioStats.rxAborts++;
+    }
+    else if (status != EasyLink_Status_Success)
+    {
+        radioStats.rxErrors++;
+    }
+}
+
+//Counts how a Tx operation ended
+static void countTxStatus(EasyLink_Status status)
+{
+    if (status == EasyLink_Status_Success)
+    {
+        radioStats.txOk++;
+    }
+    else if (status == EasyLink_Status_Aborted)
+    {
+        radioStats.txAborts++;
+    }
+    else
+    {
+        radioStats.txErrors++;
+    }
+}
+
+//Works out the bit rate and the bits sent around each packet from the setup
+//of the PHY in use, the DIV setup command starts like the plain one
+static void setPhyTiming(void)
+{
+    rfc_CMD_PROP_RADIO_SETUP_t *pSetup = &EasyLink_cmdPropRadioSetup.setup;
+    uint8_t symbolsPerBit = 1;
+
+    //The coded modes are timed at their information rate throughout, which is
+    //an upper bound as the preamble may be sent uncoded
+    if (pSetup->formatConf.fecMode != 0)
+    {
+        symbolsPerBit = (EasyLink_params.ui32ModType == EasyLink_Phy_625bpsLrm) ?
+                AIRTIME_LRM_SYMBOLS_PER_BIT : AIRTIME_SL_LR_SYMBOLS_PER_BIT;
+    }
+    phyBitRate = AirTime_bitRate(pSetup->symbolRate.rateWord,
+            pSetup->symbolRate.preScale, symbolsPerBit);
+    phyOverheadBits = AirTime_overheadBits(pSetup->preamConf.nPreamBytes,
+            pSetup->formatConf.nSwBits, EasyLink_cmdPropTx.pktConf.bVarLen,
+            EasyLink_cmdPropTx.pktConf.bUseCrc);
+}
+
 //Callback for Async Tx complete
 static void txDoneCallback(RF_Handle h, RF_CmdHandle ch, RF_EventMask e)
 {
     EasyLink_Status status;
 
+    TRACE(TRACE_RF_TX_DONE, 0);
+
     //Release now so user callback can call EasyLink API's
     Semaphore_post(busyMutex);
     asyncCmdHndl = EASYLINK_RF_CMD_HANDLE_INVALID;
@@ -190,6 +361,13 @@ static void txDoneCallback(RF_Handle h, RF_CmdHandle ch, RF_EventMask e)
     {
         status = EasyLink_Status_Tx_Error;
     }
+    countTxStatus(status);
+
+    //Listen again before anything else if the Tx paused continuous Rx
+    if (rxResumeAfterTx)
+    {
+        resumeContinuousRx();
+    }
 
     if (txCb != NULL)
     {
@@ -198,15 +376,159 @@ static void txDoneCallback(RF_Handle h, RF_CmdHandle ch, RF_EventMask e)
 }
 
 #if (defined(DeviceFamily_CC13X0) || defined(DeviceFamily_CC13X2))
+//Moves the channel busy rate towards the last carrier sense outcome
+static void ccaUpdateBusyRate(bool busy)
+{
+    uint16_t sample = busy ? EASYLINK_CCA_BUSY_RATE_ONE : 0;
+
+    //1/8 weight average, reaches both 0 and EASYLINK_CCA_BUSY_RATE_ONE
+    ccaBusyRateAcc += sample - (ccaBusyRateAcc >> 3);
+    ccaStats.busyRate = ccaBusyRateAcc >> 3;
+}
+
+//First back-off exponent of a CCA Tx, grows with the channel busy rate from
+//EASYLINK_MIN_CCA_BACKOFF_WINDOW and stops one short of
+//EASYLINK_MAX_CCA_BACKOFF_WINDOW, so that a Tx on a channel always busy
+//still gets two back-offs before it is given up
+static uint8_t ccaStartBackOff(void)
+{
+    return EASYLINK_MIN_CCA_BACKOFF_WINDOW + (uint8_t)(((uint32_t)ccaStats.busyRate *
+            (EASYLINK_MAX_CCA_BACKOFF_WINDOW - 1 - EASYLINK_MIN_CCA_BACKOFF_WINDOW)) /
+            EASYLINK_CCA_BUSY_RATE_ONE);
+}
+
+static void ccaDoneCallback(RF_Handle h, RF_CmdHandle ch, RF_EventMask e);
+
+//Takes a free context for a CCA Tx request, with a fresh carrier sense
+static EasyLink_CcaContext* ccaAllocContext(void)
+{
+    uint8_t i;
+
+    for (i = 0; i < EASYLINK_CCA_CONTEXTS; i++)
+    {
+        if (!ccaContexts[i].inUse)
+        {
+            memset(&ccaContexts[i], 0, sizeof(EasyLink_CcaContext));
+            ccaContexts[i].csCmd = EasyLink_cmdPropCs;
+            ccaContexts[i].inUse = true;
+            return &ccaContexts[i];
+        }
+    }
+
+    return NULL;
+}
+
+//Posts the carrier sense of a CCA Tx request, the Tx is chained to it
+static RF_CmdHandle ccaPost(EasyLink_CcaContext *pCtx, uint32_t endTime)
+{
+    RF_ScheduleCmdParams schParams_prop;
+
+    if(rfModeMultiClient)
+    {
+        schParams_prop.priority = RF_PriorityHigh;
+        schParams_prop.endTime = endTime;
+        return RF_scheduleCmd(rfHandle, (RF_Op*)&pCtx->csCmd,
+                &schParams_prop, ccaDoneCallback, EASYLINK_RF_EVENT_MASK);
+    }
+
+    return RF_postCmd(rfHandle, (RF_Op*)&pCtx->csCmd,
+            RF_PriorityHigh, ccaDoneCallback, EASYLINK_RF_EVENT_MASK);
+}
+
+//Ends a CCA Tx request. The caller has released the busyMutex and resumed
+//continuous Rx, the context is free again once the application's callback
+//has returned
+static void ccaFinish(EasyLink_CcaContext *pCtx, EasyLink_Status status)
+{
+    TRACE(TRACE_RF_TX_DONE, 0);
+    countTxStatus(status);
+
+    if (txCb != NULL)
+    {
+        txCb(status);
+    }
+
+    pCtx->inUse = false;
+}
+
+//Runs the carrier sense again after a back-off spent listening, continuous
+//Rx has stopped and the busyMutex is free
+static void ccaRetry(void)
+{
+    EasyLink_CcaContext *pCtx;
+    UInt key;
+
+    key = Swi_disable();
+    pCtx = ccaBackOffCtx;
+    ccaBackOffCtx = NULL;
+    ccaRetryDue = false;
+    Swi_restore(key);
+
+    //Aborted during the back-off, Rx goes on
+    if (pCtx == NULL)
+    {
+        if (rxResumeAfterTx)
+        {
+            resumeContinuousRx();
+        }
+        return;
+    }
+
+    if (Semaphore_pend(busyMutex, 0) == TRUE)
+    {
+        pCtx->csCmd.startTrigger.triggerType = TRIG_NOW;
+        pCtx->csCmd.startTrigger.pastTrig = 1;
+        pCtx->csCmd.startTime = 0;
+        asyncCmdHndl = ccaPost(pCtx, 0);
+        if (EasyLink_CmdHandle_isValid(asyncCmdHndl))
+        {
+            return;
+        }
+        Semaphore_post(busyMutex);
+    }
+
+    if (rxResumeAfterTx)
+    {
+        resumeContinuousRx();
+    }
+    ccaFinish(pCtx, EasyLink_Status_Tx_Error);
+}
+
+//Clock callback, the back-off of ccaBackOffCtx is over
+static void ccaBackOffDone(UArg arg)
+{
+    RF_CmdHandle rxHndl = asyncCmdHndl;
+
+    if (ccaBackOffCtx == NULL)
+    {
+        return;
+    }
+
+    //Continuous Rx is paused again, gracefully as a packet may be coming
+    //in, and its callback runs the carrier sense once it has stopped
+    if (rxContinuous && EasyLink_CmdHandle_isValid(rxHndl))
+    {
+        rxResumeAfterTx = true;
+        ccaRetryDue = true;
+        if (RF_cancelCmd(rfHandle, rxHndl, 1) == RF_StatSuccess)
+        {
+            return;
+        }
+        rxResumeAfterTx = false;
+        ccaRetryDue = false;
+    }
+
+    ccaRetry();
+}
+
 //Callback for Clear Channel Assessment Done
 static void ccaDoneCallback(RF_Handle h, RF_CmdHandle ch, RF_EventMask e)
 {
-    RF_ScheduleCmdParams schParams_prop;
     EasyLink_Status status        = EasyLink_Status_Tx_Error;
-    RF_Op* pCmd                   = RF_getCmdOp(h, ch);
+    EasyLink_CcaContext *pCtx     = (EasyLink_CcaContext*)RF_getCmdOp(h, ch);
+    RF_Op* pCmd                   = (RF_Op*)&pCtx->csCmd;
     bool bCcaRunAgain             = false;
-    static uint8_t be             = EASYLINK_MIN_CCA_BACKOFF_WINDOW;
-    static uint32_t backOffTime;
+    uint32_t backOffTime;
 
     asyncCmdHndl = EASYLINK_RF_CMD_HANDLE_INVALID;
 
@@ -214,94 +536,96 @@ static void ccaDoneCallback(RF_Handle h, RF_CmdHandle ch, RF_EventMask e)
     {
         if(pCmd->status ==  PROP_DONE_IDLE)
         {
+            ccaUpdateBusyRate(false);
             // Carrier Sense operation ended with an idle channel,
             // and the next op (TX) should have already taken place
             // Failure to transmit is reflected in the default status,
             // EasyLink_Status_Tx_Error, being set
             if(pCmd->pNextOp->status == PROP_DONE_OK)
             {
-                //Release now so user callback can call EasyLink API's
-                Semaphore_post(busyMutex);
                 status = EasyLink_Status_Success;
-                // Reset the number of retries
-                be = EASYLINK_MIN_CCA_BACKOFF_WINDOW;
+                ccaStats.txSuccess++;
             }
         }
         else if(pCmd->status == PROP_DONE_BUSY)
         {
-            if(be > EASYLINK_MAX_CCA_BACKOFF_WINDOW)
+            ccaUpdateBusyRate(true);
+            ccaStats.busyCount++;
+            if(pCtx->be > EASYLINK_MAX_CCA_BACKOFF_WINDOW)
             {
-                //Release now so user callback can call EasyLink API's
-                Semaphore_post(busyMutex);
-                // Reset the number of retries
-                be = EASYLINK_MIN_CCA_BACKOFF_WINDOW;
                 // CCA failed max number of retries
                 status = EasyLink_Status_Busy_Error;
+                ccaStats.busyFailures++;
             }
             else
             {
                 // The back-off time is a random number chosen from 0 to 2^be,
-                // where 'be' goes from EASYLINK_MIN_CCA_BACKOFF_WINDOW
-                // to EASYLINK_MAX_CCA_BACKOFF_WINDOW. This number is then converted
+                // where 'be' starts from ccaStartBackOff() and goes up to
+                // EASYLINK_MAX_CCA_BACKOFF_WINDOW. This number is then converted
                 // into EASYLINK_CCA_BACKOFF_TIMEUNITS units, and subsequently used to
-                // schedule the next CCA sequence. The variable 'be' is incremented each
-                // time, up to a pre-configured maximum, the back-off algorithm is run.
-                backOffTime = (getRN() & ((1 << be++)-1)) *
+                // schedule the next CCA sequence. The back-off exponent lives in
+                // the context of the Tx request, it is incremented each time the
+                // back-off algorithm is run.
+                backOffTime = (getRN() & ((1 << pCtx->be++)-1)) *
                         EasyLink_us_To_RadioTime(EASYLINK_CCA_BACKOFF_TIMEUNITS);
+                pCtx->retries++;
+                ccaStats.retries++;
                 // running CCA again
                 bCcaRunAgain = true;
-                // The random number generator function returns a value in the range
-                // 0 to 2^15 - 1 and we choose the 'be' most significant bits as our
-                // back-off time in milliseconds (converted to RAT ticks)
-                pCmd->startTime = RF_getCurrentTime() + backOffTime;
-                // post the chained CS+TX command again while checking
-                // for a clear channel (CCA) before sending a packet
-                if(rfModeMultiClient)
+                if (rxResumeAfterTx)
                 {
-                    schParams_prop.priority = RF_PriorityHigh;
-                    asyncCmdHndl = RF_scheduleCmd(rfHandle, (RF_Op*)&EasyLink_cmdPropCs,
-                                                  &schParams_prop, ccaDoneCallback, EASYLINK_RF_EVENT_MASK);
+                    // Continuous Rx was paused for this Tx, it listens through
+                    // the back-off and is only paused again for the next
+                    // carrier sense, see ccaBackOffDone()
+                    ccaBackOffCtx = pCtx;
+                    Semaphore_post(busyMutex);
+                    resumeContinuousRx();
+                    Clock_setTimeout(Clock_handle(&ccaBackOffClock),
+                            backOffTime / (EasyLink_us_To_RadioTime(Clock_tickPeriod)) + 1);
+                    Clock_start(Clock_handle(&ccaBackOffClock));
                 }
                 else
                 {
-                    asyncCmdHndl = RF_postCmd(h, (RF_Op*)&EasyLink_cmdPropCs,
-                        RF_PriorityHigh, ccaDoneCallback, EASYLINK_RF_EVENT_MASK);
+                    // The start trigger may have been TRIG_NOW, which would ignore
+                    // the back-off start time
+                    pCmd->startTrigger.triggerType = TRIG_ABSTIME;
+                    pCmd->startTrigger.pastTrig = 1;
+                    pCmd->startTime = RF_getCurrentTime() + backOffTime;
+                    // post the chained CS+TX command again while checking
+                    // for a clear channel (CCA) before sending a packet
+                    asyncCmdHndl = ccaPost(pCtx, 0);
+                    bCcaRunAgain = EasyLink_CmdHandle_isValid(asyncCmdHndl);
                 }
             }
         }
         else
         {
-            //Release now so user callback can call EasyLink API's
-            Semaphore_post(busyMutex);
-            // Reset the number of retries
-            be = EASYLINK_MIN_CCA_BACKOFF_WINDOW;
             // The CS command status should be either IDLE or BUSY,
             // all other status codes can be considered errors
             // Status is set to the default, EasyLink_Status_Tx_Error
         }
-
-
     }
     else if ( (e & RF_EventCmdAborted) || (e & RF_EventCmdCancelled ) || (e & RF_EventCmdPreempted ) )
     {
-        //Release now so user callback can call EasyLink API's
-        Semaphore_post(busyMutex);
-        // Reset the number of retries
-        be = EASYLINK_MIN_CCA_BACKOFF_WINDOW;
         status = EasyLink_Status_Aborted;
     }
     else
     {
-        //Release now so user callback can call EasyLink API's
-        Semaphore_post(busyMutex);
-        // Reset the number of retries
-        be = EASYLINK_MIN_CCA_BACKOFF_WINDOW;
         // Status is set to the default, EasyLink_Status_Tx_Error
     }
 
-    if ((txCb != NULL) && (!bCcaRunAgain))
+    if (!bCcaRunAgain)
     {
-        txCb(status);
+        //Release now so user callback can call EasyLink API's
+        Semaphore_post(busyMutex);
+
+        //Listen again before anything else if the Tx paused continuous Rx
+        if (rxResumeAfterTx)
+        {
+            resumeContinuousRx();
+        }
+
+        ccaFinish(pCtx, status);
     }
 }
 #endif // (defined(DeviceFamily_CC13X0) || defined(DeviceFamily_CC13X2))
@@ -314,6 +638,9 @@ static void rxDoneCallback(RF_Handle h, RF_CmdHandle ch, RF_EventMask e)
     //allocated from the stack
     static EasyLink_RxPacket rxPacket;
     rfc_dataEntryGeneral_t *pDataEntry;
+
+    TRACE(TRACE_RF_RX_DONE, 0);
+
     pDataEntry = (rfc_dataEntryGeneral_t*) rxBuffer;
 
     if (e & RF_EventLastCmdDone)
@@ -377,12 +704,253 @@ static void rxDoneCallback(RF_Handle h, RF_CmdHandle ch, RF_EventMask e)
         status = EasyLink_Status_Aborted;
     }
 
+    foldRxStatistics();
+    countRxStatus(status);
+
     if (rxCb != NULL)
     {
         rxCb(&rxPacket, status);
     }
 }
 
+//Sets up the Rx command for a single packet or for continuous Rx
+static void configureRxRepeat(bool continuous)
+{
+    EasyLink_cmdPropRxAdv.pktConf.bRepeatOk = continuous;
+    EasyLink_cmdPropRxAdv.pktConf.bRepeatNok = continuous;
+    //In continuous mode bad packets must not use up data entries
+    EasyLink_cmdPropRxAdv.rxConf.bAutoFlushCrcErr = continuous;
+    EasyLink_cmdPropRxAdv.rxConf.bAppendRssi = continuous;
+    EasyLink_cmdPropRxAdv.rxConf.bAppendTimestamp = continuous;
+}
+
+//Appends a pending entry to the continuous Rx queue. While the RF core may
+//be using the queue it appends the entry itself, so that it is not raced.
+//Called with Swi disabled
+static void rxQueueAppend(uint8_t index)
+{
+    rfc_dataEntryGeneral_t *pDataEntry;
+    rfc_CMD_ADD_DATA_ENTRY_t addCmd;
+
+    pDataEntry = (rfc_dataEntryGeneral_t*) &rxQueueBuffer[index * EASYLINK_RX_ENTRY_SIZE];
+    pDataEntry->pNextEntry = NULL;
+    pDataEntry->status = DATA_ENTRY_PENDING;
+
+    rxQueueOrder[(rxQueueHead + rxQueueCount) % EASYLINK_RX_QUEUE_ENTRIES] = index;
+    rxQueueCount++;
+
+    if (rxContinuous && EasyLink_CmdHandle_isValid(asyncCmdHndl))
+    {
+        addCmd.commandNo = CMD_ADD_DATA_ENTRY;
+        addCmd.__dummy0 = 0;
+        addCmd.pQueue = &rxContinuousQueue;
+        addCmd.pEntry = (uint8_t*)pDataEntry;
+        if (RF_runImmediateCmd(rfHandle, (uint32_t*)&addCmd) == RF_StatCmdDoneSuccess)
+        {
+            return;
+        }
+    }
+
+    //RF core is not in Rx, link the entry here
+    if (rxContinuousQueue.pCurrEntry == NULL)
+    {
+        rxContinuousQueue.pCurrEntry = (uint8_t*)pDataEntry;
+    }
+    else
+    {
+        ((rfc_dataEntryGeneral_t*)rxContinuousQueue.pLastEntry)->pNextEntry =
+                (uint8_t*)pDataEntry;
+    }
+    rxContinuousQueue.pLastEntry = (uint8_t*)pDataEntry;
+}
+
+//Links the continuous Rx data entries in a queue, all pending. Entries still
+//lent to the application are left alone, they join when released
+static void rxQueueInit(void)
+{
+    uint8_t i;
+    rfc_dataEntryGeneral_t *pDataEntry;
+
+    rxQueueHead = 0;
+    rxQueueCount = 0;
+    rxContinuousQueue.pCurrEntry = NULL;
+    rxContinuousQueue.pLastEntry = NULL;
+
+    for (i = 0; i < EASYLINK_RX_QUEUE_ENTRIES; i++)
+    {
+        if (rxQueueLent[i])
+        {
+            continue;
+        }
+        pDataEntry = (rfc_dataEntryGeneral_t*) &rxQueueBuffer[i * EASYLINK_RX_ENTRY_SIZE];
+        pDataEntry->config.type = DATA_ENTRY_TYPE_GEN;
+        pDataEntry->config.lenSz = 0;
+        pDataEntry->config.irqIntv = 0;
+        pDataEntry->length = EASYLINK_RX_ENTRY_DATA_LENGTH;
+        rxQueueAppend(i);
+    }
+}
+
+//Hands every finished continuous Rx data entry to the application, in order.
+//The RF core has moved past a finished entry, so it is lent to the
+//application out of the queue until EasyLink_releaseRxView() appends it again
+static void rxQueueDeliver(void)
+{
+    rfc_dataEntryGeneral_t *pDataEntry;
+    uint8_t *pData;
+    uint8_t pktLen;
+    uint8_t index;
+
+    while (rxQueueCount > 0)
+    {
+        index = rxQueueOrder[rxQueueHead];
+        pDataEntry = (rfc_dataEntryGeneral_t*) &rxQueueBuffer[index * EASYLINK_RX_ENTRY_SIZE];
+        if (pDataEntry->status != DATA_ENTRY_FINISHED)
+        {
+            break;
+        }
+        rxQueueHead = (rxQueueHead + 1) % EASYLINK_RX_QUEUE_ENTRIES;
+        rxQueueCount--;
+        rxQueueLent[index] = true;
+
+        //entry holds length, address, payload, RSSI and timestamp
+        pData = &pDataEntry->data;
+        pktLen = pData[0];
+
+        rxQueueView.entry = (uint8_t*)pDataEntry;
+        if (pktLen < addrSize)
+        {
+            EasyLink_releaseRxView(&rxQueueView);
+        }
+        else
+        {
+            rxQueueView.dstAddr = pData + 1;
+            rxQueueView.payload = pData + 1 + addrSize;
+            rxQueueView.len = pktLen - addrSize;
+            rxQueueView.rssi = (int8_t)pData[1 + pktLen];
+            memcpy(&rxQueueView.absTime, pData + 2 + pktLen, sizeof(uint32_t));
+
+            if (rxViewCb != NULL)
+            {
+                rxViewCb(&rxQueueView, EasyLink_Status_Success);
+            }
+            else
+            {
+                rxQueuePacket.len = rxQueueView.len;
+                memcpy(&rxQueuePacket.dstAddr, rxQueueView.dstAddr, addrSize);
+                memcpy(&rxQueuePacket.payload, rxQueueView.payload, rxQueueView.len);
+                rxQueuePacket.rssi = rxQueueView.rssi;
+                rxQueuePacket.absTime = rxQueueView.absTime;
+
+                //Recycle the entry before the callback so the RF core can reuse it
+                EasyLink_releaseRxView(&rxQueueView);
+
+                if (rxCb != NULL)
+                {
+                    rxCb(&rxQueuePacket, EasyLink_Status_Success);
+                }
+            }
+        }
+    }
+}
+
+//Tells the application that continuous Rx has ended
+static void rxContinuousEnded(EasyLink_Status status)
+{
+    rxContinuous = false;
+    rxQueueStarved = false;
+
+    if (rxViewCb != NULL)
+    {
+        rxViewCb(NULL, status);
+    }
+    else if (rxCb != NULL)
+    {
+        rxCb(&rxQueuePacket, status);
+    }
+}
+
+//Callback for continuous Async Rx, called per packet and when Rx ends
+static void rxContinuousCallback(RF_Handle h, RF_CmdHandle ch, RF_EventMask e)
+{
+    EasyLink_Status status = EasyLink_Status_Rx_Error;
+
+    TRACE(TRACE_RF_RX_DONE, 0);
+    foldRxStatistics();
+
+    if (e & RF_EventRxEntryDone)
+    {
+        rxQueueDeliver();
+    }
+
+    if (e & RF_EventLastCmdDone)
+    {
+        //Deliver anything that finished together with the command
+        rxQueueDeliver();
+
+        //Release now so user callback can call EasyLink API's
+        Semaphore_post(busyMutex);
+        asyncCmdHndl = EASYLINK_RF_CMD_HANDLE_INVALID;
+
+        if (EasyLink_cmdPropRxAdv.status == PROP_DONE_RXTIMEOUT)
+        {
+            status = EasyLink_Status_Rx_Timeout;
+        }
+        else if ( (EasyLink_cmdPropRxAdv.status == PROP_DONE_STOPPED) ||
+                  (EasyLink_cmdPropRxAdv.status == PROP_DONE_ABORT) )
+        {
+            status = EasyLink_Status_Aborted;
+        }
+        else if (EasyLink_cmdPropRxAdv.status == PROP_ERROR_RXBUF)
+        {
+            //No entry was pending, Rx picks up again once one is released
+            status = EasyLink_Status_Rx_Buffer_Error;
+            rxQueueStarved = true;
+        }
+    }
+    else if (e & (RF_EventCmdCancelled | RF_EventCmdAborted | RF_EventCmdPreempted | RF_EventCmdStopped))
+    {
+        //Release now so user callback can call EasyLink API's
+        Semaphore_post(busyMutex);
+        asyncCmdHndl = EASYLINK_RF_CMD_HANDLE_INVALID;
+
+        status = EasyLink_Status_Aborted;
+    }
+    else
+    {
+        //Rx is still running
+        return;
+    }
+
+    //Rx only paused for a Tx, the application is not told
+    if (rxResumeAfterTx)
+    {
+#if (defined(DeviceFamily_CC13X0) || defined(DeviceFamily_CC13X2))
+        //A CCA back-off is over, its carrier sense runs now
+        if (ccaRetryDue)
+        {
+            ccaRetry();
+        }
+#endif // (defined(DeviceFamily_CC13X0) || defined(DeviceFamily_CC13X2))
+        return;
+    }
+    countRxStatus(status);
+
+    //Rx ran out of entries, it is not over for the application
+    if (rxQueueStarved)
+    {
+        //Entries released by the callbacks above can be used straight away
+        if (rxQueueCount > 0)
+        {
+            rxQueueStarved = false;
+            resumeContinuousRx();
+        }
+        return;
+    }
+
+    rxContinuousEnded(status);
+}
+
 //Callback for Async TX Test mode
 static void asyncCmdCallback(RF_Handle h, RF_CmdHandle ch, RF_EventMask e)
 {
@@ -413,6 +981,7 @@ static EasyLink_Status enableTestMode(EasyLink_CtrlOption mode)
     if((Semaphore_pend(busyMutex, 0) == FALSE) ||
             (EasyLink_CmdHandle_isValid(asyncCmdHndl)))
     {
+        radioStats.busyErrors++;
         return EasyLink_Status_Busy_Error;
     }
 
@@ -524,12 +1093,18 @@ EasyLink_Status EasyLink_init(EasyLink_Params *params)
         //Already configure, check and take the busyMutex
         if (Semaphore_pend(busyMutex, 0) == FALSE)
         {
+            radioStats.busyErrors++;
             return EasyLink_Status_Busy_Error;
         }
 
         RF_close(rfHandle);
     }
 
+    //Clear the cumulative radio counters
+    memset(&radioStats, 0, sizeof(EasyLink_Stats));
+    memset(&rxStatistics, 0, sizeof(rfc_propRxOutput_t));
+    memset(&rxStatisticsFolded, 0, sizeof(rfc_propRxOutput_t));
+
     if (!rfParamsConfigured)
     {
         RF_Params_init(&rfParams);
@@ -549,6 +1124,10 @@ EasyLink_Status EasyLink_init(EasyLink_Params *params)
     // handle, if it is NULL any function that employs it will return a 
     // configuration error
     getRN = EasyLink_params.pGrnFxn;
+
+    // Clear the CCA counters and channel busy rate
+    memset(&ccaStats, 0, sizeof(EasyLink_CcaStats));
+    ccaBusyRateAcc = 0;
     
     // Configure the EasyLink Carrier Sense Command
     memset(&EasyLink_cmdPropCs, 0, sizeof(rfc_CMD_PROP_CS_t));
@@ -646,6 +1225,8 @@ EasyLink_Status EasyLink_init(EasyLink_Params *params)
     }
 #endif //defined(DeviceFamily_CC26X0R2)
 
+    setPhyTiming();
+
     /* Request access to the radio */
     rfHandle = RF_open(&rfObject, &EasyLink_RF_prop,
             (RF_RadioSetup*)&EasyLink_cmdPropRadioSetup.setup, &rfParams);
@@ -689,6 +1270,13 @@ EasyLink_Status EasyLink_init(EasyLink_Params *params)
         }
 
         Semaphore_post(busyMutex);
+
+#if (defined(DeviceFamily_CC13X0) || defined(DeviceFamily_CC13X2))
+        //One shot, started for each back-off that continuous Rx listens through
+        Clock_Params clkParams;
+        Clock_Params_init(&clkParams);
+        Clock_construct(&ccaBackOffClock, ccaBackOffDone, 0, &clkParams);
+#endif // (defined(DeviceFamily_CC13X0) || defined(DeviceFamily_CC13X2))
     }
     else
     {
@@ -714,6 +1302,7 @@ EasyLink_Status EasyLink_setFrequency(uint32_t ui32Frequency)
     //Check and take the busyMutex
     if (Semaphore_pend(busyMutex, 0) == FALSE)
     {
+        radioStats.busyErrors++;
         return EasyLink_Status_Busy_Error;
     }
 
@@ -736,6 +1325,17 @@ EasyLink_Status EasyLink_setFrequency(uint32_t ui32Frequency)
     return status;
 }
 
+uint32_t EasyLink_getAirTimeUs(uint8_t len)
+{
+    if (!configured)
+    {
+        return 0;
+    }
+
+    //The address is sent as part of the packet
+    return AirTime_us(phyBitRate, phyOverheadBits, (uint16_t)len + addrSize);
+}
+
 uint32_t EasyLink_getFrequency(void)
 {
     uint32_t freq_khz;
@@ -762,6 +1362,7 @@ EasyLink_Status EasyLink_setRfPower(int8_t i8TxPowerdBm)
     //Check and take the busyMutex
     if (Semaphore_pend(busyMutex, 0) == FALSE)
     {
+        radioStats.busyErrors++;
         return EasyLink_Status_Busy_Error;
     }
 
@@ -1004,6 +1605,7 @@ EasyLink_Status EasyLink_transmit(EasyLink_TxPacket *txPacket)
     //Check and take the busyMutex
     if (Semaphore_pend(busyMutex, 0) == FALSE)
     {
+        radioStats.busyErrors++;
         return EasyLink_Status_Busy_Error;
     }
 
@@ -1019,32 +1621,22 @@ EasyLink_Status EasyLink_transmit(EasyLink_TxPacket *txPacket)
     EasyLink_cmdPropTx.pktLen = txPacket->len + addrSize;
     EasyLink_cmdPropTx.pPkt = txBuffer;
 
-    if(EasyLink_params.ui32ModType == EasyLink_Phy_5kbpsSlLr)
-    {
-        /* calculate the command time:
-         * (len + preamble + phy len + address) * 8bits / 5kbps */
-        cmdTime = ((EasyLink_cmdPropTx.pktLen + 10 + addrSize) * 8) / 5;
-    }
-    else //assume 50kbps
-    {
-        /* calculate the command time:
-         * (len + preamble + syncword + len + address) * 8bits / 50kbps */
-        cmdTime = ((EasyLink_cmdPropTx.pktLen + 10 + addrSize) * 8) / 50;
-    }
+    //The command must be done by the packet's time on air
+    cmdTime = EasyLink_getAirTimeUs(txPacket->len);
 
     if (txPacket->absTime != 0)
     {
         EasyLink_cmdPropTx.startTrigger.triggerType = TRIG_ABSTIME;
         EasyLink_cmdPropTx.startTrigger.pastTrig = 1;
         EasyLink_cmdPropTx.startTime = txPacket->absTime;
-        schParams_prop.endTime = EasyLink_cmdPropTx.startTime + EasyLink_ms_To_RadioTime(cmdTime);
+        schParams_prop.endTime = EasyLink_cmdPropTx.startTime + EasyLink_us_To_RadioTime(cmdTime);
     }
     else
     {
         EasyLink_cmdPropTx.startTrigger.triggerType = TRIG_NOW;
         EasyLink_cmdPropTx.startTrigger.pastTrig = 1;
         EasyLink_cmdPropTx.startTime = 0;
-        schParams_prop.endTime = RF_getCurrentTime() + EasyLink_ms_To_RadioTime(cmdTime);
+        schParams_prop.endTime = RF_getCurrentTime() + EasyLink_us_To_RadioTime(cmdTime);
     }
 
     // Send packet
@@ -1067,6 +1659,7 @@ EasyLink_Status EasyLink_transmit(EasyLink_TxPacket *txPacket)
     {
         status = EasyLink_Status_Success;
     }
+    countTxStatus(status);
 
     //Release the busyMutex
     Semaphore_post(busyMutex);
@@ -1085,16 +1678,17 @@ EasyLink_Status EasyLink_transmitAsync(EasyLink_TxPacket *txPacket, EasyLink_TxD
     {
         return EasyLink_Status_Config_Error;
     }
-    //Check and take the busyMutex
-    if ( (Semaphore_pend(busyMutex, 0) == FALSE) || (EasyLink_CmdHandle_isValid(asyncCmdHndl)) )
-    {
-        return EasyLink_Status_Busy_Error;
-    }
-
     if (txPacket->len > EASYLINK_MAX_DATA_LENGTH)
     {
         return EasyLink_Status_Param_Error;
     }
+    //Check and take the busyMutex, continuous Rx is paused for the Tx
+    if ( ( (Semaphore_pend(busyMutex, 0) == FALSE) && (!suspendContinuousRx()) ) ||
+         (EasyLink_CmdHandle_isValid(asyncCmdHndl)) )
+    {
+        radioStats.busyErrors++;
+        return EasyLink_Status_Busy_Error;
+    }
 
     //store application callback
     txCb = cb;
@@ -1106,32 +1700,22 @@ EasyLink_Status EasyLink_transmitAsync(EasyLink_TxPacket *txPacket, EasyLink_TxD
     EasyLink_cmdPropTx.pktLen = txPacket->len + addrSize;
     EasyLink_cmdPropTx.pPkt = txBuffer;
 
-    if(EasyLink_params.ui32ModType == EasyLink_Phy_5kbpsSlLr)
-    {
-        /* calculate the command time:
-         * (len + preamble + phy len + address) * 8bits / 5kbps */
-        cmdTime = ((EasyLink_cmdPropTx.pktLen + 10 + addrSize) * 8) / 5;
-    }
-    else //assume 50kbps
-    {
-        /* calculate the command time:
-         * (len + preamble + syncword + len + address) * 8bits / 50kbps */
-        cmdTime = ((EasyLink_cmdPropTx.pktLen + 10 + addrSize) * 8) / 50;
-    }
+    //The command must be done by the packet's time on air
+    cmdTime = EasyLink_getAirTimeUs(txPacket->len);
 
     if (txPacket->absTime != 0)
     {
         EasyLink_cmdPropTx.startTrigger.triggerType = TRIG_ABSTIME;
         EasyLink_cmdPropTx.startTrigger.pastTrig = 1;
         EasyLink_cmdPropTx.startTime = txPacket->absTime;
-        schParams_prop.endTime = EasyLink_cmdPropTx.startTime + EasyLink_ms_To_RadioTime(cmdTime);
+        schParams_prop.endTime = EasyLink_cmdPropTx.startTime + EasyLink_us_To_RadioTime(cmdTime);
     }
     else
     {
         EasyLink_cmdPropTx.startTrigger.triggerType = TRIG_NOW;
         EasyLink_cmdPropTx.startTrigger.pastTrig = 1;
         EasyLink_cmdPropTx.startTime = 0;
-        schParams_prop.endTime = RF_getCurrentTime() + EasyLink_ms_To_RadioTime(cmdTime);
+        schParams_prop.endTime = RF_getCurrentTime() + EasyLink_us_To_RadioTime(cmdTime);
     }
 
     // Send packet
@@ -1151,6 +1735,12 @@ EasyLink_Status EasyLink_transmitAsync(EasyLink_TxPacket *txPacket, EasyLink_TxD
     {
         status = EasyLink_Status_Success;
     }
+    else if (rxResumeAfterTx)
+    {
+        //Callback will not be called, release the busyMutex and listen again
+        Semaphore_post(busyMutex);
+        resumeContinuousRx();
+    }
 
     //busyMutex will be released by the callback
 
@@ -1161,7 +1751,8 @@ EasyLink_Status EasyLink_transmitAsync(EasyLink_TxPacket *txPacket, EasyLink_TxD
 EasyLink_Status EasyLink_transmitCcaAsync(EasyLink_TxPacket *txPacket, EasyLink_TxDoneCb cb)
 {
     EasyLink_Status status = EasyLink_Status_Tx_Error;
-    RF_ScheduleCmdParams schParams_prop;
+    EasyLink_CcaContext *pCtx;
+    uint32_t endTime;
     uint32_t cmdTime;
 
     //Check if not configure or already an Async command being performed, or 
@@ -1170,15 +1761,33 @@ EasyLink_Status EasyLink_transmitCcaAsync(EasyLink_TxPacket *txPacket, EasyLink_
     {
         return EasyLink_Status_Config_Error;
     }
-    //Check and take the busyMutex
-    if ( (Semaphore_pend(busyMutex, 0) == FALSE) || (EasyLink_CmdHandle_isValid(asyncCmdHndl)) )
+    if (txPacket->len > EASYLINK_MAX_DATA_LENGTH)
+    {
+        return EasyLink_Status_Param_Error;
+    }
+    //Check and take the busyMutex, continuous Rx is paused for the Tx
+    if ( ( (Semaphore_pend(busyMutex, 0) == FALSE) && (!suspendContinuousRx()) ) ||
+         (EasyLink_CmdHandle_isValid(asyncCmdHndl)) )
     {
+        radioStats.busyErrors++;
         return EasyLink_Status_Busy_Error;
     }
-    if (txPacket->len > EASYLINK_MAX_DATA_LENGTH)
+
+    //Fresh back-off state and carrier sense for this Tx request, starting
+    //wider on a busy channel
+    pCtx = ccaAllocContext();
+    if (pCtx == NULL)
     {
-        return EasyLink_Status_Param_Error;
+        Semaphore_post(busyMutex);
+        if (rxResumeAfterTx)
+        {
+            resumeContinuousRx();
+        }
+        radioStats.busyErrors++;
+        return EasyLink_Status_Busy_Error;
     }
+    pCtx->be = ccaStartBackOff();
+    ccaStats.txCount++;
 
     //store application callback
     txCb = cb;
@@ -1188,63 +1797,89 @@ EasyLink_Status EasyLink_transmitCcaAsync(EasyLink_TxPacket *txPacket, EasyLink_
 
     // Set the Carrier Sense command attributes
     // Chain the TX command to run after the CS command
-    EasyLink_cmdPropCs.pNextOp        = (rfc_radioOp_t *)&EasyLink_cmdPropTx;
+    pCtx->csCmd.pNextOp = (rfc_radioOp_t *)&EasyLink_cmdPropTx;
 
     //packet length to Tx includes address
     EasyLink_cmdPropTx.pktLen = txPacket->len + addrSize;
     EasyLink_cmdPropTx.pPkt = txBuffer;
 
-    if(EasyLink_params.ui32ModType == EasyLink_Phy_5kbpsSlLr)
-    {
-        /* calculate the command time:
-         * (len + preamble + phy len + address) * 8bits / 5kbps */
-        cmdTime = ((EasyLink_cmdPropTx.pktLen + 10 + addrSize) * 8) / 5;
-    }
-    else //assume 50kbps
-    {
-        /* calculate the command time:
-         * (len + preamble + syncword + len + address) * 8bits / 50kbps */
-        cmdTime = ((EasyLink_cmdPropTx.pktLen + 10 + addrSize) * 8) / 50;
-    }
+    //The command must be done by the packet's time on air
+    cmdTime = EasyLink_getAirTimeUs(txPacket->len);
 
     if (txPacket->absTime != 0)
     {
-        EasyLink_cmdPropCs.startTrigger.triggerType = TRIG_ABSTIME;
-        EasyLink_cmdPropCs.startTrigger.pastTrig = 1;
-        EasyLink_cmdPropCs.startTime = txPacket->absTime;
-        schParams_prop.endTime = EasyLink_cmdPropCs.startTime + EasyLink_ms_To_RadioTime(cmdTime);
+        pCtx->csCmd.startTrigger.triggerType = TRIG_ABSTIME;
+        pCtx->csCmd.startTrigger.pastTrig = 1;
+        pCtx->csCmd.startTime = txPacket->absTime;
+        endTime = pCtx->csCmd.startTime + EasyLink_us_To_RadioTime(cmdTime);
     }
     else
     {
-        EasyLink_cmdPropCs.startTrigger.triggerType = TRIG_NOW;
-        EasyLink_cmdPropCs.startTrigger.pastTrig = 1;
-        EasyLink_cmdPropCs.startTime = 0;
-        schParams_prop.endTime = RF_getCurrentTime() + EasyLink_ms_To_RadioTime(cmdTime);
+        pCtx->csCmd.startTrigger.triggerType = TRIG_NOW;
+        pCtx->csCmd.startTrigger.pastTrig = 1;
+        pCtx->csCmd.startTime = 0;
+        endTime = RF_getCurrentTime() + EasyLink_us_To_RadioTime(cmdTime);
     }
 
     // Check for a clear channel (CCA) before sending a packet
-    if(rfModeMultiClient)
+    asyncCmdHndl = ccaPost(pCtx, endTime);
+
+    if (EasyLink_CmdHandle_isValid(asyncCmdHndl))
     {
-        schParams_prop.priority = RF_PriorityHigh;
-        asyncCmdHndl = RF_scheduleCmd(rfHandle, (RF_Op*)&EasyLink_cmdPropCs,
-            &schParams_prop, ccaDoneCallback, EASYLINK_RF_EVENT_MASK);
+        status = EasyLink_Status_Success;
     }
     else
     {
-        asyncCmdHndl = RF_postCmd(rfHandle, (RF_Op*)&EasyLink_cmdPropCs,
-            RF_PriorityHigh, ccaDoneCallback, EASYLINK_RF_EVENT_MASK);
+        //Callback will not be called, release the busyMutex and listen again
+        pCtx->inUse = false;
+        Semaphore_post(busyMutex);
+        if (rxResumeAfterTx)
+        {
+            resumeContinuousRx();
+        }
     }
 
-    if (EasyLink_CmdHandle_isValid(asyncCmdHndl))
+    //busyMutex will be released by the callback
+
+    return status;
+}
+
+EasyLink_Status EasyLink_getCcaStats(EasyLink_CcaStats *stats)
+{
+    if (stats == NULL)
     {
-        status = EasyLink_Status_Success;
+        return EasyLink_Status_Param_Error;
     }
 
-    //busyMutex will be released by the callback
+    //Copy with the callback held off so the counters are consistent
+    UInt key = Swi_disable();
+    *stats = ccaStats;
+    stats->startBackOff = ccaStartBackOff();
+    Swi_restore(key);
 
-    return status;
+    return EasyLink_Status_Success;
 }
 #endif // (defined(DeviceFamily_CC13X0) || defined(DeviceFamily_CC13X2))
+
+EasyLink_Status EasyLink_getStats(EasyLink_Stats *stats)
+{
+    if (stats == NULL)
+    {
+        return EasyLink_Status_Param_Error;
+    }
+
+    //Copy with the callbacks held off so the counters are consistent
+    UInt key = Swi_disable();
+    foldRxStatistics();
+    *stats = radioStats;
+#if (defined(DeviceFamily_CC13X0) || defined(DeviceFamily_CC13X2))
+    stats->cca = ccaStats;
+    stats->cca.startBackOff = ccaStartBackOff();
+#endif // (defined(DeviceFamily_CC13X0) || defined(DeviceFamily_CC13X2))
+    Swi_restore(key);
+
+    return EasyLink_Status_Success;
+}
     
 EasyLink_Status EasyLink_receive(EasyLink_RxPacket *rxPacket)
 {
@@ -1261,6 +1896,7 @@ EasyLink_Status EasyLink_receive(EasyLink_RxPacket *rxPacket)
     //Check and take the busyMutex
     if (Semaphore_pend(busyMutex, 0) == FALSE)
     {
+        radioStats.busyErrors++;
         return EasyLink_Status_Busy_Error;
     }
 
@@ -1270,6 +1906,7 @@ EasyLink_Status EasyLink_receive(EasyLink_RxPacket *rxPacket)
     pDataEntry->status = 0;
     dataQueue.pCurrEntry = (uint8_t*)pDataEntry;
     dataQueue.pLastEntry = NULL;
+    configureRxRepeat(false);
     EasyLink_cmdPropRxAdv.pQueue = &dataQueue;               /* Set the Data Entity queue for received data */
     EasyLink_cmdPropRxAdv.pOutput = (uint8_t*)&rxStatistics;
 
@@ -1300,7 +1937,7 @@ EasyLink_Status EasyLink_receive(EasyLink_RxPacket *rxPacket)
     }
 
     //Clear the Rx statistics structure
-    memset(&rxStatistics, 0, sizeof(rfc_propRxOutput_t));
+    resetRxStatistics();
 
     if(rfModeMultiClient)
     {
@@ -1370,6 +2007,12 @@ EasyLink_Status EasyLink_receive(EasyLink_RxPacket *rxPacket)
         }
     }
 
+    //Keep the counts of this Rx before the next one clears them
+    UInt key = Swi_disable();
+    foldRxStatistics();
+    Swi_restore(key);
+    countRxStatus(status);
+
     //Release the busyMutex
     Semaphore_post(busyMutex);
 
@@ -1390,6 +2033,7 @@ EasyLink_Status EasyLink_receiveAsync(EasyLink_ReceiveCb cb, uint32_t absTime)
     //Check and take the busyMutex
     if ( (Semaphore_pend(busyMutex, 0) == FALSE) || (EasyLink_CmdHandle_isValid(asyncCmdHndl)) )
     {
+        radioStats.busyErrors++;
         return EasyLink_Status_Busy_Error;
     }
 
@@ -1401,6 +2045,7 @@ EasyLink_Status EasyLink_receiveAsync(EasyLink_ReceiveCb cb, uint32_t absTime)
     pDataEntry->status = 0;
     dataQueue.pCurrEntry = (uint8_t*)pDataEntry;
     dataQueue.pLastEntry = NULL;
+    configureRxRepeat(false);
     EasyLink_cmdPropRxAdv.pQueue = &dataQueue;               /* Set the Data Entity queue for received data */
     EasyLink_cmdPropRxAdv.pOutput = (uint8_t*)&rxStatistics;
 
@@ -1431,7 +2076,7 @@ EasyLink_Status EasyLink_receiveAsync(EasyLink_ReceiveCb cb, uint32_t absTime)
     }
 
     //Clear the Rx statistics structure
-    memset(&rxStatistics, 0, sizeof(rfc_propRxOutput_t));
+    resetRxStatistics();
 
     if(rfModeMultiClient)
     {
@@ -1464,14 +2109,217 @@ EasyLink_Status EasyLink_receiveAsync(EasyLink_ReceiveCb cb, uint32_t absTime)
     return status;
 }
 
+//Starts continuous Rx for EasyLink_receiveContinuousAsync() and
+//EasyLink_receiveContinuousViewAsync(), with the callbacks passed
+static EasyLink_Status receiveContinuous(EasyLink_ReceiveCb cb,
+        EasyLink_ReceiveViewCb viewCb, uint32_t absTime, bool resume)
+{
+    EasyLink_Status status = EasyLink_Status_Rx_Error;
+    RF_ScheduleCmdParams schParams_prop;
+
+    //Check if not configure of already an Async command being performed
+    if ( (!configured) || suspended)
+    {
+        return EasyLink_Status_Config_Error;
+    }
+    //Check and take the busyMutex
+    if ( (Semaphore_pend(busyMutex, 0) == FALSE) || (EasyLink_CmdHandle_isValid(asyncCmdHndl)) )
+    {
+        radioStats.busyErrors++;
+        return EasyLink_Status_Busy_Error;
+    }
+
+    rxCb = cb;
+    rxViewCb = viewCb;
+
+    //RF core stays in Rx and fills the entries in turn, the callback hands
+    //them back as soon as they are read. A resumed Rx carries on with the
+    //entries as the RF core left them, some may still be lent
+    if (!resume)
+    {
+        rxQueueInit();
+    }
+    rxQueueStarved = false;
+    configureRxRepeat(true);
+    EasyLink_cmdPropRxAdv.pQueue = &rxContinuousQueue;       /* Set the Data Entity queue for received data */
+    EasyLink_cmdPropRxAdv.pOutput = (uint8_t*)&rxStatistics;
+
+    if (absTime != 0)
+    {
+        EasyLink_cmdPropRxAdv.startTrigger.triggerType = TRIG_ABSTIME;
+        EasyLink_cmdPropRxAdv.startTrigger.pastTrig = 1;
+        EasyLink_cmdPropRxAdv.startTime = absTime;
+    }
+    else
+    {
+        EasyLink_cmdPropRxAdv.startTrigger.triggerType = TRIG_NOW;
+        EasyLink_cmdPropRxAdv.startTrigger.pastTrig = 1;
+        EasyLink_cmdPropRxAdv.startTime = 0;
+    }
+
+    if (asyncRxTimeOut != 0)
+    {
+        EasyLink_cmdPropRxAdv.endTrigger.triggerType = TRIG_ABSTIME;
+        EasyLink_cmdPropRxAdv.endTrigger.pastTrig = 1;
+        EasyLink_cmdPropRxAdv.endTime = RF_getCurrentTime() + asyncRxTimeOut;
+    }
+    else
+    {
+        EasyLink_cmdPropRxAdv.endTrigger.triggerType = TRIG_NEVER;
+        EasyLink_cmdPropRxAdv.endTrigger.pastTrig = 1;
+        EasyLink_cmdPropRxAdv.endTime = 0;
+    }
+
+    //Clear the Rx statistics structure
+    resetRxStatistics();
+
+    if(rfModeMultiClient)
+    {
+        /* assume high priority */
+        schParams_prop.priority = RF_PriorityHigh;
+        schParams_prop.endTime = EasyLink_cmdPropRxAdv.endTime;
+
+        asyncCmdHndl = RF_scheduleCmd(rfHandle, (RF_Op*)&EasyLink_cmdPropRxAdv,
+                    &schParams_prop, rxContinuousCallback,
+                    EASYLINK_RF_EVENT_MASK | RF_EventRxEntryDone);
+    }
+    else
+    {
+        asyncCmdHndl = RF_postCmd(rfHandle, (RF_Op*)&EasyLink_cmdPropRxAdv,
+            RF_PriorityHigh, rxContinuousCallback,
+            EASYLINK_RF_EVENT_MASK | RF_EventRxEntryDone);
+    }
+
+    if (EasyLink_CmdHandle_isValid(asyncCmdHndl))
+    {
+        rxContinuous = true;
+        status = EasyLink_Status_Success;
+    }
+    else
+    {
+        //Callback will not be called, release the busyMutex
+        Semaphore_post(busyMutex);
+    }
+
+    //busyMutex will be released in callback when Rx ends
+
+    return status;
+}
+
+EasyLink_Status EasyLink_receiveContinuousAsync(EasyLink_ReceiveCb cb, uint32_t absTime)
+{
+    return receiveContinuous(cb, NULL, absTime, false);
+}
+
+EasyLink_Status EasyLink_receiveContinuousViewAsync(EasyLink_ReceiveViewCb cb, uint32_t absTime)
+{
+    return receiveContinuous(NULL, cb, absTime, false);
+}
+
+//Stops continuous Rx so that a Tx can be sent, the busyMutex is taken on
+//return. Returns false if no continuous Rx could be paused
+static bool suspendContinuousRx(void)
+{
+    RF_CmdHandle rxHndl = asyncCmdHndl;
+
+    if ( (!rxContinuous) || (!EasyLink_CmdHandle_isValid(rxHndl)) )
+    {
+        return false;
+    }
+#if (defined(DeviceFamily_CC13X0) || defined(DeviceFamily_CC13X2))
+    //Rx is listening through the back-off of a CCA Tx still in progress
+    if (ccaBackOffCtx != NULL)
+    {
+        return false;
+    }
+#endif // (defined(DeviceFamily_CC13X0) || defined(DeviceFamily_CC13X2))
+
+    rxResumeAfterTx = true;
+
+    //Graceful stop, a packet being received is finished first
+    if (RF_cancelCmd(rfHandle, rxHndl, 1) != RF_StatSuccess)
+    {
+        rxResumeAfterTx = false;
+        return false;
+    }
+    RF_pendCmd(rfHandle, rxHndl, (RF_EventLastCmdDone |
+            RF_EventCmdAborted | RF_EventCmdCancelled | RF_EventCmdStopped));
+
+    //rxContinuousCallback has released the busyMutex
+    return (Semaphore_pend(busyMutex, 0) == TRUE);
+}
+
+//Restarts continuous Rx paused by suspendContinuousRx(), the application is
+//only told if it can not be restarted
+static void resumeContinuousRx(void)
+{
+    rxResumeAfterTx = false;
+
+    if (receiveContinuous(rxCb, rxViewCb, 0, true) != EasyLink_Status_Success)
+    {
+        rxContinuousEnded(EasyLink_Status_Rx_Error);
+    }
+}
+
+void EasyLink_releaseRxView(EasyLink_RxView *rxView)
+{
+    uint8_t index = (rxView->entry - rxQueueBuffer) / EASYLINK_RX_ENTRY_SIZE;
+    bool restart;
+    UInt key;
+
+    key = Swi_disable();
+    if (!rxQueueLent[index])
+    {
+        //Already released
+        Swi_restore(key);
+        return;
+    }
+    rxQueueLent[index] = false;
+    rxQueueAppend(index);
+
+    restart = rxQueueStarved;
+    rxQueueStarved = false;
+    Swi_restore(key);
+
+    if (restart)
+    {
+        resumeContinuousRx();
+    }
+}
+
 EasyLink_Status EasyLink_abort(void)
 {
     EasyLink_Status status = EasyLink_Status_Cmd_Error;
+#if (defined(DeviceFamily_CC13X0) || defined(DeviceFamily_CC13X2))
+    EasyLink_CcaContext *pCtx;
+    UInt key;
+#endif // (defined(DeviceFamily_CC13X0) || defined(DeviceFamily_CC13X2))
 
     if ( (!configured) || suspended)
     {
         return EasyLink_Status_Config_Error;
     }
+#if (defined(DeviceFamily_CC13X0) || defined(DeviceFamily_CC13X2))
+    //A CCA Tx waiting out a back-off has no command running, it ends before
+    //the continuous Rx listening meanwhile, which goes on
+    key = Swi_disable();
+    pCtx = ccaBackOffCtx;
+    ccaBackOffCtx = NULL;
+    Swi_restore(key);
+    if (pCtx != NULL)
+    {
+        Clock_stop(Clock_handle(&ccaBackOffClock));
+        ccaFinish(pCtx, EasyLink_Status_Aborted);
+        return EasyLink_Status_Success;
+    }
+#endif // (defined(DeviceFamily_CC13X0) || defined(DeviceFamily_CC13X2))
+    //Continuous Rx waiting for an entry to be released has no command
+    //running, it just ends
+    if (rxQueueStarved)
+    {
+        rxContinuousEnded(EasyLink_Status_Aborted);
+        return EasyLink_Status_Success;
+    }
     //check an Async command is running, if not return success
     if (!EasyLink_CmdHandle_isValid(asyncCmdHndl))
     {
@@ -1518,6 +2366,7 @@ EasyLink_Status EasyLink_enableRxAddrFilter(uint8_t* pui8AddrFilterTable, uint8_
     }
     if ( Semaphore_pend(busyMutex, 0) == FALSE )
     {
+        radioStats.busyErrors++;
         return EasyLink_Status_Busy_Error;
     }
 
@@ -46,6 +46,7 @@
 #include <ti/sysbios/knl/Task.h>
 #include <ti/sysbios/knl/Semaphore.h>
 #include <ti/sysbios/knl/Clock.h>
+#include <ti/sysbios/knl/Swi.h>
 #include <ti/drivers/UART.h>
 
 /* TI-RTOS Header files */
@@ -56,32 +57,87 @@
 
 /* Custom includes */
 #include <stdio.h>
+#include <string.h>
 #include <math.h>
 
 /* EasyLink API Header files */
 #include "easylink/EasyLink.h"
 
+#include "UartFrame.h"
+#include "RingBuffer.h"
+#include "Uplink.h"
+#include "LinkStats.h"
+#include "Trace.h"
+#include "ChannelPlan.h"
+
 /***** Defines *****/
 
 /* Undefine to remove address filter and async mode */
 #define RFEASYLINKRX_ASYNC
 #define RFEASYLINKRX_ADDR_FILTER
 
+/* Define to send binary frames (see UartFrame.h) instead of ASCII records */
+//#define RFEASYLINKRX_UART_BINARY
+
 #define RFEASYLINKEX_TASK_STACK_SIZE 1024
 #define RFEASYLINKEX_TASK_PRIORITY   3
 #define UART_TASK_PRIORITY   2
 
-#define RFEASYLINKTXPAYLOAD_LENGTH      30
-#define QT_PACKETS 1
+#ifdef RFEASYLINKRX_UART_BINARY
+#define UART_STACK_SIZE (UART_FRAME_OVERHEAD + UART_FRAME_RX_TIME_SIZE + EASYLINK_MAX_DATA_LENGTH)
+#else
+//Raw uplink packets, the UART task turns them into ASCII records
+#define UART_STACK_SIZE EASYLINK_MAX_DATA_LENGTH
+//"ap;" then "sid;rss;d1d2;" per measure, plus "min;max;var;" with RSSI stats,
+//"di1di2;" with distance and "bcn;lst;" with beacon loss
+#define UART_HEADER_CHARS 4
+#define UART_MEASURE_CHARS (15 + 12 + 7 + 8)
+#endif
+#define MEM_STACK_SIZE 4 // Must be a power of two
+#define UPLINK_MAX_APS 8 // APs whose uplink losses are tracked
+
+#if (MEM_STACK_SIZE & (MEM_STACK_SIZE - 1)) != 0
+#error MEM_STACK_SIZE must be a power of two
+#endif
+#if UART_FRAME_LINK_STATS_SIZE != (15 + 4 * LINKSTATS_GAP_BUCKETS)
+#error UART_FRAME_LINK_STATS_SIZE does not match LinkStats.h
+#endif
+
+#ifdef RFEASYLINKRX_UART_BINARY
+#define UART_BATCH_SIZE (MEM_STACK_SIZE * (UART_STACK_SIZE + 1) + \
+        2 * UART_FRAME_OVERHEAD + UART_FRAME_STATUS_SIZE + \
+        UART_FRAME_RADIO_STATS_SIZE + \
+        UPLINK_MAX_APS * (UART_FRAME_OVERHEAD + UART_FRAME_LINK_STATS_SIZE)) // Whole ring plus the status frames
+#define UART_STATUS_PERIOD_MS 1000 // Period of the status frames
+#else
+#define UART_BATCH_SIZE 512 // Text written at once, a long record takes several writes
+#endif
+
+static uint8_t memStack[MEM_STACK_SIZE][UART_STACK_SIZE];
+static uint16_t memStackLen[MEM_STACK_SIZE];
+RingBuffer memRing;    /* not static so you can see the drop counter in ROV */
+
+//Counters reported by the status frames
+typedef struct
+{
+        uint32_t packets;       // Uplink packets received
+        uint32_t bytesSent;     // Bytes written to the UART
+        uint32_t uplinksLost;   // Gaps in the uplink sequence numbers of all APs
+} CentralStats;
+
+CentralStats centralStats;    /* not static so you can see in ROV */
 
-#define UART_STACK_SIZE 109 // 109 char / packet * 4 packets / stack
-#define MEM_STACK_SIZE 10
+//Uplink delivery of each AP
+typedef struct
+{
+        uint8_t apId;
+        uint8_t lastSeq;
+        LinkStats stats;
+        Uplink_Telemetry telemetry; // Latest radio counters the AP sent
+} ApLink;
 
-char uartStack[UART_STACK_SIZE];
-char memStack[MEM_STACK_SIZE][UART_STACK_SIZE];
-int mem_stack_dumper_counter = 0;
-int mem_stack_counter = 0;
-int mem_stack_filler_counter = 0;
+ApLink apLinks[UPLINK_MAX_APS];    /* not static so you can see in ROV */
+static uint8_t apLinkCount = 0;
 
 /* Pin driver handle */
 static PIN_Handle ledPinHandle;
@@ -90,6 +146,9 @@ static PIN_State ledPinState;
 /* UART params */
 UART_Handle uart;
 UART_Params uartParams;
+static uint8_t uartBatch[UART_BATCH_SIZE];
+static Semaphore_Handle uartDataSem;
+static Semaphore_Handle uartTxDoneSem;
 
 /*
  * Application LED pin configuration table:
@@ -121,14 +180,209 @@ static Semaphore_Handle rxDoneSem;
 #endif
 
 /***** Function definitions *****/
-static void uartFnx(UArg arg0, UArg arg1)
+static void uartWriteCb(UART_Handle handle, void *buf, size_t count)
+{
+    TRACE(TRACE_UART_WRITE_DONE, count);
+    Semaphore_post(uartTxDoneSem);
+}
+
+/* Starts a callback mode write and sleeps until the driver is done with buf */
+static void uartSend(const void *buf, size_t count)
+{
+    TRACE(TRACE_UART_WRITE, count);
+    if(UART_write(uart, buf, count) != UART_ERROR)
+    {
+        Semaphore_pend(uartTxDoneSem, BIOS_WAIT_FOREVER);
+        centralStats.bytesSent += count;
+    }
+}
+
+#ifdef RFEASYLINKRX_UART_BINARY
+static void putUint32(uint8_t* p, uint32_t value)
+{
+    p[0] = (uint8_t)(value);
+    p[1] = (uint8_t)(value >> 8);
+    p[2] = (uint8_t)(value >> 16);
+    p[3] = (uint8_t)(value >> 24);
+}
+
+/* Writes a status frame to frame, returns its size */
+static uint16_t encodeStatus(uint8_t* frame)
+{
+    static uint8_t statusSeq = 0;
+
+    uint8_t status[UART_FRAME_STATUS_SIZE];
+
+    putUint32(&status[0], centralStats.packets);
+    putUint32(&status[4], memRing.drops);
+    putUint32(&status[8], centralStats.bytesSent);
+    putUint32(&status[12], centralStats.uplinksLost);
+
+    return UartFrame_encode(frame, UART_FRAME_TYPE_STATUS, statusSeq++,
+            status, sizeof(status));
+}
+
+/* Writes a radio stats frame to frame, returns its size */
+static uint16_t encodeRadioStats(uint8_t* frame)
+{
+    static uint8_t radioStatsSeq = 0;
+
+    uint8_t payload[UART_FRAME_RADIO_STATS_SIZE];
+    EasyLink_Stats stats;
+
+    EasyLink_getStats(&stats);
+    putUint32(&payload[0], stats.rxOk);
+    putUint32(&payload[4], stats.rxNok);
+    putUint32(&payload[8], stats.rxIgnored);
+    putUint32(&payload[12], stats.rxBufFull);
+    putUint32(&payload[16], stats.rxTimeouts);
+    putUint32(&payload[20], stats.rxAborts);
+    putUint32(&payload[24], stats.rxErrors);
+    putUint32(&payload[28], stats.txOk);
+    putUint32(&payload[32], stats.txAborts);
+    putUint32(&payload[36], stats.txErrors);
+    putUint32(&payload[40], stats.busyErrors);
+    payload[44] = (uint8_t)stats.lastRssi;
+
+    return UartFrame_encode(frame, UART_FRAME_TYPE_RADIO_STATS, radioStatsSeq++,
+            payload, sizeof(payload));
+}
+
+/* Writes a link stats frame of every AP heard to frame, returns their size */
+static uint16_t encodeLinkStats(uint8_t* frame)
 {
+    static uint8_t linkStatsSeq = 0;
+
+    uint8_t payload[UART_FRAME_LINK_STATS_SIZE];
+    uint16_t len = 0;
+    uint16_t permille;
+    LinkStats stats;
+    uint8_t apId;
     uint8_t i;
+    uint8_t j;
+    UInt key;
+
+    for(i = 0; i < apLinkCount; i++) {
+        //rxDoneCb updates the counters from Swi context
+        key = Swi_disable();
+        apId = apLinks[i].apId;
+        stats = apLinks[i].stats;
+        Swi_restore(key);
+
+        permille = LinkStats_deliveryPermille(&stats);
+        payload[0] = apId;
+        payload[1] = (uint8_t)(permille);
+        payload[2] = (uint8_t)(permille >> 8);
+        putUint32(&payload[3], stats.received);
+        putUint32(&payload[7], stats.lost);
+        putUint32(&payload[11], stats.resyncs);
+        for(j = 0; j < LINKSTATS_GAP_BUCKETS; j++) {
+            putUint32(&payload[15 + 4 * j], stats.gaps[j]);
+        }
+
+        len += UartFrame_encode(&frame[len], UART_FRAME_TYPE_LINK_STATS, linkStatsSeq++,
+                payload, sizeof(payload));
+    }
+
+    return len;
+}
+#endif
+
+#ifndef RFEASYLINKRX_UART_BINARY
+//Writes n as three ASCII digits and returns the position right after them
+char* fillMemStack(char* a, uint8_t n) {
+    a[2] = n%10 + '0';
+    n = n/10;
+    a[1] = n%10 + '0';
+    a[0] = n/10 + '0';
+
+    return a + 3;
+}
+
+/*
+ * Appends the ASCII record of an uplink packet, ended by '.', to the batch and
+ * returns the new batch length. The batch is written out whenever the next
+ * measure may not fit.
+ */
+static uint16_t formatUplink(const uint8_t* packet, uint16_t len, uint16_t batchLen)
+{
+    Uplink_Decoder decoder;
+    Uplink_Measure m;
+    char* batch = (char*)uartBatch;
+    char* p;
+
+    if(Uplink_decoderInit(&decoder, packet, len) != 0) {
+        return batchLen;
+    }
+
+    if(batchLen + UART_HEADER_CHARS + 1 > UART_BATCH_SIZE) {
+        uartSend(uartBatch, batchLen);
+        batchLen = 0;
+    }
+    p = &batch[batchLen];
+
+    p = fillMemStack(p, decoder.apId); //ap id
+    *p++ = ';';
+
+    //Uplink packets carry as many measures as the AP collected
+    while(Uplink_decodeNext(&decoder, &m)) {
+        if((p - batch) + UART_MEASURE_CHARS + 1 > UART_BATCH_SIZE) {
+            uartSend(uartBatch, p - batch);
+            p = batch;
+        }
+
+        p = fillMemStack(p, m.id); //simio id
+        *p++ = ';';
+
+        p = fillMemStack(p, m.rssi); //rssi
+        *p++ = ';';
+
+        p = fillMemStack(p, (uint8_t)(m.delta >> 8)); //delta time byte 1
+
+        p = fillMemStack(p, (uint8_t)(m.delta & 0xFF)); //delta time byte 2
+        *p++ = ';';
+
+        if(decoder.flags & UPLINK_FLAG_RSSI_STATS) {
+            p = fillMemStack(p, m.rssiMin); //rssi min
+            *p++ = ';';
+
+            p = fillMemStack(p, m.rssiMax); //rssi max
+            *p++ = ';';
+
+            p = fillMemStack(p, m.rssiVariance); //rssi variance
+            *p++ = ';';
+        }
+
+        if(decoder.flags & UPLINK_FLAG_DISTANCE) {
+            p = fillMemStack(p, (uint8_t)(m.distance >> 8)); //distance byte 1
+
+            p = fillMemStack(p, (uint8_t)(m.distance & 0xFF)); //distance byte 2
+            *p++ = ';';
+        }
+
+        if(decoder.flags & UPLINK_FLAG_BEACON_LOSS) {
+            p = fillMemStack(p, m.beacons); //beacons
+            *p++ = ';';
+
+            p = fillMemStack(p, m.beaconsLost); //beacons lost
+            *p++ = ';';
+        }
+    }
+
+    *p++ = '.';
+    return p - batch;
+}
+#endif
+
+static void uartFnx(UArg arg0, UArg arg1)
+{
     /* Call driver init functions */
     UART_init();
 
     /* Create a UART with data processing off. */
     UART_Params_init(&uartParams);
+    uartParams.writeMode = UART_MODE_CALLBACK;
+    uartParams.writeCallback = uartWriteCb;
     uartParams.writeDataMode = UART_DATA_BINARY;
     uartParams.readDataMode = UART_DATA_BINARY;
     uartParams.readReturnMode = UART_RETURN_FULL;
@@ -141,89 +395,135 @@ static void uartFnx(UArg arg0, UArg arg1)
         uart = UART_open(Board_UART0, &uartParams);
     }
 
-    UART_write(uart, "y", 1);
+    uartSend("y", 1);
+
+#ifdef RFEASYLINKRX_UART_BINARY
+    uint32_t statusPeriod = UART_STATUS_PERIOD_MS * 1000 / Clock_tickPeriod;
+    uint32_t lastStatus = Clock_getTicks();
+#endif
 
     while(uart != NULL) {
-        //Checks if memory has been update
-        if(mem_stack_dumper_counter != mem_stack_counter) {
+        uint16_t len;
+        uint16_t batchLen = 0;
+        uint8_t* slot;
+
+#ifdef RFEASYLINKRX_UART_BINARY
+        //Sleeps until rxDoneCb publishes new records or a status is due
+        uint32_t elapsed = Clock_getTicks() - lastStatus;
+
+        Semaphore_pend(uartDataSem, (elapsed < statusPeriod) ? statusPeriod - elapsed : 0);
+        if(Clock_getTicks() - lastStatus >= statusPeriod) {
+            lastStatus = Clock_getTicks();
+            batchLen = encodeStatus(uartBatch);
+            batchLen += encodeRadioStats(&uartBatch[batchLen]);
+            batchLen += encodeLinkStats(&uartBatch[batchLen]);
+        }
+#else
+        //Sleeps until rxDoneCb publishes new records
+        Semaphore_pend(uartDataSem, BIOS_WAIT_FOREVER);
+#endif
 
-            //Send serial UART stack
-            UART_write(uart, memStack[mem_stack_dumper_counter], UART_STACK_SIZE);
-            UART_write(uart, ".", 1);
+#ifdef RFEASYLINKRX_UART_BINARY
+        //Copies every pending slot into a single write
+        while((slot = RingBuffer_peek(&memRing, &len)) != NULL &&
+                batchLen + len <= UART_BATCH_SIZE) {
+            memcpy(&uartBatch[batchLen], slot, len);
+            batchLen += len;
+            RingBuffer_release(&memRing);
+        }
+#else
+        //Formats every pending slot, writing out whenever the batch is full
+        while((slot = RingBuffer_peek(&memRing, &len)) != NULL) {
+            batchLen = formatUplink(slot, len, batchLen);
+            RingBuffer_release(&memRing);
+        }
+#endif
 
-            mem_stack_dumper_counter++;
-            if(mem_stack_dumper_counter == MEM_STACK_SIZE) {
-                mem_stack_dumper_counter = 0;
-            }
+        //Send serial UART stack
+        if(batchLen > 0) {
+            uartSend(uartBatch, batchLen);
         }
     }
 }
 
-void intToCharArray(char* a, uint8_t n, uint8_t size) {
+//Counts an uplink of an AP against its sequence number
+static void countUplink(const uint8_t* payload, uint8_t len)
+{
+    Uplink_Decoder decoder;
     uint8_t i;
-    uint8_t digit;
-    uint8_t aux = n;
-    for(i = 0; i < size; i++) {
-        digit = aux%10;
-        aux = aux/10;
-        a[i] = digit + '0';
+
+    if(Uplink_decoderInit(&decoder, payload, len) != 0) {
+        return;
+    }
+
+    for(i = 0; i < apLinkCount; i++) {
+        if(apLinks[i].apId == decoder.apId) {
+            centralStats.uplinksLost += LinkStats_next(&apLinks[i].stats,
+                    apLinks[i].lastSeq, decoder.seq);
+            apLinks[i].lastSeq = decoder.seq;
+            if(decoder.flags & UPLINK_FLAG_TELEMETRY) {
+                apLinks[i].telemetry = decoder.telemetry;
+            }
+            return;
+        }
     }
-}
 
-void fillMemStack(char* a, uint8_t size) {
-    int i;
-    for(i = size-1; i >= 0; i--) {
-        memStack[mem_stack_counter][mem_stack_filler_counter++] = a[i];
+    //APs past UPLINK_MAX_APS are forwarded but not tracked
+    if(apLinkCount < UPLINK_MAX_APS) {
+        apLinks[apLinkCount].apId = decoder.apId;
+        apLinks[apLinkCount].lastSeq = decoder.seq;
+        LinkStats_first(&apLinks[apLinkCount].stats);
+        if(decoder.flags & UPLINK_FLAG_TELEMETRY) {
+            apLinks[apLinkCount].telemetry = decoder.telemetry;
+        }
+        apLinkCount++;
     }
 }
 
 #ifdef RFEASYLINKRX_ASYNC
-void rxDoneCb(EasyLink_RxPacket * rxPacket, EasyLink_Status status)
+void rxDoneCb(EasyLink_RxView * rxView, EasyLink_Status status)
 {
     if (status == EasyLink_Status_Success)
     {
-        uint8_t i;
-        uint8_t j;
+        TRACE(TRACE_APP_RX, rxView->absTime);
 
-        const uint8_t oneByteSyze = 3;
-        char* auxOneByte = malloc(oneByteSyze*sizeof(char));
-
-        //Fills memory with packet info
-        if(((int*)rxPacket->dstAddr)[0] == 0xBB) {
-
-            intToCharArray(auxOneByte,rxPacket->payload[0],oneByteSyze); //ap id
-            fillMemStack(auxOneByte, oneByteSyze);
-            memStack[mem_stack_counter][mem_stack_filler_counter++] = ';';
-
-            for(i = 1; i < RFEASYLINKTXPAYLOAD_LENGTH - 3; ) {
-                intToCharArray(auxOneByte,rxPacket->payload[i++],oneByteSyze); //simio id
-                fillMemStack(auxOneByte, oneByteSyze);
-                memStack[mem_stack_counter][mem_stack_filler_counter++] = ';';
-
-                intToCharArray(auxOneByte,rxPacket->payload[i++],oneByteSyze); //rssi
-                fillMemStack(auxOneByte, oneByteSyze);
-                memStack[mem_stack_counter][mem_stack_filler_counter++] = ';';
+        if(rxView->dstAddr[0] == 0xBB) {
+            centralStats.packets++;
+            countUplink(rxView->payload, rxView->len);
+        }
 
-                intToCharArray(auxOneByte,rxPacket->payload[i++],oneByteSyze); //delta time byte 1
-                fillMemStack(auxOneByte, oneByteSyze);
+#ifdef RFEASYLINKRX_UART_BINARY
+        static uint8_t frameSeq = 0;
 
-                intToCharArray(auxOneByte,rxPacket->payload[i++],oneByteSyze); //delta time byte 2
-                fillMemStack(auxOneByte, oneByteSyze);
-                memStack[mem_stack_counter][mem_stack_filler_counter++] = ';';
-            }
+        uint8_t* slot;
+        uint8_t rxTime[UART_FRAME_RX_TIME_SIZE];
 
-            //Checks if memory stack is full and updates counters
-            if(mem_stack_filler_counter == UART_STACK_SIZE) {
-                mem_stack_filler_counter = 0;
+        //Fills memory with the framed packet and the time it was received
+        if(rxView->dstAddr[0] == 0xBB &&
+                rxView->len <= UART_STACK_SIZE - UART_FRAME_OVERHEAD - UART_FRAME_RX_TIME_SIZE &&
+                (slot = RingBuffer_reserve(&memRing)) != NULL) {
+            putUint32(rxTime, rxView->absTime);
 
-                mem_stack_counter++;
-                if(mem_stack_counter == MEM_STACK_SIZE) {
-                    mem_stack_counter = 0;
-                }
-            }
+            RingBuffer_commit(&memRing, UartFrame_encodePrefixed(slot,
+                    UART_FRAME_TYPE_AP_REPORT_TIMED, frameSeq++, rxTime, sizeof(rxTime),
+                    rxView->payload, rxView->len));
+            Semaphore_post(uartDataSem);
+        }
+#else
+        uint8_t* slot;
+
+        //Fills memory with the packet, the UART task formats it
+        if(rxView->dstAddr[0] == 0xBB && rxView->len >= UPLINK_HEADER_SIZE &&
+                (slot = RingBuffer_reserve(&memRing)) != NULL) {
+            memcpy(slot, rxView->payload, rxView->len);
+            RingBuffer_commit(&memRing, rxView->len);
+            Semaphore_post(uartDataSem);
         }
+#endif //RFEASYLINKRX_UART_BINARY
 
-        free(auxOneByte);
+        //The packet was read straight from its Rx entry, hand it back
+        TRACE(TRACE_APP_RX_DONE, rxView->len);
+        EasyLink_releaseRxView(rxView);
 
         /* Toggle LED2 to indicate RX */
         PIN_setOutputValue(pinHandle, Board_PIN_LED2,!PIN_getOutputValue(Board_PIN_LED2));
@@ -240,7 +540,11 @@ void rxDoneCb(EasyLink_RxPacket * rxPacket, EasyLink_Status status)
         PIN_setOutputValue(pinHandle, Board_PIN_LED2,!PIN_getOutputValue(Board_PIN_LED2));
     }
 
-    Semaphore_post(rxDoneSem);
+    //Rx stays on across packets, only wake the task once it has ended
+    if(status != EasyLink_Status_Success)
+    {
+        Semaphore_post(rxDoneSem);
+    }
 }
 #endif
 
@@ -279,11 +583,11 @@ static void rfEasyLinkRxFnx(UArg arg0, UArg arg1)
         System_abort("EasyLink_init failed");
     }
 
-    /*
-     * If you wish to use a frequency other than the default, use
-     * the following API:
-     * EasyLink_setFrequency(868000000);
-     */
+    /* The APs send their uplinks on the backhaul channel */
+    if(EasyLink_setFrequency(ChannelPlan_frequency(CHANNEL_PLAN_BACKHAUL)) != EasyLink_Status_Success)
+    {
+        System_abort("EasyLink_setFrequency failed");
+    }
 
 #ifdef RFEASYLINKRX_ADDR_FILTER
 	/* 
@@ -298,18 +602,17 @@ static void rfEasyLinkRxFnx(UArg arg0, UArg arg1)
 
     while(1) {
 #ifdef RFEASYLINKRX_ASYNC
-        EasyLink_receiveAsync(rxDoneCb, 0);
-
-        /* Wait 300ms for Rx */
-        if(Semaphore_pend(rxDoneSem, (300000 / Clock_tickPeriod)) == FALSE)
+        /*
+         * Rx is not restarted after every packet, packets sent back to back
+         * are queued by EasyLink while rxDoneCb handles the previous one
+         */
+        if(EasyLink_receiveContinuousViewAsync(rxDoneCb, 0) != EasyLink_Status_Success)
         {
-            /* RX timed out abort */
-            if(EasyLink_abort() == EasyLink_Status_Success)
-            {
-               /* Wait for the abort */
-               Semaphore_pend(rxDoneSem, BIOS_WAIT_FOREVER);
-            }
+            System_abort("EasyLink_receiveContinuousViewAsync failed");
         }
+
+        /* Wait for Rx to end before restarting it */
+        Semaphore_pend(rxDoneSem, BIOS_WAIT_FOREVER);
 #else
         rxPacket.absTime = 0;
         EasyLink_Status result = EasyLink_receive(&rxPacket);
@@ -342,11 +645,26 @@ void rxTask_init(PIN_Handle ledPinHandle) {
 }
 
 void uartTask_init() {
+    /* Create the semaphores before rxDoneCb can post them */
+    Semaphore_Params params;
+    Error_Block eb;
+
+    Semaphore_Params_init(&params);
+    params.mode = Semaphore_Mode_BINARY;
+    Error_init(&eb);
+
+    uartDataSem = Semaphore_create(0, &params, &eb);
+    uartTxDoneSem = Semaphore_create(0, &params, &eb);
+    if(uartDataSem == NULL || uartTxDoneSem == NULL)
+    {
+        System_abort("Semaphore creation failed");
+    }
+
     Task_Params_init(&uartTaskParams);
-    rxTaskParams.stackSize = RFEASYLINKEX_TASK_STACK_SIZE;
-    rxTaskParams.priority = UART_TASK_PRIORITY;
-    rxTaskParams.stack = &uartTaskStack;
-    rxTaskParams.arg0 = (UInt)1000000;
+    uartTaskParams.stackSize = RFEASYLINKEX_TASK_STACK_SIZE;
+    uartTaskParams.priority = UART_TASK_PRIORITY;
+    uartTaskParams.stack = &uartTaskStack;
+    uartTaskParams.arg0 = (UInt)1000000;
 
     Task_construct(&uartTask, uartFnx, &uartTaskParams, NULL);
 }
@@ -359,6 +677,12 @@ int main(void)
     /* Call driver init functions */
     Board_initGeneral();
 
+#ifdef TRACE_ENABLE
+    Trace_init();
+#endif
+
+    RingBuffer_init(&memRing, &memStack[0][0], memStackLen, UART_STACK_SIZE, MEM_STACK_SIZE);
+
     /* Open LED pins */
     ledPinHandle = PIN_open(&ledPinState, pinTable);
 	Assert_isTrue(ledPinHandle != NULL, NULL); 
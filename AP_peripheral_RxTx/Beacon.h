@@ -0,0 +1,36 @@
+#ifndef BEACON_H
+#define BEACON_H
+
+#include <stdint.h>
+
+/*
+ * Beacon a tag sends to the APs (dst 0xaa). Beacon.h and Beacon.c are kept
+ * identical in simio_Tx and AP_peripheral_RxTx.
+ *
+ *   [tag id][seq][flags]
+ *
+ * seq counts the beacons of the tag (see LinkStats.h). Tags before this
+ * format sent [tag id][seq] and 28 filler bytes, Beacon_decode still reads
+ * them with no flags: flags are only taken from a payload of BEACON_SIZE.
+ */
+
+#define BEACON_SIZE                 3
+
+/* Flags */
+#define BEACON_FLAG_BATTERY_LOW     0x01 // Battery below the tag's threshold
+#define BEACON_FLAG_MOTION          0x02 // Tag moved since its last beacon
+
+typedef struct
+{
+    uint8_t id;
+    uint8_t seq;
+    uint8_t flags;
+} Beacon;
+
+/* Writes a beacon to payload and returns its length */
+uint8_t Beacon_encode(uint8_t* payload, uint8_t id, uint8_t seq, uint8_t flags);
+
+/* Reads a beacon of either format, returns -1 if payload is too short */
+int Beacon_decode(Beacon* beacon, const uint8_t* payload, uint8_t len);
+
+#endif /* BEACON_H */
@@ -0,0 +1,90 @@
+/*
+ *  ======== Distance.c ========
+ */
+#include "Distance.h"
+
+/***** Defines *****/
+
+#define DECADE_FRAC_BITS    12  // Exponents are decades in Q12
+#define POW10_LUT_BITS      6   // 2^6 LUT intervals per decade
+
+/***** Variable declarations *****/
+
+//10^(i/64) in Q12 for i = 0..64, interpolated linearly in between
+static const uint16_t pow10Lut[(1 << POW10_LUT_BITS) + 1] = {
+    4096, 4246, 4402, 4563, 4730, 4903, 5083, 5269,
+    5462, 5662, 5870, 6085, 6308, 6539, 6778, 7026,
+    7284, 7551, 7827, 8114, 8411, 8719, 9039, 9370,
+    9713, 10069, 10438, 10820, 11217, 11627, 12053, 12495,
+    12953, 13427, 13919, 14429, 14958, 15505, 16073, 16662,
+    17273, 17905, 18561, 19241, 19946, 20677, 21434, 22220,
+    23034, 23877, 24752, 25659, 26599, 27573, 28583, 29630,
+    30716, 31841, 33007, 34216, 35470, 36769, 38116, 39513,
+    40960,
+};
+
+static const uint32_t pow10Int[] = {1, 10, 100, 1000, 10000};
+
+static Distance_Calibration calibration;
+static uint16_t distanceTable[DISTANCE_RSSI_COUNT]; // cm for every -dBm
+
+/***** Function definitions *****/
+
+//10^(x / 2^DECADE_FRAC_BITS) for x >= 0, saturated to DISTANCE_MAX_CM
+static uint16_t pow10Fixed(int32_t x) {
+    uint32_t decade = (uint32_t)x >> DECADE_FRAC_BITS;
+    uint32_t frac = (uint32_t)x & ((1 << DECADE_FRAC_BITS) - 1);
+    uint32_t index = frac >> (DECADE_FRAC_BITS - POW10_LUT_BITS);
+    uint32_t rem = frac & ((1 << (DECADE_FRAC_BITS - POW10_LUT_BITS)) - 1);
+    uint32_t mantissa;
+    uint32_t value;
+
+    if(decade >= sizeof(pow10Int) / sizeof(pow10Int[0])) {
+        return DISTANCE_MAX_CM;
+    }
+
+    mantissa = pow10Lut[index] + (((pow10Lut[index + 1] - pow10Lut[index]) * rem)
+            >> (DECADE_FRAC_BITS - POW10_LUT_BITS));
+    value = (mantissa * pow10Int[decade] + (1 << (DECADE_FRAC_BITS - 1))) >> DECADE_FRAC_BITS;
+
+    if(value > DISTANCE_MAX_CM) {
+        return DISTANCE_MAX_CM;
+    }
+
+    return (uint16_t)value;
+}
+
+int Distance_calibrate(uint8_t rssi1m, uint16_t pathLossQ8) {
+    uint16_t rssi;
+
+    if(pathLossQ8 == 0) {
+        return -1;
+    }
+
+    calibration.rssi1m = rssi1m;
+    calibration.pathLossQ8 = pathLossQ8;
+
+    for(rssi = 0; rssi < DISTANCE_RSSI_COUNT; rssi++) {
+        //Decades of distance in Q12, the 8 fraction bits of n cancel out
+        int32_t x = ((int32_t)rssi - rssi1m) * (1 << (DECADE_FRAC_BITS + 8)) /
+                (10 * (int32_t)pathLossQ8);
+
+        //Plus two decades for cm, below 1 cm rounds to 0
+        x += 2 << DECADE_FRAC_BITS;
+        distanceTable[rssi] = (x < 0) ? 0 : pow10Fixed(x);
+    }
+
+    return 0;
+}
+
+const Distance_Calibration* Distance_getCalibration(void) {
+    return &calibration;
+}
+
+uint16_t Distance_fromRssi(uint8_t rssi) {
+    if(rssi >= DISTANCE_RSSI_COUNT) {
+        return DISTANCE_MAX_CM;
+    }
+
+    return distanceTable[rssi];
+}
@@ -0,0 +1,37 @@
+#ifndef DISTANCE_H
+#define DISTANCE_H
+
+#include <stdint.h>
+
+/*
+ * RSSI to distance with the log-distance path loss model
+ *
+ *   d = 10 ^ ((rssi - rssi1m) / (10 * n))  meters
+ *
+ * where rssi and rssi1m are -dBm and n is the path loss exponent. The Cortex-M3
+ * has no FPU, so Distance_calibrate evaluates the model once for every RSSI in
+ * fixed point and Distance_fromRssi is a plain table lookup.
+ */
+
+#define DISTANCE_RSSI_COUNT     128 // -dBm values covered, larger ones saturate
+#define DISTANCE_MAX_CM         0xFFFF
+
+typedef struct
+{
+    uint8_t rssi1m;             // -dBm received at 1 m
+    uint16_t pathLossQ8;        // Path loss exponent n, Q8
+} Distance_Calibration;
+
+/*
+ * Sets the calibration and rebuilds the lookup table. Call from task context,
+ * not while Distance_fromRssi may run. Returns -1 if pathLossQ8 is 0.
+ */
+int Distance_calibrate(uint8_t rssi1m, uint16_t pathLossQ8);
+
+/* Calibration in use */
+const Distance_Calibration* Distance_getCalibration(void);
+
+/* Distance in cm for an RSSI in -dBm, saturated to DISTANCE_MAX_CM */
+uint16_t Distance_fromRssi(uint8_t rssi);
+
+#endif /* DISTANCE_H */
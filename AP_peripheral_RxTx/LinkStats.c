@@ -0,0 +1,57 @@
+/*
+ *  ======== LinkStats.c ========
+ */
+#include <string.h>
+
+#include "LinkStats.h"
+
+/***** Function definitions *****/
+
+static uint8_t gapBucket(uint8_t gap) {
+    uint8_t bucket = 0;
+
+    //1, 2, 3-4, 5-8, 9-16 then everything above
+    gap--;
+    while(gap > 0 && bucket < LINKSTATS_GAP_BUCKETS - 1) {
+        gap >>= 1;
+        bucket++;
+    }
+
+    return bucket;
+}
+
+void LinkStats_init(LinkStats* stats) {
+    memset(stats, 0, sizeof(LinkStats));
+}
+
+void LinkStats_first(LinkStats* stats) {
+    stats->received++;
+}
+
+uint8_t LinkStats_next(LinkStats* stats, uint8_t lastSeq, uint8_t seq) {
+    uint8_t gap = (uint8_t)(seq - lastSeq - 1);
+
+    stats->received++;
+
+    if(gap >= LINKSTATS_RESYNC_GAP) {
+        stats->resyncs++;
+        return 0;
+    }
+
+    if(gap > 0) {
+        stats->lost += gap;
+        stats->gaps[gapBucket(gap)]++;
+    }
+
+    return gap;
+}
+
+uint16_t LinkStats_deliveryPermille(const LinkStats* stats) {
+    uint32_t sent = stats->received + stats->lost;
+
+    if(stats->lost == 0) {
+        return 1000;
+    }
+
+    return (uint16_t)((uint64_t)stats->received * 1000 / sent);
+}
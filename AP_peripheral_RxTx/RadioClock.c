@@ -0,0 +1,32 @@
+/*
+ *  ======== RadioClock.c ========
+ */
+#include "RadioClock.h"
+
+/* EasyLink API Header files */
+#include "easylink/EasyLink.h"
+
+/***** Function definitions *****/
+
+uint32_t RadioClock_now(void) {
+    uint32_t absTime = 0;
+
+    EasyLink_getAbsTime(&absTime);
+
+    return absTime;
+}
+
+uint32_t RadioClock_elapsed(uint32_t then, uint32_t now) {
+    //Unsigned subtraction is modulo 2^32, so a single wrap is harmless
+    return now - then;
+}
+
+uint16_t RadioClock_delta(uint32_t then, uint32_t now, uint16_t unitMs) {
+    uint32_t units = RadioClock_elapsed(then, now) / EasyLink_ms_To_RadioTime(unitMs);
+
+    if(units > 0xFFFF) {
+        return 0xFFFF;
+    }
+
+    return (uint16_t)units;
+}
@@ -0,0 +1,22 @@
+#ifndef RADIOCLOCK_H
+#define RADIOCLOCK_H
+
+#include <stdint.h>
+
+/*
+ * Monotonic timestamps on the radio timer (RAT, 4 MHz), the same clock as
+ * EasyLink_RxPacket::absTime, so a received packet already carries its
+ * timestamp for free. The 32 bit counter wraps every ~17.9 minutes, elapsed
+ * times are correct as long as the interval is shorter than that.
+ */
+
+/* Current radio time in RAT ticks */
+uint32_t RadioClock_now(void);
+
+/* RAT ticks from then to now, across a counter wrap */
+uint32_t RadioClock_elapsed(uint32_t then, uint32_t now);
+
+/* Time from then to now in units of unitMs, saturated to 16 bits */
+uint16_t RadioClock_delta(uint32_t then, uint32_t now, uint16_t unitMs);
+
+#endif /* RADIOCLOCK_H */
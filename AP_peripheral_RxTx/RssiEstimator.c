@@ -0,0 +1,93 @@
+/*
+ *  ======== RssiEstimator.c ========
+ */
+#include "RssiEstimator.h"
+
+/***** Function definitions *****/
+
+#ifdef RSSI_ESTIMATOR_MEDIAN
+static int8_t median3(int8_t a, int8_t b, int8_t c) {
+    if(a > b) {
+        int8_t t = a;
+        a = b;
+        b = t;
+    }
+    //With a <= b the median is b if c is above it, else the larger of a and c
+    if(c >= b) {
+        return b;
+    }
+    return (c > a) ? c : a;
+}
+#endif
+
+void RssiEstimator_init(RssiEstimator* e) {
+    e->mean = 0;
+    e->sum = 0;
+    e->sumSq = 0;
+    e->count = 0;
+    e->min = 0;
+    e->max = 0;
+}
+
+void RssiEstimator_add(RssiEstimator* e, int8_t rssi) {
+    int8_t filtered = rssi;
+
+    //Keeps sum and sumSq far from overflowing, see RssiEstimator_variance
+    if(e->count == 0xFF) {
+        return;
+    }
+
+#ifdef RSSI_ESTIMATOR_MEDIAN
+    e->window[e->count % 3] = rssi;
+    if(e->count >= 2) {
+        filtered = median3(e->window[0], e->window[1], e->window[2]);
+    }
+#endif
+
+    if(e->count == 0) {
+        e->mean = (int16_t)rssi << RSSI_ESTIMATOR_FRAC_BITS;
+        e->min = rssi;
+        e->max = rssi;
+    } else {
+        int32_t error = ((int32_t)filtered << RSSI_ESTIMATOR_FRAC_BITS) - e->mean;
+
+        e->mean += (int16_t)(error / (1 << RSSI_ESTIMATOR_EWMA_SHIFT));
+        if(rssi < e->min) {
+            e->min = rssi;
+        }
+        if(rssi > e->max) {
+            e->max = rssi;
+        }
+    }
+
+    e->sum += rssi;
+    e->sumSq += (uint32_t)((int16_t)rssi * rssi);
+    e->count++;
+}
+
+int8_t RssiEstimator_mean(const RssiEstimator* e) {
+    int16_t half = 1 << (RSSI_ESTIMATOR_FRAC_BITS - 1);
+
+    //Rounds half away from zero
+    if(e->mean < 0) {
+        return (int8_t)((e->mean - half) / (1 << RSSI_ESTIMATOR_FRAC_BITS));
+    }
+    return (int8_t)((e->mean + half) / (1 << RSSI_ESTIMATOR_FRAC_BITS));
+}
+
+uint8_t RssiEstimator_variance(const RssiEstimator* e) {
+    uint32_t n = e->count;
+    uint32_t variance;
+
+    if(n < 2) {
+        return 0;
+    }
+
+    //(n * sumSq - sum^2) / n^2, both terms stay below 2^31 for n <= 255
+    variance = (n * e->sumSq - (uint32_t)((int32_t)e->sum * e->sum)) / (n * n);
+    if(variance > 0xFF) {
+        return 0xFF;
+    }
+
+    return (uint8_t)variance;
+}
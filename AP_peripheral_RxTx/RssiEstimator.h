@@ -0,0 +1,50 @@
+#ifndef RSSIESTIMATOR_H
+#define RSSIESTIMATOR_H
+
+#include <stdint.h>
+
+/*
+ * Streaming RSSI statistics of one tag in constant memory, every sample is
+ * folded in with O(1) integer work so it can run in the Rx callback.
+ *
+ * Each sample first goes through a median of the last 3 samples, which drops
+ * a single outlier (a reflection or a collision) before it reaches the
+ * exponentially weighted mean. Min, max and variance are taken over the raw
+ * samples so the spread of the channel is still visible.
+ */
+
+/* Undefine to feed raw samples to the mean */
+#define RSSI_ESTIMATOR_MEDIAN
+
+/* Weight of a new sample in the mean is 1 / 2^RSSI_ESTIMATOR_EWMA_SHIFT */
+#ifndef RSSI_ESTIMATOR_EWMA_SHIFT
+#define RSSI_ESTIMATOR_EWMA_SHIFT 2
+#endif
+
+#define RSSI_ESTIMATOR_FRAC_BITS 8 // Fraction bits of the mean
+
+typedef struct
+{
+    int16_t mean;       // Exponentially weighted mean, Q8
+    int16_t sum;        // Sum of the raw samples
+    uint32_t sumSq;     // Sum of the squared raw samples
+    uint8_t count;      // Samples taken, saturates at 255
+    int8_t min;
+    int8_t max;
+#ifdef RSSI_ESTIMATOR_MEDIAN
+    int8_t window[3];   // Last 3 raw samples
+#endif
+} RssiEstimator;
+
+void RssiEstimator_init(RssiEstimator* e);
+
+/* Folds in one sample, samples past the 255th are ignored */
+void RssiEstimator_add(RssiEstimator* e, int8_t rssi);
+
+/* Mean rounded to an integer, 0 before the first sample */
+int8_t RssiEstimator_mean(const RssiEstimator* e);
+
+/* Population variance of the raw samples, saturated to 255 */
+uint8_t RssiEstimator_variance(const RssiEstimator* e);
+
+#endif /* RSSIESTIMATOR_H */
@@ -35,11 +35,9 @@
  */
 /* Custom includes */
 #include <stdlib.h>
-#include <stdio.h>
+#include <string.h>
 #include <stdint.h>   // for the typedefs (redundant, actually)
 #include <inttypes.h> // for the macros
-#include <time.h>
-#include <math.h>
 
 /* XDCtools Header files */
 #include <xdc/std.h>
@@ -51,6 +49,7 @@
 #include <ti/sysbios/BIOS.h>
 #include <ti/sysbios/knl/Task.h>
 #include <ti/sysbios/knl/Semaphore.h>
+#include <ti/sysbios/knl/Swi.h>
 #include <ti/sysbios/knl/Clock.h>
 
 /* TI-RTOS Header files */
@@ -62,28 +61,82 @@
 /* EasyLink API Header files */
 #include "easylink/EasyLink.h"
 
+#include "RadioClock.h"
+#include "RssiEstimator.h"
+#include "Distance.h"
+#include "Uplink.h"
+#include "LinkStats.h"
+#include "Trace.h"
+#include "ChannelPlan.h"
+#include "Beacon.h"
+
 /***** Defines *****/
 
 /* Undefine to remove address filter and async mode */
 #define RFEASYLINKRX_ASYNC
 #define RFEASYLINKRX_ADDR_FILTER
 #define RFEASYLINKTX_ASYNC
+#define RFEASYLINKTX_CCA // Listen before talk for the uplink, needs RFEASYLINKTX_ASYNC
+#define RFEASYLINKTX_RSSI_STATS // Send min, max and variance of each tag's RSSI in the uplink
+#define RFEASYLINKTX_DISTANCE // Send the distance estimated from each tag's RSSI in the uplink
+#define RFEASYLINKTX_PACKED // Bit-pack the uplink measures, see Uplink.h
+#define RFEASYLINKTX_BEACON_LOSS // Send the beacons received and lost of each measure in the uplink
+#define RFEASYLINKTX_TELEMETRY // Send the radio counters every UPLINK_TELEMETRY_EVERY uplinks
 
 #define RFEASYLINKEX_TASK_STACK_SIZE 1024
 #define RFEASYLINKEX_TASK_PRIORITY   2
 
-#define RFEASYLINKTX_BURST_SIZE         10
-#define RFEASYLINKTXPAYLOAD_LENGTH      30
 
-#define ELECTROMAGNETIC_CTE 2.95
+#define ELECTROMAGNETIC_CTE 2.95 // Path loss exponent, default calibration of Distance
 #define RSSI_1M 55
-#define BUFFER_SIZE 7 // 4 pacotes : RFEASYLINKTXPAYLOAD_LENGTH/(count sending variables) = 29/4 [my_id,timestamp][id,rssi,2xtimestamp] : 7 medidas por pacote sobra 1 byte
-#define QT_PACKETS 1
-#define QT_MEASURES 10
-#define MEM_STACK_SIZE 10
-#define TIME_DELAY 1
+#ifdef RFEASYLINKTX_RSSI_STATS
+#define UPLINK_FLAGS_STATS UPLINK_FLAG_RSSI_STATS
+#else
+#define UPLINK_FLAGS_STATS 0
+#endif
+#ifdef RFEASYLINKTX_DISTANCE
+#define UPLINK_FLAGS_DISTANCE UPLINK_FLAG_DISTANCE
+#else
+#define UPLINK_FLAGS_DISTANCE 0
+#endif
+#ifdef RFEASYLINKTX_BEACON_LOSS
+#define UPLINK_FLAGS_LOSS UPLINK_FLAG_BEACON_LOSS
+#else
+#define UPLINK_FLAGS_LOSS 0
+#endif
+#ifdef RFEASYLINKTX_PACKED
+#define UPLINK_FLAGS (UPLINK_FLAGS_STATS | UPLINK_FLAGS_DISTANCE | UPLINK_FLAGS_LOSS | UPLINK_FLAG_PACKED)
+//Packed measures take about half the bytes, those that don't fit go in the next uplink
+#define BUFFER_SIZE (2 * UPLINK_MAX_MEASURES(UPLINK_FLAGS) < UPLINK_PACKED_MAX_MEASURES ? \
+        2 * UPLINK_MAX_MEASURES(UPLINK_FLAGS) : UPLINK_PACKED_MAX_MEASURES)
+#else
+#define UPLINK_FLAGS (UPLINK_FLAGS_STATS | UPLINK_FLAGS_DISTANCE | UPLINK_FLAGS_LOSS)
+#define BUFFER_SIZE UPLINK_MAX_MEASURES(UPLINK_FLAGS) // Measures that fit in one uplink packet
+#endif
+#define UPLINK_TELEMETRY_EVERY 8 // Uplinks per telemetry, power of two
+#define UPLINK_MAX_AGE_MS 5000 // Uplink is sent once the oldest measure is this old, even if not full
+#define QT_MEASURES 10 // Beacons a measure aggregates at most
+#define TIME_DELAY 1 // Seconds a measure keeps aggregating beacons of its tag
+#define DELTA_TIME_UNIT_MS 1000
+#define MEASURE_TABLE_SIZE 128 // Power of two, at least twice BUFFER_SIZE
+
+#if MEASURE_TABLE_SIZE < 2 * BUFFER_SIZE
+#error MEASURE_TABLE_SIZE must be at least twice BUFFER_SIZE
+#endif
+
+#if (UPLINK_TELEMETRY_EVERY & (UPLINK_TELEMETRY_EVERY - 1)) != 0
+#error UPLINK_TELEMETRY_EVERY must be a power of two
+#endif
+
+#define MEASURE_HASH(id) (((id) * 0x9Du) & (MEASURE_TABLE_SIZE - 1))
 
 #define MY_ID 1
+#define AP_CHANNEL 0 // Beacon channel this AP listens on, see ChannelPlan.h
+#define RETUNE_TRIES 3 // Attempts to change channel around an uplink
+
+#if AP_CHANNEL >= CHANNEL_PLAN_BEACON_CHANNELS
+#error AP_CHANNEL must be one of the beacon channels
+#endif
 
 /***** Variable declarations *****/
 static Task_Params taskParams;
@@ -94,19 +147,51 @@ static uint8_t taskStack[RFEASYLINKEX_TASK_STACK_SIZE];
 struct Measure
 {
         uint8_t id;
-        int8_t rssi[QT_MEASURES];
-        uint8_t counter;
-        int local_time;
+        RssiEstimator rssi;
+        uint8_t lost;        // Beacons of the tag missed up to this measure's last one
+        uint8_t flags;       // Beacon flags seen by this measure, see Beacon.h
+        uint32_t local_time; // RAT ticks
 };
 
 struct Measure memStack[BUFFER_SIZE];
 uint8_t rx_counter = 0;
 
+//Measures handed to Uplink_encode
+static Uplink_Measure uplinkMeasures[BUFFER_SIZE];
+static uint8_t uplinkSeq = 0;
+
+//Beacon sequence number tracking per tag id
+static uint8_t tagLastSeq[256];
+static uint8_t tagSeen[256 / 8];
+LinkStats beaconStats;    /* not static so you can see in ROV */
+
+//Open addressing index of memStack by tag id, holds the memStack position + 1
+//of the newest measure of each tag, 0 for an empty slot
+static uint8_t measureTable[MEASURE_TABLE_SIZE];
+
+//Uplink flush statistics
+typedef struct
+{
+        uint32_t flushes;
+        uint32_t fullFlushes;   // Sent because the packet was full
+        uint32_t ageFlushes;    // Sent because the oldest measure was due
+        uint32_t measures;      // measures / flushes is the mean occupancy
+        uint8_t lastOccupancy;  // Measures in the last packet
+        uint8_t minOccupancy;
+        uint32_t skipped;       // Not sent, the radio could not reach the backhaul
+} UplinkStats;
+
+UplinkStats uplinkStats;    /* not static so you can see in ROV */
+
+EasyLink_Stats radioStats; /* not static so you can see in ROV */
+
 /* The RX Output struct contains statistics about the RX operation of the radio */
 PIN_Handle pinHandle;
 
 #ifdef RFEASYLINKRX_ASYNC
 static Semaphore_Handle rxDoneSemaphore;
+//Continuous Rx is on, cleared by rxDoneCb once it has ended
+static volatile bool rxRunning = false;
 #endif
 
 #ifdef RFEASYLINKTX_ASYNC
@@ -115,67 +200,186 @@ static Semaphore_Handle txDoneSemaphore;
 
 /***** Function definitions *****/
 
-//float getRelativeDistance(uint8_t rssi) {
-//    //RSSI = -10*n*log10(d) + A
-//    return pow(10, ((RSSI_1M - rssi)/(-10*ELECTROMAGNETIC_CTE)));
-//}
+struct Measure* findMeasureByIdTimestamp(uint8_t id, uint32_t local_time) {
+    uint8_t slot = MEASURE_HASH(id);
+
+    while(measureTable[slot] != 0) {
+        struct Measure* m = &memStack[measureTable[slot] - 1];
+        if(m->id == id) {
+            //Only the newest measure of a tag is indexed
+            if(m->rssi.count < QT_MEASURES &&
+                    RadioClock_elapsed(m->local_time, local_time) <=
+                    EasyLink_ms_To_RadioTime(TIME_DELAY * 1000)) {
+                return m;
+            }
+            return NULL;
+        }
+        slot = (slot + 1) & (MEASURE_TABLE_SIZE - 1);
+    }
 
-void addMeasureRssi(struct Measure* m, int8_t rssi) {
-    m->rssi[m->counter++] = rssi;
+    return NULL;
 }
 
-int8_t getAverageRssi(struct Measure* m) {
-    int sum = 0;
+void indexMeasure(uint8_t id, uint8_t position) {
+    uint8_t slot = MEASURE_HASH(id);
 
-    uint8_t i;
-    for(i = 0; i < m->counter; i++) {
-        sum += m->rssi[i];
+    //Table is never full as it has twice as many slots as memStack
+    while(measureTable[slot] != 0 && memStack[measureTable[slot] - 1].id != id) {
+        slot = (slot + 1) & (MEASURE_TABLE_SIZE - 1);
     }
 
-    return sum/(m->counter);
+    measureTable[slot] = position + 1;
 }
 
-int findMeasureByIdTimestamp(uint8_t id, int local_time) {
-    int i;
-    for(i = 0; i < rx_counter; i++) {
-        struct Measure m = memStack[i];
-        if(m.counter < BUFFER_SIZE &&
-                m.id == id &&
-                m.local_time >= local_time - TIME_DELAY) {
-            return i;
-        }
+//Clock ticks to keep collecting before the oldest measure is due, 0 once due
+uint32_t uplinkTimeout(void) {
+    uint32_t maxAge = EasyLink_ms_To_RadioTime(UPLINK_MAX_AGE_MS);
+    uint32_t age;
+
+    if(rx_counter == 0) {
+        return BIOS_WAIT_FOREVER;
+    }
+
+    age = RadioClock_elapsed(memStack[0].local_time, RadioClock_now());
+    if(age >= maxAge) {
+        return 0;
+    }
+
+    age = maxAge - age;
+    return EasyLink_RadioTime_To_ms(age) * 1000 / Clock_tickPeriod + 1;
+}
+
+void updateUplinkStats(uint8_t occupancy, bool full) {
+    uplinkStats.flushes++;
+    if(full) {
+        uplinkStats.fullFlushes++;
+    } else {
+        uplinkStats.ageFlushes++;
+    }
+    uplinkStats.measures += occupancy;
+    uplinkStats.lastOccupancy = occupancy;
+    if(uplinkStats.flushes == 1 || occupancy < uplinkStats.minOccupancy) {
+        uplinkStats.minOccupancy = occupancy;
+    }
+}
+
+//Counts a beacon of a tag, returns the beacons of that tag missed before it
+uint8_t countBeacon(uint8_t id, uint8_t seq) {
+    uint8_t lost = 0;
+
+    if(tagSeen[id >> 3] & (1 << (id & 7))) {
+        lost = LinkStats_next(&beaconStats, tagLastSeq[id], seq);
+    } else {
+        tagSeen[id >> 3] |= 1 << (id & 7);
+        LinkStats_first(&beaconStats);
     }
+    tagLastSeq[id] = seq;
 
-    return BUFFER_SIZE;
+    return lost;
+}
+
+//Packs the measures collected into an uplink (see Uplink.h) and starts
+//collecting the next one with those that did not fit, returns the payload
+//length. rxDoneCb must be held off meanwhile
+uint8_t packUplink(uint8_t* payload) {
+    uint8_t len;
+    uint8_t sent;
+    uint8_t data_counter;
+    uint32_t now = RadioClock_now();
+    Uplink_Telemetry* telemetry = NULL;
+#ifdef RFEASYLINKTX_TELEMETRY
+    Uplink_Telemetry uplinkTelemetry;
+
+    if((uplinkSeq & (UPLINK_TELEMETRY_EVERY - 1)) == 0) {
+        EasyLink_getStats(&radioStats);
+        uplinkTelemetry.rxOk = (uint16_t)radioStats.rxOk;
+        uplinkTelemetry.rxNok = (uint16_t)radioStats.rxNok;
+        uplinkTelemetry.rxTimeouts = (uint16_t)radioStats.rxTimeouts;
+        uplinkTelemetry.txOk = (uint16_t)radioStats.txOk;
+        uplinkTelemetry.txAborts = (uint16_t)radioStats.txAborts;
+        uplinkTelemetry.txErrors = (uint16_t)radioStats.txErrors;
+        uplinkTelemetry.busyErrors = (uint16_t)radioStats.busyErrors;
+        uplinkTelemetry.ccaRetries = (uint16_t)radioStats.cca.retries;
+        telemetry = &uplinkTelemetry;
+    }
+#endif
+
+    for(data_counter = 0; data_counter < rx_counter; data_counter++) {
+        struct Measure* m = &memStack[data_counter];
+        Uplink_Measure* u = &uplinkMeasures[data_counter];
+
+        u->id = m->id;
+        u->rssi = RssiEstimator_mean(&m->rssi);
+        u->delta = RadioClock_delta(m->local_time, now, DELTA_TIME_UNIT_MS);
+#ifdef RFEASYLINKTX_RSSI_STATS
+        u->rssiMin = m->rssi.min;
+        u->rssiMax = m->rssi.max;
+        u->rssiVariance = RssiEstimator_variance(&m->rssi);
+#endif
+#ifdef RFEASYLINKTX_DISTANCE
+        u->distance = Distance_fromRssi(u->rssi);
+#endif
+#ifdef RFEASYLINKTX_BEACON_LOSS
+        u->beacons = m->rssi.count;
+        u->beaconsLost = m->lost;
+#endif
+    }
+
+    len = Uplink_encode(payload, MY_ID, UPLINK_FLAGS, uplinkSeq++, telemetry,
+            uplinkMeasures, rx_counter, &sent);
+    updateUplinkStats(sent, rx_counter == BUFFER_SIZE);
+
+    //The oldest measures were sent, the rest move to the front
+    memmove(&memStack[0], &memStack[sent], (rx_counter - sent) * sizeof(struct Measure));
+    rx_counter -= sent;
+    memset(measureTable, 0, sizeof(measureTable));
+    for(data_counter = 0; data_counter < rx_counter; data_counter++) {
+        indexMeasure(memStack[data_counter].id, data_counter);
+    }
+
+    return len;
 }
 
 #ifdef RFEASYLINKRX_ASYNC
-void rxDoneCb(EasyLink_RxPacket * rxPacket, EasyLink_Status status)
+void rxDoneCb(EasyLink_RxView * rxView, EasyLink_Status status)
 {
     if (status == EasyLink_Status_Success)
     {
-        if(((int*)rxPacket->dstAddr)[0] == 0xAA) {
-
-            uint8_t id = rxPacket->payload[0];
-            int8_t rssi = (-1)*rxPacket->rssi;
-
-            time_t t = time(NULL);
-            struct tm tm = *localtime(&t);
-            int local_time = ( ( ( ( (tm.tm_year - 70)*12 + tm.tm_mon )*30 + (tm.tm_mday - 1) )*24 + tm.tm_hour )*60 + tm.tm_min )*60 + tm.tm_sec;
-
-            int measureId = findMeasureByIdTimestamp(id, local_time);
-            if(measureId < BUFFER_SIZE) {
-                addMeasureRssi(&(memStack[measureId]), rssi);
-            } else {
-                struct Measure m;
-                m.id = id;
-                m.counter = 0;
-                addMeasureRssi(&m, rssi);
-                m.local_time = local_time;
-                memStack[rx_counter++] = m;
+        TRACE(TRACE_APP_RX, rxView->absTime);
+
+        Beacon beacon;
+
+        if(rxView->dstAddr[0] == 0xAA &&
+                Beacon_decode(&beacon, rxView->payload, rxView->len) == 0) {
+
+            uint8_t id = beacon.id;
+            uint8_t lost = countBeacon(id, beacon.seq);
+            int8_t rssi = (-1)*rxView->rssi;
+
+            //RAT time the packet was received at
+            uint32_t local_time = rxView->absTime;
+
+            struct Measure* m = findMeasureByIdTimestamp(id, local_time);
+            if(m != NULL) {
+                RssiEstimator_add(&m->rssi, rssi);
+                m->lost = (m->lost + lost > 0xFF) ? 0xFF : m->lost + lost;
+                m->flags |= beacon.flags;
+            } else if(rx_counter < BUFFER_SIZE) {
+                m = &memStack[rx_counter];
+                m->id = id;
+                m->lost = lost;
+                m->flags = beacon.flags;
+                RssiEstimator_init(&m->rssi);
+                RssiEstimator_add(&m->rssi, rssi);
+                m->local_time = local_time;
+                indexMeasure(id, rx_counter++);
             }
         }
 
+        //The packet was read straight from its Rx entry, hand it back
+        TRACE(TRACE_APP_RX_DONE, rxView->len);
+        EasyLink_releaseRxView(rxView);
+
         /* Toggle LED2 to indicate RX */
         //PIN_setOutputValue(pinHandle, Board_PIN_LED2,!PIN_getOutputValue(Board_PIN_LED2));
     }
@@ -191,6 +395,11 @@ void rxDoneCb(EasyLink_RxPacket * rxPacket, EasyLink_Status status)
         //PIN_setOutputValue(pinHandle, Board_PIN_LED2,!PIN_getOutputValue(Board_PIN_LED2));
     }
 
+    if (status != EasyLink_Status_Success)
+    {
+        rxRunning = false;
+    }
+
     Semaphore_post(rxDoneSemaphore);
 }
 #endif
@@ -271,11 +480,11 @@ void setUpEasyLink() {
         System_abort("EasyLink_init failed");
     }
 
-    /*
-     * If you wish to use a frequency other than the default, use
-     * the following API:
-     * EasyLink_setFrequency(868000000);
-     */
+    /* Listen on the AP's beacon channel of the channel plan */
+    if(EasyLink_setFrequency(ChannelPlan_frequency(AP_CHANNEL)) != EasyLink_Status_Success)
+    {
+        System_abort("EasyLink_setFrequency failed");
+    }
 
     /* Set output power to 12dBm */
     EasyLink_Status pwrStatus = EasyLink_setRfPower(12);
@@ -296,7 +505,96 @@ void setUpEasyLink() {
     uint8_t addrFilter[EASYLINK_MAX_ADDR_SIZE * EASYLINK_MAX_ADDR_FILTERS] = {0xaa};
     EasyLink_enableRxAddrFilter(addrFilter, 1, 1);
 #endif //RFEASYLINKRX_ADDR_FILTER
+
+#ifdef RFEASYLINKTX_CCA
+    /* Seed the CCA back-off (rand) per device so APs don't back off in step */
+    uint8_t ieeeAddr[8];
+    uint32_t seed = 0;
+    uint8_t i;
+
+    if(EasyLink_getIeeeAddr(ieeeAddr) == EasyLink_Status_Success) {
+        for(i = 0; i < 8; i++) {
+            seed = seed * 31 + ieeeAddr[i];
+        }
+    }
+    srand(seed + MY_ID);
+#endif //RFEASYLINKTX_CCA
+}
+
+/* Sends an uplink packet on the current channel */
+static void transmitUplink(EasyLink_TxPacket* txPacket)
+{
+    #ifdef RFEASYLINKTX_ASYNC
+    #ifdef RFEASYLINKTX_CCA
+    /*
+     * Sent as soon as the channel is clear, the tags and the other APs
+     * share it. EasyLink pauses Rx until the packet is sent
+     */
+    EasyLink_transmitCcaAsync(txPacket, txDoneCb);
+    #else
+    /* Sent right away, EasyLink pauses Rx only while the packet is on air */
+    EasyLink_transmitAsync(txPacket, txDoneCb);
+    #endif //RFEASYLINKTX_CCA
+    /* Wait 300ms for Tx to complete */
+    if(Semaphore_pend(txDoneSemaphore, (300000 / Clock_tickPeriod)) == FALSE)
+    {
+        /* TX timed out, abort */
+        if(EasyLink_abort() == EasyLink_Status_Success)
+        {
+            /*
+             * Abort will cause the txDoneCb to be called and the doneSemaphore
+             * to be released, so we must consume the doneSemaphore
+             */
+           Semaphore_pend(txDoneSemaphore, BIOS_WAIT_FOREVER);
+        }
+    }
+    EasyLink_getStats(&radioStats);
+    #else
+    #ifdef RFEASYLINKRX_ASYNC
+    /* Blocking Tx does not pause continuous Rx, stop it */
+    EasyLink_abort();
+    #endif //RX_ASYNC
+    EasyLink_Status result = EasyLink_transmit(txPacket);
+
+    if (result == EasyLink_Status_Success)
+    {
+        /* Toggle LED1 to indicate TX */
+        PIN_setOutputValue(pinHandle, Board_PIN_LED1,!PIN_getOutputValue(Board_PIN_LED1));
+    }
+    else
+    {
+        /* Toggle LED1 and LED2 to indicate error */
+        PIN_setOutputValue(pinHandle, Board_PIN_LED1,!PIN_getOutputValue(Board_PIN_LED1));
+        PIN_setOutputValue(pinHandle, Board_PIN_LED2,!PIN_getOutputValue(Board_PIN_LED2));
+    }
+    #endif //RFEASYLINKTX_ASYNC
+}
+
+#if AP_CHANNEL != CHANNEL_PLAN_BACKHAUL
+/*
+ * Stops Rx and moves the radio to a channel of the channel plan, returns false
+ * if it is still not there after RETUNE_TRIES attempts
+ */
+static bool retune(uint8_t channel)
+{
+    EasyLink_Status status;
+    uint8_t tries;
+
+    for(tries = 0; tries < RETUNE_TRIES; tries++) {
+        //Aborted only means there was nothing to abort
+        status = EasyLink_abort();
+        if((status == EasyLink_Status_Success || status == EasyLink_Status_Aborted) &&
+                EasyLink_setFrequency(ChannelPlan_frequency(channel)) == EasyLink_Status_Success) {
+            return true;
+        }
+
+        /* Let the callback of the aborted command run */
+        Task_sleep(1000 / Clock_tickPeriod);
+    }
+
+    return false;
 }
+#endif
 
 static void taskManagerFnx(UArg a0, UArg a1)
 {
@@ -304,27 +602,34 @@ static void taskManagerFnx(UArg a0, UArg a1)
     setUpRxSemaphore();
     setUpEasyLink();
 
+#ifdef RFEASYLINKTX_DISTANCE
+    /* Default calibration, Distance_calibrate can be called again to adjust it */
+    Distance_calibrate(RSSI_1M, (uint16_t)(ELECTROMAGNETIC_CTE * 256));
+#endif
+
     while(1) {
         //Start RX Task
     #ifndef RFEASYLINKRX_ASYNC
         EasyLink_RxPacket rxPacket = {0};
     #endif
 
-        rx_counter = 0;
-        while(rx_counter < BUFFER_SIZE) {
+        uint32_t timeout;
+        while(rx_counter < BUFFER_SIZE && (timeout = uplinkTimeout()) != 0) {
     #ifdef RFEASYLINKRX_ASYNC
-            EasyLink_receiveAsync(rxDoneCb, 0);
-
-            /* Wait 300ms for Rx */
-            if(Semaphore_pend(rxDoneSemaphore, (300000 / Clock_tickPeriod)) == FALSE)
-            {
-                /* RX timed out abort */
-                if(EasyLink_abort() == EasyLink_Status_Success)
+            /*
+             * Rx stays on across packets so beacons sent back to back are
+             * queued by EasyLink, it is only restarted if it has ended
+             */
+            if(!rxRunning) {
+                rxRunning = true;
+                if(EasyLink_receiveContinuousViewAsync(rxDoneCb, 0) != EasyLink_Status_Success)
                 {
-                   /* Wait for the abort */
-                   Semaphore_pend(rxDoneSemaphore, BIOS_WAIT_FOREVER);
+                    System_abort("EasyLink_receiveContinuousViewAsync failed");
                 }
             }
+
+            /* Wait for a packet, or for the oldest measure to be due */
+            Semaphore_pend(rxDoneSemaphore, timeout);
     #else
             rxPacket.absTime = 0;
             EasyLink_Status result = EasyLink_receive(&rxPacket);
@@ -344,88 +649,34 @@ static void taskManagerFnx(UArg a0, UArg a1)
         }
 
         //Entering TX
-        uint8_t txBurstSize = 0;
-        uint32_t absTime;
-
-        //Starting to send packets
-        uint8_t tx_counter;
-       for(tx_counter = 0; tx_counter < QT_PACKETS; tx_counter++) {
-            EasyLink_TxPacket txPacket =  { {0}, 0, 0, {0} };
-
-            /* Create packet with buffer on payload */
-            txPacket.payload[0] = (uint8_t)(MY_ID);
-
-            uint8_t i = 1;
-            uint8_t data_counter = 0;
-            while(i < RFEASYLINKTXPAYLOAD_LENGTH - 3) {
-                struct Measure m = memStack[data_counter++];
-
-                time_t t = time(NULL);
-                struct tm tm = *localtime(&t);
-                uint16_t deltaTime = (uint16_t)((( ( ( ( (tm.tm_year - 70)*12 + tm.tm_mon )*30 +
-                        (tm.tm_mday - 1) )*24 + tm.tm_hour )*60 + tm.tm_min )*60 + tm.tm_sec)
-                        - m.local_time);
-                uint8_t deltaTimeFirstByte = (uint8_t)(deltaTime/256);
-                uint8_t deltaTimeSecondByte = (uint8_t)(deltaTime - deltaTimeFirstByte*256);
-
-                txPacket.payload[i++] = m.id;
-                txPacket.payload[i++] = getAverageRssi(&m);
-                txPacket.payload[i++] = deltaTimeFirstByte;
-                txPacket.payload[i++] = deltaTimeSecondByte;
-            }
-
-            txPacket.len = RFEASYLINKTXPAYLOAD_LENGTH;
-            txPacket.dstAddr[0] = 0xbb;
-
-            /* Add a Tx delay for > 500ms, so that the abort kicks in and brakes the burst */
-            if(EasyLink_getAbsTime(&absTime) != EasyLink_Status_Success)
-            {
-                // Problem getting absolute time
-            }
-            if(txBurstSize++ >= RFEASYLINKTX_BURST_SIZE)
-            {
-              /* Set Tx absolute time to current time + 1s */
-              txPacket.absTime = absTime + EasyLink_ms_To_RadioTime(1000);
-              txBurstSize = 0;
-            }
-            /* Else set the next packet in burst to Tx in 100ms */
-            else
-            {
-              /* Set Tx absolute time to current time + 100ms */
-              txPacket.absTime = absTime + EasyLink_ms_To_RadioTime(100);
-            }
-
-    #ifdef RFEASYLINKTX_ASYNC
-            EasyLink_transmitAsync(&txPacket, txDoneCb);
-            /* Wait 300ms for Tx to complete */
-            if(Semaphore_pend(txDoneSemaphore, (300000 / Clock_tickPeriod)) == FALSE)
-            {
-                /* TX timed out, abort */
-                if(EasyLink_abort() == EasyLink_Status_Success)
-                {
-                    /*
-                     * Abort will cause the txDoneCb to be called and the doneSemaphore
-                     * to be released, so we must consume the doneSemaphore
-                     */
-                   Semaphore_pend(txDoneSemaphore, BIOS_WAIT_FOREVER);
-                }
-            }
-    #else
-            EasyLink_Status result = EasyLink_transmit(&txPacket);
-
-            if (result == EasyLink_Status_Success)
-            {
-                /* Toggle LED1 to indicate TX */
-                PIN_setOutputValue(pinHandle, Board_PIN_LED1,!PIN_getOutputValue(Board_PIN_LED1));
-            }
-            else
-            {
-                /* Toggle LED1 and LED2 to indicate error */
-                PIN_setOutputValue(pinHandle, Board_PIN_LED1,!PIN_getOutputValue(Board_PIN_LED1));
-                PIN_setOutputValue(pinHandle, Board_PIN_LED2,!PIN_getOutputValue(Board_PIN_LED2));
-            }
-    #endif //RFEASYLINKTX_ASYNC
+        EasyLink_TxPacket txPacket =  { {0}, 0, 0, {0} };
+
+        /* Rx keeps running, only rxDoneCb is held off while the measures are taken */
+        UInt key = Swi_disable();
+        txPacket.len = packUplink(txPacket.payload);
+        Swi_restore(key);
+
+        txPacket.dstAddr[0] = 0xbb;
+        TRACE(TRACE_APP_TX, txPacket.len);
+
+    #if AP_CHANNEL != CHANNEL_PLAN_BACKHAUL
+        /*
+         * Rx can't follow the radio to the backhaul channel, it is stopped.
+         * rxDoneCb sees the abort and Rx restarts once back on the beacon
+         * channel, which is done even if the uplink could not be sent
+         */
+        if(retune(CHANNEL_PLAN_BACKHAUL)) {
+            transmitUplink(&txPacket);
+        } else {
+            uplinkStats.skipped++;
+        }
+        if(!retune(AP_CHANNEL))
+        {
+            System_abort("EasyLink_setFrequency failed");
         }
+    #else
+        transmitUplink(&txPacket);
+    #endif
     }
 }
 
@@ -0,0 +1,438 @@
+/*
+ *  ======== Uplink.c ========
+ */
+#include <stddef.h>
+
+#include "Uplink.h"
+
+/***** Defines *****/
+
+#define PACKED_ID_BITS          8
+#define PACKED_RSSI_BITS        7
+#define PACKED_DISTANCE_BITS    16
+#define PACKED_CAPACITY_BITS(flags) ((EASYLINK_MAX_DATA_LENGTH - UPLINK_PREFIX_SIZE(flags)) * 8)
+#define PACKED_NONE             0xFF
+
+/***** Function definitions *****/
+
+static void putUint16(uint8_t* p, uint16_t value) {
+    p[0] = (uint8_t)(value >> 8);
+    p[1] = (uint8_t)(value & 0xFF);
+}
+
+static uint16_t getUint16(const uint8_t* p) {
+    return ((uint16_t)p[0] << 8) | p[1];
+}
+
+//Length of the order 0 exp-Golomb code of value
+static uint8_t expGolombBits(uint32_t value) {
+    uint8_t n = 0;
+
+    value++;
+    while(value >> (n + 1)) {
+        n++;
+    }
+
+    return 2 * n + 1;
+}
+
+static void writeBits(uint8_t* buf, uint16_t* pos, uint32_t value, uint8_t bits) {
+    while(bits > 0) {
+        bits--;
+        if((value >> bits) & 1) {
+            buf[*pos >> 3] |= 0x80 >> (*pos & 7);
+        } else {
+            buf[*pos >> 3] &= ~(0x80 >> (*pos & 7));
+        }
+        (*pos)++;
+    }
+}
+
+static void writeExpGolomb(uint8_t* buf, uint16_t* pos, uint32_t value) {
+    uint8_t bits = expGolombBits(value);
+
+    //n zeros, then value + 1 in n + 1 bits
+    writeBits(buf, pos, 0, bits / 2);
+    writeBits(buf, pos, value + 1, bits / 2 + 1);
+}
+
+//Returns -1 if the read would go past the end of the payload
+static int readBits(Uplink_Decoder* d, uint8_t bits, uint32_t* value) {
+    if(d->pos + bits > (uint16_t)d->len * 8) {
+        return -1;
+    }
+
+    *value = 0;
+    while(bits > 0) {
+        bits--;
+        *value = (*value << 1) | ((d->payload[d->pos >> 3] >> (7 - (d->pos & 7))) & 1);
+        d->pos++;
+    }
+
+    return 0;
+}
+
+static int readExpGolomb(Uplink_Decoder* d, uint32_t* value) {
+    uint8_t zeros = 0;
+    uint32_t bit;
+
+    //Leading zeros, no field is wider than 16 bits
+    for(;;) {
+        if(readBits(d, 1, &bit) != 0) {
+            return -1;
+        }
+        if(bit) {
+            break;
+        }
+        if(++zeros > 16) {
+            return -1;
+        }
+    }
+
+    if(readBits(d, zeros, value) != 0) {
+        return -1;
+    }
+
+    *value = ((1ul << zeros) | *value) - 1;
+    return 0;
+}
+
+static uint8_t clampRssi(uint8_t rssi) {
+    return (rssi > 0x7F) ? 0x7F : rssi;
+}
+
+//Stats are sent relative to rssi, RssiEstimator keeps min <= mean <= max
+static uint8_t belowRssi(const Uplink_Measure* m) {
+    uint8_t rssi = clampRssi(m->rssi);
+    return (m->rssiMin < rssi) ? rssi - m->rssiMin : 0;
+}
+
+static uint8_t aboveRssi(const Uplink_Measure* m) {
+    uint8_t rssi = clampRssi(m->rssi);
+    return (m->rssiMax > rssi) ? m->rssiMax - rssi : 0;
+}
+
+static uint16_t packedBits(const Uplink_Measure* m, uint8_t flags, const Uplink_Measure* prev) {
+    uint16_t bits = PACKED_RSSI_BITS + expGolombBits(m->delta);
+
+    bits += (prev == NULL) ? PACKED_ID_BITS : expGolombBits(m->id - prev->id);
+    if(flags & UPLINK_FLAG_RSSI_STATS) {
+        bits += expGolombBits(belowRssi(m)) + expGolombBits(aboveRssi(m)) +
+                expGolombBits(m->rssiVariance);
+    }
+    if(flags & UPLINK_FLAG_DISTANCE) {
+        bits += PACKED_DISTANCE_BITS;
+    }
+    if(flags & UPLINK_FLAG_BEACON_LOSS) {
+        bits += expGolombBits(m->beacons) + expGolombBits(m->beaconsLost);
+    }
+
+    return bits;
+}
+
+static void writePacked(uint8_t* buf, uint16_t* pos, const Uplink_Measure* m,
+        uint8_t flags, const Uplink_Measure* prev) {
+    if(prev == NULL) {
+        writeBits(buf, pos, m->id, PACKED_ID_BITS);
+    } else {
+        writeExpGolomb(buf, pos, m->id - prev->id);
+    }
+    writeBits(buf, pos, clampRssi(m->rssi), PACKED_RSSI_BITS);
+    writeExpGolomb(buf, pos, m->delta);
+    if(flags & UPLINK_FLAG_RSSI_STATS) {
+        writeExpGolomb(buf, pos, belowRssi(m));
+        writeExpGolomb(buf, pos, aboveRssi(m));
+        writeExpGolomb(buf, pos, m->rssiVariance);
+    }
+    if(flags & UPLINK_FLAG_DISTANCE) {
+        writeBits(buf, pos, m->distance, PACKED_DISTANCE_BITS);
+    }
+    if(flags & UPLINK_FLAG_BEACON_LOSS) {
+        writeExpGolomb(buf, pos, m->beacons);
+        writeExpGolomb(buf, pos, m->beaconsLost);
+    }
+}
+
+static uint8_t encodePacked(uint8_t* payload, uint8_t flags,
+        const Uplink_Measure* measures, uint8_t count, uint8_t* encoded) {
+    uint8_t order[UPLINK_PACKED_MAX_MEASURES];
+    uint8_t rank[UPLINK_PACKED_MAX_MEASURES];       //Position in order of each measure
+    uint8_t before[UPLINK_PACKED_MAX_MEASURES];     //Previous position still sent
+    uint8_t after[UPLINK_PACKED_MAX_MEASURES];      //Next position still sent
+    const Uplink_Measure* prev;
+    uint16_t bits = 0;
+    uint16_t pos;
+    uint8_t sent;
+    uint8_t i;
+    uint8_t a;
+    uint8_t b;
+
+    if(count > UPLINK_PACKED_MAX_MEASURES) {
+        count = UPLINK_PACKED_MAX_MEASURES;
+    }
+
+    //Stable insertion sort by id, ids are sent as increases
+    for(i = 0; i < count; i++) {
+        uint8_t j = i;
+        while(j > 0 && measures[order[j - 1]].id > measures[i].id) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+
+    //Size of all measures, each one costs its bits given the one before
+    prev = NULL;
+    for(i = 0; i < count; i++) {
+        rank[order[i]] = i;
+        before[i] = (i > 0) ? i - 1 : PACKED_NONE;
+        after[i] = (i + 1 < count) ? i + 1 : PACKED_NONE;
+        bits += packedBits(&measures[order[i]], flags, prev);
+        prev = &measures[order[i]];
+    }
+
+    //Drops the newest measures until the rest fits, a dropped measure only
+    //changes the id increase of the one after it
+    sent = count;
+    while(sent > 0 && bits > PACKED_CAPACITY_BITS(flags)) {
+        sent--;
+        i = rank[sent];
+        a = before[i];
+        b = after[i];
+
+        bits -= packedBits(&measures[order[i]], flags,
+                (a != PACKED_NONE) ? &measures[order[a]] : NULL);
+        if(b != PACKED_NONE) {
+            bits -= packedBits(&measures[order[b]], flags, &measures[order[i]]);
+            bits += packedBits(&measures[order[b]], flags,
+                    (a != PACKED_NONE) ? &measures[order[a]] : NULL);
+            before[b] = a;
+        }
+        if(a != PACKED_NONE) {
+            after[a] = b;
+        }
+    }
+
+    payload[3] = sent;
+    pos = UPLINK_PREFIX_SIZE(flags) * 8;
+    prev = NULL;
+    for(i = 0; i < count; i++) {
+        if(order[i] < sent) {
+            writePacked(payload, &pos, &measures[order[i]], flags, prev);
+            prev = &measures[order[i]];
+        }
+    }
+    writeBits(payload, &pos, 0, (8 - (pos & 7)) & 7);
+
+    *encoded = sent;
+    return UPLINK_PREFIX_SIZE(flags) + (bits + 7) / 8;
+}
+
+static void putTelemetry(uint8_t* p, const Uplink_Telemetry* t) {
+    putUint16(&p[0], t->rxOk);
+    putUint16(&p[2], t->rxNok);
+    putUint16(&p[4], t->rxTimeouts);
+    putUint16(&p[6], t->txOk);
+    putUint16(&p[8], t->txAborts);
+    putUint16(&p[10], t->txErrors);
+    putUint16(&p[12], t->busyErrors);
+    putUint16(&p[14], t->ccaRetries);
+}
+
+static void getTelemetry(const uint8_t* p, Uplink_Telemetry* t) {
+    t->rxOk = getUint16(&p[0]);
+    t->rxNok = getUint16(&p[2]);
+    t->rxTimeouts = getUint16(&p[4]);
+    t->txOk = getUint16(&p[6]);
+    t->txAborts = getUint16(&p[8]);
+    t->txErrors = getUint16(&p[10]);
+    t->busyErrors = getUint16(&p[12]);
+    t->ccaRetries = getUint16(&p[14]);
+}
+
+uint8_t Uplink_encode(uint8_t* payload, uint8_t apId, uint8_t flags, uint8_t seq,
+        const Uplink_Telemetry* telemetry, const Uplink_Measure* measures,
+        uint8_t count, uint8_t* encoded) {
+    uint8_t i;
+    uint8_t sent;
+
+    flags &= ~UPLINK_FLAG_TELEMETRY;
+    if(telemetry != NULL) {
+        flags |= UPLINK_FLAG_TELEMETRY;
+    }
+
+    payload[0] = apId;
+    payload[1] = flags;
+    payload[2] = seq;
+
+    i = UPLINK_PREFIX_SIZE(flags);
+    if(telemetry != NULL) {
+        putTelemetry(&payload[i - UPLINK_TELEMETRY_SIZE], telemetry);
+    }
+
+    if(flags & UPLINK_FLAG_PACKED) {
+        return encodePacked(payload, flags, measures, count, encoded);
+    }
+
+    if(count > UPLINK_MAX_MEASURES(flags)) {
+        count = UPLINK_MAX_MEASURES(flags);
+    }
+
+    for(sent = 0; sent < count; sent++) {
+        const Uplink_Measure* m = &measures[sent];
+
+        payload[i++] = m->id;
+        payload[i++] = m->rssi;
+        putUint16(&payload[i], m->delta);
+        i += 2;
+        if(flags & UPLINK_FLAG_RSSI_STATS) {
+            payload[i++] = m->rssiMin;
+            payload[i++] = m->rssiMax;
+            payload[i++] = m->rssiVariance;
+        }
+        if(flags & UPLINK_FLAG_DISTANCE) {
+            putUint16(&payload[i], m->distance);
+            i += 2;
+        }
+        if(flags & UPLINK_FLAG_BEACON_LOSS) {
+            payload[i++] = m->beacons;
+            payload[i++] = m->beaconsLost;
+        }
+    }
+
+    *encoded = sent;
+    return i;
+}
+
+int Uplink_decoderInit(Uplink_Decoder* decoder, const uint8_t* payload, uint8_t len) {
+    if(len < UPLINK_HEADER_SIZE) {
+        return -1;
+    }
+
+    decoder->payload = payload;
+    decoder->len = len;
+    decoder->apId = payload[0];
+    decoder->flags = payload[1];
+    decoder->seq = payload[2];
+    decoder->remaining = 0;
+    decoder->prevId = 0;
+
+    if(len < UPLINK_PREFIX_SIZE(decoder->flags)) {
+        return -1;
+    }
+
+    decoder->pos = UPLINK_PREFIX_SIZE(decoder->flags);
+    if(decoder->flags & UPLINK_FLAG_TELEMETRY) {
+        getTelemetry(&payload[decoder->pos - UPLINK_TELEMETRY_SIZE], &decoder->telemetry);
+    }
+
+    if(decoder->flags & UPLINK_FLAG_PACKED) {
+        decoder->remaining = payload[3];
+        decoder->pos *= 8;
+    }
+
+    return 0;
+}
+
+static int decodePacked(Uplink_Decoder* d, Uplink_Measure* m) {
+    uint32_t value;
+    uint8_t first = (d->pos == UPLINK_PREFIX_SIZE(d->flags) * 8);
+
+    if(d->remaining == 0) {
+        return 0;
+    }
+
+    if(first) {
+        if(readBits(d, PACKED_ID_BITS, &value) != 0) {
+            return 0;
+        }
+        m->id = (uint8_t)value;
+    } else {
+        if(readExpGolomb(d, &value) != 0) {
+            return 0;
+        }
+        m->id = (uint8_t)(d->prevId + value);
+    }
+
+    if(readBits(d, PACKED_RSSI_BITS, &value) != 0) {
+        return 0;
+    }
+    m->rssi = (uint8_t)value;
+
+    if(readExpGolomb(d, &value) != 0) {
+        return 0;
+    }
+    m->delta = (value > 0xFFFF) ? 0xFFFF : (uint16_t)value;
+
+    if(d->flags & UPLINK_FLAG_RSSI_STATS) {
+        if(readExpGolomb(d, &value) != 0) {
+            return 0;
+        }
+        m->rssiMin = (uint8_t)(m->rssi - value);
+        if(readExpGolomb(d, &value) != 0) {
+            return 0;
+        }
+        m->rssiMax = (uint8_t)(m->rssi + value);
+        if(readExpGolomb(d, &value) != 0) {
+            return 0;
+        }
+        m->rssiVariance = (uint8_t)value;
+    }
+
+    if(d->flags & UPLINK_FLAG_DISTANCE) {
+        if(readBits(d, PACKED_DISTANCE_BITS, &value) != 0) {
+            return 0;
+        }
+        m->distance = (uint16_t)value;
+    }
+
+    if(d->flags & UPLINK_FLAG_BEACON_LOSS) {
+        if(readExpGolomb(d, &value) != 0) {
+            return 0;
+        }
+        m->beacons = (uint8_t)value;
+        if(readExpGolomb(d, &value) != 0) {
+            return 0;
+        }
+        m->beaconsLost = (uint8_t)value;
+    }
+
+    d->prevId = m->id;
+    d->remaining--;
+    return 1;
+}
+
+int Uplink_decodeNext(Uplink_Decoder* decoder, Uplink_Measure* measure) {
+    const uint8_t* p;
+
+    if(decoder->flags & UPLINK_FLAG_PACKED) {
+        return decodePacked(decoder, measure);
+    }
+
+    if(decoder->pos + UPLINK_RECORD_SIZE(decoder->flags) > decoder->len) {
+        return 0;
+    }
+
+    p = &decoder->payload[decoder->pos];
+    measure->id = p[0];
+    measure->rssi = p[1];
+    measure->delta = getUint16(&p[2]);
+    p += UPLINK_MEASURE_SIZE;
+    if(decoder->flags & UPLINK_FLAG_RSSI_STATS) {
+        measure->rssiMin = p[0];
+        measure->rssiMax = p[1];
+        measure->rssiVariance = p[2];
+        p += UPLINK_RSSI_STATS_SIZE;
+    }
+    if(decoder->flags & UPLINK_FLAG_DISTANCE) {
+        measure->distance = getUint16(p);
+        p += UPLINK_DISTANCE_SIZE;
+    }
+    if(decoder->flags & UPLINK_FLAG_BEACON_LOSS) {
+        measure->beacons = p[0];
+        measure->beaconsLost = p[1];
+    }
+
+    decoder->pos += UPLINK_RECORD_SIZE(decoder->flags);
+    return 1;
+}
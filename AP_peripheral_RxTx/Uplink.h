@@ -0,0 +1,139 @@
+#ifndef UPLINK_H
+#define UPLINK_H
+
+#include <stdint.h>
+
+/* EasyLink API Header files */
+#include "easylink/EasyLink.h"
+
+/*
+ * Uplink packet an AP sends to the central (dst 0xbb). Uplink.h and Uplink.c
+ * are kept identical in AP_peripheral_RxTx and AP_central_RxUart.
+ *
+ *   [AP id][flags][seq] then the telemetry if UPLINK_FLAG_TELEMETRY,
+ *   then one record per measure:
+ *   [tag id][rssi][delta time MSB][delta time LSB]
+ *   followed by [rssi min][rssi max][rssi variance] if UPLINK_FLAG_RSSI_STATS
+ *   followed by [distance MSB][distance LSB] if UPLINK_FLAG_DISTANCE
+ *   followed by [beacons][beacons lost] if UPLINK_FLAG_BEACON_LOSS
+ *
+ * seq counts the uplinks of the AP (see LinkStats.h). Beacons are those the
+ * measure aggregates, beacons lost are the gaps in the tag's beacon sequence
+ * numbers up to the last one, both saturated to 255.
+ *
+ * RSSI values are -dBm (so rssi min is the strongest beacon), the variance is
+ * in dB^2 saturated to 255. Delta time is the age of the measure when the
+ * uplink was packed, in units of the AP's DELTA_TIME_UNIT_MS. Distance is the
+ * AP's estimate from the mean RSSI in cm.
+ *
+ * The telemetry is the AP's radio counters (see EasyLink_getStats) as 16 bit
+ * big endian values that wrap, sent every few uplinks rather than in all:
+ *
+ *   [rx ok][rx CRC errors][rx timeouts][tx ok][tx aborts][tx errors]
+ *   [busy errors][CCA retries]
+ *
+ * With UPLINK_FLAG_PACKED the header has a fourth byte, the measure count,
+ * the telemetry follows it and the records are a bit stream (MSB first)
+ * sorted by tag id:
+ *
+ *   first tag id in 8 bits, then the id increase from the previous record
+ *   rssi in 7 bits
+ *   delta time
+ *   rssi - rssi min, rssi max - rssi, rssi variance if UPLINK_FLAG_RSSI_STATS
+ *   distance in 16 bits if UPLINK_FLAG_DISTANCE
+ *   beacons, beacons lost if UPLINK_FLAG_BEACON_LOSS
+ *
+ * Fields without a width are order 0 exp-Golomb codes, 1 bit for 0, 3 bits for
+ * 1..2, 5 bits for 3..6 and so on, so the small values of a busy AP take a
+ * few bits instead of a byte. Uplink.c has no TI-RTOS dependencies so it can
+ * be built as is into host side tools.
+ */
+
+#define UPLINK_HEADER_SIZE          3
+#define UPLINK_PACKED_HEADER_SIZE   4
+#define UPLINK_MEASURE_SIZE         4
+#define UPLINK_RSSI_STATS_SIZE      3
+#define UPLINK_DISTANCE_SIZE        2
+#define UPLINK_BEACON_LOSS_SIZE     2
+#define UPLINK_TELEMETRY_SIZE       16
+
+/* Flags */
+#define UPLINK_FLAG_RSSI_STATS      0x01
+#define UPLINK_FLAG_DISTANCE        0x02
+#define UPLINK_FLAG_PACKED          0x04
+#define UPLINK_FLAG_BEACON_LOSS     0x08
+#define UPLINK_FLAG_TELEMETRY       0x10
+
+/* Bytes per measure record for the given flags */
+#define UPLINK_RECORD_SIZE(flags) (UPLINK_MEASURE_SIZE + \
+        (((flags) & UPLINK_FLAG_RSSI_STATS) ? UPLINK_RSSI_STATS_SIZE : 0) + \
+        (((flags) & UPLINK_FLAG_DISTANCE) ? UPLINK_DISTANCE_SIZE : 0) + \
+        (((flags) & UPLINK_FLAG_BEACON_LOSS) ? UPLINK_BEACON_LOSS_SIZE : 0))
+
+/* Bytes before the first measure record for the given flags */
+#define UPLINK_PREFIX_SIZE(flags) \
+        ((((flags) & UPLINK_FLAG_PACKED) ? UPLINK_PACKED_HEADER_SIZE : UPLINK_HEADER_SIZE) + \
+        (((flags) & UPLINK_FLAG_TELEMETRY) ? UPLINK_TELEMETRY_SIZE : 0))
+
+/* Measure records that fit in one plain uplink packet for the given flags */
+#define UPLINK_MAX_MEASURES(flags) \
+        ((EASYLINK_MAX_DATA_LENGTH - UPLINK_PREFIX_SIZE((flags) & ~UPLINK_FLAG_PACKED)) / \
+        UPLINK_RECORD_SIZE(flags))
+
+/* Most measures Uplink_encode takes for a packed uplink */
+#define UPLINK_PACKED_MAX_MEASURES  64
+
+typedef struct
+{
+    uint8_t id;
+    uint8_t rssi;
+    uint16_t delta;
+    uint8_t rssiMin;            // UPLINK_FLAG_RSSI_STATS only
+    uint8_t rssiMax;
+    uint8_t rssiVariance;
+    uint16_t distance;          // UPLINK_FLAG_DISTANCE only
+    uint8_t beacons;            // UPLINK_FLAG_BEACON_LOSS only
+    uint8_t beaconsLost;
+} Uplink_Measure;
+
+typedef struct
+{
+    uint16_t rxOk;
+    uint16_t rxNok;
+    uint16_t rxTimeouts;
+    uint16_t txOk;
+    uint16_t txAborts;
+    uint16_t txErrors;
+    uint16_t busyErrors;
+    uint16_t ccaRetries;
+} Uplink_Telemetry;
+
+typedef struct
+{
+    const uint8_t* payload;
+    uint8_t len;
+    uint8_t apId;
+    uint8_t flags;
+    uint8_t seq;
+    uint8_t remaining;          // Records left in a packed uplink
+    uint16_t pos;               // Next byte, or next bit if packed
+    uint8_t prevId;
+    Uplink_Telemetry telemetry; // UPLINK_FLAG_TELEMETRY only
+} Uplink_Decoder;
+
+/*
+ * Writes an uplink with measures, oldest first, to payload and returns its
+ * length. Only the oldest measures may fit, encoded is set to how many of
+ * them were sent. UPLINK_FLAG_TELEMETRY is set if telemetry is not NULL.
+ */
+uint8_t Uplink_encode(uint8_t* payload, uint8_t apId, uint8_t flags, uint8_t seq,
+        const Uplink_Telemetry* telemetry, const Uplink_Measure* measures,
+        uint8_t count, uint8_t* encoded);
+
+/* Reads the uplink header, returns -1 if payload is too short for one */
+int Uplink_decoderInit(Uplink_Decoder* decoder, const uint8_t* payload, uint8_t len);
+
+/* Reads the next measure, returns 0 once there are no more */
+int Uplink_decodeNext(Uplink_Decoder* decoder, Uplink_Measure* measure);
+
+#endif /* UPLINK_H */
@@ -62,6 +62,7 @@
 #include "easylink/EasyLink.h"
 
 #include "TaskManager.h"
+#include "Trace.h"
 
 /***** Defines *****/
 
@@ -97,6 +98,10 @@ int main(void)
     /* Call driver init functions */
     Board_initGeneral();
 
+#ifdef TRACE_ENABLE
+    Trace_init();
+#endif
+
     /* Open LED pins */
     ledPinHandle = PIN_open(&ledPinState, pinTable);
 	Assert_isTrue(ledPinHandle != NULL, NULL); 
@@ -0,0 +1,94 @@
+/*
+ *  ======== UartReport.c ========
+ */
+#include "UartReport.h"
+
+/***** Function definitions *****/
+
+static uint32_t getUint32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+            ((uint32_t)p[3] << 24);
+}
+
+static int parseApReport(UartReport_ApReport* ap, const uint8_t* payload,
+        uint8_t len, uint8_t timed) {
+    ap->timed = timed;
+    ap->rxTime = 0;
+    if(timed) {
+        if(len < UART_FRAME_RX_TIME_SIZE) {
+            return -1;
+        }
+        ap->rxTime = getUint32(payload);
+        payload += UART_FRAME_RX_TIME_SIZE;
+        len -= UART_FRAME_RX_TIME_SIZE;
+    }
+
+    return Uplink_decoderInit(&ap->uplink, payload, len);
+}
+
+static void parseStatus(UartReport_Status* status, const uint8_t* p) {
+    status->packets = getUint32(&p[0]);
+    status->drops = getUint32(&p[4]);
+    status->bytesSent = getUint32(&p[8]);
+    status->uplinksLost = getUint32(&p[12]);
+}
+
+static void parseRadioStats(UartReport_RadioStats* radio, const uint8_t* p) {
+    radio->rxOk = getUint32(&p[0]);
+    radio->rxNok = getUint32(&p[4]);
+    radio->rxIgnored = getUint32(&p[8]);
+    radio->rxBufFull = getUint32(&p[12]);
+    radio->rxTimeouts = getUint32(&p[16]);
+    radio->rxAborts = getUint32(&p[20]);
+    radio->rxErrors = getUint32(&p[24]);
+    radio->txOk = getUint32(&p[28]);
+    radio->txAborts = getUint32(&p[32]);
+    radio->txErrors = getUint32(&p[36]);
+    radio->busyErrors = getUint32(&p[40]);
+    radio->lastRssi = (int8_t)p[44];
+}
+
+static void parseLinkStats(UartReport_LinkStats* link, const uint8_t* p) {
+    uint8_t i;
+
+    link->apId = p[0];
+    link->deliveryPermille = (uint16_t)(p[1] | (p[2] << 8));
+    link->stats.received = getUint32(&p[3]);
+    link->stats.lost = getUint32(&p[7]);
+    link->stats.resyncs = getUint32(&p[11]);
+    for(i = 0; i < LINKSTATS_GAP_BUCKETS; i++) {
+        link->stats.gaps[i] = getUint32(&p[15 + 4 * i]);
+    }
+}
+
+int UartReport_parse(UartReport* report, const UartFrame_Decoder* decoder) {
+    report->type = decoder->type;
+    report->seq = decoder->seq;
+
+    switch(decoder->type) {
+        case UART_FRAME_TYPE_AP_REPORT:
+        case UART_FRAME_TYPE_AP_REPORT_TIMED:
+            return parseApReport(&report->u.ap, decoder->payload, decoder->len,
+                    decoder->type == UART_FRAME_TYPE_AP_REPORT_TIMED);
+        case UART_FRAME_TYPE_STATUS:
+            if(decoder->len != UART_FRAME_STATUS_SIZE) {
+                return -1;
+            }
+            parseStatus(&report->u.status, decoder->payload);
+            return 0;
+        case UART_FRAME_TYPE_RADIO_STATS:
+            if(decoder->len != UART_FRAME_RADIO_STATS_SIZE) {
+                return -1;
+            }
+            parseRadioStats(&report->u.radio, decoder->payload);
+            return 0;
+        case UART_FRAME_TYPE_LINK_STATS:
+            if(decoder->len != UART_FRAME_LINK_STATS_SIZE) {
+                return -1;
+            }
+            parseLinkStats(&report->u.link, decoder->payload);
+            return 0;
+        default:
+            return -1;
+    }
+}
@@ -0,0 +1,77 @@
+#ifndef UARTREPORT_H
+#define UARTREPORT_H
+
+#include <stdint.h>
+
+#include "UartFrame.h"
+#include "Uplink.h"
+#include "LinkStats.h"
+
+/*
+ * Host side reading of the binary UART frames the central sends (see
+ * UartFrame.h). Bytes go through UartFrame_decode as on the device, then
+ * UartReport_parse reads the payload of each complete frame by its type.
+ *
+ * AP reports hold the uplink packet as the AP sent it, its measures are read
+ * with Uplink_decodeNext on report.ap.uplink. The decoder points into the
+ * frame decoder's payload, so it is only valid until the next byte is fed.
+ */
+
+typedef struct
+{
+    uint32_t packets;           // Uplink packets received
+    uint32_t drops;             // Dropped because the UART fell behind
+    uint32_t bytesSent;         // Bytes written to the UART
+    uint32_t uplinksLost;       // Gaps in the uplink seq of every AP
+} UartReport_Status;
+
+typedef struct
+{
+    uint32_t rxOk;
+    uint32_t rxNok;
+    uint32_t rxIgnored;
+    uint32_t rxBufFull;
+    uint32_t rxTimeouts;
+    uint32_t rxAborts;
+    uint32_t rxErrors;
+    uint32_t txOk;
+    uint32_t txAborts;
+    uint32_t txErrors;
+    uint32_t busyErrors;
+    int8_t lastRssi;
+} UartReport_RadioStats;
+
+typedef struct
+{
+    uint8_t apId;
+    uint16_t deliveryPermille;
+    LinkStats stats;
+} UartReport_LinkStats;
+
+typedef struct
+{
+    uint8_t timed;              // rxTime is set, UART_FRAME_TYPE_AP_REPORT_TIMED
+    uint32_t rxTime;            // Central radio time the uplink was received at
+    Uplink_Decoder uplink;
+} UartReport_ApReport;
+
+typedef struct
+{
+    uint8_t type;               // UART_FRAME_TYPE_*
+    uint8_t seq;
+    union
+    {
+        UartReport_ApReport ap;
+        UartReport_Status status;
+        UartReport_RadioStats radio;
+        UartReport_LinkStats link;
+    } u;
+} UartReport;
+
+/*
+ * Reads the frame just completed by decoder. Returns -1 for an unknown type
+ * or a payload of the wrong size for its type.
+ */
+int UartReport_parse(UartReport* report, const UartFrame_Decoder* decoder);
+
+#endif /* UARTREPORT_H */
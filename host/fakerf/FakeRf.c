@@ -0,0 +1,491 @@
+/*
+ *  ======== FakeRf.c ========
+ *
+ *  The RF driver calls EasyLink.c makes, on a fake RF core that writes the
+ *  packets put on the air to the data entries and Rx counters of the running
+ *  command the way the CC13x0's does.
+ */
+#include <stddef.h>
+#include <string.h>
+
+#include <ti/devices/DeviceFamily.h>
+#include DeviceFamily_constructPath(driverlib/rf_data_entry.h)
+#include DeviceFamily_constructPath(driverlib/rf_prop_mailbox.h)
+
+#include "FakeRf.h"
+
+/***** Defines *****/
+
+#define HISTORY         64      // Commands RF_getCmdOp and RF_pendCmd can look back on
+#define COUNTED         16      // Command numbers FakeRf_posted tells apart
+#define NO_COMMAND      ((RF_CmdHandle)-1)
+
+/***** Type declarations *****/
+
+typedef struct
+{
+    RF_Op* op;
+    RF_Callback cb;
+    RF_EventMask mask;
+    RF_EventMask events;        // Events it ended with, 0 while it runs
+} Command;
+
+/***** Variable declarations *****/
+
+static Command history[HISTORY];
+static RF_CmdHandle nextHandle = 0;
+static RF_CmdHandle active = NO_COMMAND;
+static RF_Handle client = NULL;
+static uint32_t now = 0;
+static int8_t channelRssi = -100;
+static RF_TxPowerTable_Value txPower;
+
+static struct
+{
+    uint16_t commandNo;
+    uint32_t count;
+} posted[COUNTED];
+
+/***** Function definitions *****/
+
+static Command* command(RF_CmdHandle ch) {
+    return &history[ch % HISTORY];
+}
+
+static void countCommand(uint16_t commandNo) {
+    uint8_t i;
+
+    for(i = 0; i < COUNTED; i++) {
+        if(posted[i].count == 0 || posted[i].commandNo == commandNo) {
+            posted[i].commandNo = commandNo;
+            posted[i].count++;
+            return;
+        }
+    }
+}
+
+//Ends the running command, the slot is free again before the callback so
+//that it can post the next one, as from the RF driver's Swi
+static void finish(RF_EventMask events) {
+    RF_CmdHandle ch = active;
+    Command* c = command(ch);
+
+    c->events = events;
+    active = NO_COMMAND;
+
+    if(c->cb != NULL) {
+        c->cb(client, ch, events & c->mask);
+    }
+}
+
+//Tells the running command's callback of an event that does not end it
+static void notify(RF_EventMask events) {
+    Command* c = command(active);
+
+    if((c->cb != NULL) && (c->mask & events)) {
+        c->cb(client, active, events & c->mask);
+    }
+}
+
+static RF_Op* activeOp(uint16_t commandNo) {
+    if((active == NO_COMMAND) || (command(active)->op->commandNo != commandNo)) {
+        return NULL;
+    }
+
+    return command(active)->op;
+}
+
+static bool addressMatches(const rfc_CMD_PROP_RX_ADV_t* rx, const uint8_t* pkt, uint8_t len) {
+    uint8_t i;
+
+    if(len < rx->addrConf.addrSize) {
+        return false;
+    }
+    for(i = 0; i < rx->addrConf.numAddr; i++) {
+        if(memcmp(pkt, rx->pAddr + i * rx->addrConf.addrSize, rx->addrConf.addrSize) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void FakeRf_reset(void) {
+    memset(history, 0, sizeof(history));
+    memset(posted, 0, sizeof(posted));
+    nextHandle = 0;
+    active = NO_COMMAND;
+    now = 0;
+    channelRssi = -100;
+}
+
+//Moves time on to a RAT time, ending an Rx command whose end time comes by
+static void advanceTo(uint32_t time) {
+    rfc_CMD_PROP_RX_ADV_t* rx = (rfc_CMD_PROP_RX_ADV_t*)activeOp(CMD_PROP_RX_ADV);
+    uint32_t start = now;
+
+    if((int32_t)(time - now) <= 0) {
+        return;
+    }
+    now = time;
+
+    if((rx != NULL) && (rx->endTrigger.triggerType == TRIG_ABSTIME) &&
+            (rx->endTime - start <= time - start)) {
+        rx->status = PROP_DONE_RXTIMEOUT;
+        finish(RF_EventLastCmdDone | RF_EventCmdDone);
+    }
+}
+
+void FakeRf_advance(uint32_t ticks) {
+    uint32_t end = now + ticks;
+    uint32_t due;
+
+    //Clocks due on the way fire at their time, they may post commands
+    while(FakeRtos_nextClock(&due) && ((int32_t)(due - end) <= 0)) {
+        advanceTo(due);
+        FakeRtos_fireClocks();
+    }
+    advanceTo(end);
+}
+
+FakeRf_RxResult FakeRf_receive(const uint8_t* pkt, uint8_t len, int8_t rssi, bool crcOk) {
+    rfc_CMD_PROP_RX_ADV_t* rx = (rfc_CMD_PROP_RX_ADV_t*)activeOp(CMD_PROP_RX_ADV);
+    rfc_propRxOutput_t* out;
+    rfc_dataEntryGeneral_t* entry;
+    uint8_t* data;
+    uint16_t need;
+    bool ignored = false;
+
+    if(rx == NULL) {
+        return FakeRf_Rx_NotListening;
+    }
+    out = (rfc_propRxOutput_t*)rx->pOutput;
+
+    //Bad packets are not stored, as with bAutoFlushCrcErr
+    if(!crcOk || (len > rx->maxPktLen)) {
+        out->nRxNok++;
+        if(!rx->pktConf.bRepeatNok) {
+            rx->status = PROP_DONE_RXERR;
+            finish(RF_EventLastCmdDone | RF_EventCmdDone);
+        }
+        return FakeRf_Rx_CrcError;
+    }
+
+    //With the filter off a packet for another address is received, counted
+    //as ignored
+    if(!addressMatches(rx, pkt, len)) {
+        if(rx->pktConf.filterOp == 0) {
+            out->nRxIgnored++;
+            return FakeRf_Rx_Filtered;
+        }
+        ignored = true;
+    }
+
+    entry = (rfc_dataEntryGeneral_t*)rx->pQueue->pCurrEntry;
+    need = 1 + len + (rx->rxConf.bAppendRssi ? 1 : 0) +
+            (rx->rxConf.bAppendTimestamp ? sizeof(uint32_t) : 0);
+    if((entry == NULL) || (entry->status != DATA_ENTRY_PENDING) || (need > entry->length)) {
+        out->nRxBufFull++;
+        rx->status = PROP_ERROR_RXBUF;
+        finish(RF_EventLastCmdDone | RF_EventCmdDone);
+        return FakeRf_Rx_BufFull;
+    }
+
+    //Length byte, address and payload, then what the command appends
+    data = &entry->data;
+    data[0] = len;
+    memcpy(data + 1, pkt, len);
+    data += 1 + len;
+    if(rx->rxConf.bAppendRssi) {
+        *data++ = (uint8_t)rssi;
+    }
+    if(rx->rxConf.bAppendTimestamp) {
+        memcpy(data, &now, sizeof(uint32_t));
+    }
+    entry->status = DATA_ENTRY_FINISHED;
+    rx->pQueue->pCurrEntry = entry->pNextEntry;
+
+    if(ignored) {
+        out->nRxIgnored++;
+    } else {
+        out->nRxOk++;
+    }
+    out->lastRssi = rssi;
+    out->timeStamp = now;
+
+    if(rx->pktConf.bRepeatOk) {
+        notify(RF_EventRxEntryDone);
+    } else {
+        rx->status = PROP_DONE_OK;
+        finish(RF_EventLastCmdDone | RF_EventCmdDone | RF_EventRxEntryDone);
+    }
+
+    return FakeRf_Rx_Stored;
+}
+
+bool FakeRf_completeTx(void) {
+    RF_Op* tx = activeOp(CMD_PROP_TX);
+
+    if(tx == NULL) {
+        return false;
+    }
+
+    tx->status = PROP_DONE_OK;
+    finish(RF_EventLastCmdDone | RF_EventCmdDone | RF_EventTxDone);
+
+    return true;
+}
+
+bool FakeRf_carrierSense(bool busy) {
+    RF_Op* cs = activeOp(CMD_PROP_CS);
+
+    if(cs == NULL) {
+        return false;
+    }
+
+    //The chained Tx only runs on an idle channel, COND_STOP_ON_TRUE
+    cs->status = busy ? PROP_DONE_BUSY : PROP_DONE_IDLE;
+    if(!busy && (cs->pNextOp != NULL)) {
+        countCommand(cs->pNextOp->commandNo);
+        cs->pNextOp->status = PROP_DONE_OK;
+    }
+    finish(RF_EventLastCmdDone | RF_EventCmdDone);
+
+    return true;
+}
+
+uint16_t FakeRf_activeCommand(void) {
+    return (active == NO_COMMAND) ? 0 : command(active)->op->commandNo;
+}
+
+uint32_t FakeRf_posted(uint16_t commandNo) {
+    uint8_t i;
+
+    for(i = 0; i < COUNTED; i++) {
+        if(posted[i].commandNo == commandNo) {
+            return posted[i].count;
+        }
+    }
+
+    return 0;
+}
+
+void FakeRf_setRssi(int8_t rssi) {
+    channelRssi = rssi;
+}
+
+void RF_Params_init(RF_Params* params) {
+    memset(params, 0, sizeof(RF_Params));
+}
+
+RF_Handle RF_open(RF_Object* pObj, RF_Mode* pRfMode, RF_RadioSetup* pRadioSetup,
+        RF_Params* params) {
+    (void)pRfMode;
+    (void)params;
+
+    pObj->opened = 1;
+    client = pObj;
+    active = NO_COMMAND;
+    txPower.rawValue = pRadioSetup->prop.txPower;
+    txPower.paType = RF_TxPowerTable_DefaultPA;
+
+    return client;
+}
+
+void RF_close(RF_Handle h) {
+    h->opened = 0;
+    active = NO_COMMAND;
+}
+
+RF_CmdHandle RF_postCmd(RF_Handle h, RF_Op* pOp, RF_Priority ePri, RF_Callback pCb,
+        RF_EventMask bmEvent) {
+    RF_CmdHandle ch;
+    Command* c;
+
+    (void)h;
+    (void)ePri;
+
+    if(active != NO_COMMAND) {
+        return RF_ALLOC_ERROR;
+    }
+
+    ch = nextHandle;
+    nextHandle = (nextHandle + 1) & 0x7FFF;
+    c = command(ch);
+    c->op = pOp;
+    c->cb = pCb;
+    c->mask = bmEvent;
+    c->events = 0;
+    countCommand(pOp->commandNo);
+
+    pOp->status = ACTIVE;
+    active = ch;
+
+    //Rx, Tx, carrier sense and the test modes run until the test ends them,
+    //anything else is done at once
+    switch(pOp->commandNo) {
+        case CMD_PROP_RX_ADV:
+        case CMD_PROP_TX:
+        case CMD_PROP_CS:
+        case CMD_TX_TEST:
+        case CMD_RX_TEST:
+            break;
+        default:
+            pOp->status = DONE_OK;
+            finish(RF_EventLastCmdDone | RF_EventCmdDone);
+            break;
+    }
+
+    return ch;
+}
+
+RF_CmdHandle RF_scheduleCmd(RF_Handle h, RF_Op* pOp, RF_ScheduleCmdParams* pSchParams,
+        RF_Callback pCb, RF_EventMask bmEvent) {
+    (void)pSchParams;
+
+    return RF_postCmd(h, pOp, RF_PriorityNormal, pCb, bmEvent);
+}
+
+RF_EventMask RF_pendCmd(RF_Handle h, RF_CmdHandle ch, RF_EventMask bmEvent) {
+    RF_Op* op;
+
+    (void)h;
+    (void)bmEvent;
+
+    if(ch < 0) {
+        return 0;
+    }
+
+    //Nothing else can happen on the air while the caller waits, the command
+    //runs to its end now: a Tx is sent, a carrier sense finds the channel
+    //idle and an Rx times out
+    if(ch == active) {
+        op = command(ch)->op;
+        if(op->commandNo == CMD_PROP_CS) {
+            FakeRf_carrierSense(false);
+        } else if(op->commandNo == CMD_PROP_RX_ADV) {
+            op->status = PROP_DONE_RXTIMEOUT;
+            finish(RF_EventLastCmdDone | RF_EventCmdDone);
+        } else {
+            op->status = (op->commandNo == CMD_PROP_TX) ? PROP_DONE_OK : DONE_OK;
+            finish(RF_EventLastCmdDone | RF_EventCmdDone);
+        }
+    }
+
+    return command(ch)->events;
+}
+
+RF_EventMask RF_runCmd(RF_Handle h, RF_Op* pOp, RF_Priority ePri, RF_Callback pCb,
+        RF_EventMask bmEvent) {
+    return RF_pendCmd(h, RF_postCmd(h, pOp, ePri, pCb, bmEvent), bmEvent);
+}
+
+RF_Stat RF_cancelCmd(RF_Handle h, RF_CmdHandle ch, uint8_t mode) {
+    RF_Op* op;
+    bool prop;
+
+    (void)h;
+
+    if((ch < 0) || (ch != active)) {
+        return ((ch >= 0) && (command(ch)->events != 0)) ?
+                RF_StatCmdDoneSuccess : RF_StatInvalidParamsError;
+    }
+
+    //A graceful stop lets the command end by itself, an abort cuts it short
+    op = command(ch)->op;
+    prop = (op->commandNo & 0xFF00) == 0x3800;
+    if(mode) {
+        op->status = prop ? PROP_DONE_STOPPED : DONE_STOPPED;
+        finish(RF_EventLastCmdDone | RF_EventCmdStopped);
+    } else {
+        op->status = prop ? PROP_DONE_ABORT : DONE_ABORT;
+        finish(RF_EventCmdAborted);
+    }
+
+    return RF_StatSuccess;
+}
+
+RF_Stat RF_runImmediateCmd(RF_Handle h, uint32_t* pCmdStruct) {
+    rfc_CMD_ADD_DATA_ENTRY_t* add = (rfc_CMD_ADD_DATA_ENTRY_t*)pCmdStruct;
+    rfc_dataEntry_t* last;
+
+    (void)h;
+
+    if(active == NO_COMMAND) {
+        return RF_StatRadioInactiveError;
+    }
+    if(add->commandNo != CMD_ADD_DATA_ENTRY) {
+        return RF_StatCmdDoneError;
+    }
+    countCommand(CMD_ADD_DATA_ENTRY);
+
+    //The entry goes after the last one, or is the current one if the RF core
+    //has used up the queue
+    ((rfc_dataEntry_t*)add->pEntry)->pNextEntry = NULL;
+    if(add->pQueue->pCurrEntry == NULL) {
+        add->pQueue->pCurrEntry = add->pEntry;
+    } else {
+        last = (rfc_dataEntry_t*)add->pQueue->pLastEntry;
+        last->pNextEntry = add->pEntry;
+    }
+    add->pQueue->pLastEntry = add->pEntry;
+
+    return RF_StatCmdDoneSuccess;
+}
+
+RF_Op* RF_getCmdOp(RF_Handle h, RF_CmdHandle cmdHnd) {
+    (void)h;
+
+    return (cmdHnd < 0) ? NULL : command(cmdHnd)->op;
+}
+
+uint32_t RF_getCurrentTime(void) {
+    return now;
+}
+
+int8_t RF_getRssi(RF_Handle h) {
+    (void)h;
+
+    return channelRssi;
+}
+
+RF_Stat RF_setTxPower(RF_Handle h, RF_TxPowerTable_Value value) {
+    (void)h;
+    txPower = value;
+
+    return RF_StatSuccess;
+}
+
+RF_TxPowerTable_Value RF_getTxPower(RF_Handle h) {
+    (void)h;
+
+    return txPower;
+}
+
+RF_TxPowerTable_Value RF_TxPowerTable_findValue(RF_TxPowerTable_Entry table[], int8_t powerLevel) {
+    RF_TxPowerTable_Value value = {RF_TxPowerTable_INVALID_VALUE, RF_TxPowerTable_DefaultPA};
+    uint8_t i;
+
+    //Highest level not above the one asked for, the table is sorted
+    for(i = 0; table[i].power != RF_TxPowerTable_INVALID_DBM; i++) {
+        if(table[i].power <= powerLevel) {
+            value = table[i].value;
+        }
+    }
+
+    return value;
+}
+
+int8_t RF_TxPowerTable_findPowerLevel(RF_TxPowerTable_Entry table[],
+        RF_TxPowerTable_Value value) {
+    uint8_t i;
+
+    for(i = 0; table[i].power != RF_TxPowerTable_INVALID_DBM; i++) {
+        if((table[i].value.rawValue == value.rawValue) &&
+                (table[i].value.paType == value.paType)) {
+            return table[i].power;
+        }
+    }
+
+    return RF_TxPowerTable_INVALID_DBM;
+}
@@ -0,0 +1,70 @@
+#ifndef FAKERF_H
+#define FAKERF_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <ti/drivers/rf/RF.h>
+
+/*
+ * Fake RF core and driver under the firmware's EasyLink.c, for host tests of
+ * the real Rx queue, Tx and CCA code. Everything runs on the test's thread:
+ * a command posted by EasyLink runs when the test says what the air does,
+ * and its callback is called from within that FakeRf call, standing in for
+ * the RF driver's Swi. One command runs at a time, as EasyLink uses them.
+ *
+ * Time is RAT ticks (4 MHz), it only moves with FakeRf_advance.
+ */
+
+/* What became of a packet put on the air with FakeRf_receive */
+typedef enum
+{
+    FakeRf_Rx_NotListening,     // No Rx command was running
+    FakeRf_Rx_Stored,           // Written to a data entry
+    FakeRf_Rx_Filtered,         // Dropped by the address filter
+    FakeRf_Rx_CrcError,         // Received with a CRC error
+    FakeRf_Rx_BufFull           // No pending data entry, Rx ended
+} FakeRf_RxResult;
+
+/* Back to no command, time 0 and nothing counted */
+void FakeRf_reset(void);
+
+/*
+ * Moves time on, ending an Rx command whose end time comes by and firing the
+ * clocks of the TI-RTOS shims at their time
+ */
+void FakeRf_advance(uint32_t ticks);
+
+/*
+ * A packet on the air: the address and payload as EasyLink sent them, with
+ * the RSSI it is received at. A CRC error stands in for a collision.
+ */
+FakeRf_RxResult FakeRf_receive(const uint8_t* pkt, uint8_t len, int8_t rssi, bool crcOk);
+
+/* Sends the running Tx, returns false if none was running */
+bool FakeRf_completeTx(void);
+
+/*
+ * Ends the running carrier sense with the channel busy or idle, an idle
+ * channel sends the chained Tx. Returns false if no carrier sense was running.
+ */
+bool FakeRf_carrierSense(bool busy);
+
+/* Number of the command running, 0 if none */
+uint16_t FakeRf_activeCommand(void);
+
+/* Commands of a number posted since the reset */
+uint32_t FakeRf_posted(uint16_t commandNo);
+
+/* RSSI RF_getRssi returns */
+void FakeRf_setRssi(int8_t rssi);
+
+/*
+ * Clocks of the TI-RTOS shims, for FakeRf_advance: the RAT time the next
+ * running clock fires at, false if none runs, and firing those due by now
+ * as from the Clock Swi
+ */
+bool FakeRtos_nextClock(uint32_t* due);
+void FakeRtos_fireClocks(void);
+
+#endif /* FAKERF_H */
@@ -0,0 +1,118 @@
+/*
+ *  ======== FakeRfSettings.c ========
+ *
+ *  The RF settings EasyLink.c copies its commands from, with the values of
+ *  the AP's smartrf_settings for the fields the fake RF core and EasyLink's
+ *  air time use. The overrides and patches mean nothing to the fake and are
+ *  left out.
+ */
+#include <smartrf_settings/smartrf_settings_predefined.h>
+#include <smartrf_settings/smartrf_settings.h>
+
+/***** Defines *****/
+
+/* Setup of a PHY, the fields they all share */
+#define DIV_SETUP(rate, preamble, fec) \
+    { \
+        .commandNo = CMD_PROP_RADIO_DIV_SETUP, \
+        .condition.rule = COND_NEVER, \
+        .modulation.modType = 0x1, \
+        .symbolRate.preScale = 0xF, \
+        .symbolRate.rateWord = (rate), \
+        .preamConf.nPreamBytes = (preamble), \
+        .formatConf.nSwBits = 0x20, \
+        .formatConf.bMsbFirst = 0x1, \
+        .formatConf.fecMode = (fec), \
+        .txPower = 0xAB3F, \
+        .centerFreq = 0x0364, \
+        .loDivider = 0x05 \
+    }
+
+/***** Variable declarations *****/
+
+static rfc_CMD_PROP_RADIO_DIV_SETUP_t cmdPropRadioDivSetupFsk = DIV_SETUP(0x8000, 0x4, 0x0);
+static rfc_CMD_PROP_RADIO_DIV_SETUP_t cmdPropRadioDivSetupLrm = DIV_SETUP(0x199A, 0x5, 0x8);
+static rfc_CMD_PROP_RADIO_DIV_SETUP_t cmdPropRadioDivSetupSlLr = DIV_SETUP(0x3333, 0x2, 0x8);
+
+static RF_Mode propFsk = {.rfMode = RF_MODE_PROPRIETARY_SUB_1};
+
+static rfc_CMD_FS_t cmdFsPreDef = {
+    .commandNo = CMD_FS,
+    .condition.rule = COND_NEVER,
+    .frequency = 0x0364
+};
+
+static rfc_CMD_PROP_TX_t cmdPropTxPreDef = {
+    .commandNo = CMD_PROP_TX,
+    .condition.rule = COND_NEVER,
+    .pktConf.bUseCrc = 0x1,
+    .pktConf.bVarLen = 0x1,
+    .syncWord = 0x930B51DE
+};
+
+static rfc_CMD_PROP_RX_ADV_t cmdPropRxAdvPreDef = {
+    .commandNo = CMD_PROP_RX_ADV,
+    .condition.rule = COND_NEVER,
+    .pktConf.bUseCrc = 0x1,
+    .pktConf.bCrcIncHdr = 0x1,
+    .pktConf.filterOp = 0x1,
+    .rxConf.bIncludeHdr = 0x1,
+    .syncWord0 = 0x930B51DE,
+    .hdrConf.numHdrBits = 8,
+    .hdrConf.numLenBits = 8,
+    .addrConf.numAddr = 1,
+    .endTrigger.triggerType = TRIG_NEVER
+};
+
+const RF_TxPowerTable_Entry PROP_RF_txPowerTable[] = {
+    {-10, RF_TxPowerTable_DEFAULT_PA_ENTRY(0, 3, 0, 2) },
+    {0, RF_TxPowerTable_DEFAULT_PA_ENTRY(3, 3, 0, 9) },
+    {1, RF_TxPowerTable_DEFAULT_PA_ENTRY(4, 3, 0, 11) },
+    {2, RF_TxPowerTable_DEFAULT_PA_ENTRY(5, 3, 0, 12) },
+    {3, RF_TxPowerTable_DEFAULT_PA_ENTRY(6, 3, 0, 14) },
+    {4, RF_TxPowerTable_DEFAULT_PA_ENTRY(4, 1, 0, 12) },
+    {5, RF_TxPowerTable_DEFAULT_PA_ENTRY(8, 3, 0, 16) },
+    {6, RF_TxPowerTable_DEFAULT_PA_ENTRY(9, 3, 0, 18) },
+    {7, RF_TxPowerTable_DEFAULT_PA_ENTRY(11, 3, 0, 21) },
+    {8, RF_TxPowerTable_DEFAULT_PA_ENTRY(14, 3, 0, 25) },
+    {9, RF_TxPowerTable_DEFAULT_PA_ENTRY(18, 3, 0, 32) },
+    {10, RF_TxPowerTable_DEFAULT_PA_ENTRY(24, 3, 0, 44) },
+    {11, RF_TxPowerTable_DEFAULT_PA_ENTRY(37, 3, 0, 72) },
+    {12, RF_TxPowerTable_DEFAULT_PA_ENTRY(43, 0, 0, 94) },
+    {14, RF_TxPowerTable_DEFAULT_PA_ENTRY(63, 0, 1, 85) },
+    RF_TxPowerTable_TERMINATION_ENTRY
+};
+
+const uint8_t PROP_RF_txPowerTableSize = sizeof(PROP_RF_txPowerTable) / sizeof(RF_TxPowerTable_Entry);
+
+/* EasyLink_Phy_Custom, smartrf_settings.c */
+RF_Mode RF_prop = {.rfMode = RF_MODE_PROPRIETARY_SUB_1};
+rfc_CMD_PROP_RADIO_DIV_SETUP_t RF_cmdPropRadioDivSetup = DIV_SETUP(0x8000, 0x4, 0x0);
+rfc_CMD_FS_t RF_cmdFs = {
+    .commandNo = CMD_FS,
+    .condition.rule = COND_NEVER,
+    .frequency = 0x0364
+};
+rfc_CMD_PROP_TX_t RF_cmdPropTx = {
+    .commandNo = CMD_PROP_TX,
+    .condition.rule = COND_NEVER,
+    .pktConf.bUseCrc = 0x1,
+    .pktConf.bVarLen = 0x1,
+    .pktLen = 0x0E,
+    .syncWord = 0x930B51DE
+};
+
+/* The predefined PHYs, smartrf_settings_predefined.c, all on the one mode */
+RF_Mode* RF_pProp_fsk = &propFsk;
+RF_Mode* RF_pProp_lrm = &propFsk;
+RF_Mode* RF_pProp_sl_lr = &propFsk;
+RF_Mode* RF_pProp_2_4G_fsk = 0;
+
+rfc_CMD_PROP_RADIO_DIV_SETUP_t* RF_pCmdPropRadioDivSetup_fsk = &cmdPropRadioDivSetupFsk;
+rfc_CMD_PROP_RADIO_DIV_SETUP_t* RF_pCmdPropRadioDivSetup_lrm = &cmdPropRadioDivSetupLrm;
+rfc_CMD_PROP_RADIO_DIV_SETUP_t* RF_pCmdPropRadioDivSetup_sl_lr = &cmdPropRadioDivSetupSlLr;
+rfc_CMD_PROP_RADIO_SETUP_t* RF_pCmdPropRadioSetup_2_4G_fsk = 0;
+
+rfc_CMD_FS_t* RF_pCmdFs_preDef = &cmdFsPreDef;
+rfc_CMD_PROP_TX_t* RF_pCmdPropTx_preDef = &cmdPropTxPreDef;
+rfc_CMD_PROP_RX_ADV_t* RF_pCmdPropRxAdv_preDef = &cmdPropRxAdvPreDef;
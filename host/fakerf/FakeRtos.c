@@ -0,0 +1,182 @@
+/*
+ *  ======== FakeRtos.c ========
+ *
+ *  TI-RTOS shims for EasyLink.c on the fake RF core. The test's thread is the
+ *  only one and the RF callbacks run from within the FakeRf calls, so there
+ *  is nothing to lock and nothing to wait for: a pend on a semaphore that is
+ *  not posted returns at once, or aborts if it was meant to wait forever.
+ *  Time is the fake RF core's.
+ */
+#include <stdlib.h>
+
+#include <ti/sysbios/BIOS.h>
+#include <ti/sysbios/knl/Clock.h>
+#include <ti/sysbios/knl/Semaphore.h>
+#include <ti/sysbios/knl/Swi.h>
+#include <ti/sysbios/knl/Task.h>
+
+#include "FakeRf.h"
+
+/***** Defines *****/
+
+#define RAT_PER_US      4
+#define CLOCKS          4       // Clocks constructed at once
+
+/***** Variable declarations *****/
+
+UInt32 Clock_tickPeriod = 10;
+
+static Clock_Struct* clocks[CLOCKS];
+static UInt8 clockCount = 0;
+
+/***** Function definitions *****/
+
+UInt32 Clock_getTicks(void) {
+    return RF_getCurrentTime() / (Clock_tickPeriod * RAT_PER_US);
+}
+
+void Clock_Params_init(Clock_Params* params) {
+    params->period = 0;
+    params->startFlag = FALSE;
+    params->arg = 0;
+}
+
+void Clock_construct(Clock_Struct* clk, Clock_FuncPtr fxn, UInt timeout, const Clock_Params* params) {
+    UInt8 i;
+
+    clk->fxn = fxn;
+    clk->arg = (params != NULL) ? params->arg : 0;
+    clk->timeout = timeout;
+    clk->period = (params != NULL) ? params->period : 0;
+    clk->active = FALSE;
+
+    //Constructed again by a second EasyLink_init, it is only listed once
+    for(i = 0; i < clockCount; i++) {
+        if(clocks[i] == clk) {
+            break;
+        }
+    }
+    if(i == clockCount) {
+        if(clockCount == CLOCKS) {
+            abort();
+        }
+        clocks[clockCount++] = clk;
+    }
+    if((params != NULL) && params->startFlag) {
+        Clock_start(clk);
+    }
+}
+
+Clock_Handle Clock_handle(Clock_Struct* clk) {
+    return clk;
+}
+
+void Clock_setTimeout(Clock_Handle clk, UInt32 timeout) {
+    clk->timeout = timeout;
+}
+
+void Clock_start(Clock_Handle clk) {
+    clk->due = RF_getCurrentTime() + clk->timeout * Clock_tickPeriod * RAT_PER_US;
+    clk->active = TRUE;
+}
+
+void Clock_stop(Clock_Handle clk) {
+    clk->active = FALSE;
+}
+
+bool FakeRtos_nextClock(uint32_t* due) {
+    uint32_t now = RF_getCurrentTime();
+    bool found = false;
+    UInt8 i;
+
+    for(i = 0; i < clockCount; i++) {
+        if(clocks[i]->active && (!found || (int32_t)(clocks[i]->due - *due) < 0)) {
+            *due = clocks[i]->due;
+            found = true;
+        }
+    }
+    //One overdue fires now
+    if(found && (int32_t)(*due - now) < 0) {
+        *due = now;
+    }
+
+    return found;
+}
+
+void FakeRtos_fireClocks(void) {
+    uint32_t now = RF_getCurrentTime();
+    Clock_Struct* clk;
+    UInt8 i;
+
+    for(i = 0; i < clockCount; i++) {
+        clk = clocks[i];
+        if(!clk->active || (int32_t)(now - clk->due) < 0) {
+            continue;
+        }
+        if(clk->period != 0) {
+            clk->due += clk->period * Clock_tickPeriod * RAT_PER_US;
+        } else {
+            clk->active = FALSE;
+        }
+        clk->fxn(clk->arg);
+    }
+}
+
+UInt Swi_disable(void) {
+    return 0;
+}
+
+void Swi_restore(UInt key) {
+    (void)key;
+}
+
+void BIOS_start(void) {
+}
+
+void Task_sleep(UInt32 ticks) {
+    FakeRf_advance(ticks * Clock_tickPeriod * RAT_PER_US);
+}
+
+void Semaphore_Params_init(Semaphore_Params* params) {
+    params->mode = Semaphore_Mode_COUNTING;
+}
+
+void Semaphore_construct(Semaphore_Struct* sem, Int count, const Semaphore_Params* params) {
+    sem->mode = (params != NULL) ? params->mode : Semaphore_Mode_COUNTING;
+    sem->count = (sem->mode == Semaphore_Mode_BINARY && count > 1) ? 1 : (UInt)count;
+}
+
+Semaphore_Handle Semaphore_create(Int count, const Semaphore_Params* params, Error_Block* eb) {
+    Semaphore_Handle sem = malloc(sizeof(Semaphore_Struct));
+
+    (void)eb;
+    if(sem != NULL) {
+        Semaphore_construct(sem, count, params);
+    }
+
+    return sem;
+}
+
+void Semaphore_delete(Semaphore_Handle* sem) {
+    free(*sem);
+    *sem = NULL;
+}
+
+Bool Semaphore_pend(Semaphore_Handle sem, UInt32 timeout) {
+    if(sem->count == 0) {
+        //No one else could ever post it
+        if(timeout == BIOS_WAIT_FOREVER) {
+            abort();
+        }
+        return FALSE;
+    }
+    sem->count--;
+
+    return TRUE;
+}
+
+void Semaphore_post(Semaphore_Handle sem) {
+    if(sem->mode == Semaphore_Mode_COUNTING || sem->count == 0) {
+        sem->count++;
+    }
+}
@@ -0,0 +1,11 @@
+#ifndef HOST_DEVICEFAMILY_H
+#define HOST_DEVICEFAMILY_H
+
+/*
+ * Host stand-in for ti/devices/DeviceFamily.h. The driverlib headers next to
+ * it are those of the CC13x0, cut down to what EasyLink.c uses.
+ */
+
+#define DeviceFamily_constructPath(x) <ti/devices/cc13x0/x>
+
+#endif /* HOST_DEVICEFAMILY_H */
@@ -0,0 +1,22 @@
+#ifndef HOST_CHIPINFO_H
+#define HOST_CHIPINFO_H
+
+/* Host stand-in for driverlib's chip information, the host is a CC1350 */
+
+typedef enum
+{
+    CHIP_TYPE_Unknown = -1,
+    CHIP_TYPE_CC1310 = 0,
+    CHIP_TYPE_CC1350 = 1,
+    CHIP_TYPE_CC2620 = 2,
+    CHIP_TYPE_CC2630 = 3,
+    CHIP_TYPE_CC2640 = 4,
+    CHIP_TYPE_CC2650 = 5
+} ChipType_t;
+
+static inline ChipType_t ChipInfo_GetChipType(void)
+{
+    return CHIP_TYPE_CC1350;
+}
+
+#endif /* HOST_CHIPINFO_H */
@@ -0,0 +1,130 @@
+#ifndef HOST_RF_COMMON_CMD_H
+#define HOST_RF_COMMON_CMD_H
+
+#include <stdint.h>
+
+#include "rf_mailbox.h"
+
+/*
+ * Host stand-in for the RF core's common commands, with the fields the
+ * firmware and the fake RF core use. Every radio operation starts with the
+ * same header, so any of them can be handled as an rfc_radioOp_t.
+ */
+
+#define CMD_ABORT               0x0401
+#define CMD_STOP                0x0402
+#define CMD_ADD_DATA_ENTRY      0x0005
+#define CMD_SCH_IMM             0x0810
+#define CMD_SET_TX_POWER        0x0010
+#define CMD_RADIO_SETUP         0x0802
+#define CMD_FS                  0x0803
+#define CMD_RX_TEST             0x0807
+#define CMD_TX_TEST             0x0808
+
+typedef struct
+{
+    uint8_t triggerType;
+    uint8_t bEnaCmd;
+    uint8_t triggerNo;
+    uint8_t pastTrig;
+} rfc_trigger_t;
+
+typedef struct
+{
+    uint8_t rule;
+    uint8_t nSkip;
+} rfc_condition_t;
+
+/* Any command, by its number */
+typedef struct
+{
+    uint16_t commandNo;
+} rfc_command_t;
+
+typedef struct rfc_radioOp_s rfc_radioOp_t;
+
+#define RFC_RADIO_OP_HEADER \
+    uint16_t commandNo; \
+    uint16_t status; \
+    rfc_radioOp_t* pNextOp; \
+    ratmr_t startTime; \
+    rfc_trigger_t startTrigger; \
+    rfc_condition_t condition;
+
+struct rfc_radioOp_s
+{
+    RFC_RADIO_OP_HEADER
+};
+
+typedef struct
+{
+    RFC_RADIO_OP_HEADER
+    uint16_t frequency;         // MHz
+    uint16_t fractFreq;         // Fraction of a MHz, in 1/65536
+    struct
+    {
+        uint8_t bTxMode;
+        uint8_t refFreq;
+    } synthConf;
+} rfc_CMD_FS_t;
+
+typedef struct
+{
+    RFC_RADIO_OP_HEADER
+    uint8_t mode;
+    uint16_t txPower;
+} rfc_CMD_RADIO_SETUP_t;
+
+typedef struct
+{
+    RFC_RADIO_OP_HEADER
+    struct
+    {
+        uint8_t bUseCw;
+        uint8_t bFsOff;
+        uint8_t whitenMode;
+    } config;
+    uint16_t txWord;
+    rfc_trigger_t endTrigger;
+    uint32_t syncWord;
+    ratmr_t endTime;
+} rfc_CMD_TX_TEST_t;
+
+typedef struct
+{
+    RFC_RADIO_OP_HEADER
+    struct
+    {
+        uint8_t bEnaFifo;
+        uint8_t bFsOff;
+        uint8_t bNoSync;
+    } config;
+    rfc_trigger_t endTrigger;
+    uint32_t syncWord;
+    ratmr_t endTime;
+} rfc_CMD_RX_TEST_t;
+
+typedef struct
+{
+    RFC_RADIO_OP_HEADER
+    uint16_t __dummy0;
+    uint32_t cmdrVal;
+    uint32_t cmdstaVal;
+} rfc_CMD_SCH_IMM_t;
+
+typedef struct
+{
+    uint16_t commandNo;
+    uint16_t txPower;
+} rfc_CMD_SET_TX_POWER_t;
+
+/* Immediate command, appends pEntry to pQueue */
+typedef struct
+{
+    uint16_t commandNo;
+    uint16_t __dummy0;
+    dataQueue_t* pQueue;
+    uint8_t* pEntry;
+} rfc_CMD_ADD_DATA_ENTRY_t;
+
+#endif /* HOST_RF_COMMON_CMD_H */
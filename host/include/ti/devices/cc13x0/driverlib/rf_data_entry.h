@@ -0,0 +1,48 @@
+#ifndef HOST_RF_DATA_ENTRY_H
+#define HOST_RF_DATA_ENTRY_H
+
+#include <stdint.h>
+
+/* Host stand-in for the RF core data entries */
+
+/* Data entry status */
+#define DATA_ENTRY_PENDING      0
+#define DATA_ENTRY_ACTIVE       1
+#define DATA_ENTRY_BUSY         2
+#define DATA_ENTRY_FINISHED     3
+#define DATA_ENTRY_UNFINISHED   4
+
+/* Data entry types */
+#define DATA_ENTRY_TYPE_GEN     0
+#define DATA_ENTRY_TYPE_MULTI   1
+#define DATA_ENTRY_TYPE_PTR     2
+
+typedef struct
+{
+    uint8_t* pNextEntry;
+    uint8_t status;
+    struct
+    {
+        uint8_t type;
+        uint8_t lenSz;
+        uint8_t irqIntv;
+    } config;
+    uint16_t length;            // Bytes of data the entry can hold
+} rfc_dataEntry_t;
+
+/* General entry, the data follows the header */
+typedef struct
+{
+    uint8_t* pNextEntry;
+    uint8_t status;
+    struct
+    {
+        uint8_t type;
+        uint8_t lenSz;
+        uint8_t irqIntv;
+    } config;
+    uint16_t length;
+    uint8_t data;               // First byte of the data
+} rfc_dataEntryGeneral_t;
+
+#endif /* HOST_RF_DATA_ENTRY_H */
@@ -0,0 +1,18 @@
+#ifndef HOST_RF_HS_CMD_H
+#define HOST_RF_HS_CMD_H
+
+#include "rf_common_cmd.h"
+
+/* Host stand-in for the high speed mode commands, declared by the settings only */
+
+typedef struct
+{
+    RFC_RADIO_OP_HEADER
+} rfc_CMD_HS_TX_t;
+
+typedef struct
+{
+    RFC_RADIO_OP_HEADER
+} rfc_CMD_HS_RX_t;
+
+#endif /* HOST_RF_HS_CMD_H */
@@ -0,0 +1,8 @@
+#ifndef HOST_RF_HS_MAILBOX_H
+#define HOST_RF_HS_MAILBOX_H
+
+#include "rf_mailbox.h"
+
+/* Host stand-in for the high speed mode mailbox, nothing of it is used */
+
+#endif /* HOST_RF_HS_MAILBOX_H */
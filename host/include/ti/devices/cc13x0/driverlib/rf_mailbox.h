@@ -0,0 +1,52 @@
+#ifndef HOST_RF_MAILBOX_H
+#define HOST_RF_MAILBOX_H
+
+#include <stdint.h>
+
+/* Host stand-in for the RF core mailbox definitions, values as on the CC13x0 */
+
+/* Radio operation status */
+#define IDLE                    0x0000
+#define PENDING                 0x0001
+#define ACTIVE                  0x0002
+#define SKIPPED                 0x0003
+#define DONE_OK                 0x0400
+#define DONE_STOPPED            0x0405
+#define DONE_ABORT              0x0406
+#define ERROR_PAST_START        0x0800
+
+/* Trigger types */
+#define TRIG_NOW                0
+#define TRIG_NEVER              1
+#define TRIG_ABSTIME            2
+#define TRIG_REL_SUBMIT         3
+#define TRIG_REL_START          4
+#define TRIG_REL_PREVSTART      5
+#define TRIG_REL_FIRST_START    6
+#define TRIG_REL_PREVEND        7
+#define TRIG_REL_EVT1           8
+#define TRIG_REL_EVT2           9
+#define TRIG_EXTERNAL           10
+
+/* Rules for the next operation */
+#define COND_ALWAYS             0
+#define COND_NEVER              1
+#define COND_STOP_ON_FALSE      2
+#define COND_STOP_ON_TRUE       3
+#define COND_SKIP_ON_FALSE      4
+#define COND_SKIP_ON_TRUE       5
+
+/* Command status of direct and immediate commands */
+#define CMDSTA_Pending          0x00
+#define CMDSTA_Done             0x01
+
+typedef uint32_t ratmr_t;
+
+/* Queue of data entries, see rf_data_entry.h */
+typedef struct
+{
+    uint8_t* pCurrEntry;        // Entry the RF core is using or will use next
+    uint8_t* pLastEntry;        // Last entry, NULL for a circular queue
+} dataQueue_t;
+
+#endif /* HOST_RF_MAILBOX_H */
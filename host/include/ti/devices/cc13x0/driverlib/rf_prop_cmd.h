@@ -0,0 +1,198 @@
+#ifndef HOST_RF_PROP_CMD_H
+#define HOST_RF_PROP_CMD_H
+
+#include <stdint.h>
+
+#include "rf_mailbox.h"
+#include "rf_common_cmd.h"
+
+/*
+ * Host stand-in for the RF core's proprietary mode commands, with the fields
+ * the firmware and the fake RF core use. Flags are bytes, not bit fields.
+ */
+
+#define CMD_PROP_TX             0x3801
+#define CMD_PROP_RX             0x3802
+#define CMD_PROP_TX_ADV         0x3803
+#define CMD_PROP_RX_ADV         0x3804
+#define CMD_PROP_CS             0x3805
+#define CMD_PROP_RADIO_SETUP    0x3806
+#define CMD_PROP_RADIO_DIV_SETUP 0x3807
+
+#define RFC_PROP_RADIO_SETUP_FIELDS \
+    struct \
+    { \
+        uint8_t modType; \
+        uint16_t deviation; \
+    } modulation; \
+    struct \
+    { \
+        uint16_t preScale; \
+        uint32_t rateWord; \
+    } symbolRate; \
+    uint8_t rxBw; \
+    struct \
+    { \
+        uint8_t nPreamBytes; \
+        uint8_t preamMode; \
+    } preamConf; \
+    struct \
+    { \
+        uint8_t nSwBits; \
+        uint8_t bBitReversal; \
+        uint8_t bMsbFirst; \
+        uint8_t fecMode; \
+        uint8_t whitenMode; \
+    } formatConf; \
+    struct \
+    { \
+        uint8_t frontEndMode; \
+        uint8_t biasMode; \
+    } config; \
+    uint16_t txPower; \
+    uint32_t* pRegOverride;
+
+typedef struct
+{
+    RFC_RADIO_OP_HEADER
+    RFC_PROP_RADIO_SETUP_FIELDS
+} rfc_CMD_PROP_RADIO_SETUP_t;
+
+/* Starts like rfc_CMD_PROP_RADIO_SETUP_t */
+typedef struct
+{
+    RFC_RADIO_OP_HEADER
+    RFC_PROP_RADIO_SETUP_FIELDS
+    uint16_t centerFreq;
+    int16_t intFreq;
+    uint8_t loDivider;
+} rfc_CMD_PROP_RADIO_DIV_SETUP_t;
+
+typedef struct
+{
+    RFC_RADIO_OP_HEADER
+    struct
+    {
+        uint8_t bFsOff;
+        uint8_t bUseCrc;
+        uint8_t bVarLen;
+    } pktConf;
+    uint8_t pktLen;
+    uint32_t syncWord;
+    uint8_t* pPkt;
+} rfc_CMD_PROP_TX_t;
+
+typedef struct
+{
+    RFC_RADIO_OP_HEADER
+    struct
+    {
+        uint8_t bFsOff;
+        uint8_t bRepeatOk;
+        uint8_t bRepeatNok;
+        uint8_t bUseCrc;
+        uint8_t bVarLen;
+        uint8_t bChkAddress;
+        uint8_t endType;
+        uint8_t filterOp;
+    } pktConf;
+    struct
+    {
+        uint8_t bAutoFlushIgnored;
+        uint8_t bAutoFlushCrcErr;
+        uint8_t bIncludeHdr;
+        uint8_t bIncludeCrc;
+        uint8_t bAppendRssi;
+        uint8_t bAppendTimestamp;
+        uint8_t bAppendStatus;
+    } rxConf;
+    uint32_t syncWord;
+    uint8_t maxPktLen;
+    uint8_t address0;
+    uint8_t address1;
+    rfc_trigger_t endTrigger;
+    ratmr_t endTime;
+    dataQueue_t* pQueue;
+    uint8_t* pOutput;
+} rfc_CMD_PROP_RX_t;
+
+typedef struct
+{
+    RFC_RADIO_OP_HEADER
+    struct
+    {
+        uint8_t bFsOff;
+        uint8_t bRepeatOk;
+        uint8_t bRepeatNok;
+        uint8_t bUseCrc;
+        uint8_t bCrcIncSw;
+        uint8_t bCrcIncHdr;
+        uint8_t endType;
+        uint8_t filterOp;       // 1: packets not matching the address are received anyway
+    } pktConf;
+    struct
+    {
+        uint8_t bAutoFlushIgnored;
+        uint8_t bAutoFlushCrcErr;
+        uint8_t bIncludeHdr;
+        uint8_t bIncludeCrc;
+        uint8_t bAppendRssi;
+        uint8_t bAppendTimestamp;
+        uint8_t bAppendStatus;
+    } rxConf;
+    uint32_t syncWord0;
+    uint32_t syncWord1;
+    uint16_t maxPktLen;
+    struct
+    {
+        uint8_t numHdrBits;
+        uint8_t lenPos;
+        uint8_t numLenBits;
+    } hdrConf;
+    struct
+    {
+        uint8_t addrType;
+        uint8_t addrSize;
+        uint8_t addrPos;
+        uint8_t numAddr;
+    } addrConf;
+    int8_t lenOffset;
+    rfc_trigger_t endTrigger;
+    ratmr_t endTime;
+    uint8_t* pAddr;
+    dataQueue_t* pQueue;
+    uint8_t* pOutput;
+} rfc_CMD_PROP_RX_ADV_t;
+
+typedef struct
+{
+    RFC_RADIO_OP_HEADER
+    struct
+    {
+        uint8_t bFsOffIdle;
+        uint8_t bFsOffBusy;
+    } csFsConf;
+    uint8_t __dummy0;
+    struct
+    {
+        uint8_t bEnaRssi;
+        uint8_t bEnaCorr;
+        uint8_t operation;
+        uint8_t busyOp;         // 1: ends as soon as the channel is busy
+        uint8_t idleOp;         // 1: ends as soon as the channel is idle
+        uint8_t timeoutRes;
+    } csConf;
+    int8_t rssiThr;
+    uint8_t numRssiIdle;
+    uint8_t numRssiBusy;
+    uint16_t corrPeriod;
+    struct
+    {
+        uint8_t numCorrInv;
+        uint8_t numCorrBusy;
+    } corrConfig;
+    rfc_trigger_t csEndTrigger;
+    ratmr_t csEndTime;
+} rfc_CMD_PROP_CS_t;
+
+#endif /* HOST_RF_PROP_CMD_H */
@@ -0,0 +1,42 @@
+#ifndef HOST_RF_PROP_MAILBOX_H
+#define HOST_RF_PROP_MAILBOX_H
+
+#include <stdint.h>
+
+#include "rf_mailbox.h"
+
+/* Host stand-in for the proprietary mode mailbox definitions */
+
+/* Status of the proprietary radio operations */
+#define PROP_DONE_OK            0x3400
+#define PROP_DONE_RXTIMEOUT     0x3401
+#define PROP_DONE_BREAK         0x3402
+#define PROP_DONE_ENDED         0x3403
+#define PROP_DONE_STOPPED       0x3404
+#define PROP_DONE_ABORT         0x3405
+#define PROP_DONE_RXERR         0x3406
+#define PROP_DONE_IDLE          0x3407
+#define PROP_DONE_BUSY          0x3408
+#define PROP_DONE_IDLETIMEOUT   0x3409
+#define PROP_DONE_BUSYTIMEOUT   0x340A
+#define PROP_ERROR_PAR          0x3800
+#define PROP_ERROR_RXBUF        0x3801
+#define PROP_ERROR_RXFULL       0x3802
+#define PROP_ERROR_NO_SETUP     0x3803
+#define PROP_ERROR_NO_FS        0x3804
+#define PROP_ERROR_RXOVF        0x3805
+#define PROP_ERROR_TXUNF        0x3806
+
+/* Rx counters written to pOutput of CMD_PROP_RX_ADV */
+typedef struct
+{
+    uint16_t nRxOk;             // Packets received with a good CRC
+    uint16_t nRxNok;            // Packets received with a CRC error
+    uint8_t nRxIgnored;         // Packets not matching the address filter
+    uint8_t nRxStopped;         // Packets not received for lack of Rx buffer space
+    uint8_t nRxBufFull;         // Packets that found no data entry
+    int8_t lastRssi;            // RSSI of the last packet
+    ratmr_t timeStamp;          // Time of the last packet
+} rfc_propRxOutput_t;
+
+#endif /* HOST_RF_PROP_MAILBOX_H */
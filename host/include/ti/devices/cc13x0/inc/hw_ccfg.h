@@ -0,0 +1,6 @@
+#ifndef HOST_HW_CCFG_H
+#define HOST_HW_CCFG_H
+
+/* Host stand-in, EasyLink.c includes it but uses nothing of it */
+
+#endif /* HOST_HW_CCFG_H */
@@ -0,0 +1,162 @@
+#ifndef HOST_RF_H
+#define HOST_RF_H
+
+#include <stdint.h>
+//EasyLink.c gets memcpy and memset through the SDK headers
+#include <string.h>
+
+#include <ti/devices/DeviceFamily.h>
+#include DeviceFamily_constructPath(driverlib/rf_common_cmd.h)
+#include DeviceFamily_constructPath(driverlib/rf_prop_cmd.h)
+
+/*
+ * Host stand-in for the RF driver header. The types let the host tests and
+ * tools include EasyLink.h for its constants and macros. The functions are
+ * only implemented by the fake RF core in host/fakerf, which runs the
+ * firmware's EasyLink.c; nothing else may call them.
+ */
+
+typedef rfc_radioOp_t RF_Op;
+
+/* The fake keeps the state of its single client itself */
+typedef struct RF_Object_s
+{
+    uint32_t opened;
+} RF_Object;
+
+typedef struct RF_Object_s* RF_Handle;
+typedef int16_t RF_CmdHandle;
+typedef uint64_t RF_EventMask;
+typedef uint32_t RF_ClientEventMask;
+
+#define RF_ALLOC_ERROR          ((RF_CmdHandle)-2)
+#define RF_SCHEDULE_CMD_ERROR   ((RF_CmdHandle)-3)
+
+/* Events of a command, as in the TI driver */
+#define RF_EventCmdDone         ((RF_EventMask)1 << 0)
+#define RF_EventLastCmdDone     ((RF_EventMask)1 << 1)
+#define RF_EventTxDone          ((RF_EventMask)1 << 4)
+#define RF_EventRxOk            ((RF_EventMask)1 << 16)
+#define RF_EventRxNOk           ((RF_EventMask)1 << 17)
+#define RF_EventRxIgnored       ((RF_EventMask)1 << 18)
+#define RF_EventRxEmpty         ((RF_EventMask)1 << 19)
+#define RF_EventRxBufFull       ((RF_EventMask)1 << 22)
+#define RF_EventRxEntryDone     ((RF_EventMask)1 << 23)
+#define RF_EventCmdPreempted    ((RF_EventMask)1 << 57)
+#define RF_EventCmdCancelled    ((RF_EventMask)1 << 60)
+#define RF_EventCmdAborted      ((RF_EventMask)1 << 61)
+#define RF_EventCmdStopped      ((RF_EventMask)1 << 62)
+
+typedef void (*RF_Callback)(RF_Handle h, RF_CmdHandle ch, RF_EventMask e);
+typedef void (*RF_ClientCallback)(RF_Handle h, RF_ClientEventMask events, void* arg);
+
+typedef enum
+{
+    RF_PriorityHighest = 2,
+    RF_PriorityHigh = 1,
+    RF_PriorityNormal = 0
+} RF_Priority;
+
+typedef enum
+{
+    RF_StatBusyError,
+    RF_StatRadioInactiveError,
+    RF_StatCmdDoneError,
+    RF_StatInvalidParamsError,
+    RF_StatCmdEnded,
+    RF_StatError = 0x80,
+    RF_StatCmdDoneSuccess,
+    RF_StatCmdSch,
+    RF_StatSuccess
+} RF_Stat;
+
+#define RF_MODE_PROPRIETARY_SUB_1   0x05
+#define RF_MODE_MULTIPLE            0xFF
+
+typedef struct
+{
+    uint8_t rfMode;
+    void (*cpePatchFxn)(void);
+    void (*mcePatchFxn)(void);
+    void (*rfePatchFxn)(void);
+} RF_Mode;
+
+typedef union
+{
+    rfc_command_t commandId;
+    rfc_CMD_PROP_RADIO_SETUP_t prop;
+    rfc_CMD_PROP_RADIO_DIV_SETUP_t prop_div;
+} RF_RadioSetup;
+
+typedef struct
+{
+    uint32_t nInactivityTimeout;
+    uint32_t nPowerUpDuration;
+    RF_ClientCallback pClientEventCb;
+    RF_ClientEventMask nClientEventMask;
+} RF_Params;
+
+typedef struct
+{
+    uint32_t endTime;
+    RF_Priority priority;
+} RF_ScheduleCmdParams;
+
+/* Tx power, rawValue is the txPower field of the setup command */
+#define RF_TxPowerTable_MIN_DBM         -128
+#define RF_TxPowerTable_MAX_DBM         126
+#define RF_TxPowerTable_INVALID_DBM     127
+#define RF_TxPowerTable_INVALID_VALUE   0x3fffff
+
+typedef enum
+{
+    RF_TxPowerTable_DefaultPA = 0,
+    RF_TxPowerTable_HighPA = 1
+} RF_TxPowerTable_PAType;
+
+typedef struct
+{
+    uint32_t rawValue;
+    RF_TxPowerTable_PAType paType;
+} RF_TxPowerTable_Value;
+
+typedef struct
+{
+    int8_t power;
+    RF_TxPowerTable_Value value;
+} RF_TxPowerTable_Entry;
+
+#define RF_TxPowerTable_DEFAULT_PA_ENTRY(bias, gain, boost, coefficient) \
+    { .rawValue = ((bias) << 0) | ((gain) << 6) | ((boost) << 8) | ((coefficient) << 9), \
+      .paType = RF_TxPowerTable_DefaultPA }
+
+#define RF_TxPowerTable_TERMINATION_ENTRY \
+    { .power = RF_TxPowerTable_INVALID_DBM, \
+      .value = { .rawValue = RF_TxPowerTable_INVALID_VALUE, .paType = RF_TxPowerTable_DefaultPA } }
+
+void RF_Params_init(RF_Params* params);
+RF_Handle RF_open(RF_Object* pObj, RF_Mode* pRfMode, RF_RadioSetup* pRadioSetup,
+        RF_Params* params);
+void RF_close(RF_Handle h);
+
+RF_CmdHandle RF_postCmd(RF_Handle h, RF_Op* pOp, RF_Priority ePri, RF_Callback pCb,
+        RF_EventMask bmEvent);
+RF_CmdHandle RF_scheduleCmd(RF_Handle h, RF_Op* pOp, RF_ScheduleCmdParams* pSchParams,
+        RF_Callback pCb, RF_EventMask bmEvent);
+RF_EventMask RF_pendCmd(RF_Handle h, RF_CmdHandle ch, RF_EventMask bmEvent);
+RF_EventMask RF_runCmd(RF_Handle h, RF_Op* pOp, RF_Priority ePri, RF_Callback pCb,
+        RF_EventMask bmEvent);
+RF_Stat RF_cancelCmd(RF_Handle h, RF_CmdHandle ch, uint8_t mode);
+RF_Stat RF_runImmediateCmd(RF_Handle h, uint32_t* pCmdStruct);
+RF_Op* RF_getCmdOp(RF_Handle h, RF_CmdHandle cmdHnd);
+
+uint32_t RF_getCurrentTime(void);
+int8_t RF_getRssi(RF_Handle h);
+
+RF_Stat RF_setTxPower(RF_Handle h, RF_TxPowerTable_Value value);
+RF_TxPowerTable_Value RF_getTxPower(RF_Handle h);
+RF_TxPowerTable_Value RF_TxPowerTable_findValue(RF_TxPowerTable_Entry table[], int8_t powerLevel);
+int8_t RF_TxPowerTable_findPowerLevel(RF_TxPowerTable_Entry table[],
+        RF_TxPowerTable_Value value);
+
+#endif /* HOST_RF_H */
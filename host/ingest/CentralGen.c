@@ -0,0 +1,151 @@
+/*
+ *  ======== CentralGen.c ========
+ */
+#include <string.h>
+
+#include "CentralGen.h"
+
+/***** Function definitions *****/
+
+static void putUint32(uint8_t* p, uint32_t value) {
+    p[0] = (uint8_t)(value);
+    p[1] = (uint8_t)(value >> 8);
+    p[2] = (uint8_t)(value >> 16);
+    p[3] = (uint8_t)(value >> 24);
+}
+
+/* As fillMemStack in the central's main.c */
+static char* putDigits(char* a, uint8_t n) {
+    a[2] = n % 10 + '0';
+    n = n / 10;
+    a[1] = n % 10 + '0';
+    a[0] = n / 10 + '0';
+
+    return a + 3;
+}
+
+/* As formatUplink in the central's main.c, returns the record's size */
+static uint16_t formatUplink(uint8_t* out, const uint8_t* payload, uint8_t len) {
+    Uplink_Decoder decoder;
+    Uplink_Measure m;
+    char* p = (char*)out;
+
+    Uplink_decoderInit(&decoder, payload, len);
+    p = putDigits(p, decoder.apId);
+    *p++ = ';';
+    while(Uplink_decodeNext(&decoder, &m)) {
+        p = putDigits(p, m.id);
+        *p++ = ';';
+        p = putDigits(p, m.rssi);
+        *p++ = ';';
+        p = putDigits(p, (uint8_t)(m.delta >> 8));
+        p = putDigits(p, (uint8_t)(m.delta & 0xFF));
+        *p++ = ';';
+        if(decoder.flags & UPLINK_FLAG_RSSI_STATS) {
+            p = putDigits(p, m.rssiMin);
+            *p++ = ';';
+            p = putDigits(p, m.rssiMax);
+            *p++ = ';';
+            p = putDigits(p, m.rssiVariance);
+            *p++ = ';';
+        }
+        if(decoder.flags & UPLINK_FLAG_DISTANCE) {
+            p = putDigits(p, (uint8_t)(m.distance >> 8));
+            p = putDigits(p, (uint8_t)(m.distance & 0xFF));
+            *p++ = ';';
+        }
+        if(decoder.flags & UPLINK_FLAG_BEACON_LOSS) {
+            p = putDigits(p, m.beacons);
+            *p++ = ';';
+            p = putDigits(p, m.beaconsLost);
+            *p++ = ';';
+        }
+    }
+    *p++ = '.';
+
+    return (uint16_t)(p - (char*)out);
+}
+
+void CentralGen_init(CentralGen* gen, uint8_t aps, uint8_t tags, uint8_t format) {
+    memset(gen, 0, sizeof(*gen));
+    gen->format = format;
+    gen->aps = (aps == 0) ? 1 : (aps > CENTRALGEN_MAX_APS) ? CENTRALGEN_MAX_APS : aps;
+    gen->tags = (tags > UPLINK_PACKED_MAX_MEASURES) ? UPLINK_PACKED_MAX_MEASURES : tags;
+}
+
+uint16_t CentralGen_start(CentralGen* gen, uint8_t* out) {
+    out[0] = 'y';
+    gen->bytes++;
+
+    return 1;
+}
+
+uint16_t CentralGen_report(CentralGen* gen, uint8_t* out, uint32_t time,
+        Uplink_Measure* measures, uint8_t* count) {
+    Uplink_Measure taken[UPLINK_PACKED_MAX_MEASURES];
+    uint8_t payload[EASYLINK_MAX_DATA_LENGTH];
+    uint8_t rxTime[UART_FRAME_RX_TIME_SIZE];
+    Uplink_Measure* m;
+    uint8_t apId = gen->nextAp + 1;
+    uint8_t encoded;
+    uint8_t len;
+    uint8_t far;
+    uint16_t size;
+    uint8_t i;
+
+    for(i = 0; i < gen->tags; i++) {
+        m = &taken[i];
+        far = (uint8_t)((apId > i + 1) ? apId - (i + 1) : (i + 1) - apId);
+        m->id = i + 1;
+        m->rssi = (uint8_t)(40 + 3 * far);
+        m->delta = (uint16_t)((gen->reports + i) % (CENTRALGEN_MAX_DELTA + 1));
+        m->rssiMin = m->rssi - 2;
+        m->rssiMax = m->rssi + 2;
+        m->rssiVariance = 1;
+        m->distance = (uint16_t)(100 * far + 50);
+        m->beacons = 10;
+        m->beaconsLost = (uint8_t)(i % 2);
+    }
+
+    len = Uplink_encode(payload, apId, CENTRALGEN_FLAGS, gen->apSeq[gen->nextAp]++,
+            NULL, taken, gen->tags, &encoded);
+    if(gen->format == INGEST_FORMAT_TEXT) {
+        size = formatUplink(out, payload, len);
+    } else {
+        putUint32(rxTime, time);
+        size = UartFrame_encodePrefixed(out, UART_FRAME_TYPE_AP_REPORT_TIMED,
+                gen->frameSeq++, rxTime, sizeof(rxTime), payload, len);
+    }
+
+    if(measures != NULL) {
+        memcpy(measures, taken, encoded * sizeof(Uplink_Measure));
+    }
+    if(count != NULL) {
+        *count = encoded;
+    }
+
+    gen->nextAp = (uint8_t)((gen->nextAp + 1) % gen->aps);
+    gen->reports++;
+    gen->bytes += size;
+
+    return size;
+}
+
+uint16_t CentralGen_status(CentralGen* gen, uint8_t* out) {
+    uint8_t status[UART_FRAME_STATUS_SIZE];
+    uint16_t size;
+
+    if(gen->format == INGEST_FORMAT_TEXT) {
+        return 0;
+    }
+
+    putUint32(&status[0], gen->reports);
+    putUint32(&status[4], 0);
+    putUint32(&status[8], gen->bytes);
+    putUint32(&status[12], 0);
+    size = UartFrame_encode(out, UART_FRAME_TYPE_STATUS, gen->statusSeq++,
+            status, sizeof(status));
+    gen->bytes += size;
+
+    return size;
+}
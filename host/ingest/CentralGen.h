@@ -0,0 +1,58 @@
+#ifndef CENTRALGEN_H
+#define CENTRALGEN_H
+
+#include <stdint.h>
+
+#include "Ingest.h"
+#include "UartFrame.h"
+#include "Uplink.h"
+
+/*
+ * Stand-in for the central's UART output, to test the ingest without boards.
+ * It writes the same bytes as uartFnx and rxDoneCb in AP_central_RxUart/main.c:
+ * the 'y' sent once the UART is open, then in INGEST_FORMAT_BINARY
+ * UART_FRAME_TYPE_AP_REPORT_TIMED frames of packed uplinks, made with the
+ * firmware's UartFrame.c and Uplink.c, and status frames. In
+ * INGEST_FORMAT_TEXT, the central's default, each uplink is the record
+ * formatUplink writes from it, ended by '.', and there are no status frames.
+ *
+ * Every AP hears every tag, the RSSI grows with the distance between their
+ * ids and the delta times cycle over 0..CENTRALGEN_MAX_DELTA.
+ */
+
+#define CENTRALGEN_MAX_APS      16
+#define CENTRALGEN_MAX_DELTA    4
+#define CENTRALGEN_FLAGS        (UPLINK_FLAG_RSSI_STATS | UPLINK_FLAG_DISTANCE | \
+        UPLINK_FLAG_BEACON_LOSS | UPLINK_FLAG_PACKED)
+#define CENTRALGEN_MAX_REPORT_SIZE  (INGEST_TEXT_MAX_SIZE + 1) // Either format
+
+typedef struct
+{
+    uint8_t format;             // INGEST_FORMAT_*
+    uint8_t aps;
+    uint8_t tags;
+    uint8_t nextAp;
+    uint8_t frameSeq;
+    uint8_t statusSeq;
+    uint8_t apSeq[CENTRALGEN_MAX_APS];
+    uint32_t reports;
+    uint32_t bytes;
+} CentralGen;
+
+void CentralGen_init(CentralGen* gen, uint8_t aps, uint8_t tags, uint8_t format);
+
+/* Writes the byte the central sends once its UART is open, returns 1 */
+uint16_t CentralGen_start(CentralGen* gen, uint8_t* out);
+
+/*
+ * Writes the timed report of the next AP's uplink, received at radio time
+ * time, or its text record, and returns its size. The measures sent, count
+ * of them, are copied to measures if it is not NULL.
+ */
+uint16_t CentralGen_report(CentralGen* gen, uint8_t* out, uint32_t time,
+        Uplink_Measure* measures, uint8_t* count);
+
+/* Writes a status frame and returns its size, 0 in text */
+uint16_t CentralGen_status(CentralGen* gen, uint8_t* out);
+
+#endif /* CENTRALGEN_H */
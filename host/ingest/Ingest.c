@@ -0,0 +1,304 @@
+/*
+ *  ======== Ingest.c ========
+ */
+#include <string.h>
+
+#include "Ingest.h"
+
+/***** Defines *****/
+
+#define RAT_NS_PER_TICK     250
+#define RAT_WRAP            ((uint64_t)1 << 32)
+#define TEXT_MAX_FIELDS     9       // Of a measure, with every flag
+#define TEXT_FLAG_SETS      8
+
+/***** Variable declarations *****/
+
+/* Flags the text records may have been written with, most likely first */
+static const uint8_t textFlagSets[TEXT_FLAG_SETS] = {
+    INGEST_TEXT_FLAGS,
+    0,
+    UPLINK_FLAG_RSSI_STATS,
+    UPLINK_FLAG_DISTANCE,
+    UPLINK_FLAG_BEACON_LOSS,
+    UPLINK_FLAG_RSSI_STATS | UPLINK_FLAG_DISTANCE,
+    UPLINK_FLAG_RSSI_STATS | UPLINK_FLAG_BEACON_LOSS,
+    UPLINK_FLAG_DISTANCE | UPLINK_FLAG_BEACON_LOSS
+};
+
+/***** Function definitions *****/
+
+void Ingest_deviceInit(IngestDevice* device, uint8_t index, uint8_t format) {
+    memset(device, 0, sizeof(*device));
+    device->index = index;
+    device->format = format;
+    UartFrame_decoderInit(&device->decoder);
+}
+
+uint64_t Ingest_unwrapTime(IngestClock* clock, uint32_t time, uint64_t hostNs) {
+    uint64_t elapsed;
+    uint32_t delta;
+    uint64_t wraps;
+
+    if(!clock->started) {
+        clock->started = 1;
+        clock->time = time;
+    } else {
+        //The serial link keeps the order, time only moves forward. Whole
+        //wraps are those the host clock saw on top of the forward difference
+        delta = time - clock->last;
+        elapsed = (hostNs - clock->hostNs) / RAT_NS_PER_TICK;
+        wraps = (elapsed > delta) ? (elapsed - delta + RAT_WRAP / 2) / RAT_WRAP : 0;
+        clock->time += delta + wraps * RAT_WRAP;
+    }
+    clock->last = time;
+    clock->hostNs = hostNs;
+
+    return clock->time;
+}
+
+static uint32_t feedReport(IngestDevice* device, UartReport_ApReport* ap,
+        uint64_t hostNs, Ingest_RecordFxn recordFxn, void* arg) {
+    IngestRecord record;
+    uint32_t dropped = 0;
+
+    device->stats.reports++;
+    record.hostNs = hostNs;
+    record.rxTime = Ingest_unwrapTime(&device->clock, ap->rxTime, hostNs);
+    record.device = device->index;
+    record.apId = ap->uplink.apId;
+    record.flags = ap->uplink.flags;
+    record.uplinkSeq = ap->uplink.seq;
+
+    while(Uplink_decodeNext(&ap->uplink, &record.measure)) {
+        record.time = (int64_t)record.rxTime - (int64_t)record.measure.delta *
+                INGEST_DELTA_TIME_UNIT_MS * INGEST_RAT_TICKS_PER_MS;
+        device->stats.records++;
+        if(!recordFxn(arg, &record)) {
+            dropped++;
+        }
+    }
+
+    return dropped;
+}
+
+/* Widths of the fields of a measure written with flags, returns how many */
+static uint8_t textWidths(uint8_t flags, uint8_t* widths) {
+    uint8_t n = 0;
+
+    widths[n++] = 3;            // id
+    widths[n++] = 3;            // rssi
+    widths[n++] = 6;            // delta, a byte in three digits each
+    if(flags & UPLINK_FLAG_RSSI_STATS) {
+        widths[n++] = 3;
+        widths[n++] = 3;
+        widths[n++] = 3;
+    }
+    if(flags & UPLINK_FLAG_DISTANCE) {
+        widths[n++] = 6;
+    }
+    if(flags & UPLINK_FLAG_BEACON_LOSS) {
+        widths[n++] = 3;
+        widths[n++] = 3;
+    }
+
+    return n;
+}
+
+/* Reads a field of width digits and its ';', returns -1 if it is not one */
+static int32_t textField(const char* text, uint16_t len, uint16_t* pos, uint8_t width) {
+    int32_t value = 0;
+    int32_t part = 0;
+    uint8_t i;
+
+    if(*pos + width + 1 > len || text[*pos + width] != ';') {
+        return -1;
+    }
+    //Three digits per byte as fillMemStack writes them
+    for(i = 0; i < width; i++) {
+        if(text[*pos + i] < '0' || text[*pos + i] > '9') {
+            return -1;
+        }
+        part = part * 10 + (text[*pos + i] - '0');
+        if(i % 3 == 2) {
+            if(part > 255) {
+                return -1;
+            }
+            value = (value << 8) | part;
+            part = 0;
+        }
+    }
+    *pos += width + 1;
+
+    return value;
+}
+
+/*
+ * Reads the measures of a text record written with flags, or only checks
+ * them if measures is NULL. Returns how many, -1 if the fields don't fit.
+ */
+static int textMeasures(const char* text, uint16_t len, uint8_t flags,
+        Uplink_Measure* measures) {
+    uint8_t widths[TEXT_MAX_FIELDS];
+    int32_t values[TEXT_MAX_FIELDS];
+    uint8_t fields = textWidths(flags, widths);
+    uint16_t pos = 4;           // Past the AP id
+    int count = 0;
+    Uplink_Measure* m;
+    uint8_t i;
+
+    while(pos < len) {
+        for(i = 0; i < fields; i++) {
+            values[i] = textField(text, len, &pos, widths[i]);
+            if(values[i] < 0) {
+                return -1;
+            }
+        }
+        if(measures != NULL) {
+            m = &measures[count];
+            memset(m, 0, sizeof(*m));
+            i = 0;
+            m->id = (uint8_t)values[i++];
+            m->rssi = (uint8_t)values[i++];
+            m->delta = (uint16_t)values[i++];
+            if(flags & UPLINK_FLAG_RSSI_STATS) {
+                m->rssiMin = (uint8_t)values[i++];
+                m->rssiMax = (uint8_t)values[i++];
+                m->rssiVariance = (uint8_t)values[i++];
+            }
+            if(flags & UPLINK_FLAG_DISTANCE) {
+                m->distance = (uint16_t)values[i++];
+            }
+            if(flags & UPLINK_FLAG_BEACON_LOSS) {
+                m->beacons = (uint8_t)values[i++];
+                m->beaconsLost = (uint8_t)values[i++];
+            }
+        }
+        count++;
+    }
+
+    return count;
+}
+
+/* A text record up to its '.', returns the records recordFxn dropped */
+static uint32_t feedTextRecord(IngestDevice* device, uint64_t hostNs,
+        Ingest_RecordFxn recordFxn, void* arg) {
+    Uplink_Measure measures[UPLINK_PACKED_MAX_MEASURES];
+    IngestRecord record;
+    uint32_t dropped = 0;
+    uint16_t pos = 0;
+    int32_t apId;
+    int count = -1;
+    uint8_t s;
+    int i;
+
+    apId = textField(device->text, device->textLen, &pos, 3);
+    for(s = 0; s < TEXT_FLAG_SETS && apId >= 0 && count < 0; s++) {
+        count = textMeasures(device->text, device->textLen, textFlagSets[s], NULL);
+    }
+    if(apId < 0 || count < 0 || count > UPLINK_PACKED_MAX_MEASURES) {
+        device->stats.badFrames++;
+        return 0;
+    }
+    textMeasures(device->text, device->textLen, textFlagSets[s - 1], measures);
+
+    device->stats.reports++;
+    memset(&record, 0, sizeof(record));
+    record.hostNs = hostNs;
+    record.rxTime = hostNs / RAT_NS_PER_TICK;
+    record.device = device->index;
+    record.apId = (uint8_t)apId;
+    record.flags = textFlagSets[s - 1];
+    for(i = 0; i < count; i++) {
+        record.measure = measures[i];
+        record.time = (int64_t)record.rxTime - (int64_t)record.measure.delta *
+                INGEST_DELTA_TIME_UNIT_MS * INGEST_RAT_TICKS_PER_MS;
+        device->stats.records++;
+        if(!recordFxn(arg, &record)) {
+            dropped++;
+        }
+    }
+
+    return dropped;
+}
+
+static uint32_t feedText(IngestDevice* device, const uint8_t* data, uint32_t len,
+        uint64_t hostNs, Ingest_RecordFxn recordFxn, void* arg) {
+    uint32_t dropped = 0;
+    uint32_t i;
+    uint8_t c;
+
+    for(i = 0; i < len; i++) {
+        c = data[i];
+        if(c == '.') {
+            if(device->textSkip) {
+                device->stats.badFrames++;
+            } else if(device->textLen > 0) {
+                dropped += feedTextRecord(device, hostNs, recordFxn, arg);
+            }
+            device->textLen = 0;
+            device->textSkip = 0;
+        } else if((c >= '0' && c <= '9') || c == ';') {
+            if(device->textLen < INGEST_TEXT_MAX_SIZE) {
+                device->text[device->textLen++] = (char)c;
+            } else {
+                device->textSkip = 1;
+            }
+        } else {
+            //The 'y' before the first record, or noise ending a record
+            if(device->textLen > 0 || device->textSkip) {
+                device->stats.badFrames++;
+            }
+            device->textLen = 0;
+            device->textSkip = 0;
+        }
+    }
+
+    return dropped;
+}
+
+uint32_t Ingest_feed(IngestDevice* device, const uint8_t* data, uint32_t len,
+        uint64_t hostNs, Ingest_RecordFxn recordFxn, void* arg) {
+    UartFrame_Decoder* decoder = &device->decoder;
+    UartReport report;
+    uint32_t dropped = 0;
+    uint32_t i;
+
+    device->stats.bytes += len;
+    if(device->format == INGEST_FORMAT_TEXT) {
+        return feedText(device, data, len, hostNs, recordFxn, arg);
+    }
+
+    for(i = 0; i < len; i++) {
+        //Bytes before the first SOF, such as the 'y' the central sends when
+        //it starts, are skipped by the decoder
+        if(!UartFrame_decode(decoder, data[i])) {
+            continue;
+        }
+        if(UartReport_parse(&report, decoder) != 0) {
+            device->stats.badFrames++;
+            continue;
+        }
+
+        switch(report.type) {
+            case UART_FRAME_TYPE_AP_REPORT_TIMED:
+                if(device->seqSeen) {
+                    device->stats.seqGaps += (uint8_t)(report.seq - device->lastSeq - 1);
+                }
+                device->seqSeen = 1;
+                device->lastSeq = report.seq;
+                dropped += feedReport(device, &report.u.ap, hostNs, recordFxn, arg);
+                break;
+            case UART_FRAME_TYPE_STATUS:
+                device->stats.centralDrops = report.u.status.drops;
+                device->stats.otherFrames++;
+                break;
+            default:
+                //Reports without a time can't be placed on the central's clock
+                device->stats.otherFrames++;
+                break;
+        }
+    }
+
+    return dropped;
+}
@@ -0,0 +1,100 @@
+#ifndef INGEST_H
+#define INGEST_H
+
+#include <stdint.h>
+
+#include "UartReport.h"
+
+/*
+ * Host ingest of the central's UART output, in either of its formats. Each
+ * serial device has an IngestDevice that turns every measure the central
+ * reports into an IngestRecord.
+ *
+ * INGEST_FORMAT_BINARY (RFEASYLINKRX_UART_BINARY) frames the bytes and reads
+ * the UART_FRAME_TYPE_AP_REPORT_TIMED frames. The central stamps each report
+ * with its 32 bit radio time (4 MHz, wraps every ~18 minutes). It is
+ * unwrapped to 64 bits, using the host time between reports so that several
+ * wraps without a report are still counted, and each measure is dated back
+ * by its delta time. Records of the same tag from different APs can then be
+ * grouped by time window on the central's clock.
+ *
+ * INGEST_FORMAT_TEXT, the central's default, reads the records formatUplink
+ * writes, "apId;" then "id;rssi;delta;" and the optional fields of each
+ * measure, ended by '.'. They carry no flags, the fields present are told
+ * from their widths, the APs' INGEST_TEXT_FLAGS first when more than one set
+ * fits. They carry no time either: the receive time is the host time the
+ * '.' was read, in radio ticks, so text records only group among those of
+ * the same host. Bytes other than digits, ';' and '.', such as the 'y' the
+ * central sends when it starts, end a record unread.
+ */
+
+#define INGEST_FORMAT_BINARY        0
+#define INGEST_FORMAT_TEXT          1
+
+#define INGEST_RAT_TICKS_PER_MS     4000
+#define INGEST_DELTA_TIME_UNIT_MS   1000 // Must match DELTA_TIME_UNIT_MS of the APs
+#define INGEST_TEXT_FLAGS           (UPLINK_FLAG_RSSI_STATS | UPLINK_FLAG_DISTANCE | \
+        UPLINK_FLAG_BEACON_LOSS) // UPLINK_FLAGS of the APs, but for UPLINK_FLAG_PACKED
+#define INGEST_TEXT_MAX_SIZE        (4 + UPLINK_PACKED_MAX_MEASURES * 42) // A record, less its '.'
+
+typedef struct
+{
+    uint64_t hostNs;            // Host time the bytes were read
+    int64_t time;               // Central radio time the measure was taken
+    uint64_t rxTime;            // Central radio time the uplink was received
+    uint8_t device;
+    uint8_t apId;
+    uint8_t flags;              // UPLINK_FLAG_* of the uplink, fields of measure
+    uint8_t uplinkSeq;
+    Uplink_Measure measure;
+} IngestRecord;
+
+typedef struct
+{
+    uint64_t bytes;
+    uint64_t reports;
+    uint64_t records;
+    uint64_t otherFrames;       // Status, radio and link stats frames
+    uint64_t badFrames;         // Unknown type or wrong size, or a bad text record
+    uint64_t seqGaps;           // Reports lost on the serial link
+    uint32_t centralDrops;      // Reports the central dropped, from its status
+} IngestStats;
+
+typedef struct
+{
+    uint8_t started;
+    uint32_t last;              // Last radio time received
+    uint64_t time;              // last, unwrapped
+    uint64_t hostNs;            // Host time last was read
+} IngestClock;
+
+typedef struct
+{
+    uint8_t index;
+    uint8_t format;             // INGEST_FORMAT_*
+    uint8_t seqSeen;
+    uint8_t lastSeq;
+    UartFrame_Decoder decoder;
+    IngestClock clock;
+    IngestStats stats;
+    uint16_t textLen;           // Characters of the text record so far
+    uint8_t textSkip;           // Record too long, skipped up to its '.'
+    char text[INGEST_TEXT_MAX_SIZE];
+} IngestDevice;
+
+/* Called for every record, returns 0 if it was dropped */
+typedef int (*Ingest_RecordFxn)(void* arg, const IngestRecord* record);
+
+void Ingest_deviceInit(IngestDevice* device, uint8_t index, uint8_t format);
+
+/* Unwraps a 32 bit radio time received at host time hostNs */
+uint64_t Ingest_unwrapTime(IngestClock* clock, uint32_t time, uint64_t hostNs);
+
+/*
+ * Feeds len bytes read at host time hostNs to the device, recordFxn is called
+ * with every record they complete. Returns the records recordFxn dropped.
+ */
+uint32_t Ingest_feed(IngestDevice* device, const uint8_t* data, uint32_t len,
+        uint64_t hostNs, Ingest_RecordFxn recordFxn, void* arg);
+
+#endif /* INGEST_H */
@@ -0,0 +1,51 @@
+/*
+ *  ======== IngestQueue.c ========
+ */
+#include "IngestQueue.h"
+
+/***** Function definitions *****/
+
+int IngestQueue_init(IngestQueue* queue, IngestRecord* records, uint32_t size) {
+    if(size == 0 || (size & (size - 1)) != 0) {
+        return -1;
+    }
+
+    queue->records = records;
+    queue->size = size;
+    atomic_init(&queue->head, 0);
+    atomic_init(&queue->tail, 0);
+    atomic_init(&queue->drops, 0);
+
+    return 0;
+}
+
+int IngestQueue_push(IngestQueue* queue, const IngestRecord* record) {
+    uint32_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    uint32_t head = atomic_load_explicit(&queue->head, memory_order_acquire);
+
+    if(tail - head == queue->size) {
+        atomic_fetch_add_explicit(&queue->drops, 1, memory_order_relaxed);
+        return 0;
+    }
+
+    queue->records[tail & (queue->size - 1)] = *record;
+    //Publishes the record before the consumer can see the new tail
+    atomic_store_explicit(&queue->tail, tail + 1, memory_order_release);
+
+    return 1;
+}
+
+int IngestQueue_pop(IngestQueue* queue, IngestRecord* record) {
+    uint32_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+
+    if(head == tail) {
+        return 0;
+    }
+
+    *record = queue->records[head & (queue->size - 1)];
+    //Hands the slot back only once it has been copied out
+    atomic_store_explicit(&queue->head, head + 1, memory_order_release);
+
+    return 1;
+}
@@ -0,0 +1,33 @@
+#ifndef INGESTQUEUE_H
+#define INGESTQUEUE_H
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+#include "Ingest.h"
+
+/*
+ * Lock-free queue of ingest records between one reader thread (push) and one
+ * sink thread (pop). Like RingBuffer on the central the producer never waits:
+ * a push to a full queue is dropped and counted.
+ */
+
+typedef struct
+{
+    IngestRecord* records;
+    uint32_t size;              // Power of two
+    _Atomic uint32_t head;      // Next record to pop, written by the consumer
+    _Atomic uint32_t tail;      // Next record to push, written by the producer
+    _Atomic uint32_t drops;
+} IngestQueue;
+
+/* size must be a power of two, returns -1 if it is not */
+int IngestQueue_init(IngestQueue* queue, IngestRecord* records, uint32_t size);
+
+/* Returns 0 and counts a drop if the queue is full */
+int IngestQueue_push(IngestQueue* queue, const IngestRecord* record);
+
+/* Returns 0 if the queue is empty */
+int IngestQueue_pop(IngestQueue* queue, IngestRecord* record);
+
+#endif /* INGESTQUEUE_H */
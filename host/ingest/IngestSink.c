@@ -0,0 +1,167 @@
+/*
+ *  ======== IngestSink.c ========
+ */
+//ftruncate and the shm functions are not C99
+#define _DEFAULT_SOURCE
+
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "IngestSink.h"
+
+/***** Type declarations *****/
+
+typedef struct
+{
+    FILE* file;
+    int closeFile;
+} CsvSink;
+
+typedef struct
+{
+    IngestSink_ShmHeader* header;
+    IngestRecord* records;
+    size_t mapSize;
+    uint64_t written;
+} ShmSink;
+
+/***** Function definitions *****/
+
+static int csvWrite(void* ctx, const IngestRecord* record) {
+    CsvSink* csv = ctx;
+    const Uplink_Measure* m = &record->measure;
+
+    fprintf(csv->file, "%" PRIu64 ",%u,%u,%u,%u,-%u,%" PRId64 ",%" PRIu64 ",%u",
+            record->hostNs, record->device, record->apId, record->uplinkSeq,
+            m->id, m->rssi, record->time, record->rxTime, m->delta);
+
+    //Fields the uplink didn't carry are left empty
+    if(record->flags & UPLINK_FLAG_RSSI_STATS) {
+        fprintf(csv->file, ",-%u,-%u,%u", m->rssiMin, m->rssiMax, m->rssiVariance);
+    } else {
+        fputs(",,,", csv->file);
+    }
+    if(record->flags & UPLINK_FLAG_DISTANCE) {
+        fprintf(csv->file, ",%u", m->distance);
+    } else {
+        fputs(",", csv->file);
+    }
+    if(record->flags & UPLINK_FLAG_BEACON_LOSS) {
+        fprintf(csv->file, ",%u,%u\n", m->beacons, m->beaconsLost);
+    } else {
+        fputs(",,\n", csv->file);
+    }
+
+    return !ferror(csv->file);
+}
+
+static void csvFlush(void* ctx) {
+    CsvSink* csv = ctx;
+
+    fflush(csv->file);
+}
+
+static void csvClose(void* ctx) {
+    CsvSink* csv = ctx;
+
+    if(csv->closeFile) {
+        fclose(csv->file);
+    } else {
+        fflush(csv->file);
+    }
+    free(csv);
+}
+
+int IngestSink_openCsv(IngestSink* sink, FILE* file, int closeFile) {
+    CsvSink* csv = malloc(sizeof(*csv));
+
+    if(csv == NULL) {
+        return -1;
+    }
+    csv->file = file;
+    csv->closeFile = closeFile;
+    fputs(INGESTSINK_CSV_HEADER, file);
+
+    sink->writeFxn = csvWrite;
+    sink->flushFxn = csvFlush;
+    sink->closeFxn = csvClose;
+    sink->ctx = csv;
+
+    return 0;
+}
+
+static int shmWrite(void* ctx, const IngestRecord* record) {
+    ShmSink* shm = ctx;
+
+    shm->records[shm->written % shm->header->size] = *record;
+    shm->written++;
+    //Readers see the count only once the record is in place
+    atomic_store_explicit(&shm->header->written, shm->written, memory_order_release);
+
+    return 1;
+}
+
+static void shmFlush(void* ctx) {
+    (void)ctx;
+}
+
+static void shmClose(void* ctx) {
+    ShmSink* shm = ctx;
+
+    //The object stays for readers until it is unlinked or the host restarts
+    munmap(shm->header, shm->mapSize);
+    free(shm);
+}
+
+int IngestSink_openShm(IngestSink* sink, const char* name, uint32_t size) {
+    ShmSink* shm;
+    void* map;
+    size_t mapSize;
+    int fd;
+
+    if(size == 0) {
+        return -1;
+    }
+
+    mapSize = sizeof(IngestSink_ShmHeader) + (size_t)size * sizeof(IngestRecord);
+    fd = shm_open(name, O_CREAT | O_RDWR, 0644);
+    if(fd < 0) {
+        return -1;
+    }
+    if(ftruncate(fd, mapSize) != 0) {
+        close(fd);
+        return -1;
+    }
+    map = mmap(NULL, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if(map == MAP_FAILED) {
+        return -1;
+    }
+
+    shm = malloc(sizeof(*shm));
+    if(shm == NULL) {
+        munmap(map, mapSize);
+        return -1;
+    }
+    shm->header = map;
+    shm->records = (IngestRecord*)(shm->header + 1);
+    shm->mapSize = mapSize;
+    shm->written = 0;
+
+    shm->header->magic = INGESTSINK_SHM_MAGIC;
+    shm->header->recordSize = sizeof(IngestRecord);
+    shm->header->size = size;
+    shm->header->reserved = 0;
+    atomic_store(&shm->header->written, 0);
+
+    sink->writeFxn = shmWrite;
+    sink->flushFxn = shmFlush;
+    sink->closeFxn = shmClose;
+    sink->ctx = shm;
+
+    return 0;
+}
@@ -0,0 +1,55 @@
+#ifndef INGESTSINK_H
+#define INGESTSINK_H
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "Ingest.h"
+
+/*
+ * Destinations of the ingest records. A sink is a set of functions on its own
+ * context, so the daemon fans every record out to any mix of them:
+ *
+ *  - CSV, one line per record to a file or stdout (see IngestSink_CSV_HEADER)
+ *  - shared memory, a POSIX shm ring other processes map and follow
+ */
+
+#define INGESTSINK_CSV_HEADER "host_ns,device,ap,uplink_seq,tag,rssi,time,rx_time," \
+        "delta,rssi_min,rssi_max,rssi_var,distance,beacons,beacons_lost\n"
+
+#define INGESTSINK_SHM_MAGIC    0x53494D49  // "SIMI"
+
+/*
+ * Start of the shared memory, followed by size records. Record n is at index
+ * n % size and is complete once written is past n, a reader that falls more
+ * than size records behind has lost the oldest ones.
+ */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t recordSize;        // sizeof(IngestRecord)
+    uint32_t size;
+    uint32_t reserved;
+    _Atomic uint64_t written;
+} IngestSink_ShmHeader;
+
+typedef struct
+{
+    int (*writeFxn)(void* ctx, const IngestRecord* record);
+    void (*flushFxn)(void* ctx);
+    void (*closeFxn)(void* ctx);
+    void* ctx;
+} IngestSink;
+
+/* Writes CSV lines to file, which is closed with the sink if closeFile */
+int IngestSink_openCsv(IngestSink* sink, FILE* file, int closeFile);
+
+/* Creates the shm object name holding size records, returns -1 on failure */
+int IngestSink_openShm(IngestSink* sink, const char* name, uint32_t size);
+
+#define IngestSink_write(sink, record) ((sink)->writeFxn((sink)->ctx, (record)))
+#define IngestSink_flush(sink) ((sink)->flushFxn((sink)->ctx))
+#define IngestSink_close(sink) ((sink)->closeFxn((sink)->ctx))
+
+#endif /* INGESTSINK_H */
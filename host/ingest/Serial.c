@@ -0,0 +1,47 @@
+/*
+ *  ======== Serial.c ========
+ */
+//cfmakeraw is not POSIX
+#define _DEFAULT_SOURCE
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "Serial.h"
+
+/***** Function definitions *****/
+
+int Serial_setRaw(int fd) {
+    struct termios tio;
+
+    if(tcgetattr(fd, &tio) != 0) {
+        return -1;
+    }
+    cfmakeraw(&tio);
+    cfsetispeed(&tio, B115200);
+    cfsetospeed(&tio, B115200);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cc[VMIN] = 1;
+    tio.c_cc[VTIME] = 0;
+
+    return tcsetattr(fd, TCSANOW, &tio) == 0 ? 0 : -1;
+}
+
+int Serial_open(const char* path, int flags) {
+    int fd = open(path, O_RDONLY | O_NOCTTY | flags);
+
+    if(fd < 0) {
+        perror(path);
+        return -1;
+    }
+
+    if(isatty(fd) && Serial_setRaw(fd) != 0) {
+        perror(path);
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
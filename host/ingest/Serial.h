@@ -0,0 +1,15 @@
+#ifndef SERIAL_H
+#define SERIAL_H
+
+/*
+ * Opens a file or serial device read only. A terminal is set to the
+ * central's UART settings, 115200 8N1 raw, see uartFnx in
+ * AP_central_RxUart/main.c. flags are added to the open flags, O_NONBLOCK
+ * for instance. Returns -1 after printing why on failure.
+ */
+int Serial_open(const char* path, int flags);
+
+/* Sets an open terminal raw at 115200, returns -1 on failure */
+int Serial_setRaw(int fd);
+
+#endif /* SERIAL_H */
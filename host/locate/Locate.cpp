@@ -0,0 +1,233 @@
+/*
+ *  ======== Locate.cpp ========
+ */
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#include "Locate.h"
+
+/***** Defines *****/
+
+#define CSV_FIELDS      15
+#define CSV_AP          2
+#define CSV_TAG         4
+#define CSV_RSSI        5
+#define CSV_TIME        6
+#define CSV_DISTANCE    12
+#define LINE_SIZE       256
+
+/***** Function definitions *****/
+
+bool Locate_parseCsv(const char* line, Locate_Record* record) {
+    const char* fields[CSV_FIELDS];
+    const char* p = line;
+    char* end;
+    long long value;
+    int n = 0;
+
+    //Splits on commas, the fields point into line
+    fields[n++] = p;
+    while(*p != '\0' && *p != '\n' && *p != '\r') {
+        if(*p == ',') {
+            if(n == CSV_FIELDS) {
+                return false;
+            }
+            fields[n++] = p + 1;
+        }
+        p++;
+    }
+    if(n != CSV_FIELDS) {
+        return false;
+    }
+
+    value = strtoll(fields[CSV_AP], &end, 10);
+    if(end == fields[CSV_AP] || *end != ',' || value < 0 || value > 255) {
+        return false;
+    }
+    record->apId = (uint8_t)value;
+
+    value = strtoll(fields[CSV_TAG], &end, 10);
+    if(end == fields[CSV_TAG] || *end != ',' || value < 0 || value > 255) {
+        return false;
+    }
+    record->tag = (uint8_t)value;
+
+    //-dBm as the sink writes it
+    value = strtoll(fields[CSV_RSSI], &end, 10);
+    if(end == fields[CSV_RSSI] || *end != ',' || value > 0 || value < -255) {
+        return false;
+    }
+    record->rssi = (uint8_t)-value;
+
+    record->time = strtoll(fields[CSV_TIME], &end, 10);
+    if(end == fields[CSV_TIME] || *end != ',') {
+        return false;
+    }
+
+    //Empty if the uplink carried no distance
+    record->hasDistance = (*fields[CSV_DISTANCE] != ',');
+    record->distance = 0;
+    if(record->hasDistance) {
+        value = strtoll(fields[CSV_DISTANCE], &end, 10);
+        if(end == fields[CSV_DISTANCE] || *end != ',' || value < 0 || value > 0xFFFF) {
+            return false;
+        }
+        record->distance = (uint16_t)value;
+    }
+
+    return true;
+}
+
+float Locate_range(const Locate_RangeModel& model, const Locate_Record& record) {
+    if(record.hasDistance) {
+        return record.distance / 100.0f;
+    }
+
+    return std::pow(10.0f, ((float)record.rssi - model.rssi1m) / (10.0f * model.pathLoss));
+}
+
+Locate_ApLayout::Locate_ApLayout() : count(0) {
+    memset(known, 0, sizeof(known));
+}
+
+bool Locate_ApLayout::load(FILE* file, std::string* error) {
+    char line[LINE_SIZE];
+    unsigned number = 0;
+    unsigned apId;
+    char* comment;
+    char extra;
+    float x;
+    float y;
+    int n;
+
+    while(fgets(line, sizeof(line), file) != NULL) {
+        number++;
+        comment = strchr(line, '#');
+        if(comment != NULL) {
+            *comment = '\0';
+        }
+        n = sscanf(line, " %u %f %f %c", &apId, &x, &y, &extra);
+        if(n == EOF) {
+            continue;
+        }
+        if(n != 3 || apId > 255) {
+            *error = "line " + std::to_string(number) + ": expected \"apId x y\"";
+            return false;
+        }
+        set((uint8_t)apId, x, y);
+    }
+
+    return true;
+}
+
+void Locate_ApLayout::set(uint8_t apId, float x, float y) {
+    if(!known[apId]) {
+        known[apId] = true;
+        count++;
+    }
+    xs[apId] = x;
+    ys[apId] = y;
+}
+
+bool Locate_ApLayout::find(uint8_t apId, float* x, float* y) const {
+    if(!known[apId]) {
+        return false;
+    }
+    *x = xs[apId];
+    *y = ys[apId];
+
+    return true;
+}
+
+Locate_Grouper::Locate_Grouper(const Locate_ApLayout& layout, int64_t windowTicks,
+        uint8_t minAps) : layout(layout), window(windowTicks),
+        minAps((minAps < 3) ? 3 : minAps) {
+    memset(tags, 0, sizeof(tags));
+}
+
+bool Locate_Grouper::add(const Locate_Record& record, float range) {
+    Tag* tag = &tags[record.tag];
+    Entry* entry = NULL;
+    float x;
+    float y;
+    uint8_t i;
+
+    if(!layout.find(record.apId, &x, &y)) {
+        return false;
+    }
+
+    for(i = 0; i < tag->count && entry == NULL; i++) {
+        if(tag->entries[i].apId == record.apId) {
+            entry = &tag->entries[i];
+        }
+    }
+    if(entry == NULL) {
+        if(tag->count < MULTILAT_MAX_APS) {
+            entry = &tag->entries[tag->count++];
+            entry->time = INT64_MIN;
+        } else {
+            //All taken, the oldest range goes
+            entry = &tag->entries[0];
+            for(i = 1; i < tag->count; i++) {
+                if(tag->entries[i].time < entry->time) {
+                    entry = &tag->entries[i];
+                }
+            }
+        }
+    }
+
+    //Uplinks of an AP can come out of order after a retry
+    if(record.time >= entry->time) {
+        entry->time = record.time;
+        entry->range = range;
+        entry->apId = record.apId;
+    }
+    tag->heard = true;
+
+    return true;
+}
+
+size_t Locate_Grouper::flush(int64_t now, Multilat_Batch& batch) {
+    Multilat_Anchor anchors[MULTILAT_MAX_APS];
+    size_t fixes = 0;
+    int64_t newest;
+    Tag* tag;
+    unsigned t;
+    uint8_t kept;
+    uint8_t i;
+
+    for(t = 0; t < LOCATE_TAGS; t++) {
+        tag = &tags[t];
+        if(!tag->heard) {
+            continue;
+        }
+        tag->heard = false;
+
+        //Ranges older than the window are dropped
+        kept = 0;
+        newest = INT64_MIN;
+        for(i = 0; i < tag->count; i++) {
+            if(tag->entries[i].time >= now - window) {
+                tag->entries[kept++] = tag->entries[i];
+                if(tag->entries[i].time > newest) {
+                    newest = tag->entries[i].time;
+                }
+            }
+        }
+        tag->count = kept;
+        if(kept < minAps) {
+            continue;
+        }
+
+        for(i = 0; i < kept; i++) {
+            layout.find(tag->entries[i].apId, &anchors[i].x, &anchors[i].y);
+            anchors[i].range = tag->entries[i].range;
+        }
+        if(batch.add((uint8_t)t, newest, anchors, kept)) {
+            fixes++;
+        }
+    }
+
+    return fixes;
+}
@@ -0,0 +1,108 @@
+#ifndef LOCATE_H
+#define LOCATE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include "Multilat.h"
+
+/*
+ * Tag fixes from the central's measure stream. Records come as the CSV lines
+ * of the ingest daemon (see IngestSink_CSV_HEADER), every measure dated on
+ * the central's radio clock. Each is turned into a range, from the distance
+ * the AP sent or else from the RSSI with the APs' path loss model (see
+ * Distance.h), and kept as the tag's latest range to that AP.
+ *
+ * Locate_Grouper::flush gathers, for every tag heard since the last flush,
+ * its ranges to the APs taken within the window before now. A tag with
+ * enough of them becomes a fix of the batch, ready for Multilat_solve.
+ */
+
+#define LOCATE_RAT_TICKS_PER_MS     4000    // As INGEST_RAT_TICKS_PER_MS
+#define LOCATE_TAGS                 256
+#define LOCATE_APS                  256
+
+typedef struct
+{
+    int64_t time;               // Central radio time the measure was taken
+    uint8_t apId;
+    uint8_t tag;
+    uint8_t rssi;               // -dBm
+    uint16_t distance;          // cm, if hasDistance
+    bool hasDistance;
+} Locate_Record;
+
+/* Reads an ingest CSV line, returns false for the header or a bad line */
+bool Locate_parseCsv(const char* line, Locate_Record* record);
+
+typedef struct
+{
+    uint8_t rssi1m;             // -dBm received at 1 m
+    float pathLoss;             // Path loss exponent n
+} Locate_RangeModel;
+
+/* The APs' default calibration, RSSI_1M and ELECTROMAGNETIC_CTE */
+#define LOCATE_RANGE_MODEL_DEFAULT {55, 2.95f}
+
+/* Range in m, the AP's distance if it sent one */
+float Locate_range(const Locate_RangeModel& model, const Locate_Record& record);
+
+class Locate_ApLayout
+{
+public:
+    Locate_ApLayout();
+
+    /*
+     * Reads "apId x y" lines, x and y in m. Blank lines and # comments are
+     * skipped. Returns false and sets error on a bad line.
+     */
+    bool load(FILE* file, std::string* error);
+
+    void set(uint8_t apId, float x, float y);
+
+    /* Returns false if the AP has no position */
+    bool find(uint8_t apId, float* x, float* y) const;
+
+    unsigned size() const { return count; }
+
+private:
+    float xs[LOCATE_APS];
+    float ys[LOCATE_APS];
+    bool known[LOCATE_APS];
+    unsigned count;
+};
+
+class Locate_Grouper
+{
+public:
+    Locate_Grouper(const Locate_ApLayout& layout, int64_t windowTicks, uint8_t minAps);
+
+    /* Keeps the range, returns false if the AP has no position */
+    bool add(const Locate_Record& record, float range);
+
+    /* Adds a fix for each tag with minAps ranges in the window, returns how many */
+    size_t flush(int64_t now, Multilat_Batch& batch);
+
+private:
+    typedef struct
+    {
+        int64_t time;
+        float range;
+        uint8_t apId;
+    } Entry;
+
+    typedef struct
+    {
+        Entry entries[MULTILAT_MAX_APS];
+        uint8_t count;
+        bool heard;             // Since the last flush
+    } Tag;
+
+    const Locate_ApLayout& layout;
+    int64_t window;
+    uint8_t minAps;
+    Tag tags[LOCATE_TAGS];
+};
+
+#endif /* LOCATE_H */
@@ -0,0 +1,247 @@
+/*
+ *  ======== Multilat.cpp ========
+ */
+#include <cmath>
+#include <thread>
+
+#include "Multilat.h"
+
+/***** Defines *****/
+
+#define MIN_RANGE       0.5f    // m, ranges below weigh as this one
+#define MIN_DET         1e-4f   // Of the normal matrix's trace squared, below the APs are collinear
+#define DAMPING         1e-3f   // Of the trace, keeps a Gauss-Newton step bounded
+
+/***** Function definitions *****/
+
+bool Multilat_Batch::add(uint8_t tag, int64_t time, const Multilat_Anchor* anchors,
+        uint8_t count) {
+    float r;
+    uint8_t k;
+
+    if(count < 3 || count > MULTILAT_MAX_APS) {
+        return false;
+    }
+
+    for(k = 0; k < MULTILAT_MAX_APS; k++) {
+        //Unused anchors sit on the first with no weight
+        if(k < count) {
+            r = (anchors[k].range > MIN_RANGE) ? anchors[k].range : MIN_RANGE;
+            ax[k].push_back(anchors[k].x);
+            ay[k].push_back(anchors[k].y);
+            range[k].push_back(anchors[k].range);
+            weight[k].push_back(1.0f / (r * r));
+        } else {
+            ax[k].push_back(anchors[0].x);
+            ay[k].push_back(anchors[0].y);
+            range[k].push_back(0);
+            weight[k].push_back(0);
+        }
+    }
+    tags.push_back(tag);
+    times.push_back(time);
+    counts.push_back(count);
+
+    return true;
+}
+
+void Multilat_Batch::clear() {
+    uint8_t k;
+
+    for(k = 0; k < MULTILAT_MAX_APS; k++) {
+        ax[k].clear();
+        ay[k].clear();
+        range[k].clear();
+        weight[k].clear();
+    }
+    tags.clear();
+    times.clear();
+    counts.clear();
+}
+
+/*
+ * Solves n <= MULTILAT_BLOCK fixes from first. Every loop over f is the same
+ * work for each fix, the positions are kept relative to the fix's weighted
+ * AP centroid for the precision of the floats.
+ */
+static void solveBlock(const Multilat_Batch& batch, size_t first, size_t n,
+        Multilat_Fix* fixes) {
+    float sw[MULTILAT_BLOCK] = {0};
+    float cx[MULTILAT_BLOCK] = {0};
+    float cy[MULTILAT_BLOCK] = {0};
+    float qMean[MULTILAT_BLOCK] = {0};
+    float hxx[MULTILAT_BLOCK];
+    float hxy[MULTILAT_BLOCK];
+    float hyy[MULTILAT_BLOCK];
+    float gx[MULTILAT_BLOCK];
+    float gy[MULTILAT_BLOCK];
+    float px[MULTILAT_BLOCK];
+    float py[MULTILAT_BLOCK];
+    float ok[MULTILAT_BLOCK];
+    const float* x;
+    const float* y;
+    const float* r;
+    const float* w;
+    float det;
+    float dx;
+    float dy;
+    float d;
+    float e;
+    float b;
+    float damping;
+    size_t f;
+    uint8_t k;
+    uint8_t i;
+
+    for(k = 0; k < MULTILAT_MAX_APS; k++) {
+        x = batch.ax[k].data() + first;
+        y = batch.ay[k].data() + first;
+        w = batch.weight[k].data() + first;
+        for(f = 0; f < n; f++) {
+            sw[f] += w[f];
+            cx[f] += w[f] * x[f];
+            cy[f] += w[f] * y[f];
+        }
+    }
+    for(f = 0; f < n; f++) {
+        cx[f] /= sw[f];
+        cy[f] /= sw[f];
+    }
+
+    //Linear start: (a - c) . p = (|a - c|^2 - r^2 - mean) / 2 for every AP
+    for(k = 0; k < MULTILAT_MAX_APS; k++) {
+        x = batch.ax[k].data() + first;
+        y = batch.ay[k].data() + first;
+        r = batch.range[k].data() + first;
+        w = batch.weight[k].data() + first;
+        for(f = 0; f < n; f++) {
+            dx = x[f] - cx[f];
+            dy = y[f] - cy[f];
+            qMean[f] += w[f] * (dx * dx + dy * dy - r[f] * r[f]);
+        }
+    }
+    for(f = 0; f < n; f++) {
+        qMean[f] /= sw[f];
+        hxx[f] = hxy[f] = hyy[f] = gx[f] = gy[f] = 0;
+    }
+    for(k = 0; k < MULTILAT_MAX_APS; k++) {
+        x = batch.ax[k].data() + first;
+        y = batch.ay[k].data() + first;
+        r = batch.range[k].data() + first;
+        w = batch.weight[k].data() + first;
+        for(f = 0; f < n; f++) {
+            dx = x[f] - cx[f];
+            dy = y[f] - cy[f];
+            b = 0.5f * (dx * dx + dy * dy - r[f] * r[f] - qMean[f]);
+            hxx[f] += w[f] * dx * dx;
+            hxy[f] += w[f] * dx * dy;
+            hyy[f] += w[f] * dy * dy;
+            gx[f] += w[f] * dx * b;
+            gy[f] += w[f] * dy * b;
+        }
+    }
+    for(f = 0; f < n; f++) {
+        det = hxx[f] * hyy[f] - hxy[f] * hxy[f];
+        d = hxx[f] + hyy[f];
+        ok[f] = (det > MIN_DET * d * d) ? 1.0f : 0.0f;
+        det = (ok[f] != 0) ? det : 1.0f;
+        px[f] = ok[f] * (hyy[f] * gx[f] - hxy[f] * gy[f]) / det;
+        py[f] = ok[f] * (hxx[f] * gy[f] - hxy[f] * gx[f]) / det;
+    }
+
+    //Gauss-Newton on |p - a| - r
+    for(i = 0; i < MULTILAT_ITERATIONS; i++) {
+        for(f = 0; f < n; f++) {
+            hxx[f] = hxy[f] = hyy[f] = gx[f] = gy[f] = 0;
+        }
+        for(k = 0; k < MULTILAT_MAX_APS; k++) {
+            x = batch.ax[k].data() + first;
+            y = batch.ay[k].data() + first;
+            r = batch.range[k].data() + first;
+            w = batch.weight[k].data() + first;
+            for(f = 0; f < n; f++) {
+                dx = px[f] - (x[f] - cx[f]);
+                dy = py[f] - (y[f] - cy[f]);
+                d = std::sqrt(dx * dx + dy * dy) + 1e-6f;
+                e = d - r[f];
+                dx /= d;
+                dy /= d;
+                hxx[f] += w[f] * dx * dx;
+                hxy[f] += w[f] * dx * dy;
+                hyy[f] += w[f] * dy * dy;
+                gx[f] += w[f] * dx * e;
+                gy[f] += w[f] * dy * e;
+            }
+        }
+        for(f = 0; f < n; f++) {
+            damping = DAMPING * (hxx[f] + hyy[f]) + 1e-12f;
+            hxx[f] += damping;
+            hyy[f] += damping;
+            det = hxx[f] * hyy[f] - hxy[f] * hxy[f];
+            px[f] -= ok[f] * (hyy[f] * gx[f] - hxy[f] * gy[f]) / det;
+            py[f] -= ok[f] * (hxx[f] * gy[f] - hxy[f] * gx[f]) / det;
+        }
+    }
+
+    for(f = 0; f < n; f++) {
+        gx[f] = 0;
+    }
+    for(k = 0; k < MULTILAT_MAX_APS; k++) {
+        x = batch.ax[k].data() + first;
+        y = batch.ay[k].data() + first;
+        r = batch.range[k].data() + first;
+        w = batch.weight[k].data() + first;
+        for(f = 0; f < n; f++) {
+            dx = px[f] - (x[f] - cx[f]);
+            dy = py[f] - (y[f] - cy[f]);
+            e = std::sqrt(dx * dx + dy * dy) - r[f];
+            gx[f] += w[f] * e * e;
+        }
+    }
+
+    for(f = 0; f < n; f++) {
+        fixes[first + f].tag = batch.tags[first + f];
+        fixes[first + f].time = batch.times[first + f];
+        fixes[first + f].x = px[f] + cx[f];
+        fixes[first + f].y = py[f] + cy[f];
+        fixes[first + f].rms = std::sqrt(gx[f] / sw[f]);
+        fixes[first + f].aps = batch.counts[first + f];
+        fixes[first + f].ok = (ok[f] != 0);
+    }
+}
+
+static void solveRange(const Multilat_Batch* batch, size_t first, size_t last,
+        Multilat_Fix* fixes) {
+    size_t n;
+
+    for(; first < last; first += n) {
+        n = (last - first < MULTILAT_BLOCK) ? last - first : MULTILAT_BLOCK;
+        solveBlock(*batch, first, n, fixes);
+    }
+}
+
+void Multilat_solve(const Multilat_Batch& batch, std::vector<Multilat_Fix>& fixes,
+        unsigned threads) {
+    std::vector<std::thread> workers;
+    size_t size = batch.size();
+    size_t part;
+    size_t first;
+    size_t last;
+
+    fixes.resize(size);
+    if(threads <= 1 || size <= MULTILAT_BLOCK) {
+        solveRange(&batch, 0, size, fixes.data());
+        return;
+    }
+
+    //Whole blocks to each thread but the last
+    part = (size + threads - 1) / threads;
+    part = (part + MULTILAT_BLOCK - 1) / MULTILAT_BLOCK * MULTILAT_BLOCK;
+    for(first = 0; first < size; first = last) {
+        last = (size - first < part) ? size : first + part;
+        workers.push_back(std::thread(solveRange, &batch, first, last, fixes.data()));
+    }
+    for(std::thread& worker : workers) {
+        worker.join();
+    }
+}
@@ -0,0 +1,72 @@
+#ifndef MULTILAT_H
+#define MULTILAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+ * Least-squares multilateration of tag fixes in the plane of the APs. Each
+ * fix is a tag's ranges to 3 to MULTILAT_MAX_APS APs of known position, it
+ * is solved with a linear least squares start from the centred range
+ * equations, then MULTILAT_ITERATIONS Gauss-Newton steps on the ranges.
+ * RSSI ranges err in proportion to the range, so each one is weighted 1/r^2.
+ *
+ * Fixes are solved in batches. A batch keeps every field in its own array,
+ * anchor k of all fixes side by side, and the solver runs each step over a
+ * block of fixes at a time with no branch on the fix, so the compiler turns
+ * the loops into SIMD over the fixes. Anchors past a fix's count have weight
+ * 0 and take no part. A batch can be split over threads, each solving its
+ * own blocks.
+ */
+
+#define MULTILAT_MAX_APS        8
+#define MULTILAT_ITERATIONS     4
+#define MULTILAT_BLOCK          64      // Fixes solved side by side
+
+typedef struct
+{
+    float x;                    // AP position, m
+    float y;
+    float range;                // Measured distance to the tag, m
+} Multilat_Anchor;
+
+typedef struct
+{
+    uint8_t tag;
+    int64_t time;               // As the batch was given it
+    float x;
+    float y;
+    float rms;                  // Weighted RMS of the range residuals, m
+    uint8_t aps;
+    bool ok;                    // False if the APs were collinear
+} Multilat_Fix;
+
+class Multilat_Batch
+{
+public:
+    /* Adds a fix of count anchors, count must be 3 to MULTILAT_MAX_APS */
+    bool add(uint8_t tag, int64_t time, const Multilat_Anchor* anchors, uint8_t count);
+
+    void clear();
+
+    size_t size() const { return tags.size(); }
+
+    /* Anchor k of every fix, x, y, range and weight */
+    std::vector<float> ax[MULTILAT_MAX_APS];
+    std::vector<float> ay[MULTILAT_MAX_APS];
+    std::vector<float> range[MULTILAT_MAX_APS];
+    std::vector<float> weight[MULTILAT_MAX_APS];
+    std::vector<uint8_t> tags;
+    std::vector<int64_t> times;
+    std::vector<uint8_t> counts;
+};
+
+/*
+ * Solves every fix of batch into fixes, resized to the batch. threads 0 or 1
+ * solves on the calling thread, more split the batch in as many parts.
+ */
+void Multilat_solve(const Multilat_Batch& batch, std::vector<Multilat_Fix>& fixes,
+        unsigned threads);
+
+#endif /* MULTILAT_H */
@@ -0,0 +1,1538 @@
+/*
+ *  ======== EasyLinkSim.c ========
+ *
+ *  EasyLink API on the simulated channel of SimRadio.h. Every node keeps the
+ *  state one device's EasyLink.c keeps, commands become events on the radio
+ *  time line that a single engine thread runs in order, so the channel sees
+ *  every packet start and end in the order they happen.
+ */
+//pthread_mutexattr_settype and pthread_condattr_setclock are not C99
+#define _DEFAULT_SOURCE
+
+#include <math.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ti/sysbios/BIOS.h>
+
+#include "easylink/EasyLink.h"
+#include "easylink/AirTime.h"
+#include "SimClock.h"
+#include "SimRadio.h"
+
+/***** Defines *****/
+
+/* Commands */
+#define CMD_NONE            0
+#define CMD_TX              1
+#define CMD_RX              2
+
+/* Rx modes */
+#define RX_NONE             0
+#define RX_SINGLE           1
+#define RX_CONTINUOUS       2
+#define RX_VIEW             3
+
+/* Rx entry states */
+#define ENTRY_FREE          0
+#define ENTRY_FINISHED      1 // Holds a packet the callback hasn't had yet
+#define ENTRY_LENT          2 // Held by the application through a view
+
+/* Events */
+#define EV_TX_START         0
+#define EV_CS_DONE          1
+#define EV_TX_END           2
+#define EV_RX_START         3
+#define EV_RX_END           4
+
+/* Callbacks */
+#define CB_TX               0
+#define CB_RX               1
+#define CB_RX_QUEUE         2
+#define CB_RX_END           3
+
+#define RSSI_NONE           -128
+#define MIN_DISTANCE_M      1.0
+#define CS_TICKS            EasyLink_us_To_RadioTime((uint64_t)EASYLINK_CHANNEL_IDLE_TIME_US)
+#define PACKET_SIZE         (EASYLINK_MAX_ADDR_SIZE + EASYLINK_MAX_DATA_LENGTH)
+
+/***** Type declarations *****/
+
+/* PHY setup fields the time on air is worked out from, see smartrf_settings */
+typedef struct
+{
+    uint32_t rateWord;
+    uint8_t preScale;
+    uint8_t symbolsPerBit;
+    uint8_t nPreamBytes;
+    uint8_t nSwBits;
+} SimPhy;
+
+/* A packet on the air, kept until no other packet can overlap it */
+typedef struct
+{
+    uint64_t id;
+    SimNode* node;
+    uint32_t frequency;
+    uint64_t start;
+    uint64_t end;
+    int8_t power;
+    uint8_t ended;
+    uint8_t aborted;
+    uint8_t len;                // Address included
+    uint8_t packet[PACKET_SIZE];
+} SimTx;
+
+typedef struct
+{
+    uint64_t time;
+    uint64_t seq;
+    SimNode* node;
+    uint32_t gen;
+    uint8_t type;
+} SimEvent;
+
+typedef struct
+{
+    uint8_t state;
+    uint64_t order;
+    uint8_t len;                // Address included
+    int8_t rssi;
+    uint32_t absTime;
+    uint8_t packet[PACKET_SIZE];
+} SimEntry;
+
+typedef struct
+{
+    uint8_t type;
+    SimNode* node;
+    EasyLink_Status status;
+    EasyLink_TxDoneCb txCb;
+    EasyLink_ReceiveCb rxCb;
+    EasyLink_ReceiveViewCb rxViewCb;
+    EasyLink_RxPacket packet;
+} SimCallback;
+
+struct SimNode
+{
+    uint16_t index;
+    double x;
+    double y;
+    uint8_t ieeeAddr[8];
+    pthread_mutex_t swi;        // Recursive, see Swi_disable
+    pthread_cond_t done;        // Blocking commands wait on it with simLock
+
+    /* EasyLink configuration */
+    uint8_t configured;
+    uint32_t bitRate;
+    uint16_t overheadBits;
+    uint32_t frequency;
+    int8_t txPower;
+    uint8_t addrSize;
+    uint8_t numAddrs;           // 0 when the address filter is off
+    uint8_t addrFilter[EASYLINK_MAX_ADDR_FILTERS * EASYLINK_MAX_ADDR_SIZE];
+    uint32_t asyncRxTimeOut;
+    EasyLink_GetRandomNumber getRN;
+    EasyLink_Stats stats;
+    uint16_t ccaBusyRateAcc;
+
+    /* Running command, gen changes with every command so stale events are
+     * dropped */
+    uint8_t cmd;
+    uint32_t gen;
+    uint8_t blocking;
+    uint8_t cmdDone;
+    EasyLink_Status cmdStatus;
+
+    /* Tx */
+    EasyLink_TxDoneCb txCb;
+    uint8_t cca;
+    uint8_t be;
+    uint64_t csStart;
+    uint64_t txId;
+    uint8_t txLen;
+    uint8_t txPacket[PACKET_SIZE];
+    uint8_t resumeRx;           // Continuous Rx paused for the Tx
+
+    /* Rx */
+    uint8_t rxMode;
+    uint8_t listening;
+    uint8_t starved;            // Continuous Rx with every entry taken
+    uint64_t listenStart;
+    uint64_t rxEnd;             // 0 for no timeout
+    EasyLink_ReceiveCb rxCb;
+    EasyLink_ReceiveViewCb rxViewCb;
+    EasyLink_RxPacket* rxPacket; // Blocking EasyLink_receive only
+    uint64_t entryOrder;
+    SimEntry entries[EASYLINK_RX_QUEUE_ENTRIES];
+    EasyLink_RxView view;
+};
+
+/***** Variable declarations *****/
+
+static const SimPhy phys[] = {
+    [EasyLink_Phy_Custom] = {0x8000, 0xF, 1, 4, 32},
+    [EasyLink_Phy_50kbps2gfsk] = {0x8000, 0xF, 1, 4, 32},
+    [EasyLink_Phy_625bpsLrm] = {0x199A, 0xF, AIRTIME_LRM_SYMBOLS_PER_BIT, 5, 32},
+    [EasyLink_Phy_2_4_200kbps2gfsk] = {0x20000, 0xF, 1, 4, 32},
+    [EasyLink_Phy_5kbpsSlLr] = {0x3333, 0xF, AIRTIME_SL_LR_SYMBOLS_PER_BIT, 2, 32},
+};
+
+static pthread_mutex_t simLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t engineCond;
+static pthread_mutex_t noNodeSwi;
+static SimRadio_Params simParams;
+static SimRadio_Counters counters;
+
+static SimNode* nodes[SIMRADIO_MAX_NODES];
+static uint16_t nodeCount = 0;
+static _Thread_local SimNode* currentNode = NULL;
+
+static SimTx* air = NULL;
+static uint32_t airCount = 0;
+static uint32_t airSize = 0;
+static uint64_t txIds = 0;
+
+static SimEvent* events = NULL;
+static uint32_t eventCount = 0;
+static uint32_t eventSize = 0;
+static uint64_t eventSeq = 0;
+
+static SimCallback* pending = NULL;
+static uint32_t pendingCount = 0;
+static uint32_t pendingSize = 0;
+
+/***** Function definitions *****/
+
+static void* grow(void* array, uint32_t* size, size_t elementSize) {
+    uint32_t newSize = (*size == 0) ? 64 : *size * 2;
+    void* grown = realloc(array, newSize * elementSize);
+
+    if(grown == NULL) {
+        abort();
+    }
+    *size = newSize;
+
+    return grown;
+}
+
+/* Events are a binary heap on time, then on the order they were posted */
+static int eventBefore(const SimEvent* a, const SimEvent* b) {
+    return (a->time < b->time) || (a->time == b->time && a->seq < b->seq);
+}
+
+static void postEvent(SimNode* node, uint8_t type, uint64_t time) {
+    SimEvent ev;
+    uint32_t i;
+
+    if(eventCount == eventSize) {
+        events = grow(events, &eventSize, sizeof(SimEvent));
+    }
+    ev.time = time;
+    ev.seq = eventSeq++;
+    ev.node = node;
+    ev.gen = node->gen;
+    ev.type = type;
+
+    for(i = eventCount++; i > 0 && eventBefore(&ev, &events[(i - 1) / 2]); i = (i - 1) / 2) {
+        events[i] = events[(i - 1) / 2];
+    }
+    events[i] = ev;
+
+    pthread_cond_signal(&engineCond);
+}
+
+static SimEvent popEvent(void) {
+    SimEvent top = events[0];
+    SimEvent last = events[--eventCount];
+    uint32_t i = 0;
+    uint32_t child;
+
+    while((child = 2 * i + 1) < eventCount) {
+        if(child + 1 < eventCount && eventBefore(&events[child + 1], &events[child])) {
+            child++;
+        }
+        if(!eventBefore(&events[child], &last)) {
+            break;
+        }
+        events[i] = events[child];
+        i = child;
+    }
+    events[i] = last;
+
+    return top;
+}
+
+static SimCallback* postCallback(SimNode* node, uint8_t type, EasyLink_Status status) {
+    SimCallback* cb;
+
+    if(pendingCount == pendingSize) {
+        pending = grow(pending, &pendingSize, sizeof(SimCallback));
+    }
+    cb = &pending[pendingCount++];
+    cb->type = type;
+    cb->node = node;
+    cb->status = status;
+    cb->txCb = node->txCb;
+    cb->rxCb = node->rxCb;
+    cb->rxViewCb = node->rxViewCb;
+    cb->packet.len = 0;
+
+    return cb;
+}
+
+static void countRxStatus(SimNode* node, EasyLink_Status status) {
+    if(status == EasyLink_Status_Rx_Timeout) {
+        node->stats.rxTimeouts++;
+    } else if(status == EasyLink_Status_Aborted) {
+        node->stats.rxAborts++;
+    } else if(status != EasyLink_Status_Success) {
+        node->stats.rxErrors++;
+    }
+}
+
+static void countTxStatus(SimNode* node, EasyLink_Status status) {
+    if(status == EasyLink_Status_Success) {
+        node->stats.txOk++;
+    } else if(status == EasyLink_Status_Aborted) {
+        node->stats.txAborts++;
+    } else {
+        node->stats.txErrors++;
+    }
+}
+
+static int8_t rssiAt(const SimTx* tx, const SimNode* node) {
+    double dx = tx->node->x - node->x;
+    double dy = tx->node->y - node->y;
+    double d = sqrt(dx * dx + dy * dy);
+    double rssi;
+
+    if(d < MIN_DISTANCE_M) {
+        d = MIN_DISTANCE_M;
+    }
+    rssi = tx->power - simParams.pathLoss1mDb - 10.0 * simParams.pathLossExponent * log10(d);
+
+    return (rssi < RSSI_NONE) ? RSSI_NONE : (rssi > 127) ? 127 : (int8_t)lround(rssi);
+}
+
+/* Strongest packet of another node on the air at node between from and to */
+static int8_t strongestAt(const SimNode* node, uint64_t from, uint64_t to) {
+    int8_t strongest = RSSI_NONE;
+    int8_t rssi;
+    uint32_t i;
+
+    for(i = 0; i < airCount; i++) {
+        if(air[i].node != node && air[i].frequency == node->frequency &&
+                air[i].start <= to && air[i].end > from) {
+            rssi = rssiAt(&air[i], node);
+            if(rssi > strongest) {
+                strongest = rssi;
+            }
+        }
+    }
+
+    return strongest;
+}
+
+static SimTx* findTx(uint64_t id) {
+    uint32_t i;
+
+    for(i = 0; i < airCount; i++) {
+        if(air[i].id == id) {
+            return &air[i];
+        }
+    }
+
+    return NULL;
+}
+
+/* Drops packets that ended before anything still on the air or sensed began */
+static void pruneAir(uint64_t now) {
+    uint64_t keepFrom = (now > CS_TICKS) ? now - CS_TICKS : 0;
+    uint32_t kept = 0;
+    uint32_t i;
+
+    for(i = 0; i < airCount; i++) {
+        if(!air[i].ended && air[i].start < keepFrom) {
+            keepFrom = air[i].start;
+        }
+    }
+    for(i = 0; i < airCount; i++) {
+        if(!air[i].ended || air[i].end >= keepFrom) {
+            air[kept++] = air[i];
+        }
+    }
+    airCount = kept;
+}
+
+/* Ends a command, waking a blocking caller or posting the callback */
+static void completeCmd(SimNode* node, uint8_t type, EasyLink_Status status) {
+    node->cmd = CMD_NONE;
+    node->gen++;
+
+    if(node->blocking) {
+        node->blocking = 0;
+        node->cmdDone = 1;
+        node->cmdStatus = status;
+        pthread_cond_broadcast(&node->done);
+    } else {
+        postCallback(node, type, status);
+    }
+}
+
+static void listen(SimNode* node, uint64_t now) {
+    uint8_t i;
+
+    node->starved = 1;
+    for(i = 0; i < EASYLINK_RX_QUEUE_ENTRIES; i++) {
+        if(node->entries[i].state == ENTRY_FREE) {
+            node->starved = 0;
+        }
+    }
+    node->listening = !node->starved;
+    node->listenStart = now;
+}
+
+static void endRx(SimNode* node, EasyLink_Status status) {
+    uint8_t mode = node->rxMode;
+    SimCallback* cb;
+
+    node->rxMode = RX_NONE;
+    node->listening = 0;
+    node->starved = 0;
+    countRxStatus(node, status);
+
+    if(mode == RX_SINGLE) {
+        completeCmd(node, CB_RX, status);
+    } else {
+        node->cmd = CMD_NONE;
+        node->gen++;
+        cb = postCallback(node, CB_RX_END, status);
+        cb->rxViewCb = (mode == RX_VIEW) ? node->rxViewCb : NULL;
+    }
+}
+
+/* Ends a Tx, resuming the continuous Rx it paused before its callback */
+static void endTx(SimNode* node, EasyLink_Status status, uint64_t now) {
+    countTxStatus(node, status);
+    completeCmd(node, CB_TX, status);
+
+    if(node->resumeRx) {
+        node->resumeRx = 0;
+        node->cmd = CMD_RX;
+        listen(node, now);
+    }
+}
+
+static void startTx(SimNode* node, uint64_t now) {
+    SimTx* tx;
+
+    if(airCount == airSize) {
+        air = grow(air, &airSize, sizeof(SimTx));
+    }
+    tx = &air[airCount++];
+    tx->id = ++txIds;
+    tx->node = node;
+    tx->frequency = node->frequency;
+    tx->start = now;
+    tx->end = now + EasyLink_us_To_RadioTime((uint64_t)AirTime_us(node->bitRate,
+            node->overheadBits, node->txLen));
+    tx->power = node->txPower;
+    tx->ended = 0;
+    tx->aborted = 0;
+    tx->len = node->txLen;
+    memcpy(tx->packet, node->txPacket, node->txLen);
+
+    node->txId = tx->id;
+    node->listening = 0;
+    counters.transmissions++;
+    postEvent(node, EV_TX_END, tx->end);
+}
+
+static int addrMatch(const SimNode* node, const uint8_t* dstAddr) {
+    uint8_t i;
+
+    if(node->numAddrs == 0) {
+        return 1;
+    }
+    for(i = 0; i < node->numAddrs; i++) {
+        if(memcmp(&node->addrFilter[i * node->addrSize], dstAddr, node->addrSize) == 0) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+static void fillPacket(const SimNode* node, EasyLink_RxPacket* packet, const uint8_t* data,
+        uint8_t len, int8_t rssi, uint32_t absTime) {
+    memset(packet->dstAddr, 0, sizeof(packet->dstAddr));
+    memcpy(packet->dstAddr, data, node->addrSize);
+    packet->len = len - node->addrSize;
+    memcpy(packet->payload, data + node->addrSize, packet->len);
+    packet->rssi = rssi;
+    packet->absTime = absTime;
+    packet->rxTimeout = 0;
+}
+
+static void receivePacket(SimNode* node, const SimTx* tx, int8_t rssi) {
+    SimEntry* entry = NULL;
+    SimCallback* cb;
+    uint8_t i;
+
+    if(node->rxMode == RX_SINGLE) {
+        node->stats.rxOk++;
+        node->stats.lastRssi = rssi;
+        node->listening = 0;
+        node->rxMode = RX_NONE;
+        if(node->blocking) {
+            fillPacket(node, node->rxPacket, tx->packet, tx->len, rssi, (uint32_t)tx->start);
+            completeCmd(node, CB_RX, EasyLink_Status_Success);
+        } else {
+            node->cmd = CMD_NONE;
+            node->gen++;
+            cb = postCallback(node, CB_RX, EasyLink_Status_Success);
+            fillPacket(node, &cb->packet, tx->packet, tx->len, rssi, (uint32_t)tx->start);
+        }
+        return;
+    }
+
+    for(i = 0; i < EASYLINK_RX_QUEUE_ENTRIES && entry == NULL; i++) {
+        if(node->entries[i].state == ENTRY_FREE) {
+            entry = &node->entries[i];
+        }
+    }
+    if(entry == NULL) {
+        //Every entry is taken, the radio stops until one is handed back
+        node->stats.rxBufFull++;
+        node->starved = 1;
+        node->listening = 0;
+        return;
+    }
+
+    node->stats.rxOk++;
+    node->stats.lastRssi = rssi;
+    entry->state = ENTRY_FINISHED;
+    entry->order = node->entryOrder++;
+    entry->len = tx->len;
+    entry->rssi = rssi;
+    entry->absTime = (uint32_t)tx->start;
+    memcpy(entry->packet, tx->packet, tx->len);
+    cb = postCallback(node, CB_RX_QUEUE, EasyLink_Status_Success);
+    cb->rxViewCb = (node->rxMode == RX_VIEW) ? node->rxViewCb : NULL;
+}
+
+/* Hands a packet that just ended to every node that could hear it */
+static void deliver(const SimTx* tx) {
+    SimNode* node;
+    int8_t rssi;
+    uint8_t collided;
+    uint32_t i;
+    uint16_t n;
+
+    for(n = 0; n < nodeCount; n++) {
+        node = nodes[n];
+        if(node == tx->node || !node->listening || node->frequency != tx->frequency ||
+                node->listenStart > tx->start) {
+            continue;
+        }
+
+        rssi = rssiAt(tx, node);
+        if(rssi < simParams.sensitivityDbm) {
+            counters.belowSensitivity++;
+            continue;
+        }
+
+        collided = 0;
+        for(i = 0; i < airCount && !collided; i++) {
+            if(&air[i] != tx && air[i].node != node && air[i].frequency == tx->frequency &&
+                    air[i].start < tx->end && air[i].end > tx->start &&
+                    rssiAt(&air[i], node) + simParams.captureDb > rssi) {
+                collided = 1;
+            }
+        }
+        if(collided) {
+            counters.collisions++;
+            node->stats.rxNok++;
+            //A single Rx ends on a CRC error, a continuous one goes on
+            if(node->rxMode == RX_SINGLE) {
+                endRx(node, EasyLink_Status_Rx_Error);
+            }
+            continue;
+        }
+
+        counters.delivered++;
+        if(!addrMatch(node, tx->packet)) {
+            node->stats.rxIgnored++;
+            continue;
+        }
+        receivePacket(node, tx, rssi);
+    }
+}
+
+static void ccaUpdateBusyRate(SimNode* node, uint8_t busy) {
+    uint16_t sample = busy ? EASYLINK_CCA_BUSY_RATE_ONE : 0;
+
+    node->ccaBusyRateAcc += sample - (node->ccaBusyRateAcc >> 3);
+    node->stats.cca.busyRate = node->ccaBusyRateAcc >> 3;
+    //One short of the max window, as ccaStartBackOff()
+    node->stats.cca.startBackOff = EASYLINK_MIN_CCA_BACKOFF_WINDOW + (uint8_t)(((uint32_t)
+            node->stats.cca.busyRate * (EASYLINK_MAX_CCA_BACKOFF_WINDOW - 1 -
+            EASYLINK_MIN_CCA_BACKOFF_WINDOW)) / EASYLINK_CCA_BUSY_RATE_ONE);
+}
+
+/* Carrier sense over the idle time, then the Tx or a back-off */
+static void csDone(SimNode* node, uint64_t now) {
+    uint64_t backOff;
+
+    if(strongestAt(node, node->csStart, now) <= EASYLINK_CS_RSSI_THRESHOLD_DBM) {
+        ccaUpdateBusyRate(node, 0);
+        startTx(node, now);
+        return;
+    }
+
+    ccaUpdateBusyRate(node, 1);
+    node->stats.cca.busyCount++;
+    if(node->be > EASYLINK_MAX_CCA_BACKOFF_WINDOW) {
+        node->stats.cca.busyFailures++;
+        endTx(node, EasyLink_Status_Busy_Error, now);
+        return;
+    }
+
+    //Same back-off as EasyLink.c, 0 to 2^be - 1 time units
+    backOff = (node->getRN() & ((1u << node->be++) - 1)) *
+            EasyLink_us_To_RadioTime((uint64_t)EASYLINK_CCA_BACKOFF_TIMEUNITS);
+    node->stats.cca.retries++;
+    postEvent(node, EV_TX_START, now + backOff);
+}
+
+static void runEvent(const SimEvent* ev) {
+    SimNode* node = ev->node;
+    SimTx* tx;
+
+    if(ev->gen != node->gen) {
+        return;
+    }
+
+    switch(ev->type) {
+        case EV_TX_START:
+            //A paused continuous Rx listened up to here
+            node->listening = 0;
+            if(node->cca) {
+                node->csStart = ev->time;
+                postEvent(node, EV_CS_DONE, ev->time + CS_TICKS);
+            } else {
+                startTx(node, ev->time);
+            }
+            break;
+        case EV_CS_DONE:
+            csDone(node, ev->time);
+            break;
+        case EV_TX_END:
+            tx = findTx(node->txId);
+            tx->ended = 1;
+            deliver(tx);
+            if(node->cca) {
+                node->stats.cca.txSuccess++;
+            }
+            endTx(node, EasyLink_Status_Success, ev->time);
+            pruneAir(ev->time);
+            break;
+        case EV_RX_START:
+            listen(node, ev->time);
+            if(node->rxEnd != 0) {
+                postEvent(node, EV_RX_END, node->rxEnd);
+            }
+            break;
+        case EV_RX_END:
+            endRx(node, EasyLink_Status_Rx_Timeout);
+            break;
+    }
+}
+
+/* Runs callbacks as the RF driver's Swi would, without simLock held */
+static void runCallbacks(SimCallback* cbs, uint32_t count) {
+    EasyLink_RxPacket packet;
+    EasyLink_RxView* view;
+    SimEntry* entry;
+    SimNode* node;
+    SimCallback* cb;
+    uint32_t i;
+    uint8_t e;
+
+    for(i = 0; i < count; i++) {
+        cb = &cbs[i];
+        node = cb->node;
+        //EasyLink calls made from the callback act on its node
+        currentNode = node;
+        pthread_mutex_lock(&node->swi);
+
+        switch(cb->type) {
+            case CB_TX:
+                if(cb->txCb != NULL) {
+                    cb->txCb(cb->status);
+                }
+                break;
+            case CB_RX:
+                if(cb->rxCb != NULL) {
+                    cb->rxCb(&cb->packet, cb->status);
+                }
+                break;
+            case CB_RX_QUEUE:
+                //Every packet queued so far, oldest first
+                while(1) {
+                    pthread_mutex_lock(&simLock);
+                    entry = NULL;
+                    for(e = 0; e < EASYLINK_RX_QUEUE_ENTRIES; e++) {
+                        if(node->entries[e].state == ENTRY_FINISHED &&
+                                (entry == NULL || node->entries[e].order < entry->order)) {
+                            entry = &node->entries[e];
+                        }
+                    }
+                    if(entry != NULL && cb->rxViewCb != NULL) {
+                        entry->state = ENTRY_LENT;
+                        view = &node->view;
+                        view->dstAddr = entry->packet;
+                        view->payload = entry->packet + node->addrSize;
+                        view->len = entry->len - node->addrSize;
+                        view->rssi = entry->rssi;
+                        view->absTime = entry->absTime;
+                        view->entry = (uint8_t*)entry;
+                    } else if(entry != NULL) {
+                        fillPacket(node, &packet, entry->packet, entry->len, entry->rssi,
+                                entry->absTime);
+                        entry->state = ENTRY_FREE;
+                        if(node->starved && node->rxMode == RX_CONTINUOUS) {
+                            listen(node, SimClock_now());
+                        }
+                    }
+                    pthread_mutex_unlock(&simLock);
+
+                    if(entry == NULL) {
+                        break;
+                    }
+                    if(cb->rxViewCb != NULL) {
+                        cb->rxViewCb(&node->view, EasyLink_Status_Success);
+                    } else if(cb->rxCb != NULL) {
+                        cb->rxCb(&packet, EasyLink_Status_Success);
+                    }
+                }
+                break;
+            case CB_RX_END:
+                if(cb->rxViewCb != NULL) {
+                    cb->rxViewCb(NULL, cb->status);
+                } else if(cb->rxCb != NULL) {
+                    cb->rxCb(&cb->packet, cb->status);
+                }
+                break;
+        }
+
+        pthread_mutex_unlock(&node->swi);
+        currentNode = NULL;
+    }
+}
+
+/* Takes the pending callbacks, to run once simLock is released */
+static SimCallback* takeCallbacks(uint32_t* count) {
+    SimCallback* cbs = NULL;
+
+    *count = pendingCount;
+    if(pendingCount > 0) {
+        cbs = malloc(pendingCount * sizeof(SimCallback));
+        if(cbs == NULL) {
+            abort();
+        }
+        memcpy(cbs, pending, pendingCount * sizeof(SimCallback));
+        pendingCount = 0;
+    }
+
+    return cbs;
+}
+
+static void runTakenCallbacks(SimCallback* cbs, uint32_t count) {
+    if(cbs != NULL) {
+        runCallbacks(cbs, count);
+        free(cbs);
+    }
+}
+
+static void* engineThread(void* arg) {
+    struct timespec deadline;
+    SimCallback* cbs;
+    SimEvent ev;
+    uint32_t count;
+
+    (void)arg;
+    pthread_mutex_lock(&simLock);
+    while(1) {
+        if(eventCount == 0) {
+            pthread_cond_wait(&engineCond, &simLock);
+            continue;
+        }
+        if(events[0].time > SimClock_now()) {
+            SimClock_deadline(events[0].time, &deadline);
+            pthread_cond_timedwait(&engineCond, &simLock, &deadline);
+            continue;
+        }
+
+        //Every event that is due, then their callbacks
+        while(eventCount > 0 && events[0].time <= SimClock_now()) {
+            ev = popEvent();
+            runEvent(&ev);
+        }
+        cbs = takeCallbacks(&count);
+        pthread_mutex_unlock(&simLock);
+        runTakenCallbacks(cbs, count);
+        pthread_mutex_lock(&simLock);
+    }
+
+    return NULL;
+}
+
+void SimRadio_Params_init(SimRadio_Params* params) {
+    params->speed = 1;
+    params->startTime = 0;
+    params->pathLoss1mDb = 40.0;        // 868 MHz free space
+    params->pathLossExponent = 2.7;     // Indoor, line of sight
+    params->sensitivityDbm = -110;      // 50 kbps GFSK
+    params->captureDb = 6;
+}
+
+void SimRadio_init(const SimRadio_Params* params) {
+    pthread_mutexattr_t mutexAttr;
+    pthread_condattr_t condAttr;
+    pthread_t engine;
+
+    simParams = *params;
+    SimClock_init(params->speed, params->startTime);
+
+    pthread_condattr_init(&condAttr);
+    pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+    pthread_cond_init(&engineCond, &condAttr);
+    pthread_condattr_destroy(&condAttr);
+
+    pthread_mutexattr_init(&mutexAttr);
+    pthread_mutexattr_settype(&mutexAttr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&noNodeSwi, &mutexAttr);
+    pthread_mutexattr_destroy(&mutexAttr);
+
+    if(pthread_create(&engine, NULL, engineThread, NULL) != 0) {
+        abort();
+    }
+    pthread_detach(engine);
+}
+
+SimNode* SimRadio_addNode(double x, double y) {
+    pthread_mutexattr_t mutexAttr;
+    SimNode* node;
+
+    pthread_mutex_lock(&simLock);
+    if(nodeCount == SIMRADIO_MAX_NODES || (node = calloc(1, sizeof(SimNode))) == NULL) {
+        pthread_mutex_unlock(&simLock);
+        return NULL;
+    }
+
+    node->index = nodeCount;
+    node->x = x;
+    node->y = y;
+    //TI's OUI, then the node index
+    node->ieeeAddr[0] = 0x00;
+    node->ieeeAddr[1] = 0x12;
+    node->ieeeAddr[2] = 0x4B;
+    node->ieeeAddr[6] = (uint8_t)(nodeCount >> 8);
+    node->ieeeAddr[7] = (uint8_t)nodeCount;
+
+    pthread_mutexattr_init(&mutexAttr);
+    pthread_mutexattr_settype(&mutexAttr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&node->swi, &mutexAttr);
+    pthread_mutexattr_destroy(&mutexAttr);
+    pthread_cond_init(&node->done, NULL);
+
+    nodes[nodeCount++] = node;
+    pthread_mutex_unlock(&simLock);
+
+    return node;
+}
+
+void SimRadio_attach(SimNode* node) {
+    currentNode = node;
+}
+
+SimNode* SimRadio_current(void) {
+    return currentNode;
+}
+
+void SimRadio_getCounters(SimRadio_Counters* c) {
+    pthread_mutex_lock(&simLock);
+    *c = counters;
+    pthread_mutex_unlock(&simLock);
+}
+
+void SimRadio_swiLock(void) {
+    pthread_mutex_lock(currentNode != NULL ? &currentNode->swi : &noNodeSwi);
+}
+
+void SimRadio_swiUnlock(void) {
+    pthread_mutex_unlock(currentNode != NULL ? &currentNode->swi : &noNodeSwi);
+}
+
+/* Node of the caller with simLock held, NULL if it can't run commands */
+static SimNode* lockNode(void) {
+    SimNode* node = currentNode;
+
+    if(node == NULL) {
+        return NULL;
+    }
+    pthread_mutex_lock(&simLock);
+    if(!node->configured) {
+        pthread_mutex_unlock(&simLock);
+        return NULL;
+    }
+
+    return node;
+}
+
+/* Start time of a command from its absTime, now for 0 or a time gone by */
+static uint64_t startTime(uint32_t absTime) {
+    uint64_t now = SimClock_now();
+    uint64_t start;
+
+    if(absTime == 0) {
+        return now;
+    }
+    start = SimClock_fromAbsTime(absTime);
+
+    return (start > now) ? start : now;
+}
+
+/* Waits for a blocking command, simLock held */
+static EasyLink_Status waitCmd(SimNode* node) {
+    while(!node->cmdDone) {
+        pthread_cond_wait(&node->done, &simLock);
+    }
+
+    return node->cmdStatus;
+}
+
+void EasyLink_Params_init(EasyLink_Params *params)
+{
+    params->ui32ModType = EasyLink_Phy_50kbps2gfsk;
+    params->pClientEventCb = NULL;
+    params->nClientEventMask = 0;
+    params->pGrnFxn = (EasyLink_GetRandomNumber)rand;
+}
+
+EasyLink_Status EasyLink_init(EasyLink_Params *params)
+{
+    SimNode* node = currentNode;
+    const SimPhy* phy;
+
+    if (node == NULL || params == NULL ||
+            (uint32_t)params->ui32ModType >= sizeof(phys) / sizeof(phys[0]))
+    {
+        return EasyLink_Status_Config_Error;
+    }
+
+    pthread_mutex_lock(&simLock);
+    if (node->cmd != CMD_NONE)
+    {
+        node->stats.busyErrors++;
+        pthread_mutex_unlock(&simLock);
+        return EasyLink_Status_Busy_Error;
+    }
+
+    phy = &phys[params->ui32ModType];
+    node->bitRate = AirTime_bitRate(phy->rateWord, phy->preScale, phy->symbolsPerBit);
+    node->overheadBits = AirTime_overheadBits(phy->nPreamBytes, phy->nSwBits, true, true);
+    node->frequency = 868000000;
+    node->txPower = 14;
+    node->addrSize = 1;
+    node->numAddrs = 0;
+    node->asyncRxTimeOut = 0;
+    node->getRN = params->pGrnFxn;
+    memset(&node->stats, 0, sizeof(node->stats));
+    node->stats.cca.startBackOff = EASYLINK_MIN_CCA_BACKOFF_WINDOW;
+    node->ccaBusyRateAcc = 0;
+    node->rxMode = RX_NONE;
+    node->listening = 0;
+    node->configured = 1;
+    pthread_mutex_unlock(&simLock);
+
+    return EasyLink_Status_Success;
+}
+
+EasyLink_Status EasyLink_getAbsTime(uint32_t *pui32AbsTime)
+{
+    if (pui32AbsTime == NULL)
+    {
+        return EasyLink_Status_Param_Error;
+    }
+    *pui32AbsTime = (uint32_t)SimClock_now();
+
+    return EasyLink_Status_Success;
+}
+
+uint32_t EasyLink_getAirTimeUs(uint8_t len)
+{
+    SimNode* node = currentNode;
+
+    if (node == NULL || !node->configured)
+    {
+        return 0;
+    }
+
+    //The address is sent as part of the packet
+    return AirTime_us(node->bitRate, node->overheadBits, (uint16_t)len + node->addrSize);
+}
+
+EasyLink_Status EasyLink_getRssi(int8_t *pi8Rssi)
+{
+    SimNode* node = lockNode();
+    uint64_t now = SimClock_now();
+
+    if (node == NULL)
+    {
+        return EasyLink_Status_Config_Error;
+    }
+    *pi8Rssi = strongestAt(node, now, now);
+    pthread_mutex_unlock(&simLock);
+
+    return EasyLink_Status_Success;
+}
+
+/* Sets up a Tx, simLock held, returns its start time or 0 if busy */
+static EasyLink_Status setupTx(SimNode* node, EasyLink_TxPacket *txPacket, uint8_t pauseRx,
+        uint64_t* start)
+{
+    SimTx* tx;
+    uint32_t i;
+
+    if (txPacket->len > EASYLINK_MAX_DATA_LENGTH)
+    {
+        return EasyLink_Status_Param_Error;
+    }
+
+    *start = startTime(txPacket->absTime);
+    if (pauseRx && node->cmd == CMD_RX && node->rxMode != RX_SINGLE && !node->resumeRx)
+    {
+        //The Rx stops once the packet being received, if any, is complete
+        for (i = 0; i < airCount; i++)
+        {
+            tx = &air[i];
+            if (!tx->ended && node->listening && tx->frequency == node->frequency &&
+                    tx->start >= node->listenStart && tx->end > *start &&
+                    rssiAt(tx, node) >= simParams.sensitivityDbm)
+            {
+                *start = tx->end;
+            }
+        }
+        node->resumeRx = 1;
+    }
+    else if (node->cmd != CMD_NONE)
+    {
+        node->stats.busyErrors++;
+        return EasyLink_Status_Busy_Error;
+    }
+
+    node->cmd = CMD_TX;
+    node->gen++;
+    node->txLen = node->addrSize + txPacket->len;
+    memcpy(node->txPacket, txPacket->dstAddr, node->addrSize);
+    memcpy(node->txPacket + node->addrSize, txPacket->payload, txPacket->len);
+
+    return EasyLink_Status_Success;
+}
+
+EasyLink_Status EasyLink_transmit(EasyLink_TxPacket *txPacket)
+{
+    SimNode* node = lockNode();
+    EasyLink_Status status;
+    uint64_t start;
+
+    if (node == NULL)
+    {
+        return EasyLink_Status_Config_Error;
+    }
+
+    status = setupTx(node, txPacket, 0, &start);
+    if (status == EasyLink_Status_Success)
+    {
+        node->cca = 0;
+        node->blocking = 1;
+        node->cmdDone = 0;
+        postEvent(node, EV_TX_START, start);
+        status = waitCmd(node);
+    }
+    pthread_mutex_unlock(&simLock);
+
+    return status;
+}
+
+EasyLink_Status EasyLink_transmitAsync(EasyLink_TxPacket *txPacket, EasyLink_TxDoneCb cb)
+{
+    SimNode* node = lockNode();
+    EasyLink_Status status;
+    uint64_t start;
+
+    if (node == NULL)
+    {
+        return EasyLink_Status_Config_Error;
+    }
+
+    status = setupTx(node, txPacket, 1, &start);
+    if (status == EasyLink_Status_Success)
+    {
+        node->cca = 0;
+        node->blocking = 0;
+        node->txCb = cb;
+        postEvent(node, EV_TX_START, start);
+    }
+    pthread_mutex_unlock(&simLock);
+
+    return status;
+}
+
+EasyLink_Status EasyLink_transmitCcaAsync(EasyLink_TxPacket *txPacket, EasyLink_TxDoneCb cb)
+{
+    SimNode* node = lockNode();
+    EasyLink_Status status;
+    uint64_t start;
+
+    if (node == NULL)
+    {
+        return EasyLink_Status_Config_Error;
+    }
+    if (node->getRN == NULL)
+    {
+        pthread_mutex_unlock(&simLock);
+        return EasyLink_Status_Config_Error;
+    }
+
+    status = setupTx(node, txPacket, 1, &start);
+    if (status == EasyLink_Status_Success)
+    {
+        node->cca = 1;
+        node->be = node->stats.cca.startBackOff;
+        node->stats.cca.txCount++;
+        node->blocking = 0;
+        node->txCb = cb;
+        postEvent(node, EV_TX_START, start);
+    }
+    pthread_mutex_unlock(&simLock);
+
+    return status;
+}
+
+EasyLink_Status EasyLink_getCcaStats(EasyLink_CcaStats *stats)
+{
+    SimNode* node = lockNode();
+
+    if (node == NULL)
+    {
+        return EasyLink_Status_Config_Error;
+    }
+    if (stats != NULL)
+    {
+        *stats = node->stats.cca;
+    }
+    pthread_mutex_unlock(&simLock);
+
+    return (stats != NULL) ? EasyLink_Status_Success : EasyLink_Status_Param_Error;
+}
+
+EasyLink_Status EasyLink_getStats(EasyLink_Stats *stats)
+{
+    SimNode* node = lockNode();
+
+    if (node == NULL)
+    {
+        return EasyLink_Status_Config_Error;
+    }
+    if (stats != NULL)
+    {
+        *stats = node->stats;
+    }
+    pthread_mutex_unlock(&simLock);
+
+    return (stats != NULL) ? EasyLink_Status_Success : EasyLink_Status_Param_Error;
+}
+
+/* Sets up an Rx, simLock held */
+static EasyLink_Status setupRx(SimNode* node, uint8_t mode, uint32_t absTime, uint32_t timeout)
+{
+    uint64_t start = startTime(absTime);
+    uint8_t i;
+
+    if (node->cmd != CMD_NONE)
+    {
+        node->stats.busyErrors++;
+        return EasyLink_Status_Busy_Error;
+    }
+
+    //Entries the application still holds stay lent
+    for (i = 0; i < EASYLINK_RX_QUEUE_ENTRIES; i++)
+    {
+        if (node->entries[i].state == ENTRY_FINISHED)
+        {
+            node->entries[i].state = ENTRY_FREE;
+        }
+    }
+
+    node->cmd = CMD_RX;
+    node->gen++;
+    node->rxMode = mode;
+    node->rxEnd = (timeout != 0) ? start + timeout : 0;
+    postEvent(node, EV_RX_START, start);
+
+    return EasyLink_Status_Success;
+}
+
+EasyLink_Status EasyLink_receive(EasyLink_RxPacket *rxPacket)
+{
+    SimNode* node = lockNode();
+    EasyLink_Status status;
+
+    if (node == NULL)
+    {
+        return EasyLink_Status_Config_Error;
+    }
+
+    node->blocking = 1;
+    node->cmdDone = 0;
+    node->rxPacket = rxPacket;
+    status = setupRx(node, RX_SINGLE, rxPacket->absTime, rxPacket->rxTimeout);
+    if (status == EasyLink_Status_Success)
+    {
+        status = waitCmd(node);
+    }
+    else
+    {
+        node->blocking = 0;
+    }
+    pthread_mutex_unlock(&simLock);
+
+    return status;
+}
+
+EasyLink_Status EasyLink_receiveAsync(EasyLink_ReceiveCb cb, uint32_t absTime)
+{
+    SimNode* node = lockNode();
+    EasyLink_Status status;
+
+    if (node == NULL)
+    {
+        return EasyLink_Status_Config_Error;
+    }
+
+    status = setupRx(node, RX_SINGLE, absTime, node->asyncRxTimeOut);
+    if (status == EasyLink_Status_Success)
+    {
+        node->blocking = 0;
+        node->rxCb = cb;
+        node->rxViewCb = NULL;
+    }
+    pthread_mutex_unlock(&simLock);
+
+    return status;
+}
+
+EasyLink_Status EasyLink_receiveContinuousAsync(EasyLink_ReceiveCb cb, uint32_t absTime)
+{
+    SimNode* node = lockNode();
+    EasyLink_Status status;
+
+    if (node == NULL)
+    {
+        return EasyLink_Status_Config_Error;
+    }
+
+    status = setupRx(node, RX_CONTINUOUS, absTime, node->asyncRxTimeOut);
+    if (status == EasyLink_Status_Success)
+    {
+        node->blocking = 0;
+        node->rxCb = cb;
+        node->rxViewCb = NULL;
+    }
+    pthread_mutex_unlock(&simLock);
+
+    return status;
+}
+
+EasyLink_Status EasyLink_receiveContinuousViewAsync(EasyLink_ReceiveViewCb cb, uint32_t absTime)
+{
+    SimNode* node = lockNode();
+    EasyLink_Status status;
+
+    if (node == NULL)
+    {
+        return EasyLink_Status_Config_Error;
+    }
+
+    status = setupRx(node, RX_VIEW, absTime, node->asyncRxTimeOut);
+    if (status == EasyLink_Status_Success)
+    {
+        node->blocking = 0;
+        node->rxCb = NULL;
+        node->rxViewCb = cb;
+    }
+    pthread_mutex_unlock(&simLock);
+
+    return status;
+}
+
+void EasyLink_releaseRxView(EasyLink_RxView *rxView)
+{
+    SimNode* node = lockNode();
+    SimEntry* entry;
+
+    if (node == NULL)
+    {
+        return;
+    }
+
+    entry = (SimEntry*)rxView->entry;
+    if (entry >= node->entries && entry < node->entries + EASYLINK_RX_QUEUE_ENTRIES &&
+            entry->state == ENTRY_LENT)
+    {
+        entry->state = ENTRY_FREE;
+        //Rx starts again as soon as an entry is back
+        if (node->starved && node->cmd == CMD_RX && !node->resumeRx)
+        {
+            listen(node, SimClock_now());
+        }
+    }
+    pthread_mutex_unlock(&simLock);
+}
+
+EasyLink_Status EasyLink_abort(void)
+{
+    SimNode* node = lockNode();
+    EasyLink_Status status = EasyLink_Status_Success;
+    SimCallback* cbs;
+    uint32_t count;
+    SimTx* tx;
+
+    if (node == NULL)
+    {
+        return EasyLink_Status_Config_Error;
+    }
+
+    if (node->cmd == CMD_NONE)
+    {
+        status = EasyLink_Status_Aborted;
+    }
+    else if (node->cmd == CMD_TX)
+    {
+        //A packet cut short still garbles those it overlapped
+        tx = findTx(node->txId);
+        if (tx != NULL && !tx->ended)
+        {
+            tx->end = SimClock_now();
+            tx->ended = 1;
+            tx->aborted = 1;
+        }
+        node->txId = 0;
+        if (node->resumeRx)
+        {
+            //The paused Rx is aborted with the Tx
+            node->resumeRx = 0;
+            countTxStatus(node, EasyLink_Status_Aborted);
+            completeCmd(node, CB_TX, EasyLink_Status_Aborted);
+            node->cmd = CMD_RX;
+            endRx(node, EasyLink_Status_Aborted);
+        }
+        else
+        {
+            endTx(node, EasyLink_Status_Aborted, SimClock_now());
+        }
+    }
+    else
+    {
+        endRx(node, EasyLink_Status_Aborted);
+    }
+
+    //The callback has run by the time abort returns, as on the device
+    cbs = takeCallbacks(&count);
+    pthread_mutex_unlock(&simLock);
+    runTakenCallbacks(cbs, count);
+    currentNode = node;
+
+    return status;
+}
+
+EasyLink_Status EasyLink_setFrequency(uint32_t ui32Frequency)
+{
+    SimNode* node = lockNode();
+
+    if (node == NULL)
+    {
+        return EasyLink_Status_Config_Error;
+    }
+    if (node->cmd != CMD_NONE)
+    {
+        node->stats.busyErrors++;
+        pthread_mutex_unlock(&simLock);
+        return EasyLink_Status_Busy_Error;
+    }
+    node->frequency = ui32Frequency;
+    pthread_mutex_unlock(&simLock);
+
+    return EasyLink_Status_Success;
+}
+
+uint32_t EasyLink_getFrequency(void)
+{
+    SimNode* node = currentNode;
+
+    if (node == NULL || !node->configured)
+    {
+        return EasyLink_Status_Config_Error;
+    }
+
+    return node->frequency;
+}
+
+EasyLink_Status EasyLink_enableRxAddrFilter(uint8_t* pui8AddrFilterTable, uint8_t ui8AddrSize, uint8_t ui8NumAddrs)
+{
+    SimNode* node = lockNode();
+    EasyLink_Status status = EasyLink_Status_Param_Error;
+
+    if (node == NULL)
+    {
+        return EasyLink_Status_Config_Error;
+    }
+    if (node->cmd != CMD_NONE)
+    {
+        node->stats.busyErrors++;
+        pthread_mutex_unlock(&simLock);
+        return EasyLink_Status_Busy_Error;
+    }
+
+    if ( (pui8AddrFilterTable != NULL) &&
+            (ui8AddrSize != 0) && (ui8NumAddrs != 0) &&
+            (ui8AddrSize == node->addrSize) &&
+            (ui8NumAddrs <= EASYLINK_MAX_ADDR_FILTERS) )
+    {
+        memcpy(node->addrFilter, pui8AddrFilterTable, ui8AddrSize * ui8NumAddrs);
+        node->numAddrs = ui8NumAddrs;
+        status = EasyLink_Status_Success;
+    }
+    else if (pui8AddrFilterTable == NULL)
+    {
+        //disable filter
+        node->numAddrs = 0;
+        status = EasyLink_Status_Success;
+    }
+    pthread_mutex_unlock(&simLock);
+
+    return status;
+}
+
+EasyLink_Status EasyLink_getIeeeAddr(uint8_t *ieeeAddr)
+{
+    SimNode* node = currentNode;
+
+    if (node == NULL || ieeeAddr == NULL)
+    {
+        return EasyLink_Status_Param_Error;
+    }
+    memcpy(ieeeAddr, node->ieeeAddr, sizeof(node->ieeeAddr));
+
+    return EasyLink_Status_Success;
+}
+
+EasyLink_Status EasyLink_setRfPower(int8_t i8TxPowerdBm)
+{
+    SimNode* node = lockNode();
+
+    if (node == NULL)
+    {
+        return EasyLink_Status_Config_Error;
+    }
+
+    //Same clamping as the CC1350's power table
+    node->txPower = (i8TxPowerdBm > 14) ? 14 : (i8TxPowerdBm < 0) ? -10 : i8TxPowerdBm;
+    pthread_mutex_unlock(&simLock);
+
+    return EasyLink_Status_Success;
+}
+
+EasyLink_Status EasyLink_getRfPower(int8_t *pi8TxPowerdBm)
+{
+    SimNode* node = lockNode();
+
+    if (node == NULL)
+    {
+        return EasyLink_Status_Config_Error;
+    }
+    *pi8TxPowerdBm = node->txPower;
+    pthread_mutex_unlock(&simLock);
+
+    return EasyLink_Status_Success;
+}
+
+EasyLink_Status EasyLink_setCtrl(EasyLink_CtrlOption Ctrl, uint32_t ui32Value)
+{
+    SimNode* node = currentNode;
+    EasyLink_Status status = EasyLink_Status_Param_Error;
+
+    if (node == NULL)
+    {
+        return EasyLink_Status_Config_Error;
+    }
+
+    pthread_mutex_lock(&simLock);
+    switch(Ctrl)
+    {
+        case EasyLink_Ctrl_AddSize:
+            if (ui32Value <= EASYLINK_MAX_ADDR_SIZE)
+            {
+                node->addrSize = (uint8_t) ui32Value;
+                status = EasyLink_Status_Success;
+            }
+            break;
+        case EasyLink_Ctrl_AsyncRx_TimeOut:
+            node->asyncRxTimeOut = ui32Value;
+            status = EasyLink_Status_Success;
+            break;
+        case EasyLink_Ctrl_Idle_TimeOut:
+        case EasyLink_Ctrl_MultiClient_Mode:
+            //Nothing to model, the simulated radio never powers down
+            status = EasyLink_Status_Success;
+            break;
+        default:
+            //No test modes on the simulated channel
+            status = EasyLink_Status_Config_Error;
+            break;
+    }
+    pthread_mutex_unlock(&simLock);
+
+    return status;
+}
+
+EasyLink_Status EasyLink_getCtrl(EasyLink_CtrlOption Ctrl, uint32_t* pui32Value)
+{
+    SimNode* node = currentNode;
+    EasyLink_Status status = EasyLink_Status_Success;
+
+    if (node == NULL)
+    {
+        return EasyLink_Status_Config_Error;
+    }
+
+    switch(Ctrl)
+    {
+        case EasyLink_Ctrl_AddSize:
+            *pui32Value = node->addrSize;
+            break;
+        case EasyLink_Ctrl_AsyncRx_TimeOut:
+            *pui32Value = node->asyncRxTimeOut;
+            break;
+        default:
+            *pui32Value = 0;
+            break;
+    }
+
+    return status;
+}
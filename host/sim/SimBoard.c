@@ -0,0 +1,122 @@
+/*
+ *  ======== SimBoard.c ========
+ *
+ *  Board drivers of the simulation, see SimBoard.h.
+ */
+#include <errno.h>
+#include <unistd.h>
+
+#include <ti/drivers/PIN.h>
+#include <ti/drivers/UART.h>
+
+#include "Board.h"
+#include "SimBoard.h"
+#include "SimClock.h"
+
+/***** Defines *****/
+
+#define UART_BITS_PER_BYTE  10 // Start, 8 data and stop bit
+#define PIN_COUNT           32
+
+/***** Type declarations *****/
+
+struct UART_Config_
+{
+    UART_Params params;
+    uint8_t open;
+};
+
+/***** Variable declarations *****/
+
+static struct UART_Config_ uart;
+static int uartFd = -1;
+static uint8_t pinValues[PIN_COUNT];
+
+/***** Function definitions *****/
+
+void SimBoard_setUartFd(int fd) {
+    uartFd = fd;
+}
+
+void CC1350STK_initGeneral(void) {
+}
+
+void UART_init(void) {
+}
+
+void UART_Params_init(UART_Params* params) {
+    params->readMode = UART_MODE_BLOCKING;
+    params->writeMode = UART_MODE_BLOCKING;
+    params->readTimeout = ~(uint32_t)0;
+    params->writeTimeout = ~(uint32_t)0;
+    params->readCallback = NULL;
+    params->writeCallback = NULL;
+    params->readReturnMode = UART_RETURN_NEWLINE;
+    params->readDataMode = UART_DATA_TEXT;
+    params->writeDataMode = UART_DATA_TEXT;
+    params->readEcho = UART_ECHO_ON;
+    params->baudRate = 115200;
+}
+
+UART_Handle UART_open(unsigned int index, UART_Params* params) {
+    //The boards have a single UART
+    if(index != 0 || uart.open) {
+        return NULL;
+    }
+    uart.params = *params;
+    uart.open = 1;
+
+    return &uart;
+}
+
+void UART_close(UART_Handle handle) {
+    handle->open = 0;
+}
+
+int_fast32_t UART_write(UART_Handle handle, const void* buf, size_t size) {
+    const uint8_t* data = buf;
+    uint64_t done = SimClock_now() + (uint64_t)size * UART_BITS_PER_BYTE *
+            SIMCLOCK_RAT_HZ / handle->params.baudRate;
+    size_t sent = 0;
+    ssize_t n;
+
+    //The bytes reach the other end once they are all out
+    SimClock_sleepUntil(done);
+    while(uartFd >= 0 && sent < size) {
+        n = write(uartFd, &data[sent], size - sent);
+        if(n < 0 && errno != EINTR) {
+            return UART_ERROR;
+        }
+        sent += (n > 0) ? (size_t)n : 0;
+    }
+
+    if(handle->params.writeMode == UART_MODE_CALLBACK) {
+        handle->params.writeCallback(handle, (void*)buf, size);
+        return 0;
+    }
+
+    return (int_fast32_t)size;
+}
+
+PIN_Handle PIN_open(PIN_State* state, const PIN_Config pinList[]) {
+    (void)pinList;
+
+    return state;
+}
+
+void PIN_close(PIN_Handle handle) {
+    (void)handle;
+}
+
+uint32_t PIN_getOutputValue(PIN_Id pinId) {
+    return (pinId < PIN_COUNT) ? pinValues[pinId] : 0;
+}
+
+int PIN_setOutputValue(PIN_Handle handle, PIN_Id pinId, uint32_t val) {
+    (void)handle;
+    if(pinId < PIN_COUNT) {
+        pinValues[pinId] = (val != 0);
+    }
+
+    return 0;
+}
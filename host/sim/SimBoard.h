@@ -0,0 +1,17 @@
+#ifndef SIMBOARD_H
+#define SIMBOARD_H
+
+/*
+ * Board drivers of the simulation (ti/drivers/UART.h, ti/drivers/PIN.h and
+ * Board_initGeneral), so that the apps' main.c builds on the host as is.
+ *
+ * UART_write waits until its bytes would have gone out at the baud rate on
+ * SimClock's time line, then sends them to a file descriptor, a pipe or a
+ * file. In callback mode it then calls the write callback, as the driver's
+ * Hwi would. Pins only keep their output value.
+ */
+
+/* File descriptor the UART writes to, -1 (the default) drops the bytes */
+void SimBoard_setUartFd(int fd);
+
+#endif /* SIMBOARD_H */
@@ -0,0 +1,66 @@
+/*
+ *  ======== SimClock.c ========
+ */
+//clock_nanosleep is not C99
+#define _DEFAULT_SOURCE
+
+#include <errno.h>
+
+#include "SimClock.h"
+
+/***** Defines *****/
+
+#define NS_PER_S        1000000000ull
+
+/***** Variable declarations *****/
+
+static uint64_t epochNs = 0;
+static uint64_t startTime = 0;
+static uint32_t clockSpeed = 1;
+
+/***** Function definitions *****/
+
+static uint64_t hostNs(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * NS_PER_S + (uint64_t)ts.tv_nsec;
+}
+
+void SimClock_init(uint32_t speed, uint32_t start) {
+    clockSpeed = (speed == 0) ? 1 : speed;
+    startTime = start;
+    epochNs = hostNs();
+}
+
+uint64_t SimClock_now(void) {
+    uint64_t elapsedNs = (hostNs() - epochNs) * clockSpeed;
+
+    //4 ticks per 1000 ns, split so a long run doesn't overflow
+    return startTime + (elapsedNs / NS_PER_S) * SIMCLOCK_RAT_HZ +
+            (elapsedNs % NS_PER_S) * SIMCLOCK_RAT_HZ / NS_PER_S;
+}
+
+uint64_t SimClock_fromAbsTime(uint32_t absTime) {
+    uint64_t now = SimClock_now();
+
+    return now + (int64_t)(int32_t)(absTime - (uint32_t)now);
+}
+
+void SimClock_deadline(uint64_t time, struct timespec* deadline) {
+    uint64_t ticks = (time > startTime) ? time - startTime : 0;
+    uint64_t ns = epochNs + ((ticks / SIMCLOCK_RAT_HZ) * NS_PER_S +
+            (ticks % SIMCLOCK_RAT_HZ) * NS_PER_S / SIMCLOCK_RAT_HZ) / clockSpeed;
+
+    deadline->tv_sec = (time_t)(ns / NS_PER_S);
+    deadline->tv_nsec = (long)(ns % NS_PER_S);
+}
+
+void SimClock_sleepUntil(uint64_t time) {
+    struct timespec deadline;
+
+    SimClock_deadline(time, &deadline);
+    while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) == EINTR) {
+    }
+}
@@ -0,0 +1,31 @@
+#ifndef SIMCLOCK_H
+#define SIMCLOCK_H
+
+#include <stdint.h>
+#include <time.h>
+
+/*
+ * Simulated radio time (RAT, 4 MHz) for the EasyLink simulation and the
+ * TI-RTOS shims. It follows the host's monotonic clock, sped up by a whole
+ * factor so that long runs take less wall time. The 64 bit count never
+ * wraps, EasyLink hands out its low 32 bits as on the device.
+ */
+
+#define SIMCLOCK_RAT_HZ     4000000
+
+/* Starts the clock at startTime, running speed times faster than the host */
+void SimClock_init(uint32_t speed, uint32_t startTime);
+
+/* Current radio time */
+uint64_t SimClock_now(void);
+
+/* Radio time as of a 32 bit absTime, taken as the nearest to now */
+uint64_t SimClock_fromAbsTime(uint32_t absTime);
+
+/* Host monotonic time at which the radio time reaches time */
+void SimClock_deadline(uint64_t time, struct timespec* deadline);
+
+/* Sleeps until the radio time reaches time */
+void SimClock_sleepUntil(uint64_t time);
+
+#endif /* SIMCLOCK_H */
@@ -0,0 +1,69 @@
+#ifndef SIMRADIO_H
+#define SIMRADIO_H
+
+#include <stdint.h>
+
+/*
+ * Host simulation of the radio behind EasyLink.h. EasyLinkSim.c implements
+ * the EasyLink API for simulated nodes sharing one virtual channel, so the
+ * firmware's radio logic runs as host threads, hundreds of nodes at once.
+ *
+ * Each node has a position and the EasyLink state of one device. A thread
+ * acts for the node it is attached to, tasks it creates with the TI-RTOS
+ * shims inherit the node. EasyLink callbacks run on the simulation's engine
+ * thread with the node's Swi lock held, like the RF driver's Swi.
+ *
+ * The channel:
+ *  - time on air from the PHY, with the firmware's AirTime.c
+ *  - RSSI from the log-distance path loss of the distance between nodes
+ *  - a packet is received if the receiver listened on its frequency from
+ *    its start, it is above the sensitivity and no overlapping packet on the
+ *    frequency comes within captureDb of it, otherwise it is a CRC error
+ *  - carrier sense sees the strongest packet on the air at the node
+ *  - radio time is SimClock's 4 MHz RAT
+ */
+
+#define SIMRADIO_MAX_NODES      1024
+
+typedef struct
+{
+    uint32_t speed;             // Simulated seconds per host second
+    uint32_t startTime;         // Radio time at start, to try its wrap
+    double pathLoss1mDb;        // Loss at 1 m
+    double pathLossExponent;
+    int8_t sensitivityDbm;
+    uint8_t captureDb;          // Margin over an overlapping packet to survive it
+} SimRadio_Params;
+
+/* Channel wide counters */
+typedef struct
+{
+    uint64_t transmissions;     // Packets put on the air, aborted ones included
+    uint64_t delivered;         // Receptions with a valid CRC, filtered or not
+    uint64_t collisions;        // Receptions lost to an overlapping packet
+    uint64_t belowSensitivity;  // Receivers listening but out of range
+} SimRadio_Counters;
+
+typedef struct SimNode SimNode;
+
+void SimRadio_Params_init(SimRadio_Params* params);
+
+/* Starts the clock and the engine thread, once before any node is added */
+void SimRadio_init(const SimRadio_Params* params);
+
+/* Adds a node at x, y meters, returns NULL past SIMRADIO_MAX_NODES */
+SimNode* SimRadio_addNode(double x, double y);
+
+/* Makes the calling thread act as node for EasyLink and the shims */
+void SimRadio_attach(SimNode* node);
+
+/* Node of the calling thread, NULL if not attached */
+SimNode* SimRadio_current(void);
+
+void SimRadio_getCounters(SimRadio_Counters* counters);
+
+/* Swi lock of the calling thread's node, see Swi_disable */
+void SimRadio_swiLock(void);
+void SimRadio_swiUnlock(void);
+
+#endif /* SIMRADIO_H */
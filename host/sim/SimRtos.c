@@ -0,0 +1,166 @@
+/*
+ *  ======== SimRtos.c ========
+ *
+ *  TI-RTOS shims of the simulation: tasks are threads of a simulated node,
+ *  time is SimClock's.
+ */
+//pthread_condattr_setclock is not C99
+#define _DEFAULT_SOURCE
+
+#include <stdlib.h>
+
+#include <ti/sysbios/BIOS.h>
+#include <ti/sysbios/knl/Clock.h>
+#include <ti/sysbios/knl/Semaphore.h>
+#include <ti/sysbios/knl/Swi.h>
+#include <ti/sysbios/knl/Task.h>
+
+#include "SimClock.h"
+#include "SimRadio.h"
+
+/***** Defines *****/
+
+#define TICKS_PER_US    (SIMCLOCK_RAT_HZ / 1000000)
+
+/***** Variable declarations *****/
+
+UInt32 Clock_tickPeriod = 10;
+
+/***** Function definitions *****/
+
+static uint64_t ticksToRat(UInt32 ticks) {
+    return (uint64_t)ticks * Clock_tickPeriod * TICKS_PER_US;
+}
+
+UInt32 Clock_getTicks(void) {
+    return (UInt32)(SimClock_now() / ticksToRat(1));
+}
+
+UInt Swi_disable(void) {
+    SimRadio_swiLock();
+
+    return 0;
+}
+
+void Swi_restore(UInt key) {
+    (void)key;
+    SimRadio_swiUnlock();
+}
+
+void BIOS_start(void) {
+}
+
+static void* taskThread(void* arg) {
+    Task_Struct* task = arg;
+
+    SimRadio_attach((SimNode*)task->node);
+    task->fxn(task->arg0, task->arg1);
+
+    return NULL;
+}
+
+void Task_Params_init(Task_Params* params) {
+    params->arg0 = 0;
+    params->arg1 = 0;
+    params->priority = 1;
+    params->stack = NULL;
+    params->stackSize = 0;
+}
+
+void Task_construct(Task_Struct* task, Task_FuncPtr fxn, const Task_Params* params,
+        Error_Block* eb) {
+    (void)eb;
+    task->fxn = fxn;
+    task->arg0 = params->arg0;
+    task->arg1 = params->arg1;
+    task->node = SimRadio_current();
+
+    if(pthread_create(&task->thread, NULL, taskThread, task) != 0) {
+        abort();
+    }
+    pthread_detach(task->thread);
+}
+
+Task_Handle Task_create(Task_FuncPtr fxn, const Task_Params* params, Error_Block* eb) {
+    Task_Handle task = malloc(sizeof(Task_Struct));
+
+    if(task != NULL) {
+        Task_construct(task, fxn, params, eb);
+    }
+
+    return task;
+}
+
+void Task_sleep(UInt32 ticks) {
+    SimClock_sleepUntil(SimClock_now() + ticksToRat(ticks));
+}
+
+void Semaphore_Params_init(Semaphore_Params* params) {
+    params->mode = Semaphore_Mode_COUNTING;
+}
+
+void Semaphore_construct(Semaphore_Struct* sem, Int count, const Semaphore_Params* params) {
+    pthread_condattr_t attr;
+
+    //Timeouts are deadlines on the monotonic clock, as SimClock's
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&sem->cond, &attr);
+    pthread_condattr_destroy(&attr);
+    pthread_mutex_init(&sem->lock, NULL);
+
+    sem->mode = (params != NULL) ? params->mode : Semaphore_Mode_COUNTING;
+    sem->count = (sem->mode == Semaphore_Mode_BINARY && count > 1) ? 1 : (UInt)count;
+}
+
+Semaphore_Handle Semaphore_create(Int count, const Semaphore_Params* params, Error_Block* eb) {
+    Semaphore_Handle sem = malloc(sizeof(Semaphore_Struct));
+
+    (void)eb;
+    if(sem != NULL) {
+        Semaphore_construct(sem, count, params);
+    }
+
+    return sem;
+}
+
+void Semaphore_delete(Semaphore_Handle* sem) {
+    pthread_cond_destroy(&(*sem)->cond);
+    pthread_mutex_destroy(&(*sem)->lock);
+    free(*sem);
+    *sem = NULL;
+}
+
+Bool Semaphore_pend(Semaphore_Handle sem, UInt32 timeout) {
+    struct timespec deadline;
+    Bool taken = FALSE;
+
+    if(timeout != BIOS_WAIT_FOREVER && timeout != BIOS_NO_WAIT) {
+        SimClock_deadline(SimClock_now() + ticksToRat(timeout), &deadline);
+    }
+
+    pthread_mutex_lock(&sem->lock);
+    while(sem->count == 0 && timeout != BIOS_NO_WAIT) {
+        if(timeout == BIOS_WAIT_FOREVER) {
+            pthread_cond_wait(&sem->cond, &sem->lock);
+        } else if(pthread_cond_timedwait(&sem->cond, &sem->lock, &deadline) != 0) {
+            break;
+        }
+    }
+    if(sem->count > 0) {
+        sem->count--;
+        taken = TRUE;
+    }
+    pthread_mutex_unlock(&sem->lock);
+
+    return taken;
+}
+
+void Semaphore_post(Semaphore_Handle sem) {
+    pthread_mutex_lock(&sem->lock);
+    if(sem->mode == Semaphore_Mode_COUNTING || sem->count == 0) {
+        sem->count++;
+    }
+    pthread_cond_signal(&sem->cond);
+    pthread_mutex_unlock(&sem->lock);
+}
@@ -0,0 +1,35 @@
+#ifndef HOST_PIN_H
+#define HOST_PIN_H
+
+#include <stdint.h>
+
+/*
+ * Host stand-in for ti/drivers/PIN.h. Pins keep the output value last set,
+ * so LED toggles read back as on the device, nothing else happens.
+ */
+
+#define PIN_UNASSIGNED          0xFF
+#define PIN_TERMINATE           0xFE
+
+#define PIN_GPIO_OUTPUT_EN      (1u << 23)
+#define PIN_GPIO_LOW            (0u << 22)
+#define PIN_GPIO_HIGH           (1u << 22)
+#define PIN_PUSHPULL            (0u << 25)
+#define PIN_DRVSTR_MAX          (3u << 16)
+
+typedef uint32_t PIN_Config;
+typedef uint32_t PIN_Id;
+
+typedef struct
+{
+    uint32_t unused;
+} PIN_State;
+
+typedef PIN_State* PIN_Handle;
+
+PIN_Handle PIN_open(PIN_State* state, const PIN_Config pinList[]);
+void PIN_close(PIN_Handle handle);
+uint32_t PIN_getOutputValue(PIN_Id pinId);
+int PIN_setOutputValue(PIN_Handle handle, PIN_Id pinId, uint32_t val);
+
+#endif /* HOST_PIN_H */
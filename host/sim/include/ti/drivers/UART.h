@@ -0,0 +1,64 @@
+#ifndef HOST_UART_H
+#define HOST_UART_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Host stand-in for ti/drivers/UART.h, the write side the apps use. Bytes go
+ * to the file descriptor set with SimBoard_setUartFd() and take their time
+ * at the baud rate on the simulated clock, see SimBoard.h.
+ */
+
+#define UART_ERROR          (-1)
+
+typedef struct UART_Config_* UART_Handle;
+
+typedef void (*UART_CallbackFxn)(UART_Handle handle, void* buf, size_t count);
+
+typedef enum
+{
+    UART_MODE_BLOCKING,
+    UART_MODE_CALLBACK
+} UART_Mode;
+
+typedef enum
+{
+    UART_RETURN_FULL,
+    UART_RETURN_NEWLINE
+} UART_ReturnMode;
+
+typedef enum
+{
+    UART_DATA_BINARY,
+    UART_DATA_TEXT
+} UART_DataMode;
+
+typedef enum
+{
+    UART_ECHO_OFF,
+    UART_ECHO_ON
+} UART_Echo;
+
+typedef struct
+{
+    UART_Mode readMode;
+    UART_Mode writeMode;
+    uint32_t readTimeout;
+    uint32_t writeTimeout;
+    UART_CallbackFxn readCallback;
+    UART_CallbackFxn writeCallback;
+    UART_ReturnMode readReturnMode;
+    UART_DataMode readDataMode;
+    UART_DataMode writeDataMode;
+    UART_Echo readEcho;
+    uint32_t baudRate;
+} UART_Params;
+
+void UART_init(void);
+void UART_Params_init(UART_Params* params);
+UART_Handle UART_open(unsigned int index, UART_Params* params);
+void UART_close(UART_Handle handle);
+int_fast32_t UART_write(UART_Handle handle, const void* buf, size_t size);
+
+#endif /* HOST_UART_H */
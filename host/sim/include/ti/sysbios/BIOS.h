@@ -0,0 +1,16 @@
+#ifndef HOST_BIOS_H
+#define HOST_BIOS_H
+
+#include <xdc/std.h>
+
+/*
+ * Host stand-in for ti.sysbios.BIOS. Tasks are threads that run as soon as
+ * they are created, so BIOS_start() has nothing left to do and returns.
+ */
+
+#define BIOS_WAIT_FOREVER   (~(UInt32)0)
+#define BIOS_NO_WAIT        ((UInt32)0)
+
+void BIOS_start(void);
+
+#endif /* HOST_BIOS_H */
@@ -0,0 +1,41 @@
+#ifndef HOST_CLOCK_H
+#define HOST_CLOCK_H
+
+#include <xdc/std.h>
+
+/* Host stand-in for ti.sysbios.knl.Clock, ticks of simulated time */
+
+typedef void (*Clock_FuncPtr)(UArg arg);
+
+typedef struct
+{
+    UInt32 period;              // 0 for a one shot
+    Bool startFlag;
+    UArg arg;
+} Clock_Params;
+
+typedef struct
+{
+    Clock_FuncPtr fxn;
+    UArg arg;
+    UInt32 timeout;
+    UInt32 period;
+    UInt32 due;                 // Time it fires, in the host's own units
+    Bool active;
+} Clock_Struct;
+
+typedef Clock_Struct* Clock_Handle;
+
+/* Tick period in us, as set in the firmware's .cfg */
+extern UInt32 Clock_tickPeriod;
+
+UInt32 Clock_getTicks(void);
+
+void Clock_Params_init(Clock_Params* params);
+void Clock_construct(Clock_Struct* clk, Clock_FuncPtr fxn, UInt timeout, const Clock_Params* params);
+Clock_Handle Clock_handle(Clock_Struct* clk);
+void Clock_setTimeout(Clock_Handle clk, UInt32 timeout);
+void Clock_start(Clock_Handle clk);
+void Clock_stop(Clock_Handle clk);
+
+#endif /* HOST_CLOCK_H */
@@ -0,0 +1,41 @@
+#ifndef HOST_SEMAPHORE_H
+#define HOST_SEMAPHORE_H
+
+#include <pthread.h>
+
+#include <xdc/std.h>
+#include <xdc/runtime/Error.h>
+
+/* Host stand-in for ti.sysbios.knl.Semaphore, timeouts in simulated ticks */
+
+typedef enum
+{
+    Semaphore_Mode_COUNTING,
+    Semaphore_Mode_BINARY
+} Semaphore_Mode;
+
+typedef struct
+{
+    Semaphore_Mode mode;
+} Semaphore_Params;
+
+typedef struct
+{
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    UInt count;
+    Semaphore_Mode mode;
+} Semaphore_Struct;
+
+typedef Semaphore_Struct* Semaphore_Handle;
+
+void Semaphore_Params_init(Semaphore_Params* params);
+void Semaphore_construct(Semaphore_Struct* sem, Int count, const Semaphore_Params* params);
+Semaphore_Handle Semaphore_create(Int count, const Semaphore_Params* params, Error_Block* eb);
+void Semaphore_delete(Semaphore_Handle* sem);
+
+/* Returns FALSE if timeout ticks went by first, BIOS_WAIT_FOREVER waits on */
+Bool Semaphore_pend(Semaphore_Handle sem, UInt32 timeout);
+void Semaphore_post(Semaphore_Handle sem);
+
+#endif /* HOST_SEMAPHORE_H */
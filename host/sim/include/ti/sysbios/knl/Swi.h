@@ -0,0 +1,15 @@
+#ifndef HOST_SWI_H
+#define HOST_SWI_H
+
+#include <xdc/std.h>
+
+/*
+ * Host stand-in for ti.sysbios.knl.Swi. EasyLink callbacks of a simulated
+ * node run with its Swi lock held, so Swi_disable in the node's tasks holds
+ * them off as on the device. Nests like the real one.
+ */
+
+UInt Swi_disable(void);
+void Swi_restore(UInt key);
+
+#endif /* HOST_SWI_H */
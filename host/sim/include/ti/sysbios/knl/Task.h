@@ -0,0 +1,44 @@
+#ifndef HOST_TASK_H
+#define HOST_TASK_H
+
+#include <pthread.h>
+
+#include <xdc/std.h>
+#include <xdc/runtime/Error.h>
+
+/*
+ * Host stand-in for ti.sysbios.knl.Task. A task is a POSIX thread of the
+ * simulated node that constructs it, priorities and stacks are ignored.
+ */
+
+typedef void (*Task_FuncPtr)(UArg arg0, UArg arg1);
+
+typedef struct
+{
+    UArg arg0;
+    UArg arg1;
+    Int priority;
+    Ptr stack;
+    size_t stackSize;
+} Task_Params;
+
+typedef struct
+{
+    pthread_t thread;
+    Task_FuncPtr fxn;
+    UArg arg0;
+    UArg arg1;
+    void* node;
+} Task_Struct;
+
+typedef Task_Struct* Task_Handle;
+
+void Task_Params_init(Task_Params* params);
+void Task_construct(Task_Struct* task, Task_FuncPtr fxn, const Task_Params* params,
+        Error_Block* eb);
+Task_Handle Task_create(Task_FuncPtr fxn, const Task_Params* params, Error_Block* eb);
+
+/* Sleeps for ticks of Clock_tickPeriod of simulated time */
+void Task_sleep(UInt32 ticks);
+
+#endif /* HOST_TASK_H */
@@ -0,0 +1,10 @@
+#ifndef HOST_XDC_ASSERT_H
+#define HOST_XDC_ASSERT_H
+
+#include <assert.h>
+
+/* Host stand-in for xdc.runtime.Assert */
+
+#define Assert_isTrue(expr, id) assert(expr)
+
+#endif /* HOST_XDC_ASSERT_H */
@@ -0,0 +1,14 @@
+#ifndef HOST_XDC_ERROR_H
+#define HOST_XDC_ERROR_H
+
+/* Host stand-in for xdc.runtime.Error, the shims report errors by return value */
+
+typedef struct
+{
+    int unused;
+} Error_Block;
+
+#define Error_init(eb) ((void)(eb))
+#define Error_check(eb) (0)
+
+#endif /* HOST_XDC_ERROR_H */
@@ -0,0 +1,17 @@
+#ifndef HOST_XDC_SYSTEM_H
+#define HOST_XDC_SYSTEM_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Host stand-in for xdc.runtime.System */
+
+#define System_abort(msg) do { \
+        fprintf(stderr, "System_abort: %s\n", (msg)); \
+        abort(); \
+    } while(0)
+
+#define System_printf printf
+#define System_flush() fflush(stdout)
+
+#endif /* HOST_XDC_SYSTEM_H */
@@ -0,0 +1,34 @@
+#ifndef HOST_XDC_STD_H
+#define HOST_XDC_STD_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Host stand-in for the XDCtools base types, only those the firmware uses.
+ * The TI-RTOS shims next to it run the firmware's tasks as POSIX threads of
+ * a simulated node, see SimRadio.h.
+ */
+
+typedef uintptr_t UArg;
+typedef unsigned int UInt;
+typedef int Int;
+typedef uint32_t UInt32;
+typedef uint16_t UInt16;
+typedef uint8_t UInt8;
+typedef int32_t Int32;
+typedef bool Bool;
+typedef void* Ptr;
+typedef char Char;
+typedef char* String;
+typedef void Void;
+
+#ifndef TRUE
+#define TRUE    true
+#endif
+#ifndef FALSE
+#define FALSE   false
+#endif
+
+#endif /* HOST_XDC_STD_H */
@@ -0,0 +1,177 @@
+/*
+ *  ======== simios_decode.c ========
+ *
+ *  Prints the binary UART frames of the central (RFEASYLINKRX_UART_BINARY)
+ *  as text, one line per frame and one per measure of each AP report:
+ *
+ *      simios_decode [file or serial device]
+ *
+ *  Reads stdin without an argument. A serial device is set to 115200 8N1 raw.
+ *  CRC errors and gaps in the seq of each frame type are summed up at the end.
+ */
+#include <stdio.h>
+#include <unistd.h>
+
+#include "Serial.h"
+#include "UartReport.h"
+
+/***** Defines *****/
+
+#define READ_SIZE       256
+#define FRAME_TYPES     (UART_FRAME_TYPE_LINK_STATS + 1)
+
+/***** Variable declarations *****/
+
+static const char* typeNames[FRAME_TYPES] = {
+    NULL, "report", "timed", "status", "radio", "link"
+};
+
+static uint8_t seqSeen[FRAME_TYPES];
+static uint8_t lastSeq[FRAME_TYPES];
+static uint32_t seqGaps[FRAME_TYPES];
+static uint32_t frames = 0;
+static uint32_t badFrames = 0;
+
+/***** Function definitions *****/
+
+static void countSeq(uint8_t type, uint8_t seq) {
+    if(type >= FRAME_TYPES) {
+        return;
+    }
+    if(seqSeen[type]) {
+        seqGaps[type] += (uint8_t)(seq - lastSeq[type] - 1);
+    }
+    seqSeen[type] = 1;
+    lastSeq[type] = seq;
+}
+
+static void printApReport(UartReport_ApReport* ap, uint8_t seq) {
+    Uplink_Decoder* uplink = &ap->uplink;
+    Uplink_Telemetry* t = &uplink->telemetry;
+    Uplink_Measure m;
+
+    printf("report seq=%u ap=%u uplink=%u flags=0x%02x", seq, uplink->apId,
+            uplink->seq, uplink->flags);
+    if(ap->timed) {
+        printf(" rxTime=%lu", (unsigned long)ap->rxTime);
+    }
+    printf("\n");
+
+    if(uplink->flags & UPLINK_FLAG_TELEMETRY) {
+        printf("  telemetry rxOk=%u rxNok=%u rxTimeouts=%u txOk=%u txAborts=%u"
+                " txErrors=%u busyErrors=%u ccaRetries=%u\n", t->rxOk, t->rxNok,
+                t->rxTimeouts, t->txOk, t->txAborts, t->txErrors, t->busyErrors,
+                t->ccaRetries);
+    }
+
+    while(Uplink_decodeNext(uplink, &m)) {
+        printf("  tag=%u rssi=-%u delta=%u", m.id, m.rssi, m.delta);
+        if(uplink->flags & UPLINK_FLAG_RSSI_STATS) {
+            printf(" min=-%u max=-%u var=%u", m.rssiMin, m.rssiMax, m.rssiVariance);
+        }
+        if(uplink->flags & UPLINK_FLAG_DISTANCE) {
+            printf(" distance=%u", m.distance);
+        }
+        if(uplink->flags & UPLINK_FLAG_BEACON_LOSS) {
+            printf(" beacons=%u lost=%u", m.beacons, m.beaconsLost);
+        }
+        printf("\n");
+    }
+}
+
+static void printReport(UartReport* report) {
+    UartReport_Status* s = &report->u.status;
+    UartReport_RadioStats* r = &report->u.radio;
+    UartReport_LinkStats* l = &report->u.link;
+    uint8_t i;
+
+    switch(report->type) {
+        case UART_FRAME_TYPE_AP_REPORT:
+        case UART_FRAME_TYPE_AP_REPORT_TIMED:
+            printApReport(&report->u.ap, report->seq);
+            break;
+        case UART_FRAME_TYPE_STATUS:
+            printf("status seq=%u packets=%lu drops=%lu bytesSent=%lu uplinksLost=%lu\n",
+                    report->seq, (unsigned long)s->packets, (unsigned long)s->drops,
+                    (unsigned long)s->bytesSent, (unsigned long)s->uplinksLost);
+            break;
+        case UART_FRAME_TYPE_RADIO_STATS:
+            printf("radio seq=%u rxOk=%lu rxNok=%lu rxIgnored=%lu rxBufFull=%lu"
+                    " rxTimeouts=%lu rxAborts=%lu rxErrors=%lu txOk=%lu"
+                    " txAborts=%lu txErrors=%lu busyErrors=%lu lastRssi=%d\n",
+                    report->seq, (unsigned long)r->rxOk, (unsigned long)r->rxNok,
+                    (unsigned long)r->rxIgnored, (unsigned long)r->rxBufFull,
+                    (unsigned long)r->rxTimeouts, (unsigned long)r->rxAborts,
+                    (unsigned long)r->rxErrors, (unsigned long)r->txOk,
+                    (unsigned long)r->txAborts, (unsigned long)r->txErrors,
+                    (unsigned long)r->busyErrors, r->lastRssi);
+            break;
+        case UART_FRAME_TYPE_LINK_STATS:
+            printf("link seq=%u ap=%u delivery=%u.%u%% received=%lu lost=%lu resyncs=%lu gaps=",
+                    report->seq, l->apId, l->deliveryPermille / 10,
+                    l->deliveryPermille % 10, (unsigned long)l->stats.received,
+                    (unsigned long)l->stats.lost, (unsigned long)l->stats.resyncs);
+            for(i = 0; i < LINKSTATS_GAP_BUCKETS; i++) {
+                printf(i == 0 ? "%lu" : ",%lu", (unsigned long)l->stats.gaps[i]);
+            }
+            printf("\n");
+            break;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    static UartFrame_Decoder decoder;
+
+    uint8_t buf[READ_SIZE];
+    UartReport report;
+    ssize_t n;
+    ssize_t i;
+    uint8_t type;
+    int fd;
+
+    if(argc > 2) {
+        fprintf(stderr, "usage: %s [file or serial device]\n", argv[0]);
+        return 2;
+    }
+
+    fd = (argc == 2) ? Serial_open(argv[1], 0) : STDIN_FILENO;
+    if(fd < 0) {
+        return 1;
+    }
+
+    UartFrame_decoderInit(&decoder);
+    while((n = read(fd, buf, sizeof(buf))) > 0) {
+        for(i = 0; i < n; i++) {
+            if(!UartFrame_decode(&decoder, buf[i])) {
+                continue;
+            }
+            frames++;
+            countSeq(decoder.type, decoder.seq);
+            if(UartReport_parse(&report, &decoder) != 0) {
+                badFrames++;
+                printf("unknown seq=%u type=0x%02x len=%u\n", decoder.seq,
+                        decoder.type, decoder.len);
+                continue;
+            }
+            printReport(&report);
+        }
+        fflush(stdout);
+    }
+    if(n < 0) {
+        perror("read");
+    }
+
+    fprintf(stderr, "%lu frames, %lu unknown, %lu CRC errors, seq gaps",
+            (unsigned long)frames, (unsigned long)badFrames,
+            (unsigned long)decoder.crcErrors);
+    for(type = UART_FRAME_TYPE_AP_REPORT; type < FRAME_TYPES; type++) {
+        fprintf(stderr, " %s=%lu", typeNames[type], (unsigned long)seqGaps[type]);
+    }
+    fprintf(stderr, "\n");
+
+    if(fd != STDIN_FILENO) {
+        close(fd);
+    }
+
+    return n < 0 ? 1 : 0;
+}
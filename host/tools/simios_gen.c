@@ -0,0 +1,162 @@
+/*
+ *  ======== simios_gen.c ========
+ *
+ *  Feeds a pseudo-terminal with the central's UART output, made by
+ *  CentralGen, to run simios_ingest or simios_decode without boards:
+ *
+ *      simios_gen [-f text|binary] [-a aps] [-t tags] [-r reports/s] [-c reports]
+ *                 [-T start time]
+ *
+ *  -f is the central's format, binary frames (RFEASYLINKRX_UART_BINARY, the
+ *  default here) or the text records of the central's default build.
+ *  Prints the path of the terminal to open, waits a second, then writes the
+ *  reports of aps APs hearing tags tags each, in binary with a status frame
+ *  every second of radio time. -r 0 writes as fast as the reader takes them.
+ *  The radio time starts at -T so the wrap of the 32 bit time can be tried. Closes the
+ *  terminal after -c reports, the reader then sees it hang up.
+ */
+//posix_openpt and friends, nanosleep are not C99
+#define _DEFAULT_SOURCE
+#define _XOPEN_SOURCE 600
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "CentralGen.h"
+#include "Ingest.h"
+#include "Serial.h"
+
+/***** Defines *****/
+
+#define START_DELAY_S       1
+#define STATUS_PERIOD       (1000 * INGEST_RAT_TICKS_PER_MS)
+#define DRAIN_POLL_NS       10000000
+
+/***** Function definitions *****/
+
+static int writeAll(int fd, const uint8_t* data, uint16_t len) {
+    ssize_t n;
+
+    while(len > 0) {
+        n = write(fd, data, len);
+        if(n <= 0) {
+            perror("write");
+            return -1;
+        }
+        data += n;
+        len -= (uint16_t)n;
+    }
+
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    static CentralGen gen;
+
+    uint8_t frame[CENTRALGEN_MAX_REPORT_SIZE + UART_FRAME_MAX_SIZE]; // A report and a status
+    struct timespec drainPoll = {0, DRAIN_POLL_NS};
+    int pending;
+    uint8_t format = INGEST_FORMAT_BINARY;
+    unsigned long aps = 4;
+    unsigned long tags = 20;
+    unsigned long rate = 50;
+    unsigned long count = 1000;
+    uint32_t time = 0;
+    uint32_t lastStatus;
+    struct timespec period;
+    unsigned long i;
+    uint16_t len;
+    int master;
+    int slave;
+    int opt;
+
+    while((opt = getopt(argc, argv, "f:a:t:r:c:T:")) != -1) {
+        switch(opt) {
+            case 'f':
+                if(strcmp(optarg, "text") == 0) {
+                    format = INGEST_FORMAT_TEXT;
+                } else if(strcmp(optarg, "binary") == 0) {
+                    format = INGEST_FORMAT_BINARY;
+                } else {
+                    fprintf(stderr, "format must be text or binary\n");
+                    return 2;
+                }
+                break;
+            case 'a':
+                aps = strtoul(optarg, NULL, 0);
+                break;
+            case 't':
+                tags = strtoul(optarg, NULL, 0);
+                break;
+            case 'r':
+                rate = strtoul(optarg, NULL, 0);
+                break;
+            case 'c':
+                count = strtoul(optarg, NULL, 0);
+                break;
+            case 'T':
+                time = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-f text|binary] [-a aps] [-t tags] [-r reports/s]"
+                        " [-c reports] [-T start time]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    master = posix_openpt(O_RDWR | O_NOCTTY);
+    if(master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {
+        perror("posix_openpt");
+        return 1;
+    }
+
+    //Raw before the first byte so the line discipline passes the frames as
+    //they are. The slave stays open so it keeps its settings until the end
+    slave = Serial_open(ptsname(master), 0);
+    if(slave < 0) {
+        return 1;
+    }
+
+    printf("%s\n", ptsname(master));
+    fflush(stdout);
+    sleep(START_DELAY_S);
+
+    CentralGen_init(&gen, (uint8_t)aps, (uint8_t)tags, format);
+    len = CentralGen_start(&gen, frame);
+    if(writeAll(master, frame, len) != 0) {
+        return 1;
+    }
+
+    period.tv_sec = rate ? (time_t)(1 / rate) : 0;
+    period.tv_nsec = rate ? (long)(1000000000UL / rate % 1000000000UL) : 0;
+    lastStatus = time;
+    for(i = 0; i < count; i++) {
+        //The radio time moves on by the report period, 1 ms without a rate
+        time += rate ? 1000 * INGEST_RAT_TICKS_PER_MS / rate : INGEST_RAT_TICKS_PER_MS;
+        len = CentralGen_report(&gen, frame, time, NULL, NULL);
+        if(time - lastStatus >= STATUS_PERIOD) {
+            lastStatus = time;
+            len += CentralGen_status(&gen, &frame[len]);
+        }
+        if(writeAll(master, frame, len) != 0) {
+            return 1;
+        }
+        if(rate) {
+            nanosleep(&period, NULL);
+        }
+    }
+
+    //A hang up discards what the reader has not read yet, wait for it
+    while(ioctl(slave, FIONREAD, &pending) == 0 && pending > 0) {
+        nanosleep(&drainPoll, NULL);
+    }
+    close(slave);
+    close(master);
+
+    return 0;
+}
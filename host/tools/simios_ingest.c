@@ -0,0 +1,342 @@
+/*
+ *  ======== simios_ingest.c ========
+ *
+ *  Ingest daemon of the central's UART output (see Ingest.h):
+ *
+ *      simios_ingest [-f text|binary] [-o file] [-m shm name] [-n shm records]
+ *                    [-s seconds] device...
+ *
+ *  -f is the format the centrals were built with, binary frames by default or
+ *  the text records of the central's default build. A reader thread polls
+ *  every device with non-blocking reads and queues the records of their AP
+ *  reports, the main thread writes them to each sink: CSV to file (- for stdout, the default without any sink) and a
+ *  shared memory ring (see IngestSink.h). Every -s seconds, and at the end,
+ *  throughput, drops and the read to sink latency are printed to stderr.
+ *  Runs until every device has hung up or on SIGINT/SIGTERM.
+ */
+//clock_gettime and nanosleep are not C99
+#define _DEFAULT_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "Ingest.h"
+#include "IngestQueue.h"
+#include "IngestSink.h"
+#include "Serial.h"
+
+/***** Defines *****/
+
+#define MAX_DEVICES         16
+#define MAX_SINKS           2
+#define QUEUE_SIZE          65536   // Records, power of two
+#define READ_SIZE           4096
+#define POLL_TIMEOUT_MS     100
+#define IDLE_SLEEP_NS       100000  // Sink thread sleep when the queue is empty
+#define SHM_RECORDS         65536
+#define STATS_PERIOD_S      10
+
+/***** Type declarations *****/
+
+typedef struct
+{
+    uint64_t records;
+    uint64_t latencyNs;
+    uint64_t maxLatencyNs;
+    uint64_t sinkErrors;
+} SinkStats;
+
+typedef struct
+{
+    uint64_t bytes;
+    uint64_t records;
+    uint64_t crcErrors;
+    uint64_t seqGaps;
+    uint64_t badFrames;
+    uint64_t centralDrops;
+} DeviceTotals;
+
+/***** Variable declarations *****/
+
+static volatile sig_atomic_t stopping = 0;
+
+static IngestDevice devices[MAX_DEVICES];
+static int deviceFds[MAX_DEVICES];
+static const char* devicePaths[MAX_DEVICES];
+static uint8_t deviceCount = 0;
+static pthread_mutex_t deviceLock = PTHREAD_MUTEX_INITIALIZER;
+
+static IngestRecord queueRecords[QUEUE_SIZE];
+static IngestQueue queue;
+static atomic_int readerDone = 0;
+
+static IngestSink sinks[MAX_SINKS];
+static uint8_t sinkCount = 0;
+
+/***** Function definitions *****/
+
+static uint64_t nowNs(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void onSignal(int sig) {
+    (void)sig;
+    stopping = 1;
+}
+
+static int pushRecord(void* arg, const IngestRecord* record) {
+    return IngestQueue_push((IngestQueue*)arg, record);
+}
+
+static void* readerFxn(void* arg) {
+    struct pollfd fds[MAX_DEVICES];
+    uint8_t buf[READ_SIZE];
+    uint8_t open = deviceCount;
+    uint64_t hostNs;
+    ssize_t n;
+    uint8_t i;
+
+    (void)arg;
+    for(i = 0; i < deviceCount; i++) {
+        fds[i].fd = deviceFds[i];
+        fds[i].events = POLLIN;
+    }
+
+    while(!stopping && open > 0) {
+        if(poll(fds, deviceCount, POLL_TIMEOUT_MS) < 0) {
+            if(errno != EINTR) {
+                perror("poll");
+                break;
+            }
+            continue;
+        }
+
+        for(i = 0; i < deviceCount; i++) {
+            if(fds[i].fd < 0 || fds[i].revents == 0) {
+                continue;
+            }
+
+            //Drains the device, a hang up may still leave bytes to read
+            while((n = read(fds[i].fd, buf, sizeof(buf))) > 0) {
+                hostNs = nowNs();
+                pthread_mutex_lock(&deviceLock);
+                Ingest_feed(&devices[i], buf, (uint32_t)n, hostNs, pushRecord, &queue);
+                pthread_mutex_unlock(&deviceLock);
+            }
+
+            if(n == 0 || (n < 0 && errno != EAGAIN && errno != EINTR)) {
+                if(n < 0 && errno != EIO) {
+                    perror(devicePaths[i]);
+                }
+                //A pty whose writer closed reads EIO rather than end of file
+                fprintf(stderr, "%s: closed\n", devicePaths[i]);
+                close(fds[i].fd);
+                fds[i].fd = -1;
+                open--;
+            }
+        }
+    }
+
+    for(i = 0; i < deviceCount; i++) {
+        if(fds[i].fd >= 0) {
+            close(fds[i].fd);
+        }
+    }
+    atomic_store(&readerDone, 1);
+
+    return NULL;
+}
+
+static void sumDevices(DeviceTotals* totals) {
+    uint8_t i;
+
+    memset(totals, 0, sizeof(*totals));
+    pthread_mutex_lock(&deviceLock);
+    for(i = 0; i < deviceCount; i++) {
+        totals->bytes += devices[i].stats.bytes;
+        totals->records += devices[i].stats.records;
+        totals->crcErrors += devices[i].decoder.crcErrors;
+        totals->seqGaps += devices[i].stats.seqGaps;
+        totals->badFrames += devices[i].stats.badFrames;
+        totals->centralDrops += devices[i].stats.centralDrops;
+    }
+    pthread_mutex_unlock(&deviceLock);
+}
+
+static void printStats(const DeviceTotals* now, const DeviceTotals* last,
+        const SinkStats* sink, double seconds) {
+    fprintf(stderr, "ingest: %.0f B/s %.0f records/s, %" PRIu64 " records,"
+            " dropped %u queue %" PRIu64 " central, %" PRIu64 " CRC errors,"
+            " %" PRIu64 " seq gaps, %" PRIu64 " bad frames, %" PRIu64 " sink errors,"
+            " latency avg %" PRIu64 " us max %" PRIu64 " us\n",
+            (now->bytes - last->bytes) / seconds,
+            (now->records - last->records) / seconds, now->records,
+            atomic_load(&queue.drops), now->centralDrops, now->crcErrors,
+            now->seqGaps, now->badFrames, sink->sinkErrors,
+            sink->records ? sink->latencyNs / sink->records / 1000 : 0,
+            sink->maxLatencyNs / 1000);
+}
+
+static void usage(const char* name) {
+    fprintf(stderr, "usage: %s [-f text|binary] [-o file] [-m shm name] [-n shm records]"
+            " [-s seconds] device...\n", name);
+}
+
+static int addCsvSink(const char* path) {
+    FILE* file = (strcmp(path, "-") == 0) ? stdout : fopen(path, "w");
+
+    if(file == NULL) {
+        perror(path);
+        return -1;
+    }
+
+    return IngestSink_openCsv(&sinks[sinkCount++], file, file != stdout);
+}
+
+int main(int argc, char* argv[]) {
+    struct sigaction sa;
+    struct timespec idle = {0, IDLE_SLEEP_NS};
+    const char* csvPath = NULL;
+    const char* shmName = NULL;
+    unsigned long shmRecords = SHM_RECORDS;
+    unsigned long statsPeriod = STATS_PERIOD_S;
+    uint8_t format = INGEST_FORMAT_BINARY;
+    DeviceTotals totals;
+    DeviceTotals lastTotals;
+    SinkStats sinkStats;
+    IngestRecord record;
+    pthread_t reader;
+    uint64_t lastStats;
+    uint64_t latency;
+    uint64_t now;
+    uint8_t i;
+    int done;
+    int opt;
+
+    while((opt = getopt(argc, argv, "f:o:m:n:s:")) != -1) {
+        switch(opt) {
+            case 'f':
+                if(strcmp(optarg, "text") == 0) {
+                    format = INGEST_FORMAT_TEXT;
+                } else if(strcmp(optarg, "binary") == 0) {
+                    format = INGEST_FORMAT_BINARY;
+                } else {
+                    usage(argv[0]);
+                    return 2;
+                }
+                break;
+            case 'o':
+                csvPath = optarg;
+                break;
+            case 'm':
+                shmName = optarg;
+                break;
+            case 'n':
+                shmRecords = strtoul(optarg, NULL, 0);
+                break;
+            case 's':
+                statsPeriod = strtoul(optarg, NULL, 0);
+                break;
+            default:
+                usage(argv[0]);
+                return 2;
+        }
+    }
+    if(optind == argc || argc - optind > MAX_DEVICES || statsPeriod == 0) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    for(i = 0; optind + i < argc; i++) {
+        devicePaths[i] = argv[optind + i];
+        deviceFds[i] = Serial_open(devicePaths[i], O_NONBLOCK);
+        if(deviceFds[i] < 0) {
+            return 1;
+        }
+        Ingest_deviceInit(&devices[i], i, format);
+        deviceCount++;
+    }
+
+    IngestQueue_init(&queue, queueRecords, QUEUE_SIZE);
+    if(csvPath != NULL || shmName == NULL) {
+        if(addCsvSink(csvPath != NULL ? csvPath : "-") != 0) {
+            return 1;
+        }
+    }
+    if(shmName != NULL &&
+            IngestSink_openShm(&sinks[sinkCount++], shmName, (uint32_t)shmRecords) != 0) {
+        perror(shmName);
+        return 1;
+    }
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = onSignal;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    if(pthread_create(&reader, NULL, readerFxn, NULL) != 0) {
+        fprintf(stderr, "pthread_create failed\n");
+        return 1;
+    }
+
+    memset(&sinkStats, 0, sizeof(sinkStats));
+    memset(&lastTotals, 0, sizeof(lastTotals));
+    lastStats = nowNs();
+
+    while(1) {
+        //Read before the pop, the queue is empty for good once the reader
+        //was done before it came up empty
+        done = atomic_load(&readerDone);
+        if(IngestQueue_pop(&queue, &record)) {
+            for(i = 0; i < sinkCount; i++) {
+                if(!IngestSink_write(&sinks[i], &record)) {
+                    sinkStats.sinkErrors++;
+                }
+            }
+            latency = nowNs() - record.hostNs;
+            sinkStats.records++;
+            sinkStats.latencyNs += latency;
+            if(latency > sinkStats.maxLatencyNs) {
+                sinkStats.maxLatencyNs = latency;
+            }
+        } else if(done) {
+            break;
+        } else {
+            for(i = 0; i < sinkCount; i++) {
+                IngestSink_flush(&sinks[i]);
+            }
+            nanosleep(&idle, NULL);
+        }
+
+        now = nowNs();
+        if(now - lastStats >= statsPeriod * 1000000000u) {
+            sumDevices(&totals);
+            printStats(&totals, &lastTotals, &sinkStats, (now - lastStats) / 1e9);
+            lastTotals = totals;
+            lastStats = now;
+        }
+    }
+    pthread_join(reader, NULL);
+
+    for(i = 0; i < sinkCount; i++) {
+        IngestSink_close(&sinks[i]);
+    }
+    sumDevices(&totals);
+    now = nowNs();
+    printStats(&totals, &lastTotals, &sinkStats, now > lastStats ? (now - lastStats) / 1e9 : 1);
+
+    return 0;
+}
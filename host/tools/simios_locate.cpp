@@ -0,0 +1,198 @@
+/*
+ *  ======== simios_locate.cpp ========
+ *
+ *  Tag positions from the ingest daemon's CSV records (see Locate.h):
+ *
+ *      simios_locate -a aps [-w window ms] [-m min aps] [-j threads]
+ *                    [-r rssi at 1 m] [-n path loss] [csv file]
+ *
+ *  Reads stdin without a file, so it can follow simios_ingest -o -. The AP
+ *  positions file has one "apId x y" line per AP, in m. Every window of
+ *  central time the tags heard are solved as one batch, over -j threads, and
+ *  their fixes printed as "time,tag,x,y,rms,aps" lines, time in radio ticks
+ *  as the records have it. Counts and the solve rate go to stderr at the end.
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+
+#include "Locate.h"
+
+/***** Defines *****/
+
+#define WINDOW_MS       3000    // Three DELTA_TIME_UNIT_MS, the age of a measure is in whole seconds
+#define MIN_APS         3
+#define LINE_SIZE       512
+
+/***** Type declarations *****/
+
+typedef struct
+{
+    uint64_t lines;
+    uint64_t badLines;
+    uint64_t records;
+    uint64_t unknownAps;
+    uint64_t fixes;
+    uint64_t collinear;
+    uint64_t solveNs;
+} Counts;
+
+/***** Function definitions *****/
+
+static void usage(const char* name) {
+    fprintf(stderr, "usage: %s -a aps [-w window ms] [-m min aps] [-j threads]"
+            " [-r rssi at 1 m] [-n path loss] [csv file]\n", name);
+}
+
+static void solve(Multilat_Batch& batch, std::vector<Multilat_Fix>& fixes, unsigned threads,
+        Counts* counts) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    size_t i;
+
+    Multilat_solve(batch, fixes, threads);
+    counts->solveNs += std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+
+    for(i = 0; i < fixes.size(); i++) {
+        if(!fixes[i].ok) {
+            counts->collinear++;
+            continue;
+        }
+        counts->fixes++;
+        printf("%lld,%u,%.2f,%.2f,%.2f,%u\n", (long long)fixes[i].time, fixes[i].tag,
+                fixes[i].x, fixes[i].y, fixes[i].rms, fixes[i].aps);
+    }
+    fflush(stdout);
+    batch.clear();
+}
+
+int main(int argc, char* argv[]) {
+    Locate_RangeModel model = LOCATE_RANGE_MODEL_DEFAULT;
+    Locate_ApLayout layout;
+    Multilat_Batch batch;
+    std::vector<Multilat_Fix> fixes;
+    Locate_Record record;
+    Counts counts;
+    std::string error;
+    char line[LINE_SIZE];
+    const char* apsPath = NULL;
+    unsigned windowMs = WINDOW_MS;
+    unsigned minAps = MIN_APS;
+    unsigned threads = 1;
+    bool started = false;
+    int64_t newest = 0;
+    int64_t nextFlush = 0;
+    int64_t window;
+    FILE* file;
+    FILE* in = stdin;
+    int opt;
+
+    while((opt = getopt(argc, argv, "a:w:m:j:r:n:")) != -1) {
+        switch(opt) {
+            case 'a':
+                apsPath = optarg;
+                break;
+            case 'w':
+                windowMs = (unsigned)strtoul(optarg, NULL, 0);
+                break;
+            case 'm':
+                minAps = (unsigned)strtoul(optarg, NULL, 0);
+                break;
+            case 'j':
+                threads = (unsigned)strtoul(optarg, NULL, 0);
+                break;
+            case 'r':
+                model.rssi1m = (uint8_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'n':
+                model.pathLoss = strtof(optarg, NULL);
+                break;
+            default:
+                usage(argv[0]);
+                return 2;
+        }
+    }
+    if(apsPath == NULL || optind + 1 < argc || windowMs == 0 || minAps < 3 ||
+            minAps > MULTILAT_MAX_APS || model.pathLoss <= 0) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    file = fopen(apsPath, "r");
+    if(file == NULL) {
+        perror(apsPath);
+        return 1;
+    }
+    if(!layout.load(file, &error)) {
+        fprintf(stderr, "%s: %s\n", apsPath, error.c_str());
+        fclose(file);
+        return 1;
+    }
+    fclose(file);
+    if(layout.size() < minAps) {
+        fprintf(stderr, "%s: %u APs, at least %u are needed\n", apsPath, layout.size(), minAps);
+        return 1;
+    }
+
+    if(optind < argc) {
+        in = fopen(argv[optind], "r");
+        if(in == NULL) {
+            perror(argv[optind]);
+            return 1;
+        }
+    }
+
+    memset(&counts, 0, sizeof(counts));
+    window = (int64_t)windowMs * LOCATE_RAT_TICKS_PER_MS;
+    Locate_Grouper grouper(layout, window, (uint8_t)minAps);
+    printf("time,tag,x,y,rms,aps\n");
+    while(fgets(line, sizeof(line), in) != NULL) {
+        counts.lines++;
+        if(!Locate_parseCsv(line, &record)) {
+            //The header is no record either
+            if(counts.lines > 1 || strncmp(line, "host_ns,", 8) != 0) {
+                counts.badLines++;
+            }
+            continue;
+        }
+        counts.records++;
+
+        //Measures are dated back by their age, the newest one is the stream's
+        //time. A record past the window solves the tags heard before it.
+        if(started && record.time >= nextFlush) {
+            grouper.flush(newest, batch);
+            solve(batch, fixes, threads, &counts);
+            nextFlush = record.time + window;
+        }
+        if(!started) {
+            nextFlush = record.time + window;
+            newest = record.time;
+            started = true;
+        }
+        if(record.time > newest) {
+            newest = record.time;
+        }
+
+        if(!grouper.add(record, Locate_range(model, record))) {
+            counts.unknownAps++;
+        }
+    }
+    if(started) {
+        grouper.flush(newest, batch);
+        solve(batch, fixes, threads, &counts);
+    }
+
+    fprintf(stderr, "%llu records, %llu bad lines, %llu of unknown APs, %llu fixes,"
+            " %llu collinear, %.0f fixes/s solved\n", (unsigned long long)counts.records,
+            (unsigned long long)counts.badLines, (unsigned long long)counts.unknownAps,
+            (unsigned long long)counts.fixes, (unsigned long long)counts.collinear,
+            counts.solveNs ? (counts.fixes + counts.collinear) * 1e9 / counts.solveNs : 0.0);
+
+    if(in != stdin) {
+        fclose(in);
+    }
+
+    return 0;
+}
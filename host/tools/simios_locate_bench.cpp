@@ -0,0 +1,206 @@
+/*
+ *  ======== simios_locate_bench.cpp ========
+ *
+ *  Multilateration throughput on a synthetic trace:
+ *
+ *      simios_locate_bench [-t tags] [-s seconds] [-j max threads]
+ *
+ *  A 4 x 4 grid of APs 15 m apart, tags walking among them. Each second every
+ *  tag is heard by the APs within 25 m with the APs' path loss model, +-3 dB
+ *  of fading and the RSSI in whole dB, as their uplinks would carry it. The
+ *  records go through Locate_Grouper with a one second window, then the
+ *  batch is solved on 1, 2, 4... threads up to -j, by default the cores.
+ *
+ *  Prints the grouping rate, the solve rate for each thread count and the
+ *  median and 90th percentile position error against where the tags were.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <unistd.h>
+
+#include "Locate.h"
+
+/***** Defines *****/
+
+#define GRID            4
+#define SPACING         15.0f   // m
+#define HEARD_RANGE     25.0f   // m
+#define FADING_DB       3.0f    // Standard deviation
+#define SPEED           1.4f    // m/s, walking
+#define TAGS            255
+#define SECONDS         200
+#define TICKS_PER_S     ((int64_t)1000 * LOCATE_RAT_TICKS_PER_MS)
+
+/***** Type declarations *****/
+
+typedef struct
+{
+    float x;
+    float y;
+    float heading;
+} Walker;
+
+/***** Variable declarations *****/
+
+static uint32_t randomState = 1;
+
+/***** Function definitions *****/
+
+static double nowS(void) {
+    return std::chrono::duration<double>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/* Next pseudo random number, the same run every time */
+static uint32_t nextRandom(void) {
+    randomState = randomState * 1664525u + 1013904223u;
+
+    return randomState >> 8;
+}
+
+static float uniform(void) {
+    return (nextRandom() + 0.5f) / (1u << 24);
+}
+
+static float gaussian(void) {
+    return std::sqrt(-2.0f * std::log(uniform())) * std::cos(6.2831853f * uniform());
+}
+
+static void walk(Walker* w, float side) {
+    w->heading += 0.5f * gaussian();
+    w->x += SPEED * std::cos(w->heading);
+    w->y += SPEED * std::sin(w->heading);
+    //Turns back at the walls
+    if(w->x < 0 || w->x > side || w->y < 0 || w->y > side) {
+        w->x = std::min(std::max(w->x, 0.0f), side);
+        w->y = std::min(std::max(w->y, 0.0f), side);
+        w->heading += 3.1415927f;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const Locate_RangeModel model = LOCATE_RANGE_MODEL_DEFAULT;
+    const float side = (GRID - 1) * SPACING;
+    Locate_ApLayout layout;
+    Multilat_Batch batch;
+    std::vector<Multilat_Fix> fixes;
+    std::vector<Walker> walkers;
+    std::vector<float> truthX;
+    std::vector<float> truthY;
+    std::vector<float> errors;
+    Locate_Record record;
+    unsigned tags = TAGS;
+    unsigned seconds = SECONDS;
+    unsigned maxThreads = std::thread::hardware_concurrency();
+    unsigned threads;
+    uint64_t records = 0;
+    double groupS = 0;
+    double start;
+    double solveS;
+    float d;
+    float x;
+    float y;
+    unsigned s;
+    unsigned t;
+    unsigned a;
+    size_t i;
+    int opt;
+
+    while((opt = getopt(argc, argv, "t:s:j:")) != -1) {
+        switch(opt) {
+            case 't':
+                tags = (unsigned)strtoul(optarg, NULL, 0);
+                break;
+            case 's':
+                seconds = (unsigned)strtoul(optarg, NULL, 0);
+                break;
+            case 'j':
+                maxThreads = (unsigned)strtoul(optarg, NULL, 0);
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-t tags] [-s seconds] [-j max threads]\n", argv[0]);
+                return 2;
+        }
+    }
+    if(tags == 0 || tags > LOCATE_TAGS || seconds == 0) {
+        fprintf(stderr, "tags must be 1 to %u, seconds at least 1\n", LOCATE_TAGS);
+        return 2;
+    }
+    if(maxThreads == 0) {
+        maxThreads = 1;
+    }
+
+    for(a = 0; a < GRID * GRID; a++) {
+        layout.set((uint8_t)(a + 1), (a % GRID) * SPACING, (a / GRID) * SPACING);
+    }
+    walkers.resize(tags);
+    for(t = 0; t < tags; t++) {
+        walkers[t].x = uniform() * side;
+        walkers[t].y = uniform() * side;
+        walkers[t].heading = uniform() * 6.2831853f;
+    }
+
+    //The trace, a second of records at a time through the grouper
+    Locate_Grouper grouper(layout, TICKS_PER_S, 3);
+    for(s = 0; s < seconds; s++) {
+        for(t = 0; t < tags; t++) {
+            walk(&walkers[t], side);
+            truthX.push_back(walkers[t].x);
+            truthY.push_back(walkers[t].y);
+        }
+        start = nowS();
+        for(t = 0; t < tags; t++) {
+            for(a = 1; a <= GRID * GRID; a++) {
+                layout.find((uint8_t)a, &x, &y);
+                d = std::hypot(walkers[t].x - x, walkers[t].y - y);
+                if(d > HEARD_RANGE) {
+                    continue;
+                }
+                d = std::max(d, 0.3f);
+                record.time = (int64_t)s * TICKS_PER_S;
+                record.apId = (uint8_t)a;
+                record.tag = (uint8_t)t;
+                record.rssi = (uint8_t)std::lround(model.rssi1m +
+                        10 * model.pathLoss * std::log10(d) + FADING_DB * gaussian());
+                record.hasDistance = false;
+                grouper.add(record, Locate_range(model, record));
+                records++;
+            }
+        }
+        grouper.flush((int64_t)s * TICKS_PER_S, batch);
+        groupS += nowS() - start;
+    }
+
+    //The fixes carry their tag and second, for the error
+    Multilat_solve(batch, fixes, 1);
+    for(i = 0; i < fixes.size(); i++) {
+        if(fixes[i].ok) {
+            s = (unsigned)(fixes[i].time / TICKS_PER_S);
+            errors.push_back(std::hypot(fixes[i].x - truthX[s * tags + fixes[i].tag],
+                    fixes[i].y - truthY[s * tags + fixes[i].tag]));
+        }
+    }
+    std::sort(errors.begin(), errors.end());
+
+    printf("%u APs, %u tags, %u s: %llu records, %zu fixes, %zu solved\n", GRID * GRID,
+            tags, seconds, (unsigned long long)records, batch.size(), errors.size());
+    printf("grouping %.0f records/s\n", records / groupS);
+    if(!errors.empty()) {
+        printf("error median %.2f m, 90%% %.2f m\n", errors[errors.size() / 2],
+                errors[errors.size() * 9 / 10]);
+    }
+    printf("%8s %14s %10s\n", "threads", "fixes/s", "ns/fix");
+    for(threads = 1; threads <= maxThreads; threads *= 2) {
+        start = nowS();
+        Multilat_solve(batch, fixes, threads);
+        solveS = nowS() - start;
+        printf("%8u %14.0f %10.1f\n", threads, batch.size() / solveS,
+                solveS * 1e9 / batch.size());
+    }
+
+    return 0;
+}
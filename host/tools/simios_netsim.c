@@ -0,0 +1,332 @@
+/*
+ *  ======== simios_netsim.c ========
+ *
+ *  Runs a network of tags and APs on the EasyLink simulation, to measure
+ *  beacon delivery and collisions for a number of tags without boards:
+ *
+ *      simios_netsim [-t tags] [-a aps] [-d seconds] [-x speed] [-w area m]
+ *                    [-s seed] [-C]
+ *
+ *  Tags are placed at random in a square area of -w meters, APs on a grid
+ *  over it. Tags run the beacon loop of rfEasyLinkTx.c, with its
+ *  BeaconScheduler and Beacon encoding, -C sends them with CCA. APs run the
+ *  continuous view Rx of TaskManager.c and count the beacons of every tag
+ *  with LinkStats. After -d seconds of radio time, run -x times faster than
+ *  real time, prints the channel counters, then every AP's.
+ *
+ *  The firmware keeps its state in globals, one device per image, so the
+ *  loops are reproduced here per node rather than linked in.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <xdc/std.h>
+#include <xdc/runtime/Error.h>
+#include <xdc/runtime/System.h>
+#include <ti/sysbios/BIOS.h>
+#include <ti/sysbios/knl/Clock.h>
+#include <ti/sysbios/knl/Semaphore.h>
+#include <ti/sysbios/knl/Task.h>
+
+#include "easylink/EasyLink.h"
+#include "Beacon.h"
+#include "BeaconScheduler.h"
+#include "ChannelPlan.h"
+#include "LinkStats.h"
+#include "SimClock.h"
+#include "SimRadio.h"
+
+/***** Defines *****/
+
+#define MAX_TAGS                255 // Beacon ids are a byte, 0 is not used
+#define MAX_APS                 64
+#define TAG_TX_POWER_DBM        8   // As rfEasyLinkTx.c
+#define AP_TX_POWER_DBM         12  // As TaskManager.c
+#define TAG_WAKEUP_LEAD_MS      5
+#define TAG_TX_WAIT_MS          300
+
+/***** Type declarations *****/
+
+typedef struct
+{
+    SimNode* node;
+    Semaphore_Handle txDoneSem;
+    uint8_t id;
+    uint8_t cca;
+    uint32_t sent;
+} Tag;
+
+typedef struct
+{
+    SimNode* node;
+    LinkStats beaconStats;
+    uint8_t tagSeen[(MAX_TAGS + 1 + 7) / 8];
+    uint8_t tagLastSeq[MAX_TAGS + 1];
+    uint32_t rxEnded;
+} Ap;
+
+/***** Variable declarations *****/
+
+static Tag tags[MAX_TAGS];
+static Ap aps[MAX_APS];
+static unsigned long apCount = 4;
+
+/***** Function definitions *****/
+
+static Tag* currentTag(void) {
+    SimNode* node = SimRadio_current();
+    unsigned long i;
+
+    for(i = 0; i < MAX_TAGS; i++) {
+        if(tags[i].node == node) {
+            return &tags[i];
+        }
+    }
+
+    return NULL;
+}
+
+static Ap* currentAp(void) {
+    SimNode* node = SimRadio_current();
+    unsigned long i;
+
+    for(i = 0; i < apCount; i++) {
+        if(aps[i].node == node) {
+            return &aps[i];
+        }
+    }
+
+    return NULL;
+}
+
+static void txDoneCb(EasyLink_Status status) {
+    (void)status;
+    Semaphore_post(currentTag()->txDoneSem);
+}
+
+/* The beacon loop of rfEasyLinkTx.c, async Tx in low power mode */
+static void tagFxn(UArg a0, UArg a1) {
+    Tag* tag = (Tag*)a0;
+    BeaconScheduler scheduler;
+    EasyLink_Params easyLink_params;
+    EasyLink_TxPacket txPacket;
+    uint8_t ieeeAddr[8];
+    uint16_t seqNumber = 0;
+    uint32_t absTime;
+    uint32_t sleepMs;
+    uint32_t txWaitMs;
+
+    (void)a1;
+    tag->txDoneSem = Semaphore_create(0, NULL, NULL);
+    EasyLink_Params_init(&easyLink_params);
+    easyLink_params.ui32ModType = EasyLink_Phy_Custom;
+    if(tag->txDoneSem == NULL || EasyLink_init(&easyLink_params) != EasyLink_Status_Success ||
+            EasyLink_setFrequency(ChannelPlan_frequency(ChannelPlan_tagChannel(tag->id))) !=
+            EasyLink_Status_Success) {
+        System_abort("Tag setup failed");
+    }
+    EasyLink_setRfPower(TAG_TX_POWER_DBM);
+    EasyLink_getIeeeAddr(ieeeAddr);
+    EasyLink_getAbsTime(&absTime);
+    BeaconScheduler_init(&scheduler, ieeeAddr, tag->id, absTime);
+
+    while(1) {
+        memset(&txPacket, 0, sizeof(txPacket));
+        txPacket.len = Beacon_encode(txPacket.payload, tag->id, (uint8_t)(seqNumber++), 0);
+        txPacket.dstAddr[0] = 0xaa;
+
+        EasyLink_getAbsTime(&absTime);
+        txPacket.absTime = BeaconScheduler_next(&scheduler, absTime);
+
+        sleepMs = EasyLink_RadioTime_To_ms((txPacket.absTime - absTime));
+        if(sleepMs > TAG_WAKEUP_LEAD_MS) {
+            Task_sleep((sleepMs - TAG_WAKEUP_LEAD_MS) * 1000 / Clock_tickPeriod);
+            EasyLink_getAbsTime(&absTime);
+        }
+
+        if(tag->cca) {
+            EasyLink_transmitCcaAsync(&txPacket, txDoneCb);
+        } else {
+            EasyLink_transmitAsync(&txPacket, txDoneCb);
+        }
+        tag->sent++;
+        txWaitMs = EasyLink_RadioTime_To_ms((txPacket.absTime - absTime)) + TAG_TX_WAIT_MS;
+        if(Semaphore_pend(tag->txDoneSem, txWaitMs * 1000 / Clock_tickPeriod) == FALSE) {
+            if(EasyLink_abort() == EasyLink_Status_Success) {
+                Semaphore_pend(tag->txDoneSem, BIOS_WAIT_FOREVER);
+            }
+        }
+    }
+}
+
+/* Beacon counting of TaskManager.c's rxDoneCb */
+static void rxDoneCb(EasyLink_RxView* rxView, EasyLink_Status status) {
+    Ap* ap = currentAp();
+    Beacon beacon;
+
+    if(status != EasyLink_Status_Success) {
+        ap->rxEnded++;
+        return;
+    }
+
+    if(rxView->dstAddr[0] == 0xaa && Beacon_decode(&beacon, rxView->payload, rxView->len) == 0) {
+        if(ap->tagSeen[beacon.id >> 3] & (1 << (beacon.id & 7))) {
+            LinkStats_next(&ap->beaconStats, ap->tagLastSeq[beacon.id], beacon.seq);
+        } else {
+            ap->tagSeen[beacon.id >> 3] |= 1 << (beacon.id & 7);
+            LinkStats_first(&ap->beaconStats);
+        }
+        ap->tagLastSeq[beacon.id] = beacon.seq;
+    }
+    EasyLink_releaseRxView(rxView);
+}
+
+static void setUpAp(Ap* ap) {
+    uint8_t addrFilter[EASYLINK_MAX_ADDR_SIZE * EASYLINK_MAX_ADDR_FILTERS] = {0xaa};
+    EasyLink_Params easyLink_params;
+
+    SimRadio_attach(ap->node);
+    LinkStats_init(&ap->beaconStats);
+    EasyLink_Params_init(&easyLink_params);
+    easyLink_params.ui32ModType = EasyLink_Phy_Custom;
+    if(EasyLink_init(&easyLink_params) != EasyLink_Status_Success ||
+            EasyLink_setFrequency(ChannelPlan_frequency(0)) != EasyLink_Status_Success ||
+            EasyLink_enableRxAddrFilter(addrFilter, 1, 1) != EasyLink_Status_Success ||
+            EasyLink_receiveContinuousViewAsync(rxDoneCb, 0) != EasyLink_Status_Success) {
+        System_abort("AP setup failed");
+    }
+    EasyLink_setRfPower(AP_TX_POWER_DBM);
+}
+
+static double randomCoord(double area) {
+    return area * rand() / RAND_MAX;
+}
+
+int main(int argc, char* argv[]) {
+    SimRadio_Params params;
+    SimRadio_Counters counters;
+    EasyLink_Stats stats;
+    Task_Params taskParams;
+    unsigned long tagCount = 50;
+    unsigned long duration = 60;
+    unsigned long side;
+    unsigned long i;
+    uint64_t sent = 0;
+    double area = 50.0;
+    unsigned int seed = 1;
+    uint8_t cca = 0;
+    int opt;
+
+    SimRadio_Params_init(&params);
+    params.speed = 10;
+
+    while((opt = getopt(argc, argv, "t:a:d:x:w:s:C")) != -1) {
+        switch(opt) {
+            case 't':
+                tagCount = strtoul(optarg, NULL, 0);
+                break;
+            case 'a':
+                apCount = strtoul(optarg, NULL, 0);
+                break;
+            case 'd':
+                duration = strtoul(optarg, NULL, 0);
+                break;
+            case 'x':
+                params.speed = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'w':
+                area = strtod(optarg, NULL);
+                break;
+            case 's':
+                seed = (unsigned int)strtoul(optarg, NULL, 0);
+                break;
+            case 'C':
+                cca = 1;
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-t tags] [-a aps] [-d seconds] [-x speed]"
+                        " [-w area m] [-s seed] [-C]\n", argv[0]);
+                return 2;
+        }
+    }
+    if(tagCount < 1 || tagCount > MAX_TAGS || apCount < 1 || apCount > MAX_APS) {
+        fprintf(stderr, "1 to %d tags and 1 to %d APs\n", MAX_TAGS, MAX_APS);
+        return 2;
+    }
+
+    srand(seed);
+    SimRadio_init(&params);
+
+    //APs on the smallest square grid that holds them, cells centered
+    for(side = 1; side * side < apCount; side++) {
+    }
+    for(i = 0; i < apCount; i++) {
+        aps[i].node = SimRadio_addNode(area * (i % side + 0.5) / side,
+                area * (i / side + 0.5) / side);
+        setUpAp(&aps[i]);
+    }
+
+    Task_Params_init(&taskParams);
+    for(i = 0; i < tagCount; i++) {
+        tags[i].node = SimRadio_addNode(randomCoord(area), randomCoord(area));
+        tags[i].id = (uint8_t)(i + 1);
+        tags[i].cca = cca;
+        //The task thread acts for the node its creator is attached to
+        SimRadio_attach(tags[i].node);
+        taskParams.arg0 = (UArg)&tags[i];
+        if(tags[i].node == NULL || Task_create(tagFxn, &taskParams, NULL) == NULL) {
+            fprintf(stderr, "Can't start tag %lu\n", i + 1);
+            return 1;
+        }
+    }
+    SimRadio_attach(NULL);
+
+    SimClock_sleepUntil(SimClock_now() + (uint64_t)duration * SIMCLOCK_RAT_HZ);
+
+    SimRadio_getCounters(&counters);
+    for(i = 0; i < tagCount; i++) {
+        sent += tags[i].sent;
+    }
+    printf("tags %lu aps %lu duration %lu s cca %s\n", tagCount, apCount, duration,
+            cca ? "on" : "off");
+    printf("beacons %llu transmissions %llu delivered %llu collisions %llu"
+            " below sensitivity %llu\n", (unsigned long long)sent,
+            (unsigned long long)counters.transmissions, (unsigned long long)counters.delivered,
+            (unsigned long long)counters.collisions,
+            (unsigned long long)counters.belowSensitivity);
+
+    for(i = 0; i < apCount; i++) {
+        SimRadio_attach(aps[i].node);
+        SimRadio_swiLock();
+        EasyLink_getStats(&stats);
+        printf("ap %lu delivery %u.%u%% received %u lost %u resyncs %u rxOk %u rxNok %u"
+                " rxBufFull %u rx ended %u\n", i,
+                LinkStats_deliveryPermille(&aps[i].beaconStats) / 10,
+                LinkStats_deliveryPermille(&aps[i].beaconStats) % 10,
+                aps[i].beaconStats.received, aps[i].beaconStats.lost,
+                aps[i].beaconStats.resyncs, stats.rxOk, stats.rxNok, stats.rxBufFull,
+                aps[i].rxEnded);
+        SimRadio_swiUnlock();
+    }
+    if(cca) {
+        memset(&stats.cca, 0, sizeof(stats.cca));
+        for(i = 0; i < tagCount; i++) {
+            EasyLink_Stats tagStats;
+
+            SimRadio_attach(tags[i].node);
+            EasyLink_getStats(&tagStats);
+            stats.cca.txCount += tagStats.cca.txCount;
+            stats.cca.txSuccess += tagStats.cca.txSuccess;
+            stats.cca.busyCount += tagStats.cca.busyCount;
+            stats.cca.retries += tagStats.cca.retries;
+            stats.cca.busyFailures += tagStats.cca.busyFailures;
+        }
+        printf("cca tx %u success %u busy %u retries %u failures %u\n", stats.cca.txCount,
+                stats.cca.txSuccess, stats.cca.busyCount, stats.cca.retries,
+                stats.cca.busyFailures);
+    }
+
+    return 0;
+}
@@ -0,0 +1,224 @@
+/*
+ *  ======== simios_trace.cpp ========
+ *
+ *  Latencies along the hot path from dumps of the firmware's trace (see
+ *  TraceDump.h):
+ *
+ *      simios_trace [-s trace size] [-t] [-f] dump...
+ *
+ *  Each dump is the Trace struct saved from a halted target built with
+ *  TRACE_ENABLE, -s its TRACE_SIZE if it was changed. For every dump the
+ *  events kept, the time they cover and what recording them cost of that
+ *  time are printed, then the stages of all the dumps together: count, mean,
+ *  median, 90th percentile and max, and a histogram of each in powers of two
+ *  of us.
+ *
+ *  -t also prints each dump as a timeline, one event per line with its time
+ *  and the time since the one before, nested inside the app Rx callback and
+ *  the UART write it happened in. -f prints only the stages as folded stacks,
+ *  weighted in us, for flamegraph.pl.
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "TraceDump.h"
+
+/***** Defines *****/
+
+#define BAR_WIDTH       40
+
+/***** Function definitions *****/
+
+static void usage(const char* name) {
+    fprintf(stderr, "usage: %s [-s trace size] [-t] [-f] dump...\n", name);
+}
+
+static bool readFile(const char* path, std::vector<uint8_t>& data) {
+    uint8_t buf[4096];
+    size_t n;
+    FILE* file;
+
+    file = fopen(path, "rb");
+    if(file == NULL) {
+        perror(path);
+        return false;
+    }
+    data.clear();
+    while((n = fread(buf, 1, sizeof(buf), file)) > 0) {
+        data.insert(data.end(), buf, buf + n);
+    }
+    fclose(file);
+
+    return true;
+}
+
+static double us(int64_t ticks) {
+    return (double)ticks / TRACEDUMP_RAT_TICKS_PER_US;
+}
+
+static void printTimeline(const TraceDump_Dump& dump) {
+    int64_t start = dump.events.empty() ? 0 : dump.events[0].time;
+    int64_t last = start;
+    unsigned depth = 0;
+    size_t i;
+    uint8_t id;
+
+    printf("%12s %10s\n", "us", "+us");
+    for(i = 0; i < dump.events.size(); i++) {
+        id = dump.events[i].id;
+        if((id == TRACE_APP_RX_DONE || id == TRACE_UART_WRITE_DONE) && depth > 0) {
+            depth--;
+        }
+        printf("%12.2f %10.2f %*s%s %u\n", us(dump.events[i].time - start),
+                us(dump.events[i].time - last), 2 * depth, "",
+                TraceDump_eventName(id), dump.events[i].arg);
+        if(id == TRACE_APP_RX || id == TRACE_UART_WRITE) {
+            depth++;
+        }
+        last = dump.events[i].time;
+    }
+}
+
+static void printStages(const TraceDump_Stages& stages) {
+    const TraceDump_Histogram* h;
+    uint64_t most;
+    unsigned s;
+    unsigned i;
+
+    printf("%-14s %8s %10s %10s %10s %10s\n", "stage", "count", "mean us", "p50 us",
+            "p90 us", "max us");
+    for(s = 0; s < TraceDump_Stage_Count; s++) {
+        h = &stages.histogram((TraceDump_Stage)s);
+        printf("%-14s %8llu %10.2f %10.2f %10.2f %10.2f\n",
+                TraceDump_stageName((TraceDump_Stage)s), (unsigned long long)h->count(),
+                h->count() ? us(h->sum()) / h->count() : 0.0, us(h->percentile(0.5)),
+                us(h->percentile(0.9)), us(h->max()));
+    }
+    printf("%llu packets seen in part only\n", (unsigned long long)stages.unmatched());
+
+    for(s = 0; s < TraceDump_Stage_Count; s++) {
+        h = &stages.histogram((TraceDump_Stage)s);
+        if(h->count() == 0) {
+            continue;
+        }
+        most = 0;
+        for(i = 0; i < TRACEDUMP_BUCKETS; i++) {
+            most = (h->bucket(i) > most) ? h->bucket(i) : most;
+        }
+        printf("\n%s\n", TraceDump_stageName((TraceDump_Stage)s));
+        for(i = 0; i < TRACEDUMP_BUCKETS; i++) {
+            if(h->bucket(i) == 0) {
+                continue;
+            }
+            if(i < TRACEDUMP_BUCKETS - 1) {
+                printf("  < %6u us %8llu ", 1u << i, (unsigned long long)h->bucket(i));
+            } else {
+                printf(" >= %6u us %8llu ", 1u << (i - 1), (unsigned long long)h->bucket(i));
+            }
+            printf("%.*s\n", (int)(h->bucket(i) * BAR_WIDTH / most),
+                    "########################################");
+        }
+    }
+}
+
+/*
+ * The stages nested as they happen, each line's weight its own time less
+ * that of the stages under it
+ */
+static void printFolded(const TraceDump_Stages& stages) {
+    const TraceDump_Stage path[] = {
+        TraceDump_Stage_AirToApp, TraceDump_Stage_AppRx, TraceDump_Stage_RingWait,
+        TraceDump_Stage_RingToUart, TraceDump_Stage_UartWrite
+    };
+    int64_t children = 0;
+    int64_t self;
+    unsigned i;
+
+    for(i = 0; i < sizeof(path) / sizeof(path[0]); i++) {
+        children += stages.histogram(path[i]).sum();
+    }
+    self = stages.histogram(TraceDump_Stage_AirToUart).sum() - children;
+    if(self > 0) {
+        printf("air to uart %.0f\n", us(self));
+    }
+    self = stages.histogram(TraceDump_Stage_AirToApp).sum() -
+            stages.histogram(TraceDump_Stage_RfToApp).sum();
+    printf("air to uart;air to app %.0f\n", us((self > 0) ? self : 0));
+    printf("air to uart;air to app;rf to app %.0f\n",
+            us(stages.histogram(TraceDump_Stage_RfToApp).sum()));
+    for(i = 1; i < sizeof(path) / sizeof(path[0]); i++) {
+        printf("air to uart;%s %.0f\n", TraceDump_stageName(path[i]),
+                us(stages.histogram(path[i]).sum()));
+    }
+    printf("tx %.0f\n", us(stages.histogram(TraceDump_Stage_Tx).sum()));
+}
+
+int main(int argc, char* argv[]) {
+    TraceDump_Stages stages;
+    TraceDump_Dump dump;
+    std::vector<uint8_t> data;
+    std::string error;
+    unsigned traceSize = TRACE_SIZE;
+    bool timeline = false;
+    bool folded = false;
+    int64_t span;
+    int opt;
+    int i;
+
+    while((opt = getopt(argc, argv, "s:tf")) != -1) {
+        switch(opt) {
+            case 's':
+                traceSize = (unsigned)strtoul(optarg, NULL, 0);
+                break;
+            case 't':
+                timeline = true;
+                break;
+            case 'f':
+                folded = true;
+                break;
+            default:
+                usage(argv[0]);
+                return 2;
+        }
+    }
+    if(optind == argc) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    for(i = optind; i < argc; i++) {
+        if(!readFile(argv[i], data)) {
+            return 1;
+        }
+        if(!TraceDump_load(data.data(), data.size(), traceSize, &dump, &error)) {
+            fprintf(stderr, "%s: %s\n", argv[i], error.c_str());
+            return 1;
+        }
+        stages.add(dump);
+        if(folded) {
+            continue;
+        }
+
+        //The events kept took overhead ticks each out of the time they cover
+        span = dump.events.empty() ? 0 : dump.events.back().time - dump.events[0].time;
+        printf("%s: %zu of %u events over %.0f us, tracing took %.3f%% of it\n", argv[i],
+                dump.events.size(), dump.count, us(span),
+                span ? 100.0 * dump.events.size() * dump.overhead / span : 0.0);
+        if(timeline) {
+            printTimeline(dump);
+            printf("\n");
+        }
+    }
+
+    if(folded) {
+        printFolded(stages);
+    } else {
+        printf("\n");
+        printStages(stages);
+    }
+
+    return 0;
+}
@@ -0,0 +1,233 @@
+/*
+ *  ======== TraceDump.cpp ========
+ */
+#include <algorithm>
+#include <cmath>
+#include <deque>
+
+#include "TraceDump.h"
+
+/***** Defines *****/
+
+#define EVENT_SIZE      8       // sizeof(Trace_Event) on the target
+#define UNKNOWN         INT64_MIN
+
+/***** Type declarations *****/
+
+/* A packet's record on its way from the ring to the UART */
+typedef struct
+{
+    int64_t air;                // absTime of its packet, UNKNOWN if before the dump
+    int64_t since;              // Time of its last step
+} Record;
+
+/***** Variable declarations *****/
+
+static const char* const eventNames[] = {
+    "mark", "rf rx done", "rf tx done", "app rx", "app rx done", "app tx",
+    "ring put", "ring get", "uart write", "uart write done"
+};
+
+static const char* const stageNames[TraceDump_Stage_Count] = {
+    "air to app", "rf to app", "app rx", "ring wait", "ring to uart", "uart write",
+    "air to uart", "tx"
+};
+
+/***** Function definitions *****/
+
+static uint32_t getUint32(const uint8_t* p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+size_t TraceDump_size(unsigned traceSize) {
+    return (size_t)traceSize * EVENT_SIZE + 2 * sizeof(uint32_t);
+}
+
+bool TraceDump_load(const uint8_t* data, size_t size, unsigned traceSize,
+        TraceDump_Dump* dump, std::string* error) {
+    const uint8_t* p;
+    TraceDump_Event event;
+    uint32_t kept;
+    uint32_t first;
+    uint32_t raw;
+    uint32_t last = 0;
+    uint32_t i;
+
+    if(traceSize == 0 || (traceSize & (traceSize - 1)) != 0) {
+        *error = "the trace size must be a power of two";
+        return false;
+    }
+    if(size != TraceDump_size(traceSize)) {
+        *error = std::to_string(size) + " bytes, a trace of " + std::to_string(traceSize) +
+                " events takes " + std::to_string(TraceDump_size(traceSize));
+        return false;
+    }
+
+    dump->count = getUint32(&data[traceSize * EVENT_SIZE]);
+    dump->overhead = getUint32(&data[traceSize * EVENT_SIZE + 4]);
+    dump->events.clear();
+
+    //Once the ring is full the oldest event is the next one overwritten
+    kept = (dump->count < traceSize) ? dump->count : traceSize;
+    first = (dump->count < traceSize) ? 0 : dump->count & (traceSize - 1);
+    event.time = 0;
+    for(i = 0; i < kept; i++) {
+        p = &data[((first + i) & (traceSize - 1)) * EVENT_SIZE];
+        raw = getUint32(p);
+        event.time = (i == 0) ? raw : event.time + (uint32_t)(raw - last);
+        event.id = p[4];
+        event.arg = (uint16_t)(p[6] | (p[7] << 8));
+        dump->events.push_back(event);
+        last = raw;
+    }
+
+    return true;
+}
+
+const char* TraceDump_eventName(uint8_t id) {
+    if(id < sizeof(eventNames) / sizeof(eventNames[0])) {
+        return eventNames[id];
+    }
+
+    return "unknown";
+}
+
+const char* TraceDump_stageName(TraceDump_Stage stage) {
+    return stageNames[stage];
+}
+
+TraceDump_Histogram::TraceDump_Histogram() : total(0), maxTicks(0) {
+    std::fill(buckets, buckets + TRACEDUMP_BUCKETS, 0);
+}
+
+void TraceDump_Histogram::add(int64_t latency) {
+    int64_t us = latency / TRACEDUMP_RAT_TICKS_PER_US;
+    unsigned i = 0;
+
+    while(i < TRACEDUMP_BUCKETS - 1 && us >= ((int64_t)1 << i)) {
+        i++;
+    }
+    buckets[i]++;
+    ticks.push_back(latency);
+    total += latency;
+    maxTicks = std::max(maxTicks, latency);
+}
+
+int64_t TraceDump_Histogram::percentile(double p) const {
+    std::vector<int64_t> sorted(ticks);
+    size_t k;
+
+    if(sorted.empty()) {
+        return 0;
+    }
+    k = (size_t)std::ceil(p * sorted.size());
+    k = (k == 0) ? 0 : std::min(k, sorted.size()) - 1;
+    std::nth_element(sorted.begin(), sorted.begin() + k, sorted.end());
+
+    return sorted[k];
+}
+
+TraceDump_Stages::TraceDump_Stages() : partial(0) {
+}
+
+void TraceDump_Stages::add(const TraceDump_Dump& dump) {
+    std::deque<Record> ring;
+    std::vector<Record> taken;
+    std::vector<Record> writing;
+    int64_t rfRx = UNKNOWN;
+    int64_t appRx = UNKNOWN;
+    int64_t air = UNKNOWN;
+    int64_t write = UNKNOWN;
+    int64_t appTx = UNKNOWN;
+    Record record;
+    int64_t t;
+    size_t i;
+    size_t k;
+
+    for(i = 0; i < dump.events.size(); i++) {
+        t = dump.events[i].time;
+        switch(dump.events[i].id) {
+            case TRACE_RF_RX_DONE:
+                rfRx = t;
+                break;
+            case TRACE_APP_RX:
+                //The latest time before the event with the low bits of absTime
+                air = t - (uint16_t)((uint16_t)t - dump.events[i].arg);
+                histograms[TraceDump_Stage_AirToApp].add(t - air);
+                if(rfRx != UNKNOWN) {
+                    histograms[TraceDump_Stage_RfToApp].add(t - rfRx);
+                }
+                rfRx = UNKNOWN;
+                appRx = t;
+                break;
+            case TRACE_APP_RX_DONE:
+                if(appRx != UNKNOWN) {
+                    histograms[TraceDump_Stage_AppRx].add(t - appRx);
+                } else {
+                    partial++;
+                }
+                appRx = UNKNOWN;
+                air = UNKNOWN;
+                break;
+            case TRACE_RING_PUT:
+                record.air = air;
+                record.since = t;
+                ring.push_back(record);
+                break;
+            case TRACE_RING_GET:
+                //The arg counts the records left, a put in the Swi between the
+                //release and its probe included. Fewer pending than it says
+                //were put before the dump started.
+                while(ring.size() > (size_t)dump.events[i].arg + 1) {
+                    ring.pop_front();
+                    partial++;
+                }
+                if(ring.size() == (size_t)dump.events[i].arg + 1) {
+                    record = ring.front();
+                    ring.pop_front();
+                    histograms[TraceDump_Stage_RingWait].add(t - record.since);
+                    record.since = t;
+                    taken.push_back(record);
+                } else {
+                    partial++;
+                }
+                break;
+            case TRACE_UART_WRITE:
+                for(k = 0; k < taken.size(); k++) {
+                    histograms[TraceDump_Stage_RingToUart].add(t - taken[k].since);
+                    writing.push_back(taken[k]);
+                }
+                taken.clear();
+                write = t;
+                break;
+            case TRACE_UART_WRITE_DONE:
+                if(write != UNKNOWN) {
+                    histograms[TraceDump_Stage_UartWrite].add(t - write);
+                }
+                for(k = 0; k < writing.size(); k++) {
+                    if(writing[k].air != UNKNOWN) {
+                        histograms[TraceDump_Stage_AirToUart].add(t - writing[k].air);
+                    } else {
+                        partial++;
+                    }
+                }
+                writing.clear();
+                write = UNKNOWN;
+                break;
+            case TRACE_APP_TX:
+                appTx = t;
+                break;
+            case TRACE_RF_TX_DONE:
+                if(appTx != UNKNOWN) {
+                    histograms[TraceDump_Stage_Tx].add(t - appTx);
+                }
+                appTx = UNKNOWN;
+                break;
+            default:
+                break;
+        }
+    }
+
+    //Still on their way when the dump was taken
+    partial += ring.size() + taken.size() + writing.size();
+}
@@ -0,0 +1,121 @@
+#ifndef TRACEDUMP_H
+#define TRACEDUMP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Trace.h"
+
+/*
+ * Decoding of the firmware's hot path trace (see Trace.h). A dump is the
+ * Trace struct saved from a halted target: TRACE_SIZE events of 8 bytes, then
+ * count and overhead, all little endian. TraceDump_load puts its events in
+ * order, oldest first, with their 32 bit RAT times unwrapped.
+ *
+ * TraceDump_Stages then follows packets along the probes and times each stage
+ * of their path, in RAT ticks:
+ *
+ *      air to app      absTime of the packet to the app Rx callback
+ *      rf to app       EasyLink's Rx callback to the app's
+ *      app rx          the app's Rx callback, up to the view's release
+ *      ring wait       central ring, commit to the UART task taking it
+ *      ring to uart    taken from the ring to the UART write it goes out in
+ *      uart write      UART_write to its callback
+ *      air to uart     absTime of the packet to the end of its UART write
+ *      tx              the AP handing an uplink to EasyLink to its Tx callback
+ *
+ * The ring stages use the queue depth the probes carry, so records put before
+ * the dump starts are not taken for later ones.
+ */
+
+#define TRACEDUMP_RAT_TICKS_PER_US  4
+#define TRACEDUMP_BUCKETS           16  // Powers of two of us, the last is open
+
+typedef enum
+{
+    TraceDump_Stage_AirToApp,
+    TraceDump_Stage_RfToApp,
+    TraceDump_Stage_AppRx,
+    TraceDump_Stage_RingWait,
+    TraceDump_Stage_RingToUart,
+    TraceDump_Stage_UartWrite,
+    TraceDump_Stage_AirToUart,
+    TraceDump_Stage_Tx,
+    TraceDump_Stage_Count
+} TraceDump_Stage;
+
+typedef struct
+{
+    int64_t time;               // RAT ticks, unwrapped
+    uint8_t id;                 // TRACE_*
+    uint16_t arg;
+} TraceDump_Event;
+
+typedef struct
+{
+    std::vector<TraceDump_Event> events;
+    uint32_t count;             // Events recorded, lost ones included
+    uint32_t overhead;          // RAT ticks per event
+} TraceDump_Dump;
+
+/* Size in bytes of a dump of a trace of traceSize events */
+size_t TraceDump_size(unsigned traceSize);
+
+/*
+ * Reads a dump of a trace of traceSize events. Returns false and sets error
+ * if its size doesn't match.
+ */
+bool TraceDump_load(const uint8_t* data, size_t size, unsigned traceSize,
+        TraceDump_Dump* dump, std::string* error);
+
+/* Name of an event or a stage, for printing */
+const char* TraceDump_eventName(uint8_t id);
+const char* TraceDump_stageName(TraceDump_Stage stage);
+
+/* Latencies of a stage */
+class TraceDump_Histogram
+{
+public:
+    TraceDump_Histogram();
+
+    void add(int64_t ticks);
+
+    /* Bucket i holds latencies below 2^i us, the last the rest */
+    uint64_t bucket(unsigned i) const { return buckets[i]; }
+    uint64_t count() const { return ticks.size(); }
+    int64_t sum() const { return total; }
+    int64_t max() const { return maxTicks; }
+
+    /* The latency a share p of them are at or below, in ticks */
+    int64_t percentile(double p) const;
+
+private:
+    uint64_t buckets[TRACEDUMP_BUCKETS];
+    std::vector<int64_t> ticks;
+    int64_t total;
+    int64_t maxTicks;
+};
+
+class TraceDump_Stages
+{
+public:
+    TraceDump_Stages();
+
+    /* Times the stages of a dump's events, adding to those of earlier dumps */
+    void add(const TraceDump_Dump& dump);
+
+    const TraceDump_Histogram& histogram(TraceDump_Stage stage) const {
+        return histograms[stage];
+    }
+
+    /* Packets whose path the dump only showed in part */
+    uint64_t unmatched() const { return partial; }
+
+private:
+    TraceDump_Histogram histograms[TraceDump_Stage_Count];
+    uint64_t partial;
+};
+
+#endif /* TRACEDUMP_H */
@@ -0,0 +1,26 @@
+/*
+ *  ======== Beacon.c ========
+ */
+#include "Beacon.h"
+
+/***** Function definitions *****/
+
+uint8_t Beacon_encode(uint8_t* payload, uint8_t id, uint8_t seq, uint8_t flags) {
+    payload[0] = id;
+    payload[1] = seq;
+    payload[2] = flags;
+
+    return BEACON_SIZE;
+}
+
+int Beacon_decode(Beacon* beacon, const uint8_t* payload, uint8_t len) {
+    if(len < 2) {
+        return -1;
+    }
+
+    beacon->id = payload[0];
+    beacon->seq = payload[1];
+    beacon->flags = (len == BEACON_SIZE) ? payload[2] : 0;
+
+    return 0;
+}
@@ -0,0 +1,78 @@
+/*
+ *  ======== BeaconScheduler.c ========
+ */
+#include "BeaconScheduler.h"
+
+/* EasyLink API Header files */
+#include "easylink/EasyLink.h"
+
+/***** Defines *****/
+
+#define FNV_OFFSET_BASIS    2166136261u
+#define FNV_PRIME           16777619u
+
+/* Smallest lead time given to EasyLink to schedule a beacon */
+#define BEACON_MIN_LEAD_MS  2
+
+/***** Function definitions *****/
+
+static uint32_t nextRandom(BeaconScheduler* scheduler) {
+    uint32_t x = scheduler->rng;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    scheduler->rng = x;
+
+    return x;
+}
+
+void BeaconScheduler_init(BeaconScheduler* scheduler, const uint8_t* ieeeAddr,
+        uint8_t id, uint32_t now) {
+    uint32_t hash = FNV_OFFSET_BASIS;
+    uint8_t i;
+
+    //FNV-1a over the IEEE address and id, tags with the same MY_ID still differ
+    for(i = 0; i < 8; i++) {
+        hash = (hash ^ ieeeAddr[i]) * FNV_PRIME;
+    }
+    hash = (hash ^ id) * FNV_PRIME;
+
+    scheduler->rng = (hash != 0) ? hash : FNV_OFFSET_BASIS;
+    scheduler->slot = hash % BEACON_SLOT_COUNT;
+    scheduler->count = 0;
+    //Room to schedule even a beacon at the very start of slot 0
+    scheduler->intervalStart = now + EasyLink_ms_To_RadioTime(BEACON_MIN_LEAD_MS);
+}
+
+uint32_t BeaconScheduler_next(BeaconScheduler* scheduler, uint32_t now) {
+    uint32_t absTime;
+    uint32_t jitterUs;
+    uint32_t late;
+    uint32_t skipped;
+
+    if(scheduler->count == BEACON_BURST_SIZE) {
+        scheduler->count = 0;
+        scheduler->intervalStart += EasyLink_ms_To_RadioTime(BEACON_BURST_GAP_MS);
+        scheduler->slot = nextRandom(scheduler) % BEACON_SLOT_COUNT;
+    }
+
+    jitterUs = nextRandom(scheduler) % (BEACON_JITTER_MS * 1000);
+    absTime = scheduler->intervalStart +
+            EasyLink_ms_To_RadioTime(scheduler->slot * BEACON_SLOT_MS) +
+            EasyLink_us_To_RadioTime(jitterUs);
+
+    //Fell behind (e.g. a Tx timed out), skip to the first interval still
+    //ahead, keeping the slot and jitter
+    late = now + EasyLink_ms_To_RadioTime(BEACON_MIN_LEAD_MS) - absTime;
+    if((int32_t)late > 0) {
+        skipped = (late - 1) / EasyLink_ms_To_RadioTime(BEACON_INTERVAL_MS) + 1;
+        scheduler->intervalStart += skipped * EasyLink_ms_To_RadioTime(BEACON_INTERVAL_MS);
+        absTime += skipped * EasyLink_ms_To_RadioTime(BEACON_INTERVAL_MS);
+    }
+
+    scheduler->intervalStart += EasyLink_ms_To_RadioTime(BEACON_INTERVAL_MS);
+    scheduler->count++;
+
+    return absTime;
+}
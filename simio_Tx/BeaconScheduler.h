@@ -0,0 +1,59 @@
+#ifndef BEACONSCHEDULER_H
+#define BEACONSCHEDULER_H
+
+#include <stdint.h>
+
+/*
+ * Beacon times for a tag, in radio time (RAT ticks) for EasyLink_TxPacket's
+ * absTime.
+ *
+ * A tag sends bursts of BEACON_BURST_SIZE beacons, one per
+ * BEACON_INTERVAL_MS interval, with BEACON_BURST_GAP_MS between bursts. Each
+ * interval is split in BEACON_SLOT_COUNT slots. Every burst the tag uses one
+ * slot drawn from a PRNG seeded with its IEEE address and MY_ID, plus a
+ * random jitter below one slot for every beacon. Tags that are switched on
+ * together no longer send in lockstep, and two tags that share a slot in one
+ * burst most likely won't in the next.
+ *
+ * Beacon times follow each other from the previous one, not from when the
+ * Tx was done, so processing time doesn't stretch the schedule.
+ */
+
+/* Build time settings, can be overridden with --define */
+#ifndef BEACON_BURST_SIZE
+#define BEACON_BURST_SIZE       10
+#endif
+#ifndef BEACON_INTERVAL_MS
+#define BEACON_INTERVAL_MS      100
+#endif
+#ifndef BEACON_BURST_GAP_MS
+#define BEACON_BURST_GAP_MS     1000
+#endif
+#ifndef BEACON_SLOT_COUNT
+#define BEACON_SLOT_COUNT       10
+#endif
+
+#if (BEACON_INTERVAL_MS / BEACON_SLOT_COUNT) < 2
+#error BEACON_INTERVAL_MS must give slots of at least 2 ms
+#endif
+
+#define BEACON_SLOT_MS          (BEACON_INTERVAL_MS / BEACON_SLOT_COUNT)
+#define BEACON_JITTER_MS        (BEACON_SLOT_MS / 2) // Leaves room for a beacon in the slot, even a 30 byte one at 50 kbps
+
+typedef struct
+{
+    uint32_t rng;           // xorshift32 state, never 0
+    uint32_t intervalStart; // RAT time the current interval starts at
+    uint8_t slot;           // Slot used by the current burst
+    uint8_t count;          // Beacons sent in the current burst
+} BeaconScheduler;
+
+/* Seeds the scheduler from the tag identity, the first burst starts right
+ * after now */
+void BeaconScheduler_init(BeaconScheduler* scheduler, const uint8_t* ieeeAddr,
+        uint8_t id, uint32_t now);
+
+/* Returns the RAT time to send the next beacon at, never before now */
+uint32_t BeaconScheduler_next(BeaconScheduler* scheduler, uint32_t now);
+
+#endif /* BEACONSCHEDULER_H */
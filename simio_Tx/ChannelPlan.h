@@ -0,0 +1,48 @@
+#ifndef CHANNELPLAN_H
+#define CHANNELPLAN_H
+
+#include <stdint.h>
+
+/*
+ * Channels of the deployment. Tags beacon on one of the beacon channels,
+ * chosen from their id. Each AP listens on the beacon channel it is
+ * assigned (AP_CHANNEL in TaskManager.c) and switches to the backhaul
+ * channel only to send its uplinks. The central listens on the backhaul
+ * channel. ChannelPlan.h is kept identical in the three projects, and all
+ * nodes must be built with the same settings.
+ *
+ * The defaults put every node on channel 0, the frequency in
+ * smartrf_settings.c, which is the single channel network. For more
+ * airtime, raise CHANNEL_PLAN_BEACON_CHANNELS and move the backhaul to a
+ * channel of its own. Each area then needs an AP on every beacon channel,
+ * because a tag is only heard on its own channel. Check the plan against
+ * the sub-band rules of the site: 868.0-868.6 MHz holds 3 channels at the
+ * default spacing.
+ */
+
+/* Build time settings, can be overridden with --define */
+#ifndef CHANNEL_PLAN_BASE_HZ
+#define CHANNEL_PLAN_BASE_HZ            868000000 // Channel 0
+#endif
+#ifndef CHANNEL_PLAN_SPACING_HZ
+#define CHANNEL_PLAN_SPACING_HZ         200000 // Wider than the 50 kbps Rx bandwidth
+#endif
+#ifndef CHANNEL_PLAN_BEACON_CHANNELS
+#define CHANNEL_PLAN_BEACON_CHANNELS    1 // Beacon channels are 0 to this - 1
+#endif
+#ifndef CHANNEL_PLAN_BACKHAUL
+#define CHANNEL_PLAN_BACKHAUL           0 // Channel of the uplinks
+#endif
+
+#if CHANNEL_PLAN_BEACON_CHANNELS < 1
+#error CHANNEL_PLAN_BEACON_CHANNELS must be at least 1
+#endif
+
+/* Frequency of a channel in Hz, for EasyLink_setFrequency */
+#define ChannelPlan_frequency(channel) \
+        (CHANNEL_PLAN_BASE_HZ + (uint32_t)(channel) * CHANNEL_PLAN_SPACING_HZ)
+
+/* Beacon channel of a tag, ids given out in order spread evenly */
+#define ChannelPlan_tagChannel(id)  ((uint8_t)(id) % CHANNEL_PLAN_BEACON_CHANNELS)
+
+#endif /* CHANNELPLAN_H */
@@ -0,0 +1,46 @@
+/*
+ *  ======== Trace.c ========
+ */
+#include "Trace.h"
+
+#ifdef TRACE_ENABLE
+
+#include <string.h>
+
+#include <ti/sysbios/hal/Hwi.h>
+#include <ti/drivers/rf/RF.h>
+
+/***** Variable declarations *****/
+
+Trace trace;    /* not static so you can see in ROV */
+
+#if (TRACE_SIZE & (TRACE_SIZE - 1)) != 0
+#error TRACE_SIZE must be a power of two
+#endif
+
+/***** Function definitions *****/
+
+void Trace_init(void) {
+    uint32_t first;
+
+    memset(&trace, 0, sizeof(trace));
+
+    Trace_record(TRACE_MARK, 0);
+    Trace_record(TRACE_MARK, 0);
+    first = trace.events[0].time;
+    trace.overhead = trace.events[1].time - first;
+}
+
+void Trace_record(uint8_t id, uint16_t arg) {
+    //Hwi_disable keeps the slot and its timestamp in order from any context
+    UInt key = Hwi_disable();
+    Trace_Event* e = &trace.events[trace.count & (TRACE_SIZE - 1)];
+
+    e->time = RF_getCurrentTime();
+    e->id = id;
+    e->arg = arg;
+    trace.count++;
+    Hwi_restore(key);
+}
+
+#endif /* TRACE_ENABLE */
@@ -55,6 +55,9 @@ The following is true for receive operation:
 - RX is enabled by calling EasyLink_receive() or EasyLink_receiveAsync().
 - Entering RX can be immediate or scheduled.
 - EasyLink_receive() is blocking and EasyLink_receiveAsync() is nonblocking.
+- EasyLink_receiveContinuousAsync() stays in RX across packets, received
+  packets are queued in EASYLINK_RX_QUEUE_ENTRIES data entries so packets
+  sent back to back are not lost while the previous one is read
 - the EasyLink API does not queue messages so calling another API function
   while in EasyLink_receiveAsync() will return ::EasyLink_Status_Busy_Error
 - an Async operation can be cancelled with EasyLink_abort()
@@ -66,6 +69,8 @@ The following apply for transmit operation:
 - EasyLink_transmit() for a scheduled command, or if TX can not start
 - the EasyLink API does not queue messages so calling another API function
   while in EasyLink_transmitAsync() will return ::EasyLink_Status_Busy_Error
+- EasyLink_transmitAsync() pauses continuous RX for the TX and resumes it
+  afterwards
 - an Async operation can be cancelled with EasyLink_abort()
 
 # Error handling #
@@ -103,8 +108,13 @@ drive documentation for more details.
 | EasyLink_transmit()           | Blocking Transmit                                  |
 | EasyLink_transmitAsync()      | Non-blocking Transmit                              |
 | EasyLink_transmitCcaAsync()   | Non-blocking Transmit with Clear Channel Assessment|
+| EasyLink_getCcaStats()        | Gets the Clear Channel Assessment counters         |
+| EasyLink_getStats()           | Gets the cumulative radio counters                 |
 | EasyLink_receive()            | Blocking Receive                                   |
 | EasyLink_receiveAsync()       | Nonblocking Receive                                |
+| EasyLink_receiveContinuousAsync() | Nonblocking Receive of consecutive packets     |
+| EasyLink_receiveContinuousViewAsync() | Same, without copying the packets          |
+| EasyLink_releaseRxView()      | Hands back a packet from the above                 |
 | EasyLink_abort()              | Aborts a non blocking call                         |
 | EasyLink_enableRxAddrFilter() | Enables/Disables RX filtering on the Addr          |
 | EasyLink_getIeeeAddr()        | Gets the IEEE Address                              |
@@ -114,6 +124,7 @@ drive documentation for more details.
 | EasyLink_getRfPower()         | Gets the Tx Power                                  |
 | EasyLink_getRssi()            | Gets the RSSI                                      |
 | EasyLink_getAbsTime()         | Gets the absolute time in RAT ticks                |
+| EasyLink_getAirTimeUs()       | Gets the time on air of a packet                   |
 | EasyLink_setCtrl()            | Set RF parameters, test modes or EasyLink options  |
 | EasyLink_getCtrl()            | Get RF parameters or EasyLink options              |
 | EasyLink_getIeeeAddr()        | Gets the IEEE address                              |
@@ -166,6 +177,10 @@ extern "C"
 //! \brief defines the Tx/Rx Max Address Size
 #define EASYLINK_MAX_ADDR_SIZE              8
 
+//! \brief defines the number of Rx data entries used by
+//! EasyLink_receiveContinuousAsync()
+#define EASYLINK_RX_QUEUE_ENTRIES           4
+
 //! \brief defines the Max number of Rx Address filters
 #define EASYLINK_MAX_ADDR_FILTERS           3
 
@@ -181,6 +196,9 @@ extern "C"
 //! \brief The back-off time units in microseconds
 #define EASYLINK_CCA_BACKOFF_TIMEUNITS      250
 
+//! \brief Channel busy rate of 100% in EasyLink_CcaStats::busyRate
+#define EASYLINK_CCA_BUSY_RATE_ONE          256
+
 //! \brief RSSI threshold for Clear Channel Assessment (CCA)
 #define EASYLINK_CS_RSSI_THRESHOLD_DBM      -80
 
@@ -300,6 +318,62 @@ typedef struct
 typedef void (*EasyLink_ReceiveCb)(EasyLink_RxPacket * rxPacket,
         EasyLink_Status status);
 
+//! \brief View of a RX'ed packet still in its Rx data entry
+typedef struct
+{
+        uint8_t *dstAddr;                //!< Dst Address of RX'ed packet
+        uint8_t *payload;                //!< payload of RX'ed packet
+        uint8_t len;                     //!< length of RX'ed packet
+        int8_t rssi;                     //!< rssi of RX'ed packet
+        uint32_t absTime;                //!< Absolute time that packet was Rx
+        uint8_t *entry;                  //!< Rx data entry, handed back with
+                                         //!< EasyLink_releaseRxView()
+} EasyLink_RxView;
+
+//! \brief EasyLink Callback function type for Received packet, registered
+//! with EasyLink_receiveContinuousViewAsync()
+typedef void (*EasyLink_ReceiveViewCb)(EasyLink_RxView * rxView,
+        EasyLink_Status status);
+
+#if (defined(DeviceFamily_CC13X0) || defined(DeviceFamily_CC13X2))
+//! \brief Clear Channel Assessment counters, see EasyLink_getCcaStats()
+typedef struct
+{
+        uint32_t txCount;                //!< EasyLink_transmitCcaAsync() calls
+        uint32_t txSuccess;              //!< Packets sent on an idle channel
+        uint32_t busyCount;              //!< Carrier sense found the channel busy
+        uint32_t retries;                //!< Back-offs run
+        uint32_t busyFailures;           //!< Tx given up after the max back-off
+        uint16_t busyRate;               //!< Moving average of the carrier sense
+                                         //!< outcome, EASYLINK_CCA_BUSY_RATE_ONE
+                                         //!< is always busy
+        uint8_t startBackOff;            //!< Back-off exponent the next Tx
+                                         //!< starts with
+} EasyLink_CcaStats;
+#endif // (defined(DeviceFamily_CC13X0) || defined(DeviceFamily_CC13X2))
+
+//! \brief Radio counters kept across commands, see EasyLink_getStats()
+typedef struct
+{
+        uint32_t rxOk;                   //!< Packets received with a valid CRC
+        uint32_t rxNok;                  //!< Packets received with a CRC error
+        uint32_t rxIgnored;              //!< Packets dropped by the address filter
+        uint32_t rxBufFull;              //!< Packets lost to a full Rx buffer
+        uint32_t rxTimeouts;             //!< Rx operations ended by their timeout
+        uint32_t rxAborts;               //!< Rx operations aborted
+        uint32_t rxErrors;               //!< Rx operations ended by an error
+        uint32_t txOk;                   //!< Packets sent
+        uint32_t txAborts;               //!< Tx operations aborted
+        uint32_t txErrors;               //!< Tx operations failed, including
+                                         //!< CCA Tx given up on a busy channel
+        uint32_t busyErrors;             //!< Calls refused with
+                                         //!< EasyLink_Status_Busy_Error
+        int8_t lastRssi;                 //!< RSSI of the last packet received
+#if (defined(DeviceFamily_CC13X0) || defined(DeviceFamily_CC13X2))
+        EasyLink_CcaStats cca;           //!< Same as EasyLink_getCcaStats()
+#endif // (defined(DeviceFamily_CC13X0) || defined(DeviceFamily_CC13X2))
+} EasyLink_Stats;
+
 //! \brief EasyLink Callback function type for Tx Done registered with EasyLink_TransmitAsync()
 typedef void (*EasyLink_TxDoneCb)(EasyLink_Status status);
 
@@ -374,6 +448,23 @@ extern EasyLink_Status EasyLink_init(EasyLink_Params *params);
 //*****************************************************************************
 extern EasyLink_Status EasyLink_getAbsTime(uint32_t *pui32AbsTime);
 
+//*****************************************************************************
+//
+//! \brief Gets the time on air of a packet
+//!
+//! The time is worked out from the setup of the PHY in use (symbol rate,
+//! preamble, sync word, length byte, CRC and FEC/DSSS coding), so it holds
+//! for any PHY exported from SmartRF Studio as ::EasyLink_Phy_Custom. It is
+//! the deadline EasyLink schedules Tx commands with.
+//!
+//! \param len      Payload length in bytes, without the destination address
+//!
+//! \return Time on air in us, rounded up, or 0 if EasyLink is not
+//! initialized
+//
+//*****************************************************************************
+extern uint32_t EasyLink_getAirTimeUs(uint8_t len);
+
 //*****************************************************************************
 //
 //! \brief Gets the RSSI value of an ongoing Radio Operation
@@ -415,6 +506,13 @@ extern EasyLink_Status EasyLink_transmit(EasyLink_TxPacket *txPacket);
 //! successfully scheduled then the callback will be call once the Tx is
 //! complete.
 //!
+//! If EasyLink_receiveContinuousAsync() or
+//! EasyLink_receiveContinuousViewAsync() is running, the Rx is stopped once
+//! the packet being received (if any) is complete, the Tx is sent and the Rx
+//! is resumed, with its queue and callback, before the tx done callback is
+//! called. Lent Rx entries stay valid. In that case this function must be
+//! called from a Task as it waits for the Rx to stop.
+//!
 //! \param txPacket The descriptor for the packet to be Tx'ed.
 //! \param cb       The tx done function pointer.
 //!
@@ -435,8 +533,13 @@ extern EasyLink_Status EasyLink_transmitAsync(EasyLink_TxPacket *txPacket,
 //! reassessing. It does this a certain number
 //! (EASYLINK_MAX_CCA_BACKOFF_WINDOW - EASYLINK_MIN_CCA_BACKOFF_WINDOW)
 //! of times before quitting unsuccessfully and running to the callback.
+//! The first back-off window grows with the channel busy rate seen by
+//! earlier Tx's, so fewer retries are wasted on a crowded channel, and stays
+//! below EASYLINK_MAX_CCA_BACKOFF_WINDOW so that two back-offs are left.
 //! If the Tx is successfully scheduled then the callback will be called once
-//! the Tx is complete.
+//! the Tx is complete. A running continuous Rx is paused as for
+//! EasyLink_transmitAsync() for each carrier sense and the Tx, it listens
+//! through the back-offs in between.
 //!
 //! \param txPacket The descriptor for the packet to be Tx'ed.
 //! \param cb       The tx done function pointer.
@@ -446,8 +549,33 @@ extern EasyLink_Status EasyLink_transmitAsync(EasyLink_TxPacket *txPacket,
 //*****************************************************************************
 extern EasyLink_Status EasyLink_transmitCcaAsync(EasyLink_TxPacket *txPacket,
         EasyLink_TxDoneCb cb);
+
+//*****************************************************************************
+//
+//! \brief Gets the Clear Channel Assessment counters.
+//!
+//! \param stats    Filled with the counters since EasyLink_init().
+//!
+//! \return ::EasyLink_Status
+//
+//*****************************************************************************
+extern EasyLink_Status EasyLink_getCcaStats(EasyLink_CcaStats *stats);
 #endif // (defined(DeviceFamily_CC13X0) || defined(DeviceFamily_CC13X2))
 
+//*****************************************************************************
+//
+//! \brief Gets the radio counters.
+//!
+//! The counters accumulate over every Rx and Tx command, including one still
+//! running, so the call is cheap enough to poll for telemetry.
+//!
+//! \param stats    Filled with the counters since EasyLink_init().
+//!
+//! \return ::EasyLink_Status
+//
+//*****************************************************************************
+extern EasyLink_Status EasyLink_getStats(EasyLink_Stats *stats);
+
 //*****************************************************************************
 //
 //! \brief Blocking call that waits for an Rx Packet.
@@ -479,11 +607,74 @@ extern EasyLink_Status EasyLink_receive(EasyLink_RxPacket *rxPacket);
 //*****************************************************************************
 extern EasyLink_Status EasyLink_receiveAsync(EasyLink_ReceiveCb cb, uint32_t absTime);
 
+//*****************************************************************************
+//
+//! \brief Enables continuous Asynchronous Packet Rx with non blocking call.
+//!
+//! This function is a non blocking call to Rx consecutive packets. The Rx
+//! is turned on and stays on, the Callback is called with
+//! ::EasyLink_Status_Success for every packet received, with the RSSI and
+//! the radio time of the packet filled in. Packets are queued in
+//! EASYLINK_RX_QUEUE_ENTRIES data entries until the Callback has read them,
+//! packets with a CRC error are dropped. The Rx ends on EasyLink_abort() or
+//! on the ::EasyLink_Ctrl_AsyncRx_TimeOut timeout, the Callback is then
+//! called a last time with the status the Rx ended with.
+//!
+//! \param cb        The rx function pointer.
+//! \param absTime   Start time of Rx (0: now !0: absolute radio time to
+//!                  start Rx)
+//!
+//! \return ::EasyLink_Status
+//
+//*****************************************************************************
+extern EasyLink_Status EasyLink_receiveContinuousAsync(EasyLink_ReceiveCb cb, uint32_t absTime);
+
+//*****************************************************************************
+//
+//! \brief Enables continuous Asynchronous Packet Rx without copying packets.
+//!
+//! This function behaves as EasyLink_receiveContinuousAsync() but the
+//! Callback gets a view pointing into the Rx data entry instead of a copy
+//! of the packet. The entry is lent to the application until
+//! EasyLink_releaseRxView() is called, the view itself is only valid during
+//! the Callback and must be copied to keep the entry longer. A lent entry is
+//! out of the Rx queue, when all EASYLINK_RX_QUEUE_ENTRIES entries are lent
+//! the radio stops receiving and Rx starts again as soon as one is
+//! released. The packet that found no entry free is lost and counted in the
+//! rxBufFull of EasyLink_getStats(), packets sent while the Rx is stopped
+//! are not seen by the radio and counted nowhere. The Callback is called
+//! with a NULL view when Rx ends.
+//!
+//! \param cb        The rx function pointer.
+//! \param absTime   Start time of Rx (0: now !0: absolute radio time to
+//!                  start Rx)
+//!
+//! \return ::EasyLink_Status
+//
+//*****************************************************************************
+extern EasyLink_Status EasyLink_receiveContinuousViewAsync(EasyLink_ReceiveViewCb cb, uint32_t absTime);
+
+//*****************************************************************************
+//
+//! \brief Hands an Rx data entry back to EasyLink.
+//!
+//! This function recycles the entry of a view received from
+//! EasyLink_receiveContinuousViewAsync(), the view must not be used after.
+//! Views may be kept across a restart of the Rx, the entry joins the Rx
+//! queue when released. Releasing a view twice has no effect.
+//!
+//! \param rxView    The view of the packet.
+//
+//*****************************************************************************
+extern void EasyLink_releaseRxView(EasyLink_RxView *rxView);
+
 //*****************************************************************************
 //
 //! \brief Abort a previously call Async Tx/Rx.
 //!
-//! This function is a blocking call to abort a previous Async Tx/Rx
+//! This function is a blocking call to abort a previous Async Tx/Rx. A CCA
+//! Tx waiting out a back-off is aborted first, the continuous Rx listening
+//! meanwhile goes on until the next call.
 //!
 //! \return ::EasyLink_Status
 //
@@ -35,11 +35,6 @@
  */
  /* Standard C Libraries */
 #include <stdlib.h>
-#include <stdio.h>
-
-/* timer library */
-#include <ti/drivers/timer/GPTimerCC26XX.h>
-#include <xdc/runtime/Types.h>
 
 /* XDCtools Header files */
 #include <xdc/std.h>
@@ -56,34 +51,40 @@
 /* TI-RTOS Header files */
 #include <ti/drivers/PIN.h>
 
+/* Driverlib Header files */
+#include <ti/devices/DeviceFamily.h>
+#include DeviceFamily_constructPath(driverlib/aon_batmon.h)
+
 /* Board Header files */
 #include "Board.h"
 
 /* EasyLink API Header files */
 #include "easylink/EasyLink.h"
 
-/* Undefine to not use async mode */
+#include "BeaconScheduler.h"
+#include "Trace.h"
+#include "ChannelPlan.h"
+#include "Beacon.h"
+
+/* Undefine to not use async mode or low power beacon mode */
 #define RFEASYLINKTX_ASYNC
+#define RFEASYLINKTX_LOW_POWER
 
 #define RFEASYLINKTX_TASK_STACK_SIZE    1024
 #define RFEASYLINKTX_TASK_PRIORITY      2
 
-#define RFEASYLINKTX_BURST_SIZE         10
-#define RFEASYLINKTXPAYLOAD_LENGTH      30
+#define RFEASYLINKTX_BATTERY_LOW_MV     2300 // Beacons carry BEACON_FLAG_BATTERY_LOW below this
+
+/* Time the task wakes up before a beacon is due, covers the radio power up */
+#define RFEASYLINKTX_WAKEUP_LEAD_MS     5
 
 #define MY_ID 1
+#define TAG_CHANNEL ChannelPlan_tagChannel(MY_ID) // Beacon channel, see ChannelPlan.h
 
 Task_Struct txTask;    /* not static so you can see in ROV */
 static Task_Params txTaskParams;
 static uint8_t txTaskStack[RFEASYLINKTX_TASK_STACK_SIZE];
 
-/*Timer driver handle */
-static GPTimerCC26XX_Handle hTimer;
-Task_Struct timerTask;
-static Task_Params timerTaskParams;
-
-GPTimerCC26XX_Value restartMatchVal = 0;
-
 /* Pin driver handle */
 static PIN_Handle pinHandle;
 static PIN_State pinState;
@@ -103,6 +104,8 @@ PIN_Config pinTable[] = {
 
 static uint16_t seqNumber;
 
+BeaconScheduler beaconScheduler;    /* not static so you can see in ROV */
+
 #ifdef RFEASYLINKTX_ASYNC
 static Semaphore_Handle txDoneSem;
 #endif //RFEASYLINKTX_ASYNC
@@ -131,12 +134,24 @@ void txDoneCb(EasyLink_Status status)
 }
 #endif //RFEASYLINKTX_ASYNC
 
-static void rfEasyLinkTxFnx(UArg a0, UArg a1)//GPTimerCC26XX_Handle handle, GPTimerCC26XX_IntMask interruptMask)
+//Beacon flags from the tag's state, see Beacon.h
+static uint8_t beaconFlags(void)
 {
-    printf("oi lari\n");
+    uint8_t flags = 0;
 
-    uint8_t txBurstSize = 0;
+    //Battery voltage is 3.8 fixed point volts
+    if(((AONBatMonBatteryVoltageGet() * 1000) >> 8) < RFEASYLINKTX_BATTERY_LOW_MV)
+    {
+        flags |= BEACON_FLAG_BATTERY_LOW;
+    }
+
+    return flags;
+}
+
+static void rfEasyLinkTxFnx(UArg a0, UArg a1)
+{
     uint32_t absTime;
+    uint8_t ieeeAddr[8];
     
 #ifdef RFEASYLINKTX_ASYNC
     /* Create a semaphore for Async */
@@ -167,11 +182,11 @@ static void rfEasyLinkTxFnx(UArg a0, UArg a1)//GPTimerCC26XX_Handle handle, GPTi
         System_abort("EasyLink_init failed");
     }
 	
-    /*
-     * If you wish to use a frequency other than the default, use
-     * the following API:
-     * EasyLink_setFrequency(868000000);
-     */
+    /* Beacon on the tag's channel of the channel plan */
+    if(EasyLink_setFrequency(ChannelPlan_frequency(TAG_CHANNEL)) != EasyLink_Status_Success)
+    {
+        System_abort("EasyLink_setFrequency failed");
+    }
 
 #if (defined __CC1352P1_LAUNCHXL_BOARD_H__)
     /* Set output power to 20dBm */
@@ -186,42 +201,50 @@ static void rfEasyLinkTxFnx(UArg a0, UArg a1)//GPTimerCC26XX_Handle handle, GPTi
         while(1);
     }
 
+    /* Tag identity seeds the beacon slots and jitter */
+    if(EasyLink_getIeeeAddr(ieeeAddr) != EasyLink_Status_Success ||
+            EasyLink_getAbsTime(&absTime) != EasyLink_Status_Success)
+    {
+        System_abort("Beacon scheduler setup failed");
+    }
+    BeaconScheduler_init(&beaconScheduler, ieeeAddr, MY_ID, absTime);
+
+    /* Battery voltage for the beacon flags */
+    AONBatMonEnable();
+
     while(1) {
         EasyLink_TxPacket txPacket =  { {0}, 0, 0, {0} };
 
-        /* Create packet */
-        txPacket.payload[0] = (uint8_t)(MY_ID);
-        uint8_t i;
-        for (i = 1; i < RFEASYLINKTXPAYLOAD_LENGTH; i++)
-        {
-          txPacket.payload[i] = 0x02;
-        }
-
-        txPacket.len = RFEASYLINKTXPAYLOAD_LENGTH;
+        /* Create packet, the sequence number lets the AP count lost beacons */
+        txPacket.len = Beacon_encode(txPacket.payload, (uint8_t)(MY_ID),
+                (uint8_t)(seqNumber++), beaconFlags());
         txPacket.dstAddr[0] = 0xaa;
 
-        /* Add a Tx delay for > 500ms, so that the abort kicks in and brakes the burst */
         if(EasyLink_getAbsTime(&absTime) != EasyLink_Status_Success)
         {
             // Problem getting absolute time
         }
-        if(txBurstSize++ >= RFEASYLINKTX_BURST_SIZE)
-        {
-          /* Set Tx absolute time to current time + 1s */
-          txPacket.absTime = absTime + EasyLink_ms_To_RadioTime(1000);
-          txBurstSize = 0;
-        }
-        /* Else set the next packet in burst to Tx in 100ms */
-        else
+        txPacket.absTime = BeaconScheduler_next(&beaconScheduler, absTime);
+
+#ifdef RFEASYLINKTX_LOW_POWER
+        /*
+         * Sleep until just before the beacon is due, the device goes to
+         * standby and the radio stays off instead of holding a Tx command
+         * scheduled up to a whole burst gap ahead
+         */
+        uint32_t sleepMs = EasyLink_RadioTime_To_ms((txPacket.absTime - absTime));
+        if(sleepMs > RFEASYLINKTX_WAKEUP_LEAD_MS)
         {
-          /* Set Tx absolute time to current time + 100ms */
-          txPacket.absTime = absTime + EasyLink_ms_To_RadioTime(100);
+            Task_sleep((sleepMs - RFEASYLINKTX_WAKEUP_LEAD_MS) * 1000 / Clock_tickPeriod);
+            EasyLink_getAbsTime(&absTime);
         }
+#endif //RFEASYLINKTX_LOW_POWER
 
 #ifdef RFEASYLINKTX_ASYNC
         EasyLink_transmitAsync(&txPacket, txDoneCb);
-        /* Wait 300ms for Tx to complete */
-        if(Semaphore_pend(txDoneSem, (300000 / Clock_tickPeriod)) == FALSE)
+        /* Wait until 300ms after the beacon is due for Tx to complete */
+        uint32_t txWaitMs = EasyLink_RadioTime_To_ms((txPacket.absTime - absTime)) + 300;
+        if(Semaphore_pend(txDoneSem, (txWaitMs * 1000 / Clock_tickPeriod)) == FALSE)
         {
             /* TX timed out, abort */
             if(EasyLink_abort() == EasyLink_Status_Success)
@@ -248,8 +271,6 @@ static void rfEasyLinkTxFnx(UArg a0, UArg a1)//GPTimerCC26XX_Handle handle, GPTi
             PIN_setOutputValue(pinHandle, Board_PIN_LED2,!PIN_getOutputValue(Board_PIN_LED2));
         }
 #endif //RFEASYLINKTX_ASYNC
-
-        //Task_sleep(1000000);
     }
 
 }
@@ -274,6 +295,10 @@ int main(void)
     /* Call driver init functions. */
     Board_initGeneral();
 
+#ifdef TRACE_ENABLE
+    Trace_init();
+#endif
+
     /* Open LED pins */
     pinHandle = PIN_open(&pinState, pinTable);
 	Assert_isTrue(pinHandle != NULL, NULL); 
@@ -0,0 +1,85 @@
+/*
+ *  ======== AirTimeTest.c ========
+ */
+#include "Check.h"
+#include "easylink/AirTime.h"
+
+/***** Defines *****/
+
+#define TAG_BEACON_BYTES    (3 + 1)     // Beacon plus the address byte
+#define MAX_UPLINK_BYTES    (30 + 1)
+
+/***** Variable declarations *****/
+
+/* Radio setup fields of the PHY profiles, see smartrf_settings */
+typedef struct
+{
+    const char* name;
+    uint32_t rateWord;
+    uint8_t preScale;
+    uint8_t symbolsPerBit;
+    uint8_t nPreamBytes;
+    uint8_t nSwBits;
+    uint32_t bitRate;           // Expected
+    uint32_t beaconUs;          // Expected air time of a tag beacon
+    uint32_t uplinkUs;          // Expected air time of a 30 byte payload
+} Profile;
+
+static const Profile profiles[] = {
+    {"50 kbps custom", 0x8000, 0xF, 1, 4, 32, 50000, 2400, 6720},
+    {"SimpleLink LR", 0x3333, 0xF, AIRTIME_SL_LR_SYMBOLS_PER_BIT, 2, 32, 4999, 20805, 64013},
+    {"625 bps LRM", 0x199A, 0xF, AIRTIME_LRM_SYMBOLS_PER_BIT, 5, 32, 625, 204800, 550400},
+    {"4.8 kbps OOK", 0xC4A, 0xF, 1, 4, 32, 4800, 25000, 70000},
+    {"200 kbps GFSK", 0x20000, 0xF, 1, 4, 32, 200000, 600, 1680},
+};
+
+/***** Function definitions *****/
+
+static void testProfiles(void) {
+    const Profile* p;
+    uint16_t overhead;
+    uint32_t bitRate;
+    uint8_t i;
+
+    for(i = 0; i < sizeof(profiles) / sizeof(profiles[0]); i++) {
+        p = &profiles[i];
+        bitRate = AirTime_bitRate(p->rateWord, p->preScale, p->symbolsPerBit);
+        overhead = AirTime_overheadBits(p->nPreamBytes, p->nSwBits, true, true);
+
+        if(bitRate != p->bitRate ||
+                AirTime_us(bitRate, overhead, TAG_BEACON_BYTES) != p->beaconUs ||
+                AirTime_us(bitRate, overhead, MAX_UPLINK_BYTES) != p->uplinkUs) {
+            printf("%s: %u bit/s, %u us, %u us\n", p->name, (unsigned)bitRate,
+                    (unsigned)AirTime_us(bitRate, overhead, TAG_BEACON_BYTES),
+                    (unsigned)AirTime_us(bitRate, overhead, MAX_UPLINK_BYTES));
+            CHECK(0);
+        }
+    }
+}
+
+static void testOverhead(void) {
+    //Preamble settings that are not byte counts
+    CHECK(AirTime_overheadBits(AIRTIME_PREAMBLE_1_BIT, 32, false, false) == 1 + 32);
+    CHECK(AirTime_overheadBits(AIRTIME_PREAMBLE_4_BITS, 32, false, false) == 4 + 32);
+    CHECK(AirTime_overheadBits(1, 32, false, false) == 8 + 32);
+
+    //Length byte and CRC
+    CHECK(AirTime_overheadBits(4, 32, true, false) == 32 + 32 + 8);
+    CHECK(AirTime_overheadBits(4, 32, false, true) == 32 + 32 + AIRTIME_CRC_BITS);
+}
+
+static void testRounding(void) {
+    //Rounded up so a deadline is never short, 0 without a bit rate
+    CHECK(AirTime_us(3, 0, 1) == 2666667);
+    CHECK(AirTime_us(1000000, 8, 0) == 8);
+    CHECK(AirTime_us(0, 88, 31) == 0);
+    CHECK(AirTime_bitRate(0x8000, 0, 1) == 0);
+}
+
+int main(void) {
+    testProfiles();
+    testOverhead();
+    testRounding();
+
+    return CHECK_RESULT();
+}
@@ -0,0 +1,185 @@
+/*
+ *  ======== BeaconCapacityTest.c ========
+ *
+ *  The tags' 3 byte beacon against the 30 byte one it replaced: both decode
+ *  with Beacon.c, and the air time of each gives the tags one channel takes.
+ *
+ *  For each format tags are added to a channel, switched on at random times
+ *  and sending with the tag's BeaconScheduler.c, until fewer than a share of
+ *  their beacons get through; beacons that overlap are all lost. Prints the
+ *  air time of each format, the share of beacons through for a few tag counts
+ *  and the most tags that keep 75% and 50% of their beacons.
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "Check.h"
+#include "Beacon.h"
+#include "BeaconScheduler.h"
+#include "easylink/AirTime.h"
+
+/***** Defines *****/
+
+#define OLD_BEACON_SIZE     30      // [tag id][seq] and 28 filler bytes
+#define SIM_SECONDS         60
+#define MAX_TAGS            250
+#define RUNS                4       // Switch on times averaged over
+#define BELOW_RUN           5
+#define RAT_PER_US          4
+#define RAT_PER_MS          4000
+
+/* The radio setup of the tags, see smartrf_settings */
+#define RATE_WORD           0x8000
+#define PRESCALE            0xF
+#define PREAMBLE_BYTES      4
+#define SYNC_WORD_BITS      32
+
+#define BURST_PERIOD_MS     (BEACON_BURST_SIZE * BEACON_INTERVAL_MS + BEACON_BURST_GAP_MS)
+#define MAX_BEACONS         (MAX_TAGS * (SIM_SECONDS + 1) * BEACON_BURST_SIZE * 1000 / \
+        BURST_PERIOD_MS + MAX_TAGS)
+
+/***** Variable declarations *****/
+
+static uint32_t starts[MAX_BEACONS];
+static uint32_t randomState = 1;
+
+/***** Function definitions *****/
+
+/* Next pseudo random number, the same run every time */
+static uint32_t nextRandom(void) {
+    randomState = randomState * 1664525u + 1013904223u;
+
+    return randomState >> 8;
+}
+
+static int byTime(const void* a, const void* b) {
+    const uint32_t* x = a;
+    const uint32_t* y = b;
+
+    return (*x > *y) - (*x < *y);
+}
+
+/* Share of the beacons of tags 1 to tags that overlap no other, in % */
+static double deliveredOnce(uint8_t tags, uint32_t beaconTicks) {
+    const uint32_t end = (uint32_t)SIM_SECONDS * 1000 * RAT_PER_MS;
+    BeaconScheduler scheduler;
+    uint8_t ieeeAddr[8] = {0x00, 0x12, 0x4B, 0x00, 0x0A, 0x0B, 0, 0};
+    uint32_t count = 0;
+    uint32_t lost = 0;
+    uint32_t t;
+    uint32_t i;
+    uint8_t tag;
+
+    for(tag = 1; tag <= tags; tag++) {
+        //Switched on at any time in a burst period
+        ieeeAddr[7] = tag;
+        t = nextRandom() % (BURST_PERIOD_MS * RAT_PER_MS);
+        BeaconScheduler_init(&scheduler, ieeeAddr, tag, t);
+        while((t = BeaconScheduler_next(&scheduler, t)) < end && count < MAX_BEACONS) {
+            starts[count++] = t;
+            t += beaconTicks;
+        }
+    }
+
+    qsort(starts, count, sizeof(uint32_t), byTime);
+    for(i = 0; i < count; i++) {
+        if((i > 0 && starts[i] < starts[i - 1] + beaconTicks) ||
+                (i + 1 < count && starts[i + 1] < starts[i] + beaconTicks)) {
+            lost++;
+        }
+    }
+
+    return count ? 100.0 * (count - lost) / count : 100.0;
+}
+
+static double delivered(uint8_t tags, uint32_t beaconTicks) {
+    double sum = 0;
+    uint8_t run;
+
+    randomState = tags;
+    for(run = 0; run < RUNS; run++) {
+        sum += deliveredOnce(tags, beaconTicks);
+    }
+
+    return sum / RUNS;
+}
+
+/*
+ * Most tags one channel takes with at least percent of their beacons through,
+ * the search ends once BELOW_RUN tag counts in a row fall short
+ */
+static uint8_t capacity(uint32_t beaconTicks, double percent) {
+    uint8_t most = 1;
+    uint8_t tags;
+
+    for(tags = 2; tags < MAX_TAGS && tags <= most + BELOW_RUN; tags++) {
+        if(delivered(tags, beaconTicks) >= percent) {
+            most = tags;
+        }
+    }
+
+    return most;
+}
+
+static void testFormats(void) {
+    uint8_t payload[OLD_BEACON_SIZE];
+    Beacon beacon;
+
+    CHECK(Beacon_encode(payload, 42, 200, BEACON_FLAG_BATTERY_LOW) == BEACON_SIZE);
+    CHECK(Beacon_decode(&beacon, payload, BEACON_SIZE) == 0);
+    CHECK(beacon.id == 42 && beacon.seq == 200 && beacon.flags == BEACON_FLAG_BATTERY_LOW);
+
+    //The old beacon as the tags sent it, its filler is not taken for flags
+    memset(payload, 0x02, sizeof(payload));
+    payload[0] = 7;
+    payload[1] = 9;
+    CHECK(Beacon_decode(&beacon, payload, OLD_BEACON_SIZE) == 0);
+    CHECK(beacon.id == 7 && beacon.seq == 9 && beacon.flags == 0);
+
+    CHECK(Beacon_decode(&beacon, payload, 1) == -1);
+}
+
+static void testCapacity(void) {
+    static const uint8_t tagCounts[] = {5, 10, 20, 40, 80};
+    static const double shares[] = {75, 50};
+    uint32_t bitRate = AirTime_bitRate(RATE_WORD, PRESCALE, 1);
+    uint16_t overhead = AirTime_overheadBits(PREAMBLE_BYTES, SYNC_WORD_BITS, true, true);
+    uint32_t oldUs = AirTime_us(bitRate, overhead, 1 + OLD_BEACON_SIZE);
+    uint32_t newUs = AirTime_us(bitRate, overhead, 1 + BEACON_SIZE);
+    double oldShare;
+    double newShare;
+    uint8_t oldTags;
+    uint8_t newTags;
+    uint8_t i;
+
+    //Address byte included
+    CHECK(oldUs == 6720);
+    CHECK(newUs == 2400);
+    printf("beacon air time %u us with %u bytes, %u us with %u\n", oldUs, OLD_BEACON_SIZE,
+            newUs, BEACON_SIZE);
+
+    printf("%6s %12s %16s\n", "tags", "old through", "compact through");
+    for(i = 0; i < sizeof(tagCounts); i++) {
+        oldShare = delivered(tagCounts[i], oldUs * RAT_PER_US);
+        newShare = delivered(tagCounts[i], newUs * RAT_PER_US);
+        printf("%6u %11.1f%% %15.1f%%\n", tagCounts[i], oldShare, newShare);
+        CHECK(newShare > oldShare);
+    }
+
+    //The channel takes about as many more tags as the air time is shorter
+    for(i = 0; i < sizeof(shares) / sizeof(shares[0]); i++) {
+        oldTags = capacity(oldUs * RAT_PER_US, shares[i]);
+        newTags = capacity(newUs * RAT_PER_US, shares[i]);
+        printf("%2.0f%% of the beacons through: %u tags, %u compact, %.1f times\n", shares[i],
+                oldTags, newTags, (double)newTags / oldTags);
+        CHECK(newTags < MAX_TAGS - 1);
+        CHECK(2 * newTags > 5 * oldTags);
+    }
+}
+
+int main(void) {
+    testFormats();
+    testCapacity();
+
+    return CHECK_RESULT();
+}
@@ -0,0 +1,117 @@
+/*
+ *  ======== BeaconSchedulerTest.c ========
+ */
+#include "Check.h"
+#include "BeaconScheduler.h"
+#include "easylink/EasyLink.h"
+
+/***** Defines *****/
+
+#define INTERVAL        ((uint32_t)EasyLink_ms_To_RadioTime(BEACON_INTERVAL_MS))
+#define GAP             ((uint32_t)EasyLink_ms_To_RadioTime(BEACON_BURST_GAP_MS))
+#define SLOT            ((uint32_t)EasyLink_ms_To_RadioTime(BEACON_SLOT_MS))
+#define JITTER          ((uint32_t)EasyLink_ms_To_RadioTime(BEACON_JITTER_MS))
+#define MIN_LEAD        ((uint32_t)EasyLink_ms_To_RadioTime(2))
+
+/***** Function definitions *****/
+
+/* Offset of a beacon time into its interval, from the interval base */
+static uint32_t offsetInInterval(uint32_t t, uint32_t base) {
+    return (t - base) % INTERVAL;
+}
+
+static void testSchedule(void) {
+    const uint8_t ieeeAddr[8] = {0x00, 0x12, 0x4B, 0x00, 0x11, 0x22, 0x33, 0x44};
+    BeaconScheduler scheduler;
+    uint32_t start = 0xFFF00000u; //RAT time wraps during the test
+    uint32_t base;
+    uint32_t t;
+    uint32_t prev = 0;
+    uint32_t offset;
+    uint8_t slot;
+    int burst;
+    int i;
+
+    BeaconScheduler_init(&scheduler, ieeeAddr, 1, start);
+    base = scheduler.intervalStart;
+    CHECK(base - start >= MIN_LEAD);
+
+    for(burst = 0; burst < 20; burst++) {
+        slot = scheduler.slot;
+        for(i = 0; i < BEACON_BURST_SIZE; i++) {
+            //Asked right after the previous beacon, never late
+            t = BeaconScheduler_next(&scheduler, (burst == 0 && i == 0) ? start : prev);
+            if(i == 0 && burst > 0) {
+                //New burst, in a new slot after the gap
+                slot = scheduler.slot;
+                base += GAP;
+            }
+            CHECK(slot < BEACON_SLOT_COUNT);
+
+            //In its slot, jitter within the first half of the slot
+            offset = offsetInInterval(t, base);
+            CHECK(offset >= slot * SLOT);
+            CHECK(offset < slot * SLOT + JITTER);
+
+            if(burst > 0 || i > 0) {
+                CHECK((int32_t)(t - prev) > 0);
+            }
+            prev = t;
+        }
+        base += INTERVAL;
+    }
+}
+
+static void testFallBehind(void) {
+    const uint8_t ieeeAddr[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    BeaconScheduler scheduler;
+    uint32_t base;
+    uint32_t now;
+    uint32_t t;
+    uint8_t slot;
+
+    BeaconScheduler_init(&scheduler, ieeeAddr, 7, 1000);
+    base = scheduler.intervalStart;
+    slot = scheduler.slot;
+
+    //3.5 intervals late: the beacon moves to the first interval still ahead,
+    //keeping its slot
+    now = base + 3 * INTERVAL + INTERVAL / 2;
+    t = BeaconScheduler_next(&scheduler, now);
+    CHECK((int32_t)(t - now) >= (int32_t)MIN_LEAD);
+    CHECK(t - now < INTERVAL + MIN_LEAD);
+    CHECK(offsetInInterval(t, base) >= slot * SLOT);
+    CHECK(offsetInInterval(t, base) < slot * SLOT + JITTER);
+
+    //The next one follows in the next interval, in the same slot
+    now = t;
+    t = BeaconScheduler_next(&scheduler, now);
+    CHECK((t - base) / INTERVAL == (now - base) / INTERVAL + 1);
+    CHECK(offsetInInterval(t, base) >= slot * SLOT);
+    CHECK(offsetInInterval(t, base) < slot * SLOT + JITTER);
+}
+
+static void testSlotSpread(void) {
+    uint8_t ieeeAddr[8] = {0};
+    BeaconScheduler scheduler;
+    int used[BEACON_SLOT_COUNT] = {0};
+    int id;
+    int i;
+
+    //Tags that only differ by id spread over the slots
+    for(id = 0; id < 10 * BEACON_SLOT_COUNT; id++) {
+        BeaconScheduler_init(&scheduler, ieeeAddr, (uint8_t)id, 0);
+        used[scheduler.slot]++;
+    }
+    for(i = 0; i < BEACON_SLOT_COUNT; i++) {
+        CHECK(used[i] > 0);
+    }
+}
+
+int main(void) {
+    testSchedule();
+    testFallBehind();
+    testSlotSpread();
+
+    return CHECK_RESULT();
+}
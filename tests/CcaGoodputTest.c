@@ -0,0 +1,262 @@
+/*
+ *  ======== CcaGoodputTest.c ========
+ *
+ *  Uplink goodput of 4 to 32 APs in range of each other, all sending with
+ *  EasyLink_transmitCcaAsync, slotted on the CCA back-off time unit. Each AP
+ *  runs the CCA of EasyLink.c: a carrier sense over the channel idle time
+ *  ending on busy, a back-off of 0 to 2^be - 1 units after each busy one, a
+ *  start exponent from its own busy rate and the Tx given up past the max
+ *  exponent. APs ending their carrier sense in the same slot collide. Two
+ *  ways of running it:
+ *
+ *    paused     as before, the start exponent up to the max window, leaving
+ *               a busy channel a single back-off, and continuous Rx paused
+ *               from the request to the end of the Tx
+ *    listening  as now, the start exponent one short of the max and Rx only
+ *               paused for the carrier senses and the Tx
+ *
+ *  Prints the uplinks sent, collided and given up, the goodput as the share
+ *  of time the channel carried a good uplink, and the share of time the APs
+ *  listened for beacons.
+ */
+#include <string.h>
+
+#include "Check.h"
+#include "easylink/AirTime.h"
+#include "easylink/EasyLink.h"
+
+/***** Defines *****/
+
+#define SIM_SECONDS         120
+#define SLOT_US             EASYLINK_CCA_BACKOFF_TIMEUNITS
+#define CS_SLOTS            (EASYLINK_CHANNEL_IDLE_TIME_US / SLOT_US)
+#define MAX_APS             32
+#define UPLINK_GAP_MS       400     // Mean time from an uplink to the next one
+#define UPLINK_BYTES        EASYLINK_MAX_DATA_LENGTH
+
+/* The AP's radio setup, see smartrf_settings */
+#define AP_RATE_WORD        0x8000
+#define AP_PRESCALE         0xF
+#define AP_PREAMBLE_BYTES   4
+#define AP_SYNC_WORD_BITS   32
+
+/***** Type declarations *****/
+
+typedef enum
+{
+    Scheme_Paused,
+    Scheme_Listening
+} Scheme;
+
+typedef enum
+{
+    Ap_Idle,                    // Waiting for the next uplink, listening
+    Ap_Sensing,
+    Ap_BackOff,
+    Ap_Tx
+} ApState;
+
+typedef struct
+{
+    ApState state;
+    uint32_t until;             // Slot the state ends in
+    uint8_t be;
+    uint16_t busyRateAcc;
+    bool collided;
+} Ap;
+
+typedef struct
+{
+    uint32_t requests;          // Uplinks finished, one way or the other
+    uint32_t sent;
+    uint32_t collided;
+    uint32_t givenUp;
+    uint32_t retries;
+    uint64_t goodSlots;         // Slots carrying an uplink that got through
+    uint64_t listenSlots;       // AP slots with Rx on
+    uint64_t slots;
+} Result;
+
+/***** Function definitions *****/
+
+/* Next pseudo random number, the same run every time */
+static uint32_t nextRandom(uint32_t* state) {
+    *state = *state * 1664525u + 1013904223u;
+
+    return *state >> 8;
+}
+
+/* As ccaStartBackOff() of each scheme */
+static uint8_t startBackOff(Scheme scheme, const Ap* ap) {
+    uint8_t top = (scheme == Scheme_Listening) ? EASYLINK_MAX_CCA_BACKOFF_WINDOW - 1 :
+            EASYLINK_MAX_CCA_BACKOFF_WINDOW;
+
+    return EASYLINK_MIN_CCA_BACKOFF_WINDOW + (uint8_t)(((uint32_t)(ap->busyRateAcc >> 3) *
+            (top - EASYLINK_MIN_CCA_BACKOFF_WINDOW)) / EASYLINK_CCA_BUSY_RATE_ONE);
+}
+
+/* As ccaUpdateBusyRate() */
+static void updateBusyRate(Ap* ap, bool busy) {
+    uint16_t sample = busy ? EASYLINK_CCA_BUSY_RATE_ONE : 0;
+
+    ap->busyRateAcc += sample - (ap->busyRateAcc >> 3);
+}
+
+static uint32_t nextUplink(uint32_t slot, uint32_t* random) {
+    uint32_t gapSlots = (UPLINK_GAP_MS * 1000) / SLOT_US;
+
+    return slot + gapSlots / 2 + nextRandom(random) % gapSlots;
+}
+
+static void simulate(Scheme scheme, uint8_t apCount, uint32_t txSlots, Result* result) {
+    Ap aps[MAX_APS];
+    Ap* ap;
+    uint32_t end = (uint32_t)SIM_SECONDS * 1000000 / SLOT_US;
+    uint32_t random = apCount;
+    uint8_t onAir;
+    uint8_t starting;
+    uint32_t slot;
+    uint8_t i;
+    bool rxOn;
+
+    memset(result, 0, sizeof(*result));
+    memset(aps, 0, sizeof(aps));
+    for(i = 0; i < apCount; i++) {
+        aps[i].state = Ap_Idle;
+        aps[i].until = nextUplink(0, &random);
+    }
+
+    for(slot = 0; slot < end; slot++) {
+        //The channel as the carrier senses of this slot find it
+        onAir = 0;
+        for(i = 0; i < apCount; i++) {
+            if(aps[i].state == Ap_Tx) {
+                onAir++;
+            }
+        }
+        if(onAir == 1) {
+            for(i = 0; i < apCount; i++) {
+                if(aps[i].state == Ap_Tx && !aps[i].collided) {
+                    result->goodSlots++;
+                }
+            }
+        }
+
+        starting = 0;
+        for(i = 0; i < apCount; i++) {
+            ap = &aps[i];
+            switch(ap->state) {
+                case Ap_Idle:
+                    if(slot >= ap->until) {
+                        ap->be = startBackOff(scheme, ap);
+                        ap->state = Ap_Sensing;
+                        ap->until = slot + CS_SLOTS;
+                    }
+                    break;
+                case Ap_BackOff:
+                    if(slot >= ap->until) {
+                        ap->state = Ap_Sensing;
+                        ap->until = slot + CS_SLOTS;
+                    }
+                    break;
+                case Ap_Sensing:
+                    if(onAir > 0) {
+                        //Busy, the carrier sense ends at once
+                        updateBusyRate(ap, true);
+                        if(ap->be > EASYLINK_MAX_CCA_BACKOFF_WINDOW) {
+                            result->givenUp++;
+                            result->requests++;
+                            ap->state = Ap_Idle;
+                            ap->until = nextUplink(slot, &random);
+                            break;
+                        }
+                        result->retries++;
+                        ap->state = Ap_BackOff;
+                        ap->until = slot + 1 + (nextRandom(&random) & ((1u << ap->be++) - 1));
+                    } else if(slot + 1 >= ap->until) {
+                        //Idle all along, the Tx follows
+                        updateBusyRate(ap, false);
+                        ap->state = Ap_Tx;
+                        ap->until = slot + 1 + txSlots;
+                        ap->collided = false;
+                        starting++;
+                    }
+                    break;
+                case Ap_Tx:
+                    if(slot + 1 >= ap->until) {
+                        result->requests++;
+                        if(ap->collided) {
+                            result->collided++;
+                        } else {
+                            result->sent++;
+                        }
+                        ap->state = Ap_Idle;
+                        ap->until = nextUplink(slot, &random);
+                    }
+                    break;
+            }
+
+            rxOn = (ap->state == Ap_Idle) ||
+                    ((scheme == Scheme_Listening) && (ap->state == Ap_BackOff));
+            if(rxOn) {
+                result->listenSlots++;
+            }
+        }
+
+        //Tx's started in the same slot found each other idle
+        if(starting > 1) {
+            for(i = 0; i < apCount; i++) {
+                if(aps[i].state == Ap_Tx && aps[i].until == slot + 1 + txSlots) {
+                    aps[i].collided = true;
+                }
+            }
+        }
+        result->slots++;
+    }
+    result->slots *= apCount;
+}
+
+int main(void) {
+    static const uint8_t apCounts[] = {4, 8, 16, 32};
+    static const char* names[] = {"paused", "listening"};
+    uint32_t bitRate = AirTime_bitRate(AP_RATE_WORD, AP_PRESCALE, 1);
+    uint16_t overhead = AirTime_overheadBits(AP_PREAMBLE_BYTES, AP_SYNC_WORD_BITS, true, true);
+    uint32_t txSlots = (AirTime_us(bitRate, overhead, 1 + UPLINK_BYTES) + SLOT_US - 1) / SLOT_US;
+    uint32_t goodSlots;
+    Result results[2];
+    Result* r;
+    uint8_t i;
+    uint8_t s;
+
+    printf("%u us per uplink, one every %u ms per AP on average\n", txSlots * SLOT_US,
+            UPLINK_GAP_MS);
+    printf("%4s %-10s %8s %8s %8s %8s %9s %9s %9s\n", "aps", "scheme", "uplinks", "sent",
+            "collided", "given up", "retries/u", "goodput %", "listen %");
+    for(i = 0; i < sizeof(apCounts) / sizeof(apCounts[0]); i++) {
+        for(s = Scheme_Paused; s <= Scheme_Listening; s++) {
+            r = &results[s];
+            simulate((Scheme)s, apCounts[i], txSlots, r);
+
+            CHECK(r->requests > 0);
+            CHECK(r->sent + r->collided + r->givenUp == r->requests);
+            //Only uplinks that got through carry goodput, all of their slots
+            goodSlots = r->sent * txSlots;
+            CHECK(r->goodSlots >= goodSlots && r->goodSlots <= goodSlots + txSlots * apCounts[i]);
+
+            printf("%4u %-10s %8u %8u %8u %8u %9.2f %9.2f %9.2f\n", apCounts[i], names[s],
+                    r->requests, r->sent, r->collided, r->givenUp,
+                    (double)r->retries / r->requests,
+                    100.0 * r->goodSlots * apCounts[i] / r->slots,
+                    100.0 * r->listenSlots / r->slots);
+        }
+
+        //Rx listens through the back-offs
+        CHECK(results[Scheme_Listening].listenSlots > results[Scheme_Paused].listenSlots ||
+                results[Scheme_Paused].retries == 0);
+    }
+
+    //On a crowded channel the retry left by the capped start gives up less
+    CHECK(results[Scheme_Listening].givenUp < results[Scheme_Paused].givenUp);
+
+    return CHECK_RESULT();
+}
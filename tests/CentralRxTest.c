@@ -0,0 +1,179 @@
+/*
+ *  ======== CentralRxTest.c ========
+ *
+ *  Feeds the central's rxDoneCb, built from its main.c as is, with views of
+ *  AP uplinks and checks it takes no heap memory, nor does the UART task's
+ *  side of the ring. Prints what rxDoneCb costs per packet, in ns and on x86
+ *  in TSC ticks, for regressions to show up on the host.
+ *
+ *  Built once per UART format, RFEASYLINKRX_UART_BINARY set or not. The
+ *  allocator is wrapped at link time (--wrap) to count its calls.
+ */
+#include <stdlib.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "Check.h"
+
+//The central's main.c, whose statics the test sets up like its main()
+#define main centralMain
+#include "main.c"
+#undef main
+
+/***** Defines *****/
+
+#define PACKETS         200000
+#define MEASURES        7
+
+/***** Variable declarations *****/
+
+static volatile int counting = 0;
+static unsigned long allocations = 0;
+
+/***** Function definitions *****/
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+void __real_free(void* ptr);
+
+void* __wrap_malloc(size_t size) {
+    allocations += counting;
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+    allocations += counting;
+    return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+    allocations += counting;
+    return __real_realloc(ptr, size);
+}
+
+void __wrap_free(void* ptr) {
+    allocations += counting && ptr != NULL;
+    __real_free(ptr);
+}
+
+static uint64_t nowNs(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static uint64_t ticks(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/* An uplink of an AP as the central receives it */
+static uint8_t makeUplink(uint8_t* payload, uint8_t seq) {
+    Uplink_Measure measures[MEASURES];
+    uint8_t encoded;
+    uint8_t i;
+
+    memset(measures, 0, sizeof(measures));
+    for(i = 0; i < MEASURES; i++) {
+        measures[i].id = i + 1;
+        measures[i].rssi = 60 + i;
+        measures[i].delta = 100 * i;
+    }
+
+    return Uplink_encode(payload, 3, 0, seq, NULL, measures, MEASURES, &encoded);
+}
+
+/* The UART task's side: takes every record, formatting the text ones */
+static uint16_t drainRing(void) {
+    uint16_t records = 0;
+    uint8_t* slot;
+    uint16_t len;
+
+    while((slot = RingBuffer_peek(&memRing, &len)) != NULL) {
+#ifndef RFEASYLINKRX_UART_BINARY
+        formatUplink(slot, len, 0);
+#endif
+        RingBuffer_release(&memRing);
+        records++;
+    }
+
+    return records;
+}
+
+int main(void) {
+    uint8_t dstAddr[EASYLINK_MAX_ADDR_SIZE] = {0xBB};
+    uint8_t payload[EASYLINK_MAX_DATA_LENGTH];
+    EasyLink_RxView view;
+    void* volatile probe;
+    uint64_t ns = 0;
+    uint64_t tsc = 0;
+    uint64_t start;
+    uint64_t startTsc;
+    uint32_t records = 0;
+    uint32_t i;
+    uint8_t j;
+
+    //What main() and uartTask_init() set up before rxDoneCb can run
+    RingBuffer_init(&memRing, &memStack[0][0], memStackLen, UART_STACK_SIZE, MEM_STACK_SIZE);
+    uartDataSem = Semaphore_create(0, NULL, NULL);
+    rxDoneSem = Semaphore_create(0, NULL, NULL);
+    CHECK(uartDataSem != NULL && rxDoneSem != NULL);
+
+    memset(&view, 0, sizeof(view));
+    view.dstAddr = dstAddr;
+    view.payload = payload;
+    view.rssi = -70;
+
+    //The wrappers see the allocator calls, kept by the volatile
+    counting = 1;
+    probe = malloc(1);
+    free(probe);
+    counting = 0;
+    CHECK(allocations == 2);
+    allocations = 0;
+
+    //The ring is filled then drained, only rxDoneCb is timed
+    counting = 1;
+    for(i = 0; i < PACKETS; i += MEM_STACK_SIZE) {
+        for(j = 0; j < MEM_STACK_SIZE; j++) {
+            view.len = makeUplink(payload, (uint8_t)(i + j));
+            view.absTime = (i + j) * 4000;
+
+            start = nowNs();
+            startTsc = ticks();
+            rxDoneCb(&view, EasyLink_Status_Success);
+            tsc += ticks() - startTsc;
+            ns += nowNs() - start;
+        }
+        records += drainRing();
+    }
+    counting = 0;
+
+    CHECK(allocations == 0);
+    CHECK(records == PACKETS);
+    CHECK(memRing.drops == 0);
+    CHECK(centralStats.packets == PACKETS);
+    CHECK(centralStats.uplinksLost == 0);
+
+    printf("%s rxDoneCb: %u packets, %lu allocations, %.1f ns",
+#ifdef RFEASYLINKRX_UART_BINARY
+            "binary",
+#else
+            "text",
+#endif
+            PACKETS, allocations, (double)ns / PACKETS);
+    if(tsc != 0) {
+        printf(", %.0f TSC ticks", (double)tsc / PACKETS);
+    }
+    printf(" per packet\n");
+
+    return CHECK_RESULT();
+}
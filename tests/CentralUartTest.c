@@ -0,0 +1,231 @@
+/*
+ *  ======== CentralUartTest.c ========
+ *
+ *  The central's UART task, built from its main.c as is with binary frames,
+ *  writing to a pipe on the simulation's drivers. A generator stands in for
+ *  the radio and calls rxDoneCb with bursts of AP uplinks, the test reads
+ *  the frames back from the pipe.
+ *
+ *  Reports how much of the time the UART task leaves the CPU idle, from its
+ *  thread's CPU time, and a histogram of the latency from the packet's Rx
+ *  time to the end of its frame on the pipe. The UART takes 10 bits per
+ *  byte at 115200 baud on SimClock's time line.
+ */
+//clock_gettime and pthread_getcpuclockid are not C99
+#define _DEFAULT_SOURCE
+
+#include <poll.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "Check.h"
+#include "SimBoard.h"
+#include "SimClock.h"
+#include "SimRadio.h"
+
+//The central's main.c, whose statics the test sets up like its main()
+#define main centralMain
+#include "main.c"
+#undef main
+
+/***** Defines *****/
+
+#define RUN_MS              3000
+#define DRAIN_MS            200
+#define PACKETS_PER_S       150
+#define BURST_MAX           3       // Uplinks of APs back to back
+#define BURST_GAP_US        1000    // Between uplinks of a burst
+#define MEASURES            7
+#define RAT_PER_US          (SIMCLOCK_RAT_HZ / 1000000)
+#define LATENCY_BUCKETS     8
+
+/***** Variable declarations *****/
+
+/* Upper bounds of the latency buckets in us, the last is open */
+static const uint32_t latencyBounds[LATENCY_BUCKETS - 1] = {
+    4000, 8000, 12000, 16000, 24000, 32000, 64000
+};
+
+static int pipeFds[2];
+static volatile int readerStop = 0;
+
+/* Reader side */
+static uint32_t reports = 0;
+static uint32_t statusFrames = 0;
+static uint32_t latencies[LATENCY_BUCKETS];
+static uint64_t latencySum = 0;
+static uint32_t latencyMax = 0;
+static UartFrame_Decoder decoder;
+
+/***** Function definitions *****/
+
+static uint64_t wallNs(clockid_t clock) {
+    struct timespec ts;
+
+    clock_gettime(clock, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static void countLatency(uint32_t us) {
+    uint8_t i = 0;
+
+    while(i < LATENCY_BUCKETS - 1 && us >= latencyBounds[i]) {
+        i++;
+    }
+    latencies[i]++;
+    latencySum += us;
+    if(us > latencyMax) {
+        latencyMax = us;
+    }
+}
+
+/* Takes the frames off the pipe as they arrive, timing the AP reports */
+static void* reader(void* arg) {
+    struct pollfd pfd = {pipeFds[0], POLLIN, 0};
+    uint8_t buf[256];
+    uint32_t rxTime;
+    uint64_t now;
+    ssize_t n;
+    ssize_t i;
+
+    (void)arg;
+    UartFrame_decoderInit(&decoder);
+    while(!readerStop) {
+        if(poll(&pfd, 1, 10) <= 0) {
+            continue;
+        }
+        n = read(pipeFds[0], buf, sizeof(buf));
+        now = SimClock_now();
+        for(i = 0; i < n; i++) {
+            if(!UartFrame_decode(&decoder, buf[i])) {
+                continue;
+            }
+            if(decoder.type == UART_FRAME_TYPE_AP_REPORT_TIMED) {
+                rxTime = decoder.payload[0] | (decoder.payload[1] << 8) |
+                        (decoder.payload[2] << 16) | ((uint32_t)decoder.payload[3] << 24);
+                countLatency((uint32_t)((now - SimClock_fromAbsTime(rxTime)) / RAT_PER_US));
+                reports++;
+            } else if(decoder.type == UART_FRAME_TYPE_STATUS) {
+                statusFrames++;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/* An uplink of an AP as the central receives it */
+static uint8_t makeUplink(uint8_t* payload, uint8_t apId, uint8_t seq) {
+    Uplink_Measure measures[MEASURES];
+    uint8_t encoded;
+    uint8_t i;
+
+    memset(measures, 0, sizeof(measures));
+    for(i = 0; i < MEASURES; i++) {
+        measures[i].id = i + 1;
+        measures[i].rssi = 60 + i;
+        measures[i].delta = 100 * i;
+    }
+
+    return Uplink_encode(payload, apId, 0, seq, NULL, measures, MEASURES, &encoded);
+}
+
+/* Next pseudo random number, the same run every time */
+static uint32_t nextRandom(uint32_t* state) {
+    *state = *state * 1664525u + 1013904223u;
+
+    return *state >> 8;
+}
+
+int main(void) {
+    uint8_t dstAddr[EASYLINK_MAX_ADDR_SIZE] = {0xBB};
+    uint8_t payload[EASYLINK_MAX_DATA_LENGTH];
+    uint8_t seqs[UPLINK_MAX_APS] = {0};
+    EasyLink_RxView view;
+    pthread_t readerThread;
+    clockid_t uartClock;
+    uint32_t random = 1;
+    uint32_t sent = 0;
+    uint32_t burst;
+    uint32_t i;
+    uint64_t meanGap;
+    uint64_t end;
+    uint64_t next;
+    uint64_t wallStart;
+    uint64_t cpuStart;
+    uint64_t wall;
+    uint64_t cpu;
+    uint8_t apId;
+
+    //Radio time starts a second before it wraps
+    SimClock_init(1, 0xFFFFFFFFu - SIMCLOCK_RAT_HZ);
+    CHECK(pipe(pipeFds) == 0);
+    SimBoard_setUartFd(pipeFds[1]);
+    CHECK(pthread_create(&readerThread, NULL, reader, NULL) == 0);
+
+    //What main() sets up, the generator stands in for the Rx task
+    RingBuffer_init(&memRing, &memStack[0][0], memStackLen, UART_STACK_SIZE, MEM_STACK_SIZE);
+    uartTask_init();
+    CHECK(pthread_getcpuclockid(uartTask.thread, &uartClock) == 0);
+
+    memset(&view, 0, sizeof(view));
+    view.dstAddr = dstAddr;
+    view.payload = payload;
+    view.rssi = -70;
+
+    //Bursts of uplinks, each burst from consecutive APs
+    meanGap = (uint64_t)SIMCLOCK_RAT_HZ * (BURST_MAX + 1) / 2 / PACKETS_PER_S;
+    next = SimClock_now() + SIMCLOCK_RAT_HZ / 100;
+    end = next + (uint64_t)RUN_MS * SIMCLOCK_RAT_HZ / 1000;
+    wallStart = wallNs(CLOCK_MONOTONIC);
+    cpuStart = wallNs(uartClock);
+    while(next < end) {
+        burst = 1 + nextRandom(&random) % BURST_MAX;
+        for(i = 0; i < burst; i++) {
+            SimClock_sleepUntil(next);
+            apId = (uint8_t)(nextRandom(&random) % UPLINK_MAX_APS);
+            view.len = makeUplink(payload, apId, seqs[apId]++);
+            view.absTime = (uint32_t)SimClock_now();
+
+            //rxDoneCb runs in the RF driver's Swi
+            SimRadio_swiLock();
+            rxDoneCb(&view, EasyLink_Status_Success);
+            SimRadio_swiUnlock();
+            sent++;
+            next += (uint64_t)BURST_GAP_US * RAT_PER_US;
+        }
+        next += nextRandom(&random) % (2 * meanGap);
+    }
+
+    SimClock_sleepUntil(SimClock_now() + (uint64_t)DRAIN_MS * SIMCLOCK_RAT_HZ / 1000);
+    wall = wallNs(CLOCK_MONOTONIC) - wallStart;
+    cpu = wallNs(uartClock) - cpuStart;
+    readerStop = 1;
+    pthread_join(readerThread, NULL);
+
+    //Every uplink reaches the pipe or is counted as a drop by the ring
+    CHECK(sent > 0);
+    CHECK(centralStats.packets == sent);
+    CHECK(reports + memRing.drops == sent);
+    CHECK(decoder.crcErrors == 0);
+    CHECK(statusFrames >= RUN_MS / UART_STATUS_PERIOD_MS);
+    //The task sleeps between bursts instead of spinning on the ring
+    CHECK(cpu * 2 < wall);
+
+    printf("%u uplinks in %u ms: %u on the pipe, %u dropped, %u status frames\n",
+            sent, RUN_MS, reports, memRing.drops, statusFrames);
+    printf("UART task idle %.2f%% of the time\n", 100.0 * (1.0 - (double)cpu / wall));
+    printf("latency mean %.0f us, max %u us\n",
+            reports ? (double)latencySum / reports : 0.0, latencyMax);
+    for(i = 0; i < LATENCY_BUCKETS; i++) {
+        if(i < LATENCY_BUCKETS - 1) {
+            printf("  < %5u us: %u\n", latencyBounds[i], latencies[i]);
+        } else {
+            printf(" >= %5u us: %u\n", latencyBounds[i - 1], latencies[i]);
+        }
+    }
+
+    return CHECK_RESULT();
+}
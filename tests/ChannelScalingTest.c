@@ -0,0 +1,407 @@
+/*
+ *  ======== ChannelScalingTest.c ========
+ *
+ *  Measures delivered to the central by a crowded cell, the tags spread over
+ *  1 to 8 beacon channels as ChannelPlan_tagChannel does, with
+ *  APS_PER_CHANNEL APs listening on each and the uplinks of all of them on
+ *  a backhaul channel of its own.
+ *
+ *  Tags send with the tag's BeaconScheduler.c, every AP of a channel hears
+ *  every beacon on it, and beacons that overlap on a channel are all lost.
+ *  Each AP misses AP_MISS_PERCENT of them on its own and stores a measure
+ *  of a tag at its first beacon, aggregating its beacons over TIME_DELAY_MS
+ *  or QT_MEASURES of them, as TaskManager.c does, and sends an uplink of the
+ *  AP's Uplink.c once BUFFER_SIZE measures are waiting or the oldest is
+ *  UPLINK_MAX_AGE_MS old, the measures that don't fit left for the next.
+ *  Uplinks go out with the CCA of EasyLink.c on the backhaul: a carrier
+ *  sense, back-offs of 0 to 2^be - 1 units while it is busy, given up past
+ *  the max exponent, and uplinks whose carrier senses end in the same unit
+ *  collide. be always starts at the min, not from the channel's busy rate,
+ *  and the time an AP spends away on the backhaul is not taken from its
+ *  listening.
+ *
+ *  Prints, for each channel count, the beacon load per channel, the share of
+ *  beacons delivered, the measures the APs made, the backhaul's use and the
+ *  measures per second that reached the central. The beacon channels take
+ *  the measures made from collision bound to tag bound, while what reaches
+ *  the central levels off past a few channels: APs of a channel whose
+ *  buffers fill on the same beacon collide on the backhaul, and the more
+ *  APs share it the more uplinks give up.
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "Check.h"
+#include "BeaconScheduler.h"
+#include "Uplink.h"
+#include "easylink/AirTime.h"
+#include "easylink/EasyLink.h"
+
+/***** Defines *****/
+
+#define SIM_SECONDS         60
+#define TAGS                200     // Ids 1 to TAGS
+#define APS_PER_CHANNEL     3       // Enough for a fix of every tag
+#define AP_MISS_PERCENT     10      // Beacons an AP misses on its own, fading or range
+#define MAX_CHANNELS        8
+#define MAX_APS             (MAX_CHANNELS * APS_PER_CHANNEL)
+#define RAT_PER_US          4
+#define RAT_PER_MS          4000
+#define BEACON_PAYLOAD      3       // BEACON_SIZE of the tags
+
+/* As TaskManager.c */
+#define QT_MEASURES         10
+#define TIME_DELAY_MS       1000
+#define UPLINK_MAX_AGE_MS   5000
+#define UPLINK_FLAGS        (UPLINK_FLAG_RSSI_STATS | UPLINK_FLAG_DISTANCE | \
+        UPLINK_FLAG_BEACON_LOSS | UPLINK_FLAG_PACKED)
+#define BUFFER_SIZE         (2 * UPLINK_MAX_MEASURES(UPLINK_FLAGS) < UPLINK_PACKED_MAX_MEASURES ? \
+        2 * UPLINK_MAX_MEASURES(UPLINK_FLAGS) : UPLINK_PACKED_MAX_MEASURES)
+
+/* CCA of EasyLink.c, in RAT ticks */
+#define CCA_UNIT            (EASYLINK_CCA_BACKOFF_TIMEUNITS * RAT_PER_US)
+#define CCA_SENSE           (EASYLINK_CHANNEL_IDLE_TIME_US * RAT_PER_US)
+
+/* The radio setup of every node, see smartrf_settings */
+#define RATE_WORD           0x8000
+#define PRESCALE            0xF
+#define PREAMBLE_BYTES      4
+#define SYNC_WORD_BITS      32
+
+#define BURST_PERIOD_MS     (BEACON_BURST_SIZE * BEACON_INTERVAL_MS + BEACON_BURST_GAP_MS)
+#define MAX_BEACONS         (TAGS * (SIM_SECONDS + 1) * BEACON_BURST_SIZE * 1000 / BURST_PERIOD_MS + TAGS)
+#define MAX_MEASURES        (TAGS * (SIM_SECONDS + 1) * 1000 / TIME_DELAY_MS)
+#define MAX_UPLINKS         (MAX_APS * MAX_MEASURES / TAGS + MAX_APS * SIM_SECONDS)
+
+/***** Type declarations *****/
+
+typedef struct
+{
+    uint32_t start;
+    uint8_t tag;
+    bool lost;
+} Beacon;
+
+typedef struct
+{
+    uint32_t time;              // Carrier sense start, then Tx start once sent
+    uint32_t end;               // End of the Tx
+    uint8_t waiting;            // Measures at the AP, sendable[waiting] go
+    uint8_t be;
+    bool done;
+    bool sent;
+    bool collided;
+} Uplink;
+
+typedef struct
+{
+    uint32_t beacons;
+    uint32_t delivered;         // Beacons with no other on their channel
+    uint32_t measures;          // Made by all the APs
+    uint32_t uplinks;
+    uint32_t sentUplinks;       // Got through
+    uint32_t collided;
+    uint32_t givenUp;
+    uint32_t measuresIn;        // Reached the central
+    uint64_t backhaulBusy;      // RAT ticks with an uplink on the air
+} Result;
+
+/***** Variable declarations *****/
+
+static Beacon beacons[MAX_BEACONS];
+static uint32_t beaconCount;
+static uint32_t measureTimes[MAX_MEASURES];
+static Uplink uplinks[MAX_UPLINKS];
+static uint32_t uplinkCount;
+static uint32_t txTicks[BUFFER_SIZE + 1];
+static uint8_t sendable[BUFFER_SIZE + 1];
+static uint32_t beaconTicks;
+static uint32_t bitRate;
+static uint16_t overheadBits;
+static uint32_t randomState = 1;
+
+/***** Function definitions *****/
+
+/* Next pseudo random number, the same run every time */
+static uint32_t nextRandom(void) {
+    randomState = randomState * 1664525u + 1013904223u;
+
+    return randomState >> 8;
+}
+
+static int byStart(const void* a, const void* b) {
+    const Beacon* x = a;
+    const Beacon* y = b;
+
+    return (x->start > y->start) - (x->start < y->start);
+}
+
+/* The beacons of the tags of a channel, those overlapping another lost */
+static void sendBeacons(uint8_t channel, uint8_t channels) {
+    const uint32_t end = (uint32_t)SIM_SECONDS * 1000 * RAT_PER_MS;
+    BeaconScheduler scheduler;
+    uint8_t ieeeAddr[8] = {0x00, 0x12, 0x4B, 0x00, 0x0A, 0x0B, 0, 0};
+    uint32_t latest = 0;
+    uint32_t t;
+    uint32_t i;
+    uint8_t tag;
+
+    beaconCount = 0;
+    for(tag = 1; tag <= TAGS; tag++) {
+        if(tag % channels != channel) {
+            continue;
+        }
+        //Switched on at any time in a burst period
+        ieeeAddr[7] = tag;
+        t = nextRandom() % (BURST_PERIOD_MS * RAT_PER_MS);
+        BeaconScheduler_init(&scheduler, ieeeAddr, tag, t);
+        while((t = BeaconScheduler_next(&scheduler, t)) < end && beaconCount < MAX_BEACONS) {
+            beacons[beaconCount].start = t;
+            beacons[beaconCount].tag = tag;
+            beacons[beaconCount].lost = false;
+            beaconCount++;
+            t += beaconTicks;
+        }
+    }
+
+    qsort(beacons, beaconCount, sizeof(Beacon), byStart);
+    for(i = 1; i < beaconCount; i++) {
+        if(beacons[i].start < beacons[latest].start + beaconTicks) {
+            beacons[i].lost = true;
+            beacons[latest].lost = true;
+        }
+        latest = i;
+    }
+}
+
+/*
+ * Times an AP of the channel stores the measures of its tags at, the first
+ * beacon of each as it is aged from. Returns how many.
+ */
+static uint32_t makeMeasures(void) {
+    static uint32_t windowStart[TAGS + 1];
+    static uint8_t windowBeacons[TAGS + 1];
+    const uint32_t window = TIME_DELAY_MS * RAT_PER_MS;
+    uint32_t count = 0;
+    uint32_t i;
+    uint8_t tag;
+
+    memset(windowBeacons, 0, sizeof(windowBeacons));
+    for(i = 0; i < beaconCount; i++) {
+        if(beacons[i].lost || nextRandom() % 100 < AP_MISS_PERCENT) {
+            continue;
+        }
+        tag = beacons[i].tag;
+        if(windowBeacons[tag] == QT_MEASURES || beacons[i].start > windowStart[tag] + window) {
+            windowBeacons[tag] = 0;
+        }
+        if(windowBeacons[tag]++ == 0 && count < MAX_MEASURES) {
+            windowStart[tag] = beacons[i].start;
+            measureTimes[count++] = beacons[i].start;
+        }
+    }
+
+    return count;
+}
+
+/*
+ * Air time of an uplink with count measures waiting as the AP encodes it, and
+ * how many of them fit
+ */
+static void encodeUplinks(void) {
+    Uplink_Measure measures[UPLINK_PACKED_MAX_MEASURES];
+    uint8_t payload[EASYLINK_MAX_DATA_LENGTH];
+    uint8_t len;
+    uint8_t i;
+
+    memset(measures, 0, sizeof(measures));
+    for(i = 0; i < BUFFER_SIZE; i++) {
+        measures[i].id = (uint8_t)(1 + 3 * i);
+        measures[i].rssi = (uint8_t)(60 + i % 25);
+        measures[i].rssiMin = measures[i].rssi - 2;
+        measures[i].rssiMax = measures[i].rssi + 3;
+        measures[i].rssiVariance = 2;
+        measures[i].distance = (uint16_t)(300 + 40 * i);
+        measures[i].beacons = QT_MEASURES;
+        measures[i].beaconsLost = i % 3;
+        measures[i].delta = i % 5;
+    }
+    for(i = 1; i <= BUFFER_SIZE; i++) {
+        len = Uplink_encode(payload, 1, UPLINK_FLAGS, 0, NULL, measures, i, &sendable[i]);
+        CHECK(sendable[i] > 0 && sendable[i] <= i);
+        txTicks[i] = AirTime_us(bitRate, overheadBits, 1 + len) * RAT_PER_US;
+    }
+}
+
+/*
+ * An AP's uplinks, once BUFFER_SIZE measures wait or the oldest is due. The
+ * measures that don't fit wait for the next one.
+ */
+static void queueUplinks(uint32_t measures) {
+    const uint32_t maxAge = UPLINK_MAX_AGE_MS * RAT_PER_MS;
+    uint32_t first = 0;
+    uint32_t time = 0;
+    uint32_t i;
+    uint32_t due;
+    uint8_t waiting;
+
+    for(i = 0; i <= measures; i++) {
+        //Measures first to i - 1 wait, i is the next one to come
+        while(i > first && uplinkCount < MAX_UPLINKS) {
+            waiting = (uint8_t)(i - first);
+            due = measureTimes[first] + maxAge;
+            if(waiting == BUFFER_SIZE) {
+                due = measureTimes[i - 1];
+            } else if(i < measures && measureTimes[i] < due) {
+                break;
+            }
+            time = (due > time) ? due : time;
+
+            memset(&uplinks[uplinkCount], 0, sizeof(Uplink));
+            uplinks[uplinkCount].time = time;
+            uplinks[uplinkCount].waiting = waiting;
+            uplinks[uplinkCount].be = EASYLINK_MIN_CCA_BACKOFF_WINDOW;
+            uplinkCount++;
+            first += sendable[waiting];
+        }
+    }
+}
+
+/* The uplinks through the CCA on the backhaul, in the order of their time */
+static void sendUplinks(Result* result) {
+    Uplink* next;
+    Uplink* u;
+    uint32_t txStart;
+    uint32_t i;
+    bool busy;
+
+    while(1) {
+        next = NULL;
+        for(i = 0; i < uplinkCount; i++) {
+            if(!uplinks[i].done && (next == NULL || uplinks[i].time < next->time)) {
+                next = &uplinks[i];
+            }
+        }
+        if(next == NULL) {
+            break;
+        }
+
+        //On the back-off grid, so carrier senses can end in the same unit
+        next->time -= next->time % CCA_UNIT;
+        txStart = next->time + CCA_SENSE;
+        //Uplinks on the air during the carrier sense make it busy, those
+        //starting as it ends aren't heard and collide
+        busy = false;
+        for(i = 0; i < uplinkCount; i++) {
+            u = &uplinks[i];
+            busy = busy || (u->sent && u->time < txStart && u->end > next->time);
+        }
+        for(i = 0; i < uplinkCount && !busy; i++) {
+            u = &uplinks[i];
+            if(u->sent && u->time == txStart) {
+                u->collided = true;
+                next->collided = true;
+            }
+        }
+
+        if(busy) {
+            if(next->be > EASYLINK_MAX_CCA_BACKOFF_WINDOW) {
+                next->done = true;
+                result->givenUp++;
+                continue;
+            }
+            next->time += CCA_UNIT * (nextRandom() & ((1u << next->be++) - 1));
+            continue;
+        }
+        next->done = true;
+        next->sent = true;
+        next->time = txStart;
+        next->end = txStart + txTicks[next->waiting];
+    }
+
+    for(i = 0; i < uplinkCount; i++) {
+        u = &uplinks[i];
+        if(!u->sent) {
+            continue;
+        }
+        result->backhaulBusy += u->end - u->time;
+        if(u->collided) {
+            result->collided++;
+        } else {
+            result->sentUplinks++;
+            result->measuresIn += sendable[u->waiting];
+        }
+    }
+}
+
+static void simulate(uint8_t channels, Result* result) {
+    uint32_t measures;
+    uint8_t channel;
+    uint8_t ap;
+
+    memset(result, 0, sizeof(*result));
+    uplinkCount = 0;
+    randomState = channels;
+    for(channel = 0; channel < channels; channel++) {
+        sendBeacons(channel, channels);
+        result->beacons += beaconCount;
+        for(ap = 0; ap < APS_PER_CHANNEL; ap++) {
+            measures = makeMeasures();
+            queueUplinks(measures);
+            result->measures += measures;
+        }
+        while(beaconCount > 0) {
+            result->delivered += !beacons[--beaconCount].lost;
+        }
+    }
+    result->uplinks = uplinkCount;
+    sendUplinks(result);
+}
+
+int main(void) {
+    static const uint8_t channelCounts[] = {1, 2, 3, 4, 6, 8};
+    const double seconds = SIM_SECONDS;
+    Result results[sizeof(channelCounts)];
+    Result* r;
+    uint8_t i;
+
+    bitRate = AirTime_bitRate(RATE_WORD, PRESCALE, 1);
+    overheadBits = AirTime_overheadBits(PREAMBLE_BYTES, SYNC_WORD_BITS, true, true);
+    beaconTicks = AirTime_us(bitRate, overheadBits, 1 + BEACON_PAYLOAD) * RAT_PER_US;
+    encodeUplinks();
+
+    printf("%u tags, %u APs per beacon channel, %u us per beacon, uplinks of up to %u"
+            " measures in %u us\n", TAGS, APS_PER_CHANNEL, beaconTicks / RAT_PER_US,
+            sendable[BUFFER_SIZE], txTicks[BUFFER_SIZE] / RAT_PER_US);
+    printf("%8s %4s %8s %11s %10s %9s %9s %9s %10s %11s\n", "channels", "aps", "load/ch",
+            "delivered %", "measures/s", "uplinks/s", "collided", "given up", "backhaul %",
+            "central m/s");
+    for(i = 0; i < sizeof(channelCounts); i++) {
+        r = &results[i];
+        simulate(channelCounts[i], r);
+
+        CHECK(r->delivered <= r->beacons);
+        CHECK(r->sentUplinks + r->collided + r->givenUp == r->uplinks);
+        CHECK(r->measuresIn <= r->measures);
+
+        printf("%8u %4u %8.2f %11.1f %10.1f %9.1f %9u %9u %10.1f %11.1f\n", channelCounts[i],
+                channelCounts[i] * APS_PER_CHANNEL,
+                (double)r->beacons * beaconTicks / channelCounts[i] / (seconds * 1e6 * RAT_PER_US),
+                100.0 * r->delivered / r->beacons, r->measures / seconds,
+                r->uplinks / seconds, r->collided, r->givenUp,
+                100.0 * r->backhaulBusy / (seconds * 1e6 * RAT_PER_US),
+                r->measuresIn / seconds);
+    }
+
+    //More beacon channels, fewer beacons lost and more measures made. What
+    //reaches the central grows as much until the backhaul fills up.
+    for(i = 1; i < sizeof(channelCounts); i++) {
+        CHECK(results[i].delivered > results[i - 1].delivered);
+        CHECK(results[i].measures > results[i - 1].measures);
+        CHECK(results[i].measuresIn > 5 * results[0].measuresIn);
+    }
+    CHECK(results[1].measuresIn > results[0].measuresIn);
+    CHECK(results[2].measuresIn > results[1].measuresIn);
+
+    return CHECK_RESULT();
+}
@@ -0,0 +1,22 @@
+#ifndef CHECK_H
+#define CHECK_H
+
+#include <stdio.h>
+
+/*
+ * Minimal checks for the host tests: a failed CHECK prints where it failed
+ * and the test carries on, main returns CHECK_RESULT() for ctest.
+ */
+
+static int checkFailures = 0;
+
+#define CHECK(cond) do { \
+        if(!(cond)) { \
+            printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+            checkFailures++; \
+        } \
+    } while(0)
+
+#define CHECK_RESULT() (checkFailures == 0 ? 0 : 1)
+
+#endif /* CHECK_H */
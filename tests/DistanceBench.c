@@ -0,0 +1,115 @@
+/*
+ *  ======== DistanceBench.c ========
+ *
+ *  Cost of the AP's RSSI to distance lookup against the pow() of the model
+ *  it replaced, over a trace of RSSIs as tags at all distances would give,
+ *  and the cost of rebuilding the table on a new calibration. The host has
+ *  an FPU where the CC1350 has none, so pow() here is far cheaper than on
+ *  the AP and the ratio is a floor. The worst error against the float model
+ *  over the trace, past the cm rounding, is printed and must stay within the
+ *  table's 0.2 %.
+ */
+#include <math.h>
+#include <time.h>
+
+#include "Check.h"
+#include "Distance.h"
+
+/***** Defines *****/
+
+#define LOOKUPS         (1u << 20)
+#define TRACE_SAMPLES   4096
+#define CALIBRATIONS    256
+#define RSSI_1M         55
+#define PATH_LOSS       2.95
+
+/***** Variable declarations *****/
+
+static uint8_t trace[TRACE_SAMPLES];
+static volatile uint32_t sink;
+static volatile double sinkCm;
+
+/***** Function definitions *****/
+
+static uint64_t nowNs(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+/* Next pseudo random number, the same run every time */
+static uint32_t nextRandom(uint32_t* state) {
+    *state = *state * 1664525u + 1013904223u;
+
+    return *state >> 8;
+}
+
+/* The model as the commented out getRelativeDistance had it, in cm */
+static double powCm(uint8_t rssi, uint8_t rssi1m, double n) {
+    return 100.0 * pow(10.0, ((double)rssi - rssi1m) / (10.0 * n));
+}
+
+int main(void) {
+    uint16_t pathLossQ8 = (uint16_t)(PATH_LOSS * 256 + 0.5);
+    double n = pathLossQ8 / 256.0;
+    uint32_t random = 1;
+    double worst = 0;
+    double expected;
+    double error;
+    uint64_t lookupNs;
+    uint64_t powNs;
+    uint64_t calibrateNs;
+    uint64_t start;
+    uint32_t i;
+    uint16_t cm;
+
+    //-40 to -100 dBm, the AP's range
+    for(i = 0; i < TRACE_SAMPLES; i++) {
+        trace[i] = (uint8_t)(40 + nextRandom(&random) % 61);
+    }
+    CHECK(Distance_calibrate(RSSI_1M, pathLossQ8) == 0);
+
+    for(i = 0; i < TRACE_SAMPLES; i++) {
+        cm = Distance_fromRssi(trace[i]);
+        expected = powCm(trace[i], RSSI_1M, n);
+        if(expected < DISTANCE_MAX_CM) {
+            //Beyond the cm rounding
+            error = (fabs(cm - expected) - 1) / expected;
+            if(error > worst) {
+                worst = error;
+            }
+        } else {
+            CHECK(cm == DISTANCE_MAX_CM);
+        }
+    }
+
+    CHECK(worst <= 0.002);
+
+    start = nowNs();
+    for(i = 0; i < LOOKUPS; i++) {
+        sink += Distance_fromRssi(trace[i % TRACE_SAMPLES]);
+    }
+    lookupNs = nowNs() - start;
+
+    start = nowNs();
+    for(i = 0; i < LOOKUPS; i++) {
+        sinkCm += powCm(trace[i % TRACE_SAMPLES], RSSI_1M, n);
+    }
+    powNs = nowNs() - start;
+
+    start = nowNs();
+    for(i = 0; i < CALIBRATIONS; i++) {
+        Distance_calibrate((uint8_t)(RSSI_1M + i % 8), pathLossQ8);
+    }
+    calibrateNs = nowNs() - start;
+
+    printf("%12s %12s %8s %14s %12s\n", "lookup ns", "pow ns", "speedup", "calibrate us",
+            "worst err %");
+    printf("%12.2f %12.2f %7.1fx %14.2f %12.3f\n", (double)lookupNs / LOOKUPS,
+            (double)powNs / LOOKUPS, (double)powNs / (lookupNs ? lookupNs : 1),
+            (double)calibrateNs / CALIBRATIONS / 1000, 100 * worst);
+
+    return CHECK_RESULT();
+}
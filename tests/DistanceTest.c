@@ -0,0 +1,70 @@
+/*
+ *  ======== DistanceTest.c ========
+ */
+#include <math.h>
+
+#include "Check.h"
+#include "Distance.h"
+
+/***** Function definitions *****/
+
+/* Model in floating point, cm */
+static double modelCm(uint8_t rssi, uint8_t rssi1m, double n) {
+    return 100.0 * pow(10.0, ((double)rssi - rssi1m) / (10.0 * n));
+}
+
+/* Checks the whole table against the model */
+static void checkTable(uint8_t rssi1m, double n) {
+    uint16_t pathLossQ8 = (uint16_t)(n * 256 + 0.5);
+    double nQ8 = pathLossQ8 / 256.0;
+    double expected;
+    uint16_t cm;
+    uint16_t rssi;
+    uint16_t prev = 0;
+
+    CHECK(Distance_calibrate(rssi1m, pathLossQ8) == 0);
+    CHECK(Distance_getCalibration()->rssi1m == rssi1m);
+    CHECK(Distance_getCalibration()->pathLossQ8 == pathLossQ8);
+
+    for(rssi = 0; rssi < DISTANCE_RSSI_COUNT; rssi++) {
+        cm = Distance_fromRssi((uint8_t)rssi);
+        expected = modelCm((uint8_t)rssi, rssi1m, nQ8);
+
+        if(expected >= DISTANCE_MAX_CM) {
+            CHECK(cm == DISTANCE_MAX_CM);
+        } else {
+            //Interpolated 64 entry LUT, within 0.2 % and the cm rounding
+            CHECK(fabs(cm - expected) <= expected * 0.002 + 1);
+        }
+
+        //Further for weaker signals
+        CHECK(cm >= prev);
+        prev = cm;
+    }
+
+    CHECK(Distance_fromRssi(rssi1m) == 100);
+}
+
+static void testTables(void) {
+    checkTable(55, 2.95);
+    checkTable(40, 2.0);
+    checkTable(60, 3.5);
+    checkTable(30, 4.0);
+    checkTable(70, 1.6);
+}
+
+static void testSaturation(void) {
+    CHECK(Distance_calibrate(55, 0) == -1);
+
+    //Far or past the table, saturated
+    CHECK(Distance_calibrate(20, 256) == 0);
+    CHECK(Distance_fromRssi(DISTANCE_RSSI_COUNT - 1) == DISTANCE_MAX_CM);
+    CHECK(Distance_fromRssi(255) == DISTANCE_MAX_CM);
+}
+
+int main(void) {
+    testTables();
+    testSaturation();
+
+    return CHECK_RESULT();
+}
@@ -0,0 +1,201 @@
+/*
+ *  ======== EasyLinkCcaTest.c ========
+ *
+ *  The AP's EasyLink.c, built as is, on the fake RF core: a CCA Tx made
+ *  while continuous Rx runs. Rx is only paused for the carrier sense and the
+ *  Tx, it listens through the back-offs in between and the application's Rx
+ *  goes on unaware. Abort during a back-off ends the Tx and leaves Rx on. On
+ *  a channel always busy the first back-off stays below the max, each Tx
+ *  still gets two back-offs before it is given up.
+ */
+#include <string.h>
+
+#include "Check.h"
+#include "EasyLink.h"
+#include "FakeRf.h"
+
+/***** Defines *****/
+
+#define RAT_PER_MS      4000
+#define BACKOFF_MAX_MS  (((1 << EASYLINK_MAX_CCA_BACKOFF_WINDOW) * \
+        EASYLINK_CCA_BACKOFF_TIMEUNITS) / 1000 + 1)
+#define AP_ADDR         0xAA
+#define BUSY_TXS        30      // CCA Tx's on a busy channel, the busy rate saturates
+
+/***** Variable declarations *****/
+
+static uint32_t views;
+static uint32_t ends;
+static uint32_t txDones;
+static EasyLink_Status txStatus;
+
+/***** Function definitions *****/
+
+static void rxViewCb(EasyLink_RxView* rxView, EasyLink_Status status) {
+    if(rxView == NULL) {
+        CHECK(status == EasyLink_Status_Aborted);
+        ends++;
+        return;
+    }
+    CHECK(status == EasyLink_Status_Success);
+    views++;
+    EasyLink_releaseRxView(rxView);
+}
+
+static void txDoneCb(EasyLink_Status status) {
+    txStatus = status;
+    txDones++;
+}
+
+static EasyLink_Status sendCca(void) {
+    EasyLink_TxPacket txPacket;
+
+    memset(&txPacket, 0, sizeof(txPacket));
+    txPacket.dstAddr[0] = 0xBB;
+    txPacket.len = 10;
+
+    return EasyLink_transmitCcaAsync(&txPacket, txDoneCb);
+}
+
+static FakeRf_RxResult send(uint8_t seq) {
+    uint8_t pkt[2] = {AP_ADDR, seq};
+
+    return FakeRf_receive(pkt, sizeof(pkt), -70, true);
+}
+
+static void getCcaStats(EasyLink_CcaStats* stats) {
+    CHECK(EasyLink_getCcaStats(stats) == EasyLink_Status_Success);
+}
+
+/* Rx is back on between the carrier senses and the application not told */
+static void testListenThroughBackOff(void) {
+    EasyLink_TxPacket txPacket;
+    EasyLink_CcaStats before;
+    EasyLink_CcaStats after;
+    uint32_t rxCommands;
+
+    views = 0;
+    ends = 0;
+    txDones = 0;
+    getCcaStats(&before);
+    CHECK(EasyLink_receiveContinuousViewAsync(rxViewCb, 0) == EasyLink_Status_Success);
+    rxCommands = FakeRf_posted(CMD_PROP_RX_ADV);
+
+    CHECK(sendCca() == EasyLink_Status_Success);
+    CHECK(FakeRf_activeCommand() == CMD_PROP_CS);
+    CHECK(send(1) == FakeRf_Rx_NotListening);
+
+    //Busy, Rx listens through the back-off
+    CHECK(FakeRf_carrierSense(true));
+    CHECK(FakeRf_activeCommand() == CMD_PROP_RX_ADV);
+    CHECK(FakeRf_posted(CMD_PROP_RX_ADV) - rxCommands == 1);
+    CHECK(send(2) == FakeRf_Rx_Stored);
+    CHECK(views == 1 && txDones == 0);
+
+    //Another Tx must wait for this one
+    memset(&txPacket, 0, sizeof(txPacket));
+    txPacket.len = 1;
+    CHECK(EasyLink_transmitAsync(&txPacket, txDoneCb) == EasyLink_Status_Busy_Error);
+    CHECK(sendCca() == EasyLink_Status_Busy_Error);
+
+    //Once the back-off is over Rx is paused again for the carrier sense
+    FakeRf_advance(BACKOFF_MAX_MS * RAT_PER_MS);
+    CHECK(FakeRf_activeCommand() == CMD_PROP_CS);
+    CHECK(FakeRf_carrierSense(false));
+    CHECK(txDones == 1 && txStatus == EasyLink_Status_Success);
+    CHECK(FakeRf_activeCommand() == CMD_PROP_RX_ADV);
+    CHECK(send(3) == FakeRf_Rx_Stored);
+
+    getCcaStats(&after);
+    CHECK(after.txCount - before.txCount == 1);
+    CHECK(after.retries - before.retries == 1);
+    CHECK(after.txSuccess - before.txSuccess == 1);
+    CHECK(views == 2 && ends == 0);
+
+    CHECK(EasyLink_abort() == EasyLink_Status_Success);
+    CHECK(ends == 1);
+}
+
+/* Abort during a back-off ends the Tx, Rx goes on */
+static void testAbortDuringBackOff(void) {
+    EasyLink_TxPacket txPacket;
+    EasyLink_Stats before;
+    EasyLink_Stats after;
+    uint32_t csCommands;
+
+    views = 0;
+    ends = 0;
+    txDones = 0;
+    CHECK(EasyLink_getStats(&before) == EasyLink_Status_Success);
+    CHECK(EasyLink_receiveContinuousViewAsync(rxViewCb, 0) == EasyLink_Status_Success);
+    CHECK(sendCca() == EasyLink_Status_Success);
+    CHECK(FakeRf_carrierSense(true));
+    CHECK(FakeRf_activeCommand() == CMD_PROP_RX_ADV);
+    csCommands = FakeRf_posted(CMD_PROP_CS);
+
+    CHECK(EasyLink_abort() == EasyLink_Status_Success);
+    CHECK(txDones == 1 && txStatus == EasyLink_Status_Aborted);
+    CHECK(FakeRf_activeCommand() == CMD_PROP_RX_ADV && ends == 0);
+
+    //The back-off clock was stopped, no carrier sense comes
+    FakeRf_advance(BACKOFF_MAX_MS * RAT_PER_MS);
+    CHECK(FakeRf_posted(CMD_PROP_CS) == csCommands);
+    CHECK(FakeRf_activeCommand() == CMD_PROP_RX_ADV);
+    CHECK(send(1) == FakeRf_Rx_Stored && views == 1);
+
+    //A plain Tx pauses Rx again as usual
+    memset(&txPacket, 0, sizeof(txPacket));
+    txPacket.len = 1;
+    CHECK(EasyLink_transmitAsync(&txPacket, txDoneCb) == EasyLink_Status_Success);
+    CHECK(FakeRf_completeTx());
+    CHECK(txDones == 2 && txStatus == EasyLink_Status_Success);
+    CHECK(FakeRf_activeCommand() == CMD_PROP_RX_ADV);
+
+    CHECK(EasyLink_getStats(&after) == EasyLink_Status_Success);
+    CHECK(after.txAborts - before.txAborts == 1);
+    CHECK(after.txOk - before.txOk == 1);
+
+    CHECK(EasyLink_abort() == EasyLink_Status_Success);
+    CHECK(ends == 1);
+}
+
+/* However busy the channel was, a Tx keeps retries */
+static void testRetriesOnBusyChannel(void) {
+    EasyLink_CcaStats before;
+    EasyLink_CcaStats after;
+    uint32_t i;
+
+    for(i = 0; i < BUSY_TXS; i++) {
+        getCcaStats(&before);
+        CHECK(before.startBackOff < EASYLINK_MAX_CCA_BACKOFF_WINDOW);
+        txDones = 0;
+        CHECK(sendCca() == EasyLink_Status_Success);
+        while(FakeRf_carrierSense(true)) {
+            FakeRf_advance(BACKOFF_MAX_MS * RAT_PER_MS);
+        }
+        CHECK(txDones == 1 && txStatus == EasyLink_Status_Busy_Error);
+        getCcaStats(&after);
+        CHECK(after.retries - before.retries ==
+                (uint32_t)(EASYLINK_MAX_CCA_BACKOFF_WINDOW - before.startBackOff + 1));
+    }
+
+    CHECK(after.busyRate == EASYLINK_CCA_BUSY_RATE_ONE);
+    CHECK(after.startBackOff == EASYLINK_MAX_CCA_BACKOFF_WINDOW - 1);
+    CHECK(after.retries - before.retries == 2);
+    printf("busy channel: start exponent %u, %u back-offs before a Tx is given up\n",
+            after.startBackOff, after.retries - before.retries);
+}
+
+int main(void) {
+    EasyLink_Params params;
+
+    FakeRf_reset();
+    EasyLink_Params_init(&params);
+    CHECK(EasyLink_init(&params) == EasyLink_Status_Success);
+
+    testListenThroughBackOff();
+    testAbortDuringBackOff();
+    testRetriesOnBusyChannel();
+
+    return CHECK_RESULT();
+}
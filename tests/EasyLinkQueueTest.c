@@ -0,0 +1,369 @@
+/*
+ *  ======== EasyLinkQueueTest.c ========
+ *
+ *  The AP's EasyLink.c, built as is, on the fake RF core: continuous Rx
+ *  under the tags' bursts, each tag sending BURST beacons BURST_GAP_MS apart
+ *  from a random start, on a 1 ms grid. Tags on the same millisecond collide
+ *  and reach the AP as one packet with a CRC error.
+ *
+ *  With packets copied out, Rx stays on a single command across all of them
+ *  and none is lost. With views, the application holds them until its task
+ *  runs every few ms, as the AP's task does with its Rx semaphore: each
+ *  entry must be handed out again only after its release, with the packet it
+ *  held intact until then, and every packet not delivered must be one that
+ *  found all entries lent or came while Rx waited for a release. The loss
+ *  against the task period is printed. A Tx in the middle of Rx must leave
+ *  the lent entries alone.
+ */
+#include <string.h>
+
+#include "Check.h"
+#include "EasyLink.h"
+#include "FakeRf.h"
+
+/***** Defines *****/
+
+#define TAGS            24
+#define BURST           10
+#define BURST_GAP_MS    100
+#define ROUND_MS        2000    // A burst of every tag starts in each round
+#define ROUNDS          20
+#define RAT_PER_MS      4000
+#define AP_ADDR         0xAA
+#define PKT_LEN         4       // Address, tag, sequence number and a check byte
+#define MAX_HELD        EASYLINK_RX_QUEUE_ENTRIES
+
+/***** Type declarations *****/
+
+/* What the air did in one run */
+typedef struct
+{
+    uint32_t sent;              // Packets of a single tag
+    uint32_t collided;          // Packets lost to a collision
+    uint32_t delivered;
+    uint32_t notListening;      // Packets sent while Rx was not on
+    uint32_t bufFull;           // Packets that found no entry, as the RF core saw them
+    uint32_t outOfOrder;
+    uint32_t badRxCb;           // Callbacks with another status while Rx ran
+} Run;
+
+/***** Variable declarations *****/
+
+static Run run;
+static uint8_t lastSeq[TAGS];
+static uint32_t lastTime;
+static EasyLink_Status endStatus;
+static bool ended;
+
+/* Views the application holds, oldest first */
+static EasyLink_RxView held[MAX_HELD + 1];
+static uint8_t heldTag[MAX_HELD + 1];
+static uint8_t heldSeq[MAX_HELD + 1];
+static uint8_t heldCount;
+static uint32_t doubleLent;
+static uint32_t corrupted;
+static uint8_t* entriesSeen[EASYLINK_RX_QUEUE_ENTRIES + 1];
+static uint8_t entriesSeenCount;
+
+/***** Function definitions *****/
+
+/* Next pseudo random number, the same run every time */
+static uint32_t nextRandom(uint32_t* state) {
+    *state = *state * 1664525u + 1013904223u;
+
+    return *state >> 8;
+}
+
+static uint8_t checkByte(uint8_t tag, uint8_t seq) {
+    return (uint8_t)(tag * 31 + seq * 7 + 1);
+}
+
+/* In order per tag and in time overall */
+static void checkOrder(uint8_t tag, uint8_t seq, uint32_t absTime) {
+    if((int8_t)(seq - lastSeq[tag]) <= 0 || (int32_t)(absTime - lastTime) < 0) {
+        run.outOfOrder++;
+    }
+    lastSeq[tag] = seq;
+    lastTime = absTime;
+    run.delivered++;
+}
+
+static void rxCb(EasyLink_RxPacket* rxPacket, EasyLink_Status status) {
+    if(status != EasyLink_Status_Success) {
+        endStatus = status;
+        ended = true;
+        return;
+    }
+    if(rxPacket->len != PKT_LEN - 1 || rxPacket->dstAddr[0] != AP_ADDR ||
+            rxPacket->payload[2] != checkByte(rxPacket->payload[0], rxPacket->payload[1])) {
+        run.badRxCb++;
+        return;
+    }
+    checkOrder(rxPacket->payload[0], rxPacket->payload[1], rxPacket->absTime);
+}
+
+static void noteEntry(uint8_t* entry) {
+    uint8_t i;
+
+    for(i = 0; i < entriesSeenCount; i++) {
+        if(entriesSeen[i] == entry) {
+            return;
+        }
+    }
+    if(entriesSeenCount < sizeof(entriesSeen) / sizeof(entriesSeen[0])) {
+        entriesSeen[entriesSeenCount++] = entry;
+    }
+}
+
+static void rxViewCb(EasyLink_RxView* rxView, EasyLink_Status status) {
+    uint8_t i;
+
+    if(rxView == NULL) {
+        endStatus = status;
+        ended = true;
+        return;
+    }
+    if(status != EasyLink_Status_Success || rxView->len != PKT_LEN - 1 ||
+            heldCount == MAX_HELD + 1) {
+        run.badRxCb++;
+        return;
+    }
+    //An entry still held must not come back
+    for(i = 0; i < heldCount; i++) {
+        if(held[i].entry == rxView->entry) {
+            doubleLent++;
+        }
+    }
+    noteEntry(rxView->entry);
+
+    //The view is only valid in the callback, its pointers until the release
+    held[heldCount] = *rxView;
+    heldTag[heldCount] = rxView->payload[0];
+    heldSeq[heldCount] = rxView->payload[1];
+    heldCount++;
+    checkOrder(rxView->payload[0], rxView->payload[1], rxView->absTime);
+}
+
+/* The application's task: done with every view it holds */
+static void releaseHeld(void) {
+    uint8_t i;
+
+    for(i = 0; i < heldCount; i++) {
+        //Nothing was written to the entry while it was lent
+        if(held[i].payload[0] != heldTag[i] || held[i].payload[1] != heldSeq[i] ||
+                held[i].payload[2] != checkByte(heldTag[i], heldSeq[i])) {
+            corrupted++;
+        }
+        EasyLink_releaseRxView(&held[i]);
+    }
+    heldCount = 0;
+}
+
+static void resetRun(void) {
+    memset(&run, 0, sizeof(run));
+    memset(lastSeq, 0xFF, sizeof(lastSeq));
+    lastTime = RF_getCurrentTime();
+    ended = false;
+    heldCount = 0;
+    doubleLent = 0;
+    corrupted = 0;
+    entriesSeenCount = 0;
+}
+
+/* Puts a packet of a tag on the air, a collision is counted by the caller */
+static void send(uint8_t tag, uint8_t seq, bool collision) {
+    uint8_t pkt[PKT_LEN] = {AP_ADDR, tag, seq, checkByte(tag, seq)};
+    FakeRf_RxResult result = FakeRf_receive(pkt, PKT_LEN, -60 - tag, !collision);
+
+    if(collision) {
+        return;
+    }
+    switch(result) {
+        case FakeRf_Rx_NotListening:
+            run.notListening++;
+            break;
+        case FakeRf_Rx_BufFull:
+            run.bufFull++;
+            break;
+        default:
+            break;
+    }
+}
+
+/*
+ * The tags' bursts for ROUNDS rounds, 1 ms at a time. The application's task
+ * runs every taskMs, 0 for none.
+ */
+static void runBursts(uint32_t taskMs) {
+    uint16_t start[TAGS];
+    uint8_t seqs[TAGS] = {0};
+    uint32_t random = 7;
+    uint32_t round;
+    uint32_t ms;
+    uint32_t since;
+    uint8_t onAir;
+    uint8_t first = 0;
+    uint8_t tag;
+
+    for(round = 0; round < ROUNDS; round++) {
+        for(tag = 0; tag < TAGS; tag++) {
+            start[tag] = nextRandom(&random) % (ROUND_MS - BURST * BURST_GAP_MS);
+        }
+        for(ms = 0; ms < ROUND_MS; ms++) {
+            onAir = 0;
+            for(tag = 0; tag < TAGS; tag++) {
+                since = ms - start[tag];
+                if(ms >= start[tag] && since % BURST_GAP_MS == 0 &&
+                        since / BURST_GAP_MS < BURST) {
+                    if(onAir == 0) {
+                        first = tag;
+                    }
+                    onAir++;
+                    run.sent++;
+                    seqs[tag]++;
+                }
+            }
+            if(onAir == 1) {
+                send(first, seqs[first], false);
+            } else if(onAir > 1) {
+                send(first, seqs[first], true);
+                run.collided += onAir;
+            }
+            FakeRf_advance(RAT_PER_MS);
+            if(taskMs != 0 && ms % taskMs == 0) {
+                releaseHeld();
+            }
+        }
+    }
+}
+
+static void getStats(EasyLink_Stats* stats) {
+    CHECK(EasyLink_getStats(stats) == EasyLink_Status_Success);
+}
+
+/* Copied out, Rx stays on one command and no packet is lost */
+static void testCopyUnderLoad(void) {
+    EasyLink_Stats before;
+    EasyLink_Stats after;
+    uint32_t rxCommands = FakeRf_posted(CMD_PROP_RX_ADV);
+
+    resetRun();
+    getStats(&before);
+    CHECK(EasyLink_receiveContinuousAsync(rxCb, 0) == EasyLink_Status_Success);
+    runBursts(0);
+    getStats(&after);
+
+    CHECK(run.sent > 0);
+    CHECK(run.delivered + run.collided == run.sent);
+    CHECK(run.notListening == 0 && run.bufFull == 0);
+    CHECK(run.outOfOrder == 0 && run.badRxCb == 0);
+    CHECK(!ended);
+    CHECK(FakeRf_posted(CMD_PROP_RX_ADV) - rxCommands == 1);
+    CHECK(after.rxOk - before.rxOk == run.delivered);
+    CHECK(after.rxBufFull == before.rxBufFull);
+    //A collision is one packet with a CRC error, its entry is not used up
+    CHECK(after.rxNok - before.rxNok > 0);
+
+    CHECK(EasyLink_abort() == EasyLink_Status_Success);
+    CHECK(ended && endStatus == EasyLink_Status_Aborted);
+
+    printf("copy: %u sent, %u collided, %u delivered on %u Rx command\n", run.sent,
+            run.collided, run.delivered, FakeRf_posted(CMD_PROP_RX_ADV) - rxCommands);
+}
+
+/* Views held until the task runs, every packet is accounted for */
+static void testViewsUnderLoad(uint32_t taskMs) {
+    EasyLink_Stats before;
+    EasyLink_Stats after;
+    uint32_t rxCommands = FakeRf_posted(CMD_PROP_RX_ADV);
+
+    resetRun();
+    getStats(&before);
+    CHECK(EasyLink_receiveContinuousViewAsync(rxViewCb, 0) == EasyLink_Status_Success);
+    runBursts(taskMs);
+    releaseHeld();
+    getStats(&after);
+
+    CHECK(run.sent > 0);
+    CHECK(run.delivered + run.collided + run.bufFull + run.notListening == run.sent);
+    CHECK(run.outOfOrder == 0 && run.badRxCb == 0);
+    CHECK(doubleLent == 0 && corrupted == 0);
+    CHECK(entriesSeenCount == EASYLINK_RX_QUEUE_ENTRIES);
+    CHECK(after.rxOk - before.rxOk == run.delivered);
+    CHECK(after.rxBufFull - before.rxBufFull == run.bufFull);
+    //Rx restarts once per time it ran out of entries
+    CHECK(FakeRf_posted(CMD_PROP_RX_ADV) - rxCommands == 1 + run.bufFull);
+    CHECK(!ended);
+
+    CHECK(EasyLink_abort() == EasyLink_Status_Success);
+    CHECK(ended && endStatus == EasyLink_Status_Aborted);
+
+    printf("views, task every %2u ms: %u delivered, %u found no entry, %u while not "
+            "listening, %.2f%% lost\n", taskMs, run.delivered, run.bufFull, run.notListening,
+            100.0 * (run.bufFull + run.notListening) / (run.sent - run.collided));
+}
+
+/* Views lent before a Tx stay lent and intact, and recycle after it */
+static void testTxKeepsLentViews(void) {
+    EasyLink_TxPacket txPacket;
+    uint8_t seq;
+
+    resetRun();
+    CHECK(EasyLink_receiveContinuousViewAsync(rxViewCb, 0) == EasyLink_Status_Success);
+    for(seq = 1; seq <= 2; seq++) {
+        send(0, seq, false);
+        FakeRf_advance(RAT_PER_MS);
+    }
+    CHECK(heldCount == 2);
+
+    memset(&txPacket, 0, sizeof(txPacket));
+    txPacket.dstAddr[0] = 0xBB;
+    txPacket.len = 10;
+    CHECK(EasyLink_transmitAsync(&txPacket, NULL) == EasyLink_Status_Success);
+    CHECK(FakeRf_activeCommand() == CMD_PROP_TX);
+    send(0, 3, false);
+    CHECK(run.notListening == 1);
+    CHECK(FakeRf_completeTx());
+    CHECK(FakeRf_activeCommand() == CMD_PROP_RX_ADV);
+    CHECK(!ended);
+
+    //The two lent entries are still out, the other two take packets
+    for(seq = 4; seq <= 5; seq++) {
+        send(0, seq, false);
+        FakeRf_advance(RAT_PER_MS);
+    }
+    CHECK(heldCount == 4);
+    CHECK(doubleLent == 0);
+    releaseHeld();
+    CHECK(corrupted == 0);
+
+    //All four are back in the queue
+    for(seq = 6; seq <= 9; seq++) {
+        send(0, seq, false);
+        FakeRf_advance(RAT_PER_MS);
+    }
+    CHECK(heldCount == 4 && run.bufFull == 0 && doubleLent == 0);
+    releaseHeld();
+    CHECK(corrupted == 0 && run.outOfOrder == 0);
+
+    CHECK(EasyLink_abort() == EasyLink_Status_Success);
+    CHECK(ended);
+}
+
+int main(void) {
+    static const uint32_t taskPeriods[] = {1, 2, 5, 10, 20};
+    EasyLink_Params params;
+    uint8_t i;
+
+    FakeRf_reset();
+    EasyLink_Params_init(&params);
+    CHECK(EasyLink_init(&params) == EasyLink_Status_Success);
+
+    testCopyUnderLoad();
+    for(i = 0; i < sizeof(taskPeriods) / sizeof(taskPeriods[0]); i++) {
+        testViewsUnderLoad(taskPeriods[i]);
+    }
+    testTxKeepsLentViews();
+
+    return CHECK_RESULT();
+}
@@ -0,0 +1,296 @@
+/*
+ *  ======== EasyLinkSimTest.c ========
+ */
+#include <math.h>
+#include <string.h>
+
+#include <ti/sysbios/BIOS.h>
+#include <ti/sysbios/knl/Semaphore.h>
+
+#include "Check.h"
+#include "easylink/EasyLink.h"
+#include "SimClock.h"
+#include "SimRadio.h"
+
+/***** Defines *****/
+
+#define FREQUENCY(test)     (868000000 + (test) * 200000) // One channel per test
+#define LEAD_TICKS          EasyLink_ms_To_RadioTime(20) // Commands are set up ahead of this
+#define WAIT_TICKS          100000 // 1 s of Clock ticks
+#define DISTANCE_M          10.0
+
+/***** Variable declarations *****/
+
+static SimRadio_Params params;
+static Semaphore_Handle doneSem;
+
+static EasyLink_Status lastStatus;
+static EasyLink_RxPacket lastPacket;
+static EasyLink_RxView views[EASYLINK_RX_QUEUE_ENTRIES + 1];
+static uint8_t viewCount;
+
+/***** Function definitions *****/
+
+static uint32_t zeroRN(void) {
+    return 0;
+}
+
+static void txDoneCb(EasyLink_Status status) {
+    lastStatus = status;
+    Semaphore_post(doneSem);
+}
+
+static void rxCb(EasyLink_RxPacket* rxPacket, EasyLink_Status status) {
+    lastStatus = status;
+    lastPacket = *rxPacket;
+    Semaphore_post(doneSem);
+}
+
+/* Keeps every view lent, up to the Rx queue size plus one */
+static void rxViewCb(EasyLink_RxView* rxView, EasyLink_Status status) {
+    lastStatus = status;
+    if(rxView != NULL && viewCount < sizeof(views) / sizeof(views[0])) {
+        views[viewCount++] = *rxView;
+    }
+    Semaphore_post(doneSem);
+}
+
+static SimNode* addNode(double x, uint8_t test, EasyLink_GetRandomNumber getRN) {
+    SimNode* node = SimRadio_addNode(x, 0.0);
+    EasyLink_Params easyLink_params;
+
+    SimRadio_attach(node);
+    EasyLink_Params_init(&easyLink_params);
+    if(getRN != NULL) {
+        easyLink_params.pGrnFxn = getRN;
+    }
+    CHECK(EasyLink_init(&easyLink_params) == EasyLink_Status_Success);
+    CHECK(EasyLink_setFrequency(FREQUENCY(test)) == EasyLink_Status_Success);
+
+    return node;
+}
+
+static uint32_t ahead(void) {
+    return (uint32_t)(SimClock_now() + LEAD_TICKS);
+}
+
+static void initTxPacket(EasyLink_TxPacket* txPacket, uint8_t dst, uint8_t len, uint32_t absTime) {
+    memset(txPacket, 0, sizeof(*txPacket));
+    txPacket->dstAddr[0] = dst;
+    txPacket->len = len;
+    txPacket->absTime = absTime;
+    memset(txPacket->payload, 0x5a, len);
+}
+
+static void testDelivery(void) {
+    SimNode* tx = addNode(0.0, 1, NULL);
+    SimNode* rx = addNode(DISTANCE_M, 1, NULL);
+    EasyLink_TxPacket txPacket;
+    EasyLink_Stats stats;
+    int8_t rssi = (int8_t)lround(14 - params.pathLoss1mDb -
+            10.0 * params.pathLossExponent * log10(DISTANCE_M));
+
+    CHECK(EasyLink_receiveContinuousAsync(rxCb, 0) == EasyLink_Status_Success);
+    //Anything that changes the radio setup is refused while Rx runs
+    CHECK(EasyLink_setFrequency(FREQUENCY(1)) == EasyLink_Status_Busy_Error);
+
+    SimRadio_attach(tx);
+    initTxPacket(&txPacket, 0xaa, 3, ahead());
+    txPacket.payload[0] = 1;
+    CHECK(EasyLink_transmit(&txPacket) == EasyLink_Status_Success);
+    CHECK(Semaphore_pend(doneSem, WAIT_TICKS) == TRUE);
+    CHECK(lastStatus == EasyLink_Status_Success);
+    CHECK(lastPacket.dstAddr[0] == 0xaa);
+    CHECK(lastPacket.len == 3 && lastPacket.payload[0] == 1 && lastPacket.payload[1] == 0x5a);
+    CHECK(lastPacket.rssi == rssi);
+    CHECK(lastPacket.absTime == txPacket.absTime);
+
+    SimRadio_attach(rx);
+    CHECK(EasyLink_getStats(&stats) == EasyLink_Status_Success);
+    CHECK(stats.rxOk == 1 && stats.rxNok == 0 && stats.lastRssi == rssi);
+    CHECK(stats.busyErrors == 1);
+
+    //Continuous Rx runs until it is aborted, the callback comes before abort
+    //returns
+    CHECK(EasyLink_abort() == EasyLink_Status_Success);
+    CHECK(Semaphore_pend(doneSem, BIOS_NO_WAIT) == TRUE);
+    CHECK(lastStatus == EasyLink_Status_Aborted);
+    CHECK(EasyLink_abort() == EasyLink_Status_Aborted);
+    CHECK(EasyLink_getStats(&stats) == EasyLink_Status_Success);
+    CHECK(stats.rxAborts == 1);
+}
+
+static void testCollision(void) {
+    SimNode* tx1 = addNode(-DISTANCE_M, 2, NULL);
+    SimNode* tx2 = addNode(DISTANCE_M, 2, NULL);
+    SimNode* rx = addNode(0.0, 2, NULL);
+    EasyLink_TxPacket txPacket;
+    EasyLink_Stats stats;
+    SimRadio_Counters before;
+    SimRadio_Counters after;
+    uint32_t absTime = ahead();
+
+    SimRadio_getCounters(&before);
+    CHECK(EasyLink_receiveContinuousAsync(rxCb, 0) == EasyLink_Status_Success);
+
+    //Same strength at the receiver, neither is captured
+    SimRadio_attach(tx1);
+    initTxPacket(&txPacket, 0xaa, 3, absTime);
+    CHECK(EasyLink_transmitAsync(&txPacket, txDoneCb) == EasyLink_Status_Success);
+    SimRadio_attach(tx2);
+    initTxPacket(&txPacket, 0xaa, 3, absTime + EasyLink_us_To_RadioTime(500));
+    CHECK(EasyLink_transmitAsync(&txPacket, txDoneCb) == EasyLink_Status_Success);
+    CHECK(Semaphore_pend(doneSem, WAIT_TICKS) == TRUE);
+    CHECK(Semaphore_pend(doneSem, WAIT_TICKS) == TRUE);
+
+    SimRadio_attach(rx);
+    CHECK(EasyLink_getStats(&stats) == EasyLink_Status_Success);
+    CHECK(stats.rxOk == 0 && stats.rxNok == 2);
+    SimRadio_getCounters(&after);
+    CHECK(after.collisions - before.collisions == 2);
+    CHECK(after.transmissions - before.transmissions == 2);
+    CHECK(EasyLink_abort() == EasyLink_Status_Success);
+    CHECK(Semaphore_pend(doneSem, BIOS_NO_WAIT) == TRUE);
+}
+
+static void testFilter(void) {
+    SimNode* tx = addNode(0.0, 3, NULL);
+    SimNode* rx = addNode(DISTANCE_M, 3, NULL);
+    uint8_t addrFilter[EASYLINK_MAX_ADDR_SIZE * EASYLINK_MAX_ADDR_FILTERS] = {0xaa};
+    EasyLink_TxPacket txPacket;
+    EasyLink_Stats stats;
+
+    CHECK(EasyLink_enableRxAddrFilter(addrFilter, 2, 1) == EasyLink_Status_Param_Error);
+    CHECK(EasyLink_enableRxAddrFilter(addrFilter, 1, 1) == EasyLink_Status_Success);
+    CHECK(EasyLink_receiveContinuousAsync(rxCb, 0) == EasyLink_Status_Success);
+
+    SimRadio_attach(tx);
+    initTxPacket(&txPacket, 0xbb, 3, ahead());
+    CHECK(EasyLink_transmit(&txPacket) == EasyLink_Status_Success);
+    initTxPacket(&txPacket, 0xaa, 3, ahead());
+    CHECK(EasyLink_transmit(&txPacket) == EasyLink_Status_Success);
+    CHECK(Semaphore_pend(doneSem, WAIT_TICKS) == TRUE);
+    CHECK(lastPacket.dstAddr[0] == 0xaa);
+    CHECK(Semaphore_pend(doneSem, BIOS_NO_WAIT) == FALSE);
+
+    SimRadio_attach(rx);
+    CHECK(EasyLink_getStats(&stats) == EasyLink_Status_Success);
+    CHECK(stats.rxOk == 1 && stats.rxIgnored == 1);
+    CHECK(EasyLink_abort() == EasyLink_Status_Success);
+    CHECK(Semaphore_pend(doneSem, BIOS_NO_WAIT) == TRUE);
+}
+
+static void testTimeout(void) {
+    EasyLink_RxPacket rxPacket;
+    EasyLink_Stats stats;
+    uint32_t start;
+    uint32_t end;
+
+    addNode(0.0, 4, NULL);
+    memset(&rxPacket, 0, sizeof(rxPacket));
+    rxPacket.rxTimeout = EasyLink_ms_To_RadioTime(5);
+    EasyLink_getAbsTime(&start);
+    CHECK(EasyLink_receive(&rxPacket) == EasyLink_Status_Rx_Timeout);
+    EasyLink_getAbsTime(&end);
+    CHECK(end - start >= EasyLink_ms_To_RadioTime(5));
+
+    //Async Rx takes its timeout from the ctrl option
+    CHECK(EasyLink_setCtrl(EasyLink_Ctrl_AsyncRx_TimeOut, EasyLink_ms_To_RadioTime(5)) ==
+            EasyLink_Status_Success);
+    CHECK(EasyLink_receiveAsync(rxCb, 0) == EasyLink_Status_Success);
+    CHECK(Semaphore_pend(doneSem, WAIT_TICKS) == TRUE);
+    CHECK(lastStatus == EasyLink_Status_Rx_Timeout);
+
+    CHECK(EasyLink_getStats(&stats) == EasyLink_Status_Success);
+    CHECK(stats.rxTimeouts == 2 && stats.rxOk == 0);
+}
+
+static void testView(void) {
+    SimNode* tx = addNode(0.0, 5, NULL);
+    SimNode* rx = addNode(DISTANCE_M, 5, NULL);
+    EasyLink_TxPacket txPacket;
+    EasyLink_Stats stats;
+    uint8_t i;
+
+    viewCount = 0;
+    CHECK(EasyLink_receiveContinuousViewAsync(rxViewCb, 0) == EasyLink_Status_Success);
+
+    //One more than the queue holds, the last is lost while all are lent
+    SimRadio_attach(tx);
+    for(i = 0; i <= EASYLINK_RX_QUEUE_ENTRIES; i++) {
+        initTxPacket(&txPacket, 0xaa, 3, ahead());
+        txPacket.payload[0] = i;
+        CHECK(EasyLink_transmit(&txPacket) == EasyLink_Status_Success);
+    }
+    for(i = 0; i < EASYLINK_RX_QUEUE_ENTRIES; i++) {
+        CHECK(Semaphore_pend(doneSem, WAIT_TICKS) == TRUE);
+    }
+    CHECK(viewCount == EASYLINK_RX_QUEUE_ENTRIES);
+    for(i = 0; i < viewCount; i++) {
+        CHECK(views[i].payload[0] == i && views[i].len == 3 && views[i].dstAddr[0] == 0xaa);
+    }
+
+    SimRadio_attach(rx);
+    CHECK(EasyLink_getStats(&stats) == EasyLink_Status_Success);
+    CHECK(stats.rxOk == EASYLINK_RX_QUEUE_ENTRIES && stats.rxBufFull == 1);
+
+    //A view handed back restarts the Rx, a second release changes nothing
+    EasyLink_releaseRxView(&views[0]);
+    EasyLink_releaseRxView(&views[0]);
+    SimRadio_attach(tx);
+    initTxPacket(&txPacket, 0xaa, 3, ahead());
+    txPacket.payload[0] = 0x10;
+    CHECK(EasyLink_transmit(&txPacket) == EasyLink_Status_Success);
+    CHECK(Semaphore_pend(doneSem, WAIT_TICKS) == TRUE);
+    CHECK(viewCount == EASYLINK_RX_QUEUE_ENTRIES + 1);
+    CHECK(views[EASYLINK_RX_QUEUE_ENTRIES].payload[0] == 0x10);
+    CHECK(views[EASYLINK_RX_QUEUE_ENTRIES].entry == views[0].entry);
+
+    SimRadio_attach(rx);
+    for(i = 1; i < viewCount; i++) {
+        EasyLink_releaseRxView(&views[i]);
+    }
+    CHECK(EasyLink_abort() == EasyLink_Status_Success);
+    CHECK(Semaphore_pend(doneSem, WAIT_TICKS) == TRUE);
+    CHECK(lastStatus == EasyLink_Status_Aborted);
+}
+
+static void testCca(void) {
+    SimNode* jammer = addNode(0.0, 6, NULL);
+    SimNode* tag = addNode(DISTANCE_M, 6, zeroRN);
+    EasyLink_TxPacket txPacket;
+    EasyLink_Stats stats;
+    uint32_t absTime = ahead();
+
+    //About 9 ms on the air, carrier sense finds it twice with no back-off
+    SimRadio_attach(jammer);
+    initTxPacket(&txPacket, 0xbb, 40, absTime);
+    CHECK(EasyLink_transmitAsync(&txPacket, txDoneCb) == EasyLink_Status_Success);
+
+    SimRadio_attach(tag);
+    initTxPacket(&txPacket, 0xaa, 3, absTime);
+    CHECK(EasyLink_transmitCcaAsync(&txPacket, txDoneCb) == EasyLink_Status_Success);
+    CHECK(EasyLink_transmitCcaAsync(&txPacket, txDoneCb) == EasyLink_Status_Busy_Error);
+    CHECK(Semaphore_pend(doneSem, WAIT_TICKS) == TRUE);
+    CHECK(Semaphore_pend(doneSem, WAIT_TICKS) == TRUE);
+
+    CHECK(EasyLink_getStats(&stats) == EasyLink_Status_Success);
+    CHECK(stats.cca.txCount == 1 && stats.cca.txSuccess == 1);
+    CHECK(stats.cca.busyCount == 2 && stats.cca.retries == 2 && stats.cca.busyFailures == 0);
+    CHECK(stats.txOk == 1 && stats.busyErrors == 1);
+}
+
+int main(void) {
+    SimRadio_Params_init(&params);
+    SimRadio_init(&params);
+    doneSem = Semaphore_create(0, NULL, NULL);
+
+    testDelivery();
+    testCollision();
+    testFilter();
+    testTimeout();
+    testView();
+    testCca();
+
+    return CHECK_RESULT();
+}
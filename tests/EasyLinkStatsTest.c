@@ -0,0 +1,193 @@
+/*
+ *  ======== EasyLinkStatsTest.c ========
+ *
+ *  The AP's EasyLink.c, built as is, on the fake RF core: the counters of
+ *  EasyLink_getStats add up across Rx, Tx and the commands in between, while
+ *  the RF core's own counters restart with every Rx command and are only 8
+ *  or 16 bits wide. Reading them changes nothing.
+ */
+#include <string.h>
+
+#include "Check.h"
+#include "EasyLink.h"
+#include "FakeRf.h"
+
+/***** Defines *****/
+
+#define RAT_PER_MS      4000
+#define AP_ADDR         0xAA
+#define OTHER_ADDR      0x55
+#define ROUNDS          6       // Rx commands, each ended by an abort
+#define OK_PER_ROUND    30
+#define NOK_PER_ROUND   5
+#define IGNORED_PER_OK  10      // 300 a round, past the RF core's 8 bit count
+#define TIMEOUTS        3
+#define TXS             5
+
+/***** Variable declarations *****/
+
+static uint32_t packets;
+static uint32_t aborted;
+static uint32_t timedOut;
+static uint32_t txDones;
+static EasyLink_Status txStatus;
+
+/***** Function definitions *****/
+
+static void rxCb(EasyLink_RxPacket* rxPacket, EasyLink_Status status) {
+    (void)rxPacket;
+    if(status == EasyLink_Status_Success) {
+        packets++;
+    } else if(status == EasyLink_Status_Aborted) {
+        aborted++;
+    } else if(status == EasyLink_Status_Rx_Timeout) {
+        timedOut++;
+    }
+}
+
+static void txDoneCb(EasyLink_Status status) {
+    txStatus = status;
+    txDones++;
+}
+
+static FakeRf_RxResult send(uint8_t addr, int8_t rssi, bool crcOk) {
+    uint8_t pkt[3] = {addr, 1, 2};
+    FakeRf_RxResult result = FakeRf_receive(pkt, sizeof(pkt), rssi, crcOk);
+
+    FakeRf_advance(RAT_PER_MS);
+
+    return result;
+}
+
+static void getStats(EasyLink_Stats* stats) {
+    CHECK(EasyLink_getStats(stats) == EasyLink_Status_Success);
+}
+
+static void initTxPacket(EasyLink_TxPacket* txPacket) {
+    memset(txPacket, 0, sizeof(*txPacket));
+    txPacket->dstAddr[0] = 0xBB;
+    txPacket->len = 10;
+}
+
+/* Packets of every kind over several Rx commands */
+static void testRxAcrossCommands(void) {
+    EasyLink_Stats before;
+    EasyLink_Stats after;
+    int8_t rssi = 0;
+    uint8_t round;
+    uint8_t i;
+    uint8_t j;
+
+    packets = 0;
+    aborted = 0;
+    getStats(&before);
+    for(round = 0; round < ROUNDS; round++) {
+        CHECK(EasyLink_receiveContinuousAsync(rxCb, 0) == EasyLink_Status_Success);
+        for(i = 0; i < OK_PER_ROUND; i++) {
+            //Filtered packets call nothing, the next packet's callback folds them
+            for(j = 0; j < IGNORED_PER_OK; j++) {
+                CHECK(send(OTHER_ADDR, -90, true) == FakeRf_Rx_Filtered);
+            }
+            rssi = (int8_t)(-40 - round - i);
+            CHECK(send(AP_ADDR, rssi, true) == FakeRf_Rx_Stored);
+        }
+        for(i = 0; i < NOK_PER_ROUND; i++) {
+            CHECK(send(AP_ADDR, -95, false) == FakeRf_Rx_CrcError);
+        }
+        CHECK(FakeRf_activeCommand() == CMD_PROP_RX_ADV);
+        CHECK(EasyLink_abort() == EasyLink_Status_Success);
+    }
+    getStats(&after);
+
+    CHECK(FakeRf_posted(CMD_PROP_RX_ADV) >= ROUNDS);
+    CHECK(packets == ROUNDS * OK_PER_ROUND);
+    CHECK(aborted == ROUNDS);
+    CHECK(after.rxOk - before.rxOk == ROUNDS * OK_PER_ROUND);
+    CHECK(after.rxNok - before.rxNok == ROUNDS * NOK_PER_ROUND);
+    CHECK(after.rxIgnored - before.rxIgnored == ROUNDS * OK_PER_ROUND * IGNORED_PER_OK);
+    CHECK(after.rxAborts - before.rxAborts == ROUNDS);
+    CHECK(after.rxErrors == before.rxErrors);
+    CHECK(after.rxBufFull == before.rxBufFull);
+    //The last packet received, not the CRC errors after it
+    CHECK(after.lastRssi == rssi);
+}
+
+static void testRxTimeouts(void) {
+    EasyLink_Stats before;
+    EasyLink_Stats after;
+    uint8_t i;
+
+    timedOut = 0;
+    getStats(&before);
+    CHECK(EasyLink_setCtrl(EasyLink_Ctrl_AsyncRx_TimeOut, 5 * RAT_PER_MS) ==
+            EasyLink_Status_Success);
+    for(i = 0; i < TIMEOUTS; i++) {
+        CHECK(EasyLink_receiveAsync(rxCb, 0) == EasyLink_Status_Success);
+        FakeRf_advance(10 * RAT_PER_MS);
+        CHECK(FakeRf_activeCommand() == 0);
+    }
+    CHECK(EasyLink_setCtrl(EasyLink_Ctrl_AsyncRx_TimeOut, 0) == EasyLink_Status_Success);
+    getStats(&after);
+
+    CHECK(timedOut == TIMEOUTS);
+    CHECK(after.rxTimeouts - before.rxTimeouts == TIMEOUTS);
+    CHECK(after.rxOk == before.rxOk && after.rxAborts == before.rxAborts);
+}
+
+/* Sent, refused while busy and aborted */
+static void testTx(void) {
+    EasyLink_TxPacket txPacket;
+    EasyLink_Stats before;
+    EasyLink_Stats after;
+    uint8_t i;
+
+    txDones = 0;
+    getStats(&before);
+    initTxPacket(&txPacket);
+    for(i = 0; i < TXS; i++) {
+        CHECK(EasyLink_transmitAsync(&txPacket, txDoneCb) == EasyLink_Status_Success);
+        CHECK(EasyLink_transmitAsync(&txPacket, txDoneCb) == EasyLink_Status_Busy_Error);
+        CHECK(FakeRf_completeTx());
+        CHECK(txStatus == EasyLink_Status_Success);
+    }
+    CHECK(EasyLink_transmitAsync(&txPacket, txDoneCb) == EasyLink_Status_Success);
+    CHECK(EasyLink_abort() == EasyLink_Status_Success);
+    CHECK(txStatus == EasyLink_Status_Aborted);
+    getStats(&after);
+
+    CHECK(txDones == TXS + 1);
+    CHECK(after.txOk - before.txOk == TXS);
+    CHECK(after.busyErrors - before.busyErrors == TXS);
+    CHECK(after.txAborts - before.txAborts == 1);
+    CHECK(after.txErrors == before.txErrors);
+}
+
+int main(void) {
+    uint8_t addrFilter[1] = {AP_ADDR};
+    EasyLink_Params params;
+    EasyLink_Stats first;
+    EasyLink_Stats stats;
+
+    FakeRf_reset();
+    EasyLink_Params_init(&params);
+    CHECK(EasyLink_init(&params) == EasyLink_Status_Success);
+    CHECK(EasyLink_enableRxAddrFilter(addrFilter, 1, 1) == EasyLink_Status_Success);
+
+    getStats(&first);
+    testRxAcrossCommands();
+    testRxTimeouts();
+    testTx();
+    testRxAcrossCommands();
+
+    //Everything since the start, reading twice gives the same counters
+    getStats(&stats);
+    CHECK(stats.rxOk - first.rxOk == 2 * ROUNDS * OK_PER_ROUND);
+    CHECK(stats.rxIgnored - first.rxIgnored == 2 * ROUNDS * OK_PER_ROUND * IGNORED_PER_OK);
+    CHECK(stats.rxAborts - first.rxAborts == 2 * ROUNDS);
+    CHECK(stats.rxTimeouts - first.rxTimeouts == TIMEOUTS);
+    CHECK(stats.txOk - first.txOk == TXS);
+    getStats(&first);
+    CHECK(memcmp(&first, &stats, sizeof(stats)) == 0);
+
+    return CHECK_RESULT();
+}
@@ -0,0 +1,270 @@
+/*
+ *  ======== EasyLinkViewTest.c ========
+ *
+ *  The AP's EasyLink.c, built as is, on the fake RF core: lending the
+ *  continuous Rx entries as views one packet at a time. Each entry is lent
+ *  once until released, with all of them lent the radio stops and only the
+ *  packet that found no entry is counted, and Rx starts again on the first
+ *  release. Abort works while Rx waits for a release, and views lent before
+ *  the Rx ended are taken back by the next one.
+ */
+#include <string.h>
+
+#include "Check.h"
+#include "EasyLink.h"
+#include "FakeRf.h"
+
+/***** Defines *****/
+
+#define RAT_PER_MS      4000
+#define AP_ADDR         0xAA
+#define PKT_LEN         3       // Address, sequence number and a check byte
+#define ENTRIES         EASYLINK_RX_QUEUE_ENTRIES
+
+/***** Variable declarations *****/
+
+static EasyLink_RxView held[ENTRIES + 1];
+static uint8_t heldSeq[ENTRIES + 1];
+static uint8_t heldCount;
+static uint32_t views;
+static uint32_t ends;
+static EasyLink_Status endStatus;
+static bool releaseInCallback;
+
+/***** Function definitions *****/
+
+static uint8_t checkByte(uint8_t seq) {
+    return (uint8_t)(seq * 7 + 1);
+}
+
+static void rxViewCb(EasyLink_RxView* rxView, EasyLink_Status status) {
+    if(rxView == NULL) {
+        endStatus = status;
+        ends++;
+        return;
+    }
+    views++;
+    CHECK(status == EasyLink_Status_Success);
+    CHECK(rxView->len == PKT_LEN - 1 && rxView->dstAddr[0] == AP_ADDR);
+    if(releaseInCallback) {
+        EasyLink_releaseRxView(rxView);
+        return;
+    }
+    CHECK(heldCount < ENTRIES);
+    if(heldCount < ENTRIES) {
+        held[heldCount] = *rxView;
+        heldSeq[heldCount] = rxView->payload[0];
+        heldCount++;
+    }
+}
+
+static FakeRf_RxResult send(uint8_t seq) {
+    uint8_t pkt[PKT_LEN] = {AP_ADDR, seq, checkByte(seq)};
+    FakeRf_RxResult result = FakeRf_receive(pkt, PKT_LEN, -70, true);
+
+    FakeRf_advance(RAT_PER_MS);
+
+    return result;
+}
+
+/* The oldest view still held goes back, its packet must be intact */
+static void releaseOldest(void) {
+    EasyLink_RxView view = held[0];
+
+    CHECK(view.payload[0] == heldSeq[0] && view.payload[1] == checkByte(heldSeq[0]));
+    heldCount--;
+    memmove(&held[0], &held[1], heldCount * sizeof(held[0]));
+    memmove(&heldSeq[0], &heldSeq[1], heldCount);
+    EasyLink_releaseRxView(&view);
+}
+
+static void releaseAll(void) {
+    while(heldCount > 0) {
+        releaseOldest();
+    }
+}
+
+static void resetCounts(void) {
+    heldCount = 0;
+    views = 0;
+    ends = 0;
+    releaseInCallback = false;
+}
+
+static void getStats(EasyLink_Stats* stats) {
+    CHECK(EasyLink_getStats(stats) == EasyLink_Status_Success);
+}
+
+/* Every entry is lent once, with its own packet */
+static void testLend(void) {
+    EasyLink_RxView view;
+    uint8_t seq;
+    uint8_t i;
+    uint8_t j;
+
+    resetCounts();
+    CHECK(EasyLink_receiveContinuousViewAsync(rxViewCb, 0) == EasyLink_Status_Success);
+    for(seq = 1; seq <= ENTRIES; seq++) {
+        CHECK(send(seq) == FakeRf_Rx_Stored);
+    }
+    CHECK(heldCount == ENTRIES);
+    for(i = 0; i < heldCount; i++) {
+        CHECK(held[i].payload[0] == i + 1);
+        for(j = i + 1; j < heldCount; j++) {
+            CHECK(held[i].entry != held[j].entry);
+        }
+    }
+
+    //A second release of the same view changes nothing
+    view = held[0];
+    releaseOldest();
+    EasyLink_releaseRxView(&view);
+    CHECK(send(ENTRIES + 1) == FakeRf_Rx_Stored);
+    CHECK(send(ENTRIES + 2) == FakeRf_Rx_BufFull);
+    CHECK(views == ENTRIES + 1);
+
+    CHECK(EasyLink_abort() == EasyLink_Status_Success);
+    CHECK(ends == 1 && endStatus == EasyLink_Status_Aborted);
+    releaseAll();
+}
+
+/* With every entry lent the radio stops, one packet is counted lost */
+static void testStarvation(void) {
+    EasyLink_Stats before;
+    EasyLink_Stats after;
+    uint32_t rxCommands;
+    uint8_t seq;
+
+    resetCounts();
+    getStats(&before);
+    rxCommands = FakeRf_posted(CMD_PROP_RX_ADV);
+    CHECK(EasyLink_receiveContinuousViewAsync(rxViewCb, 0) == EasyLink_Status_Success);
+    for(seq = 1; seq <= ENTRIES; seq++) {
+        CHECK(send(seq) == FakeRf_Rx_Stored);
+    }
+    CHECK(FakeRf_activeCommand() == CMD_PROP_RX_ADV);
+
+    CHECK(send(ENTRIES + 1) == FakeRf_Rx_BufFull);
+    CHECK(FakeRf_activeCommand() == 0);
+    for(seq = ENTRIES + 2; seq <= ENTRIES + 5; seq++) {
+        CHECK(send(seq) == FakeRf_Rx_NotListening);
+    }
+    getStats(&after);
+
+    //Not over for the application, only the first packet lost is counted
+    CHECK(ends == 0);
+    CHECK(views == ENTRIES);
+    CHECK(after.rxOk - before.rxOk == ENTRIES);
+    CHECK(after.rxBufFull - before.rxBufFull == 1);
+    CHECK(after.rxErrors - before.rxErrors == 1);
+    CHECK(after.rxAborts == before.rxAborts);
+    CHECK(FakeRf_posted(CMD_PROP_RX_ADV) - rxCommands == 1);
+}
+
+/* The first release starts Rx again, into the entry released */
+static void testRestartOnRelease(void) {
+    EasyLink_Stats before;
+    EasyLink_Stats after;
+    uint32_t rxCommands = FakeRf_posted(CMD_PROP_RX_ADV);
+    uint8_t* released = held[0].entry;
+    uint8_t seq;
+
+    getStats(&before);
+    releaseOldest();
+    CHECK(FakeRf_activeCommand() == CMD_PROP_RX_ADV);
+    CHECK(FakeRf_posted(CMD_PROP_RX_ADV) - rxCommands == 1);
+
+    CHECK(send(20) == FakeRf_Rx_Stored);
+    CHECK(heldCount == ENTRIES && held[ENTRIES - 1].entry == released);
+    CHECK(held[ENTRIES - 1].payload[0] == 20);
+    CHECK(send(21) == FakeRf_Rx_BufFull);
+    CHECK(FakeRf_activeCommand() == 0);
+
+    //Releasing all at once restarts once and every entry takes a packet
+    releaseAll();
+    CHECK(FakeRf_posted(CMD_PROP_RX_ADV) - rxCommands == 2);
+    for(seq = 22; seq < 22 + ENTRIES; seq++) {
+        CHECK(send(seq) == FakeRf_Rx_Stored);
+    }
+    getStats(&after);
+    CHECK(after.rxOk - before.rxOk == 1 + ENTRIES);
+    CHECK(after.rxBufFull - before.rxBufFull == 1);
+    CHECK(ends == 0);
+}
+
+/* Abort while Rx waits for a release ends it without a command to cancel */
+static void testAbortWhileStarved(void) {
+    CHECK(send(40) == FakeRf_Rx_BufFull);
+    CHECK(FakeRf_activeCommand() == 0);
+    CHECK(EasyLink_abort() == EasyLink_Status_Success);
+    CHECK(ends == 1 && endStatus == EasyLink_Status_Aborted);
+
+    //A release after the end does not start Rx again
+    releaseOldest();
+    CHECK(FakeRf_activeCommand() == 0);
+    CHECK(ends == 1);
+}
+
+/* Views kept across the end of Rx join the next Rx when released */
+static void testViewsKeptAcrossRestart(void) {
+    uint8_t kept = heldCount;
+    uint8_t seq;
+
+    CHECK(kept == ENTRIES - 1);
+    resetCounts();
+    heldCount = kept;
+    CHECK(EasyLink_receiveContinuousViewAsync(rxViewCb, 0) == EasyLink_Status_Success);
+    CHECK(send(50) == FakeRf_Rx_Stored);
+    CHECK(send(51) == FakeRf_Rx_BufFull);
+    CHECK(ends == 0 && heldCount == ENTRIES);
+
+    releaseAll();
+    for(seq = 52; seq < 52 + ENTRIES; seq++) {
+        CHECK(send(seq) == FakeRf_Rx_Stored);
+    }
+    CHECK(heldCount == ENTRIES);
+    releaseAll();
+
+    CHECK(EasyLink_abort() == EasyLink_Status_Success);
+    CHECK(ends == 1);
+}
+
+/* Released in the callback, an entry is back before the next packet */
+static void testReleaseInCallback(void) {
+    EasyLink_Stats before;
+    EasyLink_Stats after;
+    uint32_t rxCommands = FakeRf_posted(CMD_PROP_RX_ADV);
+    uint8_t seq;
+
+    resetCounts();
+    releaseInCallback = true;
+    getStats(&before);
+    CHECK(EasyLink_receiveContinuousViewAsync(rxViewCb, 0) == EasyLink_Status_Success);
+    for(seq = 1; seq <= 4 * ENTRIES; seq++) {
+        CHECK(send(seq) == FakeRf_Rx_Stored);
+    }
+    getStats(&after);
+    CHECK(views == 4 * ENTRIES);
+    CHECK(after.rxBufFull == before.rxBufFull);
+    CHECK(FakeRf_posted(CMD_PROP_RX_ADV) - rxCommands == 1);
+
+    CHECK(EasyLink_abort() == EasyLink_Status_Success);
+    CHECK(ends == 1);
+}
+
+int main(void) {
+    EasyLink_Params params;
+
+    FakeRf_reset();
+    EasyLink_Params_init(&params);
+    CHECK(EasyLink_init(&params) == EasyLink_Status_Success);
+
+    testLend();
+    testStarvation();
+    testRestartOnRelease();
+    testAbortWhileStarved();
+    testViewsKeptAcrossRestart();
+    testReleaseInCallback();
+
+    return CHECK_RESULT();
+}
@@ -0,0 +1,354 @@
+/*
+ *  ======== IngestTest.c ========
+ */
+//posix_openpt and friends are not C99
+#define _DEFAULT_SOURCE
+#define _XOPEN_SOURCE 600
+
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "Check.h"
+#include "CentralGen.h"
+#include "Ingest.h"
+#include "IngestQueue.h"
+#include "Serial.h"
+
+/***** Defines *****/
+
+#define APS                 3
+#define TAGS                12
+#define REPORTS             40
+#define MAX_RECORDS         (REPORTS * TAGS)
+#define REPORT_TICKS        (250 * INGEST_RAT_TICKS_PER_MS)
+#define START_TIME          (0xFFFFFFFFu - 5 * REPORT_TICKS)
+#define NS_PER_TICK         250
+
+/***** Type declarations *****/
+
+typedef struct
+{
+    IngestRecord records[MAX_RECORDS];
+    uint32_t count;
+} Collected;
+
+/* What the generator sent, to compare the records with */
+typedef struct
+{
+    uint8_t stream[REPORTS * 2 * UART_FRAME_MAX_SIZE];
+    uint32_t len;
+    uint16_t reportEnd[REPORTS];
+    Uplink_Measure measures[MAX_RECORDS];
+    uint8_t apIds[MAX_RECORDS];
+    uint64_t rxTimes[MAX_RECORDS];
+    uint32_t count;
+} Sent;
+
+/***** Variable declarations *****/
+
+static Collected collected;
+static Sent sent;
+
+/***** Function definitions *****/
+
+static int collect(void* arg, const IngestRecord* record) {
+    Collected* c = arg;
+
+    if(c->count == MAX_RECORDS) {
+        return 0;
+    }
+    c->records[c->count++] = *record;
+
+    return 1;
+}
+
+/* The 'y', then REPORTS timed reports with a status frame after the tenth */
+static void generate(void) {
+    CentralGen gen;
+    uint32_t time = START_TIME;
+    uint64_t unwrapped = START_TIME;
+    uint8_t count;
+    uint8_t i;
+    uint8_t r;
+
+    memset(&sent, 0, sizeof(sent));
+    CentralGen_init(&gen, APS, TAGS, INGEST_FORMAT_BINARY);
+    sent.len = CentralGen_start(&gen, sent.stream);
+    for(r = 0; r < REPORTS; r++) {
+        time += REPORT_TICKS;
+        unwrapped += REPORT_TICKS;
+        sent.len += CentralGen_report(&gen, &sent.stream[sent.len], time,
+                &sent.measures[sent.count], &count);
+        for(i = 0; i < count; i++) {
+            sent.apIds[sent.count + i] = (uint8_t)(r % APS + 1);
+            sent.rxTimes[sent.count + i] = unwrapped;
+        }
+        sent.count += count;
+        if(r == 10) {
+            sent.len += CentralGen_status(&gen, &sent.stream[sent.len]);
+        }
+        sent.reportEnd[r] = (uint16_t)sent.len;
+    }
+}
+
+static void checkCollected(void) {
+    const IngestRecord* record;
+    const Uplink_Measure* m;
+    uint32_t i;
+
+    CHECK(collected.count == sent.count);
+    for(i = 0; i < collected.count && i < sent.count; i++) {
+        record = &collected.records[i];
+        m = &sent.measures[i];
+        CHECK(record->apId == sent.apIds[i]);
+        CHECK(record->flags == CENTRALGEN_FLAGS);
+        CHECK(record->measure.id == m->id);
+        CHECK(record->measure.rssi == m->rssi);
+        CHECK(record->measure.delta == m->delta);
+        CHECK(record->measure.distance == m->distance);
+        CHECK(record->measure.beaconsLost == m->beaconsLost);
+        CHECK(record->rxTime == sent.rxTimes[i]);
+        CHECK(record->time == (int64_t)sent.rxTimes[i] -
+                (int64_t)m->delta * INGEST_DELTA_TIME_UNIT_MS * INGEST_RAT_TICKS_PER_MS);
+    }
+}
+
+static void testUnwrap(void) {
+    IngestClock clock;
+    uint64_t host = 1000000000u;
+
+    memset(&clock, 0, sizeof(clock));
+    CHECK(Ingest_unwrapTime(&clock, 0xFFFFF000u, host) == 0xFFFFF000u);
+
+    //Across the wrap
+    host += 0x1100 * NS_PER_TICK;
+    CHECK(Ingest_unwrapTime(&clock, 0x100, host) == 0x100000100ull);
+
+    //Two wraps and a bit without a report, the host clock tells them apart
+    host += (2 * 0x100000000ull + 0x200) * NS_PER_TICK + 5000000;
+    CHECK(Ingest_unwrapTime(&clock, 0x300 + 5000000 / NS_PER_TICK, host) ==
+            0x300000300ull + 5000000 / NS_PER_TICK);
+
+    //Serial latency makes the host clock run a little ahead or behind
+    host += 1000 * NS_PER_TICK + 3000000;
+    CHECK(Ingest_unwrapTime(&clock, 0x300 + 5000000 / NS_PER_TICK + 1000, host) ==
+            0x300000300ull + 5000000 / NS_PER_TICK + 1000);
+}
+
+static void testQueue(void) {
+    IngestRecord records[4];
+    IngestRecord record;
+    IngestQueue queue;
+    uint8_t i;
+
+    CHECK(IngestQueue_init(&queue, records, 3) == -1);
+    CHECK(IngestQueue_init(&queue, records, 4) == 0);
+    CHECK(!IngestQueue_pop(&queue, &record));
+
+    memset(&record, 0, sizeof(record));
+    for(i = 0; i < 5; i++) {
+        record.apId = i;
+        CHECK(IngestQueue_push(&queue, &record) == (i < 4));
+    }
+    CHECK(atomic_load(&queue.drops) == 1);
+
+    for(i = 0; i < 4; i++) {
+        CHECK(IngestQueue_pop(&queue, &record));
+        CHECK(record.apId == i);
+    }
+    CHECK(!IngestQueue_pop(&queue, &record));
+}
+
+static void testFeed(void) {
+    IngestDevice device;
+    uint64_t host = 0;
+    uint32_t pos;
+    uint32_t len;
+
+    //Odd sized reads split frames anywhere
+    Ingest_deviceInit(&device, 0, INGEST_FORMAT_BINARY);
+    memset(&collected, 0, sizeof(collected));
+    for(pos = 0; pos < sent.len; pos += len) {
+        len = (sent.len - pos < 7) ? sent.len - pos : 7;
+        host += (uint64_t)REPORT_TICKS * NS_PER_TICK / 20;
+        CHECK(Ingest_feed(&device, &sent.stream[pos], len, host, collect, &collected) == 0);
+    }
+    checkCollected();
+    CHECK(device.stats.bytes == sent.len);
+    CHECK(device.stats.reports == REPORTS);
+    CHECK(device.stats.otherFrames == 1);
+    CHECK(device.stats.seqGaps == 0);
+    CHECK(device.decoder.crcErrors == 0);
+
+    //A report lost on the serial link and a corrupted one
+    Ingest_deviceInit(&device, 1, INGEST_FORMAT_BINARY);
+    memset(&collected, 0, sizeof(collected));
+    Ingest_feed(&device, sent.stream, sent.reportEnd[0], 0, collect, &collected);
+    sent.stream[sent.reportEnd[1] + 10] ^= 0x01;
+    Ingest_feed(&device, &sent.stream[sent.reportEnd[1]],
+            sent.reportEnd[3] - sent.reportEnd[1], 0, collect, &collected);
+    sent.stream[sent.reportEnd[1] + 10] ^= 0x01;
+    CHECK(device.stats.reports == 2);
+    CHECK(device.stats.seqGaps == 2);
+    CHECK(device.decoder.crcErrors == 1);
+    CHECK(collected.records[TAGS].device == 1);
+}
+
+/* The text records of the central's default build, dated on the host clock */
+static void testText(void) {
+    //AP 7, no optional fields: tag 5 at 71 dB two seconds ago, tag 300 is no byte
+    const char plain[] = "y007;005;071;000002;.";
+    const char badByte[] = "007;300;071;000002;.";
+    const char badWidth[] = "007;05;071;000002;.";
+    const char noise[] = "007;005;0x71;000002;.";
+    static uint8_t stream[REPORTS * CENTRALGEN_MAX_REPORT_SIZE + 1];
+    uint64_t hostNs[REPORTS];
+    Uplink_Measure measures[MAX_RECORDS];
+    const IngestRecord* record;
+    const Uplink_Measure* m;
+    IngestDevice device;
+    CentralGen gen;
+    uint64_t host = 1000000000u;
+    uint32_t reportEnd[REPORTS];
+    uint32_t len = 0;
+    uint32_t pos = 0;
+    uint32_t count = 0;
+    uint32_t n;
+    uint32_t i;
+    uint8_t r = 0;
+    uint8_t got;
+
+    CentralGen_init(&gen, APS, TAGS, INGEST_FORMAT_TEXT);
+    len = CentralGen_start(&gen, stream);
+    for(r = 0; r < REPORTS; r++) {
+        len += CentralGen_report(&gen, &stream[len], 0, &measures[count], &got);
+        count += got;
+        reportEnd[r] = len;
+        CHECK(CentralGen_status(&gen, &stream[len]) == 0);
+    }
+
+    //Odd sized reads, the host time moving on between them
+    Ingest_deviceInit(&device, 0, INGEST_FORMAT_TEXT);
+    memset(&collected, 0, sizeof(collected));
+    for(r = 0; pos < len; pos += n) {
+        n = (len - pos < 11) ? len - pos : 11;
+        host += 1000000;
+        Ingest_feed(&device, &stream[pos], n, host, collect, &collected);
+        while(r < REPORTS && reportEnd[r] <= pos + n) {
+            hostNs[r++] = host;
+        }
+    }
+    CHECK(device.stats.bytes == len);
+    CHECK(device.stats.reports == REPORTS);
+    CHECK(device.stats.badFrames == 0);
+    CHECK(collected.count == count);
+    for(i = 0; i < collected.count && i < count; i++) {
+        record = &collected.records[i];
+        m = &measures[i];
+        r = (uint8_t)(i / TAGS);
+        CHECK(record->apId == r % APS + 1);
+        CHECK(record->flags == INGEST_TEXT_FLAGS);
+        CHECK(record->measure.id == m->id);
+        CHECK(record->measure.rssi == m->rssi);
+        CHECK(record->measure.delta == m->delta);
+        CHECK(record->measure.rssiMin == m->rssiMin);
+        CHECK(record->measure.rssiMax == m->rssiMax);
+        CHECK(record->measure.rssiVariance == m->rssiVariance);
+        CHECK(record->measure.distance == m->distance);
+        CHECK(record->measure.beacons == m->beacons);
+        CHECK(record->measure.beaconsLost == m->beaconsLost);
+        CHECK(record->hostNs == hostNs[r]);
+        CHECK(record->rxTime == hostNs[r] / NS_PER_TICK);
+        CHECK(record->time == (int64_t)record->rxTime -
+                (int64_t)m->delta * INGEST_DELTA_TIME_UNIT_MS * INGEST_RAT_TICKS_PER_MS);
+    }
+
+    //The fields present are told from their widths
+    Ingest_deviceInit(&device, 2, INGEST_FORMAT_TEXT);
+    memset(&collected, 0, sizeof(collected));
+    Ingest_feed(&device, (const uint8_t*)plain, sizeof(plain) - 1, host, collect, &collected);
+    CHECK(collected.count == 1);
+    record = &collected.records[0];
+    CHECK(record->device == 2 && record->apId == 7 && record->flags == 0);
+    CHECK(record->measure.id == 5 && record->measure.rssi == 71 && record->measure.delta == 2);
+    CHECK(device.stats.badFrames == 0);
+
+    //Each bad record is counted and skipped, the next one still read
+    Ingest_feed(&device, (const uint8_t*)badByte, sizeof(badByte) - 1, host, collect, &collected);
+    Ingest_feed(&device, (const uint8_t*)badWidth, sizeof(badWidth) - 1, host, collect, &collected);
+    Ingest_feed(&device, (const uint8_t*)noise, sizeof(noise) - 1, host, collect, &collected);
+    //The noise ends its record, the rest of it is a bad record of its own
+    CHECK(device.stats.badFrames == 4);
+    Ingest_feed(&device, (const uint8_t*)&plain[1], sizeof(plain) - 2, host, collect, &collected);
+    CHECK(collected.count == 2);
+    CHECK(device.stats.reports == 2);
+}
+
+/* The generator's bytes through a pseudo-terminal set up like the daemon's */
+static void testPty(void) {
+    IngestDevice device;
+    struct pollfd pfd;
+    uint8_t buf[256];
+    uint64_t host = 0;
+    uint32_t written = 0;
+    uint32_t end;
+    uint8_t r = 0;
+    ssize_t n;
+    int master;
+    int slave;
+
+    master = posix_openpt(O_RDWR | O_NOCTTY);
+    CHECK(master >= 0);
+    if(master < 0) {
+        return;
+    }
+    CHECK(grantpt(master) == 0 && unlockpt(master) == 0);
+    slave = Serial_open(ptsname(master), O_NONBLOCK);
+    CHECK(slave >= 0);
+    if(slave < 0) {
+        close(master);
+        return;
+    }
+
+    Ingest_deviceInit(&device, 0, INGEST_FORMAT_BINARY);
+    memset(&collected, 0, sizeof(collected));
+    pfd.fd = slave;
+    pfd.events = POLLIN;
+
+    //One report at a time, well within what the terminal buffers
+    while(r < REPORTS) {
+        end = sent.reportEnd[r];
+        CHECK(write(master, &sent.stream[written], end - written) == (ssize_t)(end - written));
+        written = end;
+        host += (uint64_t)REPORT_TICKS * NS_PER_TICK;
+
+        while(device.stats.bytes < written && poll(&pfd, 1, 1000) > 0) {
+            while((n = read(slave, buf, sizeof(buf))) > 0) {
+                Ingest_feed(&device, buf, (uint32_t)n, host, collect, &collected);
+            }
+        }
+        CHECK(device.stats.bytes == written);
+        if(device.stats.bytes != written) {
+            break;
+        }
+        r++;
+    }
+    checkCollected();
+
+    close(slave);
+    close(master);
+}
+
+int main(void) {
+    generate();
+    testUnwrap();
+    testQueue();
+    testFeed();
+    testText();
+    testPty();
+
+    return CHECK_RESULT();
+}
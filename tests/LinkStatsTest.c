@@ -0,0 +1,82 @@
+/*
+ *  ======== LinkStatsTest.c ========
+ */
+#include "Check.h"
+#include "LinkStats.h"
+
+/***** Function definitions *****/
+
+/* Counts a packet after one with lastSeq, returns the packets lost */
+static uint8_t next(LinkStats* stats, uint8_t* lastSeq, uint8_t seq) {
+    uint8_t lost = LinkStats_next(stats, *lastSeq, seq);
+
+    *lastSeq = seq;
+    return lost;
+}
+
+static void testGapBuckets(void) {
+    //Gap and the bucket it falls in: 1, 2, 3-4, 5-8, 9-16, 17 or more
+    static const uint8_t gaps[] = {1, 2, 3, 4, 5, 8, 9, 16, 17, 127};
+    static const uint8_t buckets[] = {0, 1, 2, 2, 3, 3, 4, 4, 5, 5};
+    LinkStats stats;
+    uint8_t i;
+
+    for(i = 0; i < sizeof(gaps); i++) {
+        LinkStats_init(&stats);
+        CHECK(LinkStats_next(&stats, 10, (uint8_t)(10 + gaps[i] + 1)) == gaps[i]);
+        CHECK(stats.gaps[buckets[i]] == 1);
+        CHECK(stats.lost == gaps[i]);
+    }
+}
+
+static void testDelivery(void) {
+    LinkStats stats;
+    uint8_t seq = 250;
+    int i;
+
+    LinkStats_init(&stats);
+    LinkStats_first(&stats);
+    CHECK(LinkStats_deliveryPermille(&stats) == 1000);
+
+    //In order across the 8 bit wrap, nothing lost
+    for(i = 0; i < 10; i++) {
+        CHECK(next(&stats, &seq, (uint8_t)(seq + 1)) == 0);
+    }
+    CHECK(stats.received == 11);
+    CHECK(LinkStats_deliveryPermille(&stats) == 1000);
+
+    //9 lost out of 29 sent
+    CHECK(next(&stats, &seq, (uint8_t)(seq + 3)) == 2);
+    CHECK(next(&stats, &seq, (uint8_t)(seq + 8)) == 7);
+    for(i = 0; i < 7; i++) {
+        next(&stats, &seq, (uint8_t)(seq + 1));
+    }
+    CHECK(stats.received == 20);
+    CHECK(stats.lost == 9);
+    CHECK(LinkStats_deliveryPermille(&stats) == 20 * 1000 / 29);
+    CHECK(stats.gaps[1] == 1);
+    CHECK(stats.gaps[3] == 1);
+}
+
+static void testResync(void) {
+    LinkStats stats;
+    uint8_t seq = 40;
+
+    //A restarted sender or a repeated packet is not counted as lost
+    LinkStats_init(&stats);
+    LinkStats_first(&stats);
+    CHECK(next(&stats, &seq, 0) == 0);
+    CHECK(next(&stats, &seq, 0) == 0);
+    CHECK(stats.resyncs == 2);
+    CHECK(stats.lost == 0);
+    CHECK(next(&stats, &seq, 1) == 0);
+    CHECK(stats.received == 4);
+}
+
+int main(void) {
+    testGapBuckets();
+    testDelivery();
+    testResync();
+
+    return CHECK_RESULT();
+}
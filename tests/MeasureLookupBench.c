@@ -0,0 +1,150 @@
+/*
+ *  ======== MeasureLookupBench.c ========
+ *
+ *  Cost of finding a tag's open measure in the AP's TaskManager.c, built as
+ *  is, against the linear scan it replaced, for tag populations of 8 to
+ *  1024. Each tag beacons every BEACON_PERIOD_MS, the beacons go through the
+ *  AP's rxDoneCb and memStack is packed into an uplink whenever it is full,
+ *  as the task does. Before each beacon both lookups are timed on the same
+ *  memStack and must find the same measure.
+ *
+ *  Tag ids are 8 bits, past 256 tags ids are shared as they would be on the
+ *  air. memStack holds BUFFER_SIZE measures, so the scan's cost stops
+ *  growing once it is always full.
+ */
+#include <time.h>
+
+#include "Check.h"
+#include "SimClock.h"
+
+//The AP's TaskManager.c, for the layout of its measures and its statics
+#include "TaskManager.c"
+
+/***** Defines *****/
+
+#define BEACON_PERIOD_MS    100
+#define BEACONS             20000   // Per tag population
+#define REPEATS             16      // Lookups per timing, to hide the clock's cost
+#define MIN_TAGS            8
+#define MAX_TAGS            1024
+
+/***** Variable declarations *****/
+
+static volatile uint8_t lookupId;
+static volatile uintptr_t sink;
+
+/***** Function definitions *****/
+
+/* The lookup before the table: a scan of memStack copying each measure */
+static struct Measure* scanMeasure(uint8_t id, uint32_t local_time) {
+    uint8_t i;
+
+    for(i = 0; i < rx_counter; i++) {
+        struct Measure m = memStack[i];
+        if(m.id == id && m.rssi.count < QT_MEASURES &&
+                RadioClock_elapsed(m.local_time, local_time) <=
+                EasyLink_ms_To_RadioTime(TIME_DELAY * 1000)) {
+            return &memStack[i];
+        }
+    }
+
+    return NULL;
+}
+
+static uint64_t nowNs(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+/* Next pseudo random number, the same run every time */
+static uint32_t nextRandom(uint32_t* state) {
+    *state = *state * 1664525u + 1013904223u;
+
+    return *state >> 8;
+}
+
+static void resetAp(void) {
+    rx_counter = 0;
+    memset(measureTable, 0, sizeof(measureTable));
+    memset(tagSeen, 0, sizeof(tagSeen));
+}
+
+int main(void) {
+    uint8_t dstAddr[EASYLINK_MAX_ADDR_SIZE] = {0xAA};
+    uint8_t payload[EASYLINK_MAX_DATA_LENGTH];
+    uint8_t uplink[EASYLINK_MAX_DATA_LENGTH];
+    uint8_t seqs[MAX_TAGS] = {0};
+    EasyLink_RxView view;
+    uint32_t random = 1;
+    uint32_t time;
+    uint32_t step;
+    uint32_t tags;
+    uint32_t tag;
+    uint32_t i;
+    uint64_t scanNs;
+    uint64_t tableNs;
+    uint64_t occupancy;
+    uint64_t start;
+    uint8_t r;
+    uint32_t mismatches = 0;
+
+    SimClock_init(1, 0);
+    setUpRxSemaphore();
+
+    memset(&view, 0, sizeof(view));
+    view.dstAddr = dstAddr;
+    view.payload = payload;
+    view.rssi = -60;
+
+    printf("%6s %10s %10s %8s %10s\n", "tags", "scan ns", "table ns", "speedup", "occupancy");
+    for(tags = MIN_TAGS; tags <= MAX_TAGS; tags *= 2) {
+        resetAp();
+        scanNs = 0;
+        tableNs = 0;
+        occupancy = 0;
+        time = 0;
+        step = EasyLink_ms_To_RadioTime(BEACON_PERIOD_MS) / tags;
+
+        for(i = 0; i < BEACONS; i++) {
+            tag = nextRandom(&random) % tags;
+            time += step;
+            lookupId = (uint8_t)tag;
+
+            if(scanMeasure(lookupId, time) != findMeasureByIdTimestamp(lookupId, time)) {
+                mismatches++;
+            }
+
+            start = nowNs();
+            for(r = 0; r < REPEATS; r++) {
+                sink += (uintptr_t)scanMeasure(lookupId, time);
+            }
+            scanNs += nowNs() - start;
+
+            start = nowNs();
+            for(r = 0; r < REPEATS; r++) {
+                sink += (uintptr_t)findMeasureByIdTimestamp(lookupId, time);
+            }
+            tableNs += nowNs() - start;
+            occupancy += rx_counter;
+
+            //The beacon itself, then the uplink once memStack is full
+            view.len = Beacon_encode(payload, (uint8_t)tag, seqs[tag]++, 0);
+            view.absTime = time;
+            rxDoneCb(&view, EasyLink_Status_Success);
+            if(rx_counter == BUFFER_SIZE) {
+                packUplink(uplink);
+            }
+        }
+
+        printf("%6u %10.1f %10.1f %7.1fx %10.1f\n", tags,
+                (double)scanNs / BEACONS / REPEATS, (double)tableNs / BEACONS / REPEATS,
+                (double)scanNs / (tableNs ? tableNs : 1), (double)occupancy / BEACONS);
+    }
+
+    CHECK(mismatches == 0);
+
+    return CHECK_RESULT();
+}
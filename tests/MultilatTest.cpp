@@ -0,0 +1,231 @@
+/*
+ *  ======== MultilatTest.cpp ========
+ */
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#include "Check.h"
+#include "Locate.h"
+
+/***** Defines *****/
+
+#define FIXES           1000
+#define RAT_PER_MS      LOCATE_RAT_TICKS_PER_MS
+
+/***** Function definitions *****/
+
+/* Next pseudo random number, the same run every time */
+static uint32_t nextRandom(uint32_t* state) {
+    *state = *state * 1664525u + 1013904223u;
+
+    return *state >> 8;
+}
+
+static float uniform(uint32_t* state, float scale) {
+    return scale * (nextRandom(state) % 10000) / 10000.0f;
+}
+
+/* Exact ranges from 3 to MULTILAT_MAX_APS APs, mixed in one batch */
+static void testExact(void) {
+    Multilat_Anchor anchors[MULTILAT_MAX_APS];
+    Multilat_Batch batch;
+    std::vector<Multilat_Fix> fixes;
+    std::vector<Multilat_Fix> threaded;
+    float tagX[FIXES];
+    float tagY[FIXES];
+    uint32_t random = 1;
+    uint32_t bad = 0;
+    uint8_t count;
+    uint8_t k;
+    int i;
+
+    for(i = 0; i < FIXES; i++) {
+        count = (uint8_t)(3 + i % (MULTILAT_MAX_APS - 2));
+        tagX[i] = uniform(&random, 50);
+        tagY[i] = uniform(&random, 50);
+        for(k = 0; k < count; k++) {
+            //Around the tag so none are collinear by chance
+            anchors[k].x = tagX[i] + 20 * std::cos(6.2831853f * (k + uniform(&random, 0.5f)) / count);
+            anchors[k].y = tagY[i] + 20 * std::sin(6.2831853f * (k + uniform(&random, 0.5f)) / count);
+            anchors[k].range = std::hypot(tagX[i] - anchors[k].x, tagY[i] - anchors[k].y);
+        }
+        CHECK(batch.add((uint8_t)i, i * 10, anchors, count));
+    }
+    CHECK(batch.size() == FIXES);
+
+    Multilat_solve(batch, fixes, 1);
+    CHECK(fixes.size() == FIXES);
+    for(i = 0; i < FIXES; i++) {
+        if(!fixes[i].ok || std::fabs(fixes[i].x - tagX[i]) > 0.01f ||
+                std::fabs(fixes[i].y - tagY[i]) > 0.01f || fixes[i].rms > 0.01f ||
+                fixes[i].tag != (uint8_t)i || fixes[i].time != i * 10 ||
+                fixes[i].aps != 3 + i % (MULTILAT_MAX_APS - 2)) {
+            bad++;
+        }
+    }
+    CHECK(bad == 0);
+
+    //Split over threads, the same fixes
+    Multilat_solve(batch, threaded, 3);
+    CHECK(threaded.size() == FIXES);
+    CHECK(memcmp(threaded.data(), fixes.data(), FIXES * sizeof(Multilat_Fix)) == 0);
+
+    batch.clear();
+    CHECK(batch.size() == 0);
+}
+
+/* A range too long or short moves the fix, the residual shows it */
+static void testNoisy(void) {
+    const Multilat_Anchor anchors[4] = {{0, 0, 10}, {20, 0, 10}, {20, 20, 0}, {0, 20, 0}};
+    Multilat_Anchor noisy[4];
+    Multilat_Batch batch;
+    std::vector<Multilat_Fix> fixes;
+    uint8_t k;
+
+    //The tag at (10, 10)
+    for(k = 0; k < 4; k++) {
+        noisy[k] = anchors[k];
+        noisy[k].range = std::sqrt(200.0f);
+    }
+    noisy[0].range *= 1.3f;
+    CHECK(batch.add(1, 0, noisy, 4));
+    Multilat_solve(batch, fixes, 1);
+    CHECK(fixes[0].ok);
+    CHECK(std::hypot(fixes[0].x - 10, fixes[0].y - 10) < 3);
+    CHECK(fixes[0].rms > 0.1f);
+}
+
+static void testCollinear(void) {
+    const Multilat_Anchor line[3] = {{0, 0, 5}, {10, 0, 5}, {20, 0, 15}};
+    const Multilat_Anchor few[2] = {{0, 0, 5}, {10, 0, 5}};
+    Multilat_Batch batch;
+    std::vector<Multilat_Fix> fixes;
+
+    CHECK(!batch.add(1, 0, few, 2));
+    CHECK(batch.add(1, 0, line, 3));
+    Multilat_solve(batch, fixes, 1);
+    CHECK(!fixes[0].ok);
+}
+
+static void testParseCsv(void) {
+    Locate_Record record;
+
+    CHECK(!Locate_parseCsv("host_ns,device,ap,uplink_seq,tag,rssi,time,rx_time,delta,"
+            "rssi_min,rssi_max,rssi_var,distance,beacons,beacons_lost\n", &record));
+    CHECK(Locate_parseCsv("123,0,7,9,42,-71,-4000,8000,3,-68,-75,4,1234,10,0\n", &record));
+    CHECK(record.apId == 7 && record.tag == 42 && record.rssi == 71);
+    CHECK(record.time == -4000);
+    CHECK(record.hasDistance && record.distance == 1234);
+
+    //Fields the uplink didn't carry are empty
+    CHECK(Locate_parseCsv("123,0,7,9,42,-71,4000,8000,0,,,,,,\n", &record));
+    CHECK(!record.hasDistance && record.time == 4000);
+
+    CHECK(!Locate_parseCsv("123,0,7,9,42,-71,4000,8000,0,,,,,\n", &record));
+    CHECK(!Locate_parseCsv("123,0,300,9,42,-71,4000,8000,0,,,,,,\n", &record));
+    CHECK(!Locate_parseCsv("123,0,7,9,42,71,4000,8000,0,,,,,,\n", &record));
+}
+
+static void testRange(void) {
+    const Locate_RangeModel model = LOCATE_RANGE_MODEL_DEFAULT;
+    Locate_Record record;
+
+    memset(&record, 0, sizeof(record));
+    record.rssi = model.rssi1m;
+    CHECK(std::fabs(Locate_range(model, record) - 1) < 1e-4f);
+    record.rssi = (uint8_t)(model.rssi1m + 10 * model.pathLoss + 0.5f);
+    CHECK(std::fabs(Locate_range(model, record) - 10) < 0.5f);
+
+    //The AP's distance over the RSSI
+    record.hasDistance = true;
+    record.distance = 250;
+    CHECK(std::fabs(Locate_range(model, record) - 2.5f) < 1e-4f);
+}
+
+static void testLayout(void) {
+    const char good[] = "# ap x y\n1 0 0\n2 15.5 0 # corner\n\n  3 0 -2.5\n";
+    const char bad[] = "1 0 0\n2 15\n";
+    Locate_ApLayout layout;
+    std::string error;
+    FILE* file;
+    float x;
+    float y;
+
+    file = fmemopen((void*)good, sizeof(good) - 1, "r");
+    CHECK(layout.load(file, &error));
+    fclose(file);
+    CHECK(layout.size() == 3);
+    CHECK(layout.find(2, &x, &y) && x == 15.5f && y == 0);
+    CHECK(layout.find(3, &x, &y) && y == -2.5f);
+    CHECK(!layout.find(4, &x, &y));
+
+    file = fmemopen((void*)bad, sizeof(bad) - 1, "r");
+    CHECK(!layout.load(file, &error));
+    fclose(file);
+    CHECK(error.find("line 2") == 0);
+}
+
+static void testGrouper(void) {
+    const int64_t window = 1000 * RAT_PER_MS;
+    Locate_ApLayout layout;
+    Multilat_Batch batch;
+    Locate_Record record;
+    uint8_t a;
+
+    layout.set(1, 0, 0);
+    layout.set(2, 20, 0);
+    layout.set(3, 0, 20);
+    layout.set(4, 20, 20);
+    Locate_Grouper grouper(layout, window, 3);
+
+    memset(&record, 0, sizeof(record));
+    record.tag = 5;
+    for(a = 1; a <= 2; a++) {
+        record.apId = a;
+        record.time = a * 100 * RAT_PER_MS;
+        CHECK(grouper.add(record, 10));
+    }
+    //Two APs are no fix
+    CHECK(grouper.flush(300 * RAT_PER_MS, batch) == 0);
+
+    record.apId = 9;
+    CHECK(!grouper.add(record, 10));
+
+    record.apId = 3;
+    record.time = 300 * RAT_PER_MS;
+    CHECK(grouper.add(record, 10));
+    CHECK(grouper.flush(300 * RAT_PER_MS, batch) == 1);
+    CHECK(batch.tags[0] == 5 && batch.counts[0] == 3);
+    CHECK(batch.times[0] == 300 * RAT_PER_MS);
+
+    //Not heard since, no fix
+    CHECK(grouper.flush(400 * RAT_PER_MS, batch) == 0);
+
+    //An older uplink of an AP doesn't replace its range
+    record.apId = 3;
+    record.time = 250 * RAT_PER_MS;
+    CHECK(grouper.add(record, 99));
+    CHECK(grouper.flush(400 * RAT_PER_MS, batch) == 1);
+    CHECK(batch.range[2][1] == 10);
+
+    //AP 1 at 100 ms leaves the window, AP 4 comes in
+    record.apId = 4;
+    record.time = 1150 * RAT_PER_MS;
+    CHECK(grouper.add(record, 10));
+    CHECK(grouper.flush(1150 * RAT_PER_MS, batch) == 1);
+    CHECK(batch.counts[2] == 3);
+    CHECK(batch.ax[0][2] == 20 && batch.ay[2][2] == 20);
+}
+
+int main(void) {
+    testExact();
+    testNoisy();
+    testCollinear();
+    testParseCsv();
+    testRange();
+    testLayout();
+    testGrouper();
+
+    return CHECK_RESULT();
+}
@@ -0,0 +1,123 @@
+/*
+ *  ======== RadioClockTest.c ========
+ *
+ *  RadioClock.c with EasyLink_getAbsTime from the simulation, whose radio
+ *  time can start right before the 32 bit RAT wraps. Also prints what each
+ *  call costs next to time() and localtime(), which the AP used before.
+ */
+//localtime_r is not C99
+#define _DEFAULT_SOURCE
+
+#include <time.h>
+
+#include "Check.h"
+#include "RadioClock.h"
+#include "SimClock.h"
+
+/***** Defines *****/
+
+#define RAT_PER_MS      (SIMCLOCK_RAT_HZ / 1000)
+#define CALLS           1000000
+
+/***** Variable declarations *****/
+
+static volatile uint32_t sink;
+
+/***** Function definitions *****/
+
+static void testElapsed(void) {
+    CHECK(RadioClock_elapsed(100, 350) == 250);
+    CHECK(RadioClock_elapsed(5, 5) == 0);
+
+    //Across the wrap
+    CHECK(RadioClock_elapsed(0xFFFFFF00u, 0x100) == 0x200);
+    CHECK(RadioClock_elapsed(0xFFFFFFFFu, 0) == 1);
+
+    //Longest interval that is still right
+    CHECK(RadioClock_elapsed(0x80000000u, 0x7FFFFFFFu) == 0xFFFFFFFFu);
+}
+
+static void testDelta(void) {
+    CHECK(RadioClock_delta(0, 999 * RAT_PER_MS, 1000) == 0);
+    CHECK(RadioClock_delta(0, 1000 * RAT_PER_MS, 1000) == 1);
+    CHECK(RadioClock_delta(0, 2500 * RAT_PER_MS, 100) == 25);
+
+    //Across the wrap, as TaskManager.c packs an old measure
+    CHECK(RadioClock_delta(0xFFFFFFFFu - 3000 * RAT_PER_MS + 1, 2000 * RAT_PER_MS, 1000) == 5);
+
+    //Saturated to 16 bits, 0xFFFFFFFF RAT ticks is 1073741 ms
+    CHECK(RadioClock_delta(0, 0xFFFFFFFFu, 1) == 0xFFFF);
+    CHECK(RadioClock_delta(0, 0xFFFFFFFFu, 1000) == 1073);
+}
+
+static void testNow(void) {
+    uint32_t before;
+    uint32_t after;
+
+    //Radio time starts 50 ms before the wrap, 100 ms later it is past it
+    SimClock_init(1, 0xFFFFFFFFu - 50 * RAT_PER_MS);
+    before = RadioClock_now();
+    SimClock_sleepUntil(SimClock_now() + 100 * RAT_PER_MS);
+    after = RadioClock_now();
+
+    CHECK(before > 0xFFFFFFFFu - 50 * RAT_PER_MS - 1);
+    CHECK(after < before);
+    CHECK(RadioClock_elapsed(before, after) >= 100 * RAT_PER_MS);
+    CHECK(RadioClock_elapsed(before, after) < 1000 * RAT_PER_MS);
+}
+
+static uint64_t nowNs(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static void printCost(const char* name, uint64_t ns) {
+    printf("%-22s %6.1f ns per call\n", name, (double)ns / CALLS);
+}
+
+static void measureCost(void) {
+    struct tm tm;
+    time_t t;
+    uint64_t start;
+    uint32_t i;
+
+    start = nowNs();
+    for(i = 0; i < CALLS; i++) {
+        sink += RadioClock_now();
+    }
+    printCost("RadioClock_now", nowNs() - start);
+
+    start = nowNs();
+    for(i = 0; i < CALLS; i++) {
+        sink += RadioClock_elapsed(sink, i);
+    }
+    printCost("RadioClock_elapsed", nowNs() - start);
+
+    start = nowNs();
+    for(i = 0; i < CALLS; i++) {
+        sink += RadioClock_delta(sink, i * RAT_PER_MS, 1000);
+    }
+    printCost("RadioClock_delta", nowNs() - start);
+
+    //What the AP did per packet and per measure before
+    start = nowNs();
+    for(i = 0; i < CALLS; i++) {
+        t = time(NULL);
+        localtime_r(&t, &tm);
+        sink += tm.tm_sec + 60 * (tm.tm_min + 60 * (tm.tm_hour + 24 * (tm.tm_mday +
+                30 * tm.tm_mon)));
+    }
+    printCost("time and localtime_r", nowNs() - start);
+}
+
+int main(void) {
+    testElapsed();
+    testDelta();
+    testNow();
+    measureCost();
+
+    return CHECK_RESULT();
+}
@@ -0,0 +1,167 @@
+/*
+ *  ======== RingBufferStressTest.c ========
+ *
+ *  A producer and a consumer thread on one RingBuffer, as rxDoneCb and the
+ *  UART task share memRing. Every record the producer offers is stamped
+ *  with the number of the offer and filled from it, so the consumer sees a
+ *  torn record as bad bytes, a lost one as a gap not counted as a drop and
+ *  reordering as a number going back.
+ */
+//clock_gettime and sched_yield are not C99
+#define _DEFAULT_SOURCE
+
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include <time.h>
+
+#include "Check.h"
+#include "RingBuffer.h"
+
+/***** Defines *****/
+
+#define SLOT_SIZE       32
+#define SLOT_COUNT      16
+#define OFFERS          2000000
+#define SEQ_SIZE        4
+
+/***** Variable declarations *****/
+
+static uint8_t storage[SLOT_COUNT][SLOT_SIZE];
+static uint16_t lengths[SLOT_COUNT];
+static RingBuffer ring;
+
+/* Producer side */
+static uint32_t published = 0;
+static uint32_t refused = 0;
+static volatile int producerDone = 0;
+
+/* Consumer side */
+static uint32_t received = 0;
+static uint32_t gaps = 0;
+static uint32_t reordered = 0;
+static uint32_t torn = 0;
+static uint32_t nextSeq = 0;
+
+/***** Function definitions *****/
+
+/* Record length and contents follow from the offer number alone */
+static uint16_t recordLen(uint32_t seq) {
+    return SEQ_SIZE + seq % (SLOT_SIZE - SEQ_SIZE + 1);
+}
+
+static uint8_t recordByte(uint32_t seq, uint16_t i) {
+    return (uint8_t)(seq * 31 + i * 7);
+}
+
+static void* producer(void* arg) {
+    uint8_t* slot;
+    uint32_t seq;
+    uint16_t len;
+    uint16_t i;
+
+    (void)arg;
+    for(seq = 0; seq < OFFERS; seq++) {
+        slot = RingBuffer_reserve(&ring);
+        if(slot == NULL) {
+            //Lets the consumer catch up, as the radio leaves gaps between packets
+            refused++;
+            sched_yield();
+            continue;
+        }
+        len = recordLen(seq);
+        memcpy(slot, &seq, SEQ_SIZE);
+        for(i = SEQ_SIZE; i < len; i++) {
+            slot[i] = recordByte(seq, i);
+        }
+        RingBuffer_commit(&ring, len);
+        published++;
+    }
+    producerDone = 1;
+
+    return NULL;
+}
+
+static void* consumer(void* arg) {
+    uint8_t* slot;
+    uint32_t seq;
+    uint16_t len;
+    uint16_t i;
+
+    (void)arg;
+    while(1) {
+        slot = RingBuffer_peek(&ring, &len);
+        if(slot == NULL) {
+            //Done once nothing is left after the producer's last commit
+            if(producerDone && RingBuffer_count(&ring) == 0) {
+                break;
+            }
+            //As the UART task pends on its semaphore
+            sched_yield();
+            continue;
+        }
+
+        memcpy(&seq, slot, SEQ_SIZE);
+        if(seq < nextSeq) {
+            reordered++;
+        } else {
+            gaps += seq - nextSeq;
+        }
+        if(len != recordLen(seq)) {
+            torn++;
+        } else {
+            for(i = SEQ_SIZE; i < len; i++) {
+                if(slot[i] != recordByte(seq, i)) {
+                    torn++;
+                    break;
+                }
+            }
+        }
+        nextSeq = seq + 1;
+        RingBuffer_release(&ring);
+        received++;
+
+        //Falls behind now and then so that the ring also fills up
+        if((received & 0xFFF) == 0) {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+int main(void) {
+    struct timespec start;
+    struct timespec end;
+    pthread_t producerThread;
+    pthread_t consumerThread;
+    double seconds;
+
+    RingBuffer_init(&ring, &storage[0][0], lengths, SLOT_SIZE, SLOT_COUNT);
+    //Counters wrap during the run
+    ring.head = 0xFFFFFF00u;
+    ring.tail = 0xFFFFFF00u;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    CHECK(pthread_create(&consumerThread, NULL, consumer, NULL) == 0);
+    CHECK(pthread_create(&producerThread, NULL, producer, NULL) == 0);
+    pthread_join(producerThread, NULL);
+    pthread_join(consumerThread, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    //Every offer is either received in order and intact or counted as a drop
+    CHECK(published + refused == OFFERS);
+    CHECK(ring.drops == refused);
+    CHECK(received == published);
+    //Gaps in the numbers, up to the last offer, are exactly the drops
+    CHECK(gaps + (OFFERS - nextSeq) == refused);
+    CHECK(reordered == 0);
+    CHECK(torn == 0);
+    CHECK(RingBuffer_count(&ring) == 0);
+
+    seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    printf("%u offers: %u received, %u dropped, %.1f M offers/s\n", OFFERS, received,
+            refused, OFFERS / seconds / 1e6);
+
+    return CHECK_RESULT();
+}
@@ -0,0 +1,114 @@
+/*
+ *  ======== RingBufferTest.c ========
+ */
+#include <string.h>
+
+#include "Check.h"
+#include "RingBuffer.h"
+
+/***** Defines *****/
+
+#define SLOT_SIZE   8
+#define SLOT_COUNT  4
+
+/***** Variable declarations *****/
+
+static uint8_t storage[SLOT_COUNT][SLOT_SIZE];
+static uint16_t lengths[SLOT_COUNT];
+static RingBuffer ring;
+
+/***** Function definitions *****/
+
+/* Publishes a record of len bytes all set to value, returns 0 if full */
+static int put(uint8_t value, uint16_t len) {
+    uint8_t* slot = RingBuffer_reserve(&ring);
+
+    if(slot == NULL) {
+        return 0;
+    }
+    memset(slot, value, len);
+    RingBuffer_commit(&ring, len);
+
+    return 1;
+}
+
+/* Checks the oldest record is len bytes of value and releases it */
+static void get(uint8_t value, uint16_t len) {
+    uint16_t got = 0;
+    uint8_t* slot = RingBuffer_peek(&ring, &got);
+    uint16_t i;
+
+    CHECK(slot != NULL);
+    if(slot == NULL) {
+        return;
+    }
+    CHECK(got == len);
+    for(i = 0; i < len; i++) {
+        CHECK(slot[i] == value);
+    }
+    RingBuffer_release(&ring);
+}
+
+static void testFifo(void) {
+    uint16_t len;
+
+    RingBuffer_init(&ring, &storage[0][0], lengths, SLOT_SIZE, SLOT_COUNT);
+    CHECK(RingBuffer_peek(&ring, &len) == NULL);
+
+    CHECK(put(1, 1));
+    CHECK(put(2, 2));
+    CHECK(RingBuffer_count(&ring) == 2);
+    get(1, 1);
+    CHECK(put(3, 8));
+    get(2, 2);
+    get(3, 8);
+    CHECK(RingBuffer_count(&ring) == 0);
+    CHECK(RingBuffer_peek(&ring, &len) == NULL);
+}
+
+static void testFullDrops(void) {
+    uint8_t i;
+
+    RingBuffer_init(&ring, &storage[0][0], lengths, SLOT_SIZE, SLOT_COUNT);
+    for(i = 0; i < SLOT_COUNT; i++) {
+        CHECK(put(i, i + 1));
+    }
+
+    //Full: the new records are dropped, the queued ones are kept
+    CHECK(!put(0xAA, 1));
+    CHECK(!put(0xBB, 1));
+    CHECK(ring.drops == 2);
+
+    for(i = 0; i < SLOT_COUNT; i++) {
+        get(i, i + 1);
+    }
+    CHECK(put(0xCC, 3));
+    get(0xCC, 3);
+    CHECK(ring.drops == 2);
+}
+
+static void testCounterWrap(void) {
+    uint32_t n;
+
+    //Free running counters about to wrap around
+    RingBuffer_init(&ring, &storage[0][0], lengths, SLOT_SIZE, SLOT_COUNT);
+    ring.head = 0xFFFFFFFEu;
+    ring.tail = 0xFFFFFFFEu;
+
+    for(n = 0; n < 3 * SLOT_COUNT; n++) {
+        CHECK(put((uint8_t)n, 4));
+        CHECK(put((uint8_t)(n + 100), 5));
+        get((uint8_t)n, 4);
+        get((uint8_t)(n + 100), 5);
+    }
+    CHECK(RingBuffer_count(&ring) == 0);
+    CHECK(ring.drops == 0);
+}
+
+int main(void) {
+    testFifo();
+    testFullDrops();
+    testCounterWrap();
+
+    return CHECK_RESULT();
+}
@@ -0,0 +1,163 @@
+/*
+ *  ======== RssiEstimatorBench.c ========
+ *
+ *  Cost of the AP's per-tag RSSI statistics over one measure's cycle, its
+ *  samples folded in as beacons come and the statistics read out when the
+ *  uplink is packed, against the fixed array of QT_MEASURES samples it
+ *  replaced, averaged again at each pack. Prints ns per update and per
+ *  measure for measures of 1 to 255 samples. The array could not hold more
+ *  than QT_MEASURES, the estimator's update must cost the same however many
+ *  samples it has taken.
+ *
+ *  The samples come from a recorded-like trace: a tag walking away from the
+ *  AP with fading and a reflection now and then.
+ */
+#include <time.h>
+
+#include "Check.h"
+#include "RssiEstimator.h"
+
+/***** Defines *****/
+
+#define MEASURES        4096    // Measure cycles per timing
+#define TRACE_SAMPLES   4096
+#define QT_MEASURES     10      // Samples the old array held per measure
+
+/***** Type declarations *****/
+
+/* The measure before the estimator, as TaskManager.c kept it */
+typedef struct
+{
+    int8_t rssi[QT_MEASURES];
+    uint8_t counter;
+} ArrayMeasure;
+
+/***** Variable declarations *****/
+
+static int8_t trace[TRACE_SAMPLES];
+static volatile int32_t sink;
+
+/***** Function definitions *****/
+
+static uint64_t nowNs(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+/* Next pseudo random number, the same run every time */
+static uint32_t nextRandom(uint32_t* state) {
+    *state = *state * 1664525u + 1013904223u;
+
+    return *state >> 8;
+}
+
+static void makeTrace(void) {
+    uint32_t random = 1;
+    int32_t rssi;
+    uint32_t i;
+
+    for(i = 0; i < TRACE_SAMPLES; i++) {
+        //-50 dBm falling to -90 dBm, +-4 dB of fading, 1 in 20 a reflection
+        rssi = -50 - (int32_t)(40 * i / TRACE_SAMPLES) + (int32_t)(nextRandom(&random) % 9) - 4;
+        if(nextRandom(&random) % 20 == 0) {
+            rssi += 25;
+        }
+        trace[i] = (int8_t)rssi;
+    }
+}
+
+/* The old addMeasureRssi and getAverageRssi */
+static void arrayAdd(ArrayMeasure* m, int8_t rssi) {
+    m->rssi[m->counter++] = rssi;
+}
+
+static int8_t arrayAverage(const ArrayMeasure* m) {
+    int sum = 0;
+    uint8_t i;
+
+    for(i = 0; i < m->counter; i++) {
+        sum += m->rssi[i];
+    }
+
+    return sum / m->counter;
+}
+
+static uint64_t timeEstimator(uint32_t samples, uint32_t* badMeans) {
+    RssiEstimator e;
+    uint32_t next = 0;
+    uint64_t start = nowNs();
+    uint32_t m;
+    uint32_t s;
+    int8_t mean;
+
+    for(m = 0; m < MEASURES; m++) {
+        RssiEstimator_init(&e);
+        for(s = 0; s < samples; s++) {
+            RssiEstimator_add(&e, trace[next++ % TRACE_SAMPLES]);
+        }
+        mean = RssiEstimator_mean(&e);
+        sink += mean + RssiEstimator_variance(&e) + e.min + e.max;
+        if(mean < e.min || mean > e.max || e.count != samples) {
+            (*badMeans)++;
+        }
+    }
+
+    return nowNs() - start;
+}
+
+static uint64_t timeArray(uint32_t samples) {
+    ArrayMeasure a;
+    uint32_t next = 0;
+    uint64_t start = nowNs();
+    uint32_t m;
+    uint32_t s;
+
+    for(m = 0; m < MEASURES; m++) {
+        a.counter = 0;
+        for(s = 0; s < samples; s++) {
+            arrayAdd(&a, trace[next++ % TRACE_SAMPLES]);
+        }
+        sink += arrayAverage(&a);
+    }
+
+    return nowNs() - start;
+}
+
+int main(void) {
+    static const uint32_t sampleCounts[] = {1, 2, 5, QT_MEASURES, 64, 255};
+    uint32_t badMeans = 0;
+    uint64_t estimatorNs;
+    uint64_t arrayNs;
+    uint32_t samples;
+    uint8_t i;
+
+    makeTrace();
+
+    printf("%u bytes per tag, the array took %u\n", (unsigned)sizeof(RssiEstimator),
+            (unsigned)sizeof(ArrayMeasure));
+    printf("%7s %14s %14s %14s %14s\n", "samples", "est ns/update", "est ns/measure",
+            "arr ns/update", "arr ns/measure");
+    for(i = 0; i < sizeof(sampleCounts) / sizeof(sampleCounts[0]); i++) {
+        samples = sampleCounts[i];
+        estimatorNs = timeEstimator(samples, &badMeans);
+        printf("%7u %14.2f %14.2f", samples, (double)estimatorNs / MEASURES / samples,
+                (double)estimatorNs / MEASURES);
+
+        //Past QT_MEASURES the old array was written out of bounds
+        if(samples <= QT_MEASURES) {
+            arrayNs = timeArray(samples);
+            printf(" %14.2f %14.2f\n", (double)arrayNs / MEASURES / samples,
+                    (double)arrayNs / MEASURES);
+        } else {
+            printf(" %14s %14s\n", "-", "-");
+        }
+    }
+
+    //The mean is a filtered one, it stays within the samples it came from
+    CHECK(badMeans == 0);
+
+    return CHECK_RESULT();
+}
@@ -0,0 +1,111 @@
+/*
+ *  ======== RssiEstimatorTest.c ========
+ */
+#include <stdlib.h>
+
+#include "Check.h"
+#include "RssiEstimator.h"
+
+/***** Function definitions *****/
+
+static void testConstant(void) {
+    RssiEstimator e;
+    int i;
+
+    RssiEstimator_init(&e);
+    CHECK(RssiEstimator_mean(&e) == 0);
+    CHECK(RssiEstimator_variance(&e) == 0);
+
+    for(i = 0; i < 50; i++) {
+        RssiEstimator_add(&e, -70);
+    }
+    CHECK(RssiEstimator_mean(&e) == -70);
+    CHECK(RssiEstimator_variance(&e) == 0);
+    CHECK(e.min == -70 && e.max == -70);
+    CHECK(e.count == 50);
+}
+
+static void testOutlier(void) {
+    RssiEstimator e;
+    int i;
+
+    RssiEstimator_init(&e);
+    for(i = 0; i < 10; i++) {
+        RssiEstimator_add(&e, -80);
+    }
+
+    //A single reflection does not move the mean, min and max still see it
+    RssiEstimator_add(&e, -40);
+    RssiEstimator_add(&e, -80);
+    CHECK(RssiEstimator_mean(&e) == -80);
+    CHECK(e.max == -40);
+    CHECK(e.min == -80);
+    CHECK(RssiEstimator_variance(&e) > 0);
+}
+
+static void testStep(void) {
+    RssiEstimator e;
+    int i;
+
+    //The mean follows a lasting change
+    RssiEstimator_init(&e);
+    for(i = 0; i < 10; i++) {
+        RssiEstimator_add(&e, -90);
+    }
+    for(i = 0; i < 40; i++) {
+        RssiEstimator_add(&e, -60);
+    }
+    CHECK(RssiEstimator_mean(&e) == -60);
+}
+
+static void testVariance(void) {
+    RssiEstimator e;
+    int8_t samples[255];
+    double mean = 0;
+    double variance = 0;
+    int n;
+    int i;
+
+    srand(5);
+    for(n = 2; n <= 255; n += 23) {
+        RssiEstimator_init(&e);
+        mean = 0;
+        variance = 0;
+        for(i = 0; i < n; i++) {
+            samples[i] = (int8_t)(-75 + rand() % 21 - 10);
+            RssiEstimator_add(&e, samples[i]);
+            mean += samples[i];
+        }
+        mean /= n;
+        for(i = 0; i < n; i++) {
+            variance += (samples[i] - mean) * (samples[i] - mean);
+        }
+        variance /= n;
+
+        //Integer division truncates
+        CHECK(RssiEstimator_variance(&e) <= variance);
+        CHECK(RssiEstimator_variance(&e) > variance - 1);
+    }
+}
+
+static void testSaturation(void) {
+    RssiEstimator e;
+    int i;
+
+    RssiEstimator_init(&e);
+    for(i = 0; i < 300; i++) {
+        RssiEstimator_add(&e, (i & 1) ? -127 : 0);
+    }
+    CHECK(e.count == 255);
+    CHECK(RssiEstimator_variance(&e) == 255);
+}
+
+int main(void) {
+    testConstant();
+    testOutlier();
+    testStep();
+    testVariance();
+    testSaturation();
+
+    return CHECK_RESULT();
+}
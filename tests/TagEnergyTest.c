@@ -0,0 +1,191 @@
+/*
+ *  ======== TagEnergyTest.c ========
+ *
+ *  Energy model of a tag's beacon loop: the time spent per CPU and radio
+ *  state for beacons due when the tag's BeaconScheduler says, times the
+ *  current of each state, in mA*s per beacon. Two loops of rfEasyLinkTx.c:
+ *
+ *    posted ahead  the loop before RFEASYLINKTX_LOW_POWER, the next Tx is
+ *                  posted as soon as the last one is done, the radio stays
+ *                  powered waiting for its start time and the device never
+ *                  reaches standby
+ *    low power     the task sleeps in standby until RFEASYLINKTX_WAKEUP_LEAD_MS
+ *                  before the beacon, the radio powers up for it and goes
+ *                  off after EasyLink's 1 ms inactivity timeout
+ *
+ *  Currents are typical CC1350 datasheet figures at 3 V. The radio waiting
+ *  for a start trigger with the synthesizer locked is taken at the Rx
+ *  current, the power up and the CPU's work per beacon are estimates.
+ */
+#include <string.h>
+
+#include "Check.h"
+#include "BeaconScheduler.h"
+#include "easylink/AirTime.h"
+#include "easylink/EasyLink.h"
+
+/***** Defines *****/
+
+#define BEACONS             10000
+#define WAKEUP_LEAD_MS      5       // RFEASYLINKTX_WAKEUP_LEAD_MS
+#define INACTIVITY_US       1000    // EasyLink's default RF inactivity timeout
+#define POWER_UP_US         1500    // RF core boot, radio setup and synthesizer
+#define CPU_US              300     // Task work per beacon, packet and schedule
+
+/* The tag's radio setup, see smartrf_settings */
+#define TAG_RATE_WORD       0x8000
+#define TAG_PRESCALE        0xF
+#define TAG_PREAMBLE_BYTES  4
+#define TAG_SYNC_WORD_BITS  32
+#define TAG_PAYLOAD         (1 + 3) // Address and beacon
+
+/***** Type declarations *****/
+
+typedef enum
+{
+    State_Standby,
+    State_Cpu,                  // CPU running, radio off
+    State_RadioPowerUp,
+    State_RadioWait,            // Radio powered, waiting or idle, CPU idle
+    State_RadioTx,
+    State_Count
+} State;
+
+typedef enum
+{
+    Loop_PostedAhead,
+    Loop_LowPower
+} Loop;
+
+typedef struct
+{
+    uint64_t us[State_Count];
+    uint64_t elapsedUs;
+} Energy;
+
+/***** Variable declarations *****/
+
+/* nA per state */
+static const uint32_t stateCurrent[State_Count] = {
+    700,        // Standby, RTC on and RAM retained
+    2940000,    // 48 MHz, 1.45 mA + 31 uA/MHz
+    3000000,
+    5400000,    // As Rx at 868 MHz
+    13400000,   // +10 dBm at 868 MHz, the tag sends at 8 dBm
+};
+
+static const char* stateNames[State_Count] = {
+    "standby", "cpu", "power up", "radio wait", "tx"
+};
+
+/***** Function definitions *****/
+
+static uint32_t ratToUs(uint32_t ticks) {
+    return ticks / (EasyLink_us_To_RadioTime(1));
+}
+
+/* Fills the time from the end of the last Tx to the end of the next */
+static void accountBeacon(Loop loop, uint32_t gapUs, uint32_t airUs, Energy* energy) {
+    uint32_t sleepMs;
+    uint32_t awakeUs;
+
+    energy->elapsedUs += gapUs + airUs;
+    energy->us[State_RadioTx] += airUs;
+    energy->us[State_Cpu] += CPU_US;
+
+    if(loop == Loop_PostedAhead) {
+        //The Tx is posted right away, the radio is still on from the last one
+        energy->us[State_RadioWait] += gapUs - CPU_US;
+        return;
+    }
+
+    //As rfEasyLinkTxFnx, the sleep is in whole ms before the wake up lead
+    sleepMs = gapUs / 1000;
+    if(sleepMs <= WAKEUP_LEAD_MS) {
+        energy->us[State_RadioWait] += gapUs - CPU_US;
+        return;
+    }
+    awakeUs = gapUs - (sleepMs - WAKEUP_LEAD_MS) * 1000;
+    //The radio stays on for the inactivity timeout, overlapping the sleep
+    energy->us[State_RadioWait] += INACTIVITY_US;
+    energy->us[State_Standby] += gapUs - awakeUs - INACTIVITY_US;
+    //Awake: the task posts the Tx, the radio powers up and waits for its time
+    energy->us[State_Cpu] += CPU_US;
+    energy->us[State_RadioPowerUp] += POWER_UP_US;
+    energy->us[State_RadioWait] += awakeUs - 2 * CPU_US - POWER_UP_US;
+}
+
+static void runLoop(Loop loop, uint32_t airUs, Energy* energy) {
+    BeaconScheduler scheduler;
+    const uint8_t ieeeAddr[8] = {0x00, 0x12, 0x4B, 0x00, 0x0A, 0x27, 0x01, 0x02};
+    uint32_t txEnd = 0;
+    uint32_t due;
+    uint32_t i;
+
+    memset(energy, 0, sizeof(*energy));
+    BeaconScheduler_init(&scheduler, ieeeAddr, 1, 0);
+    for(i = 0; i < BEACONS; i++) {
+        //The next beacon is scheduled once the task has done its work
+        due = BeaconScheduler_next(&scheduler, txEnd + EasyLink_us_To_RadioTime(CPU_US));
+        accountBeacon(loop, ratToUs(due - txEnd), airUs, energy);
+        txEnd = due + EasyLink_us_To_RadioTime(airUs);
+    }
+}
+
+/* mA*s, the sum over the states */
+static double charge(const Energy* energy) {
+    double mAs = 0;
+    uint8_t s;
+
+    for(s = 0; s < State_Count; s++) {
+        mAs += (double)stateCurrent[s] * energy->us[s] / 1e12;
+    }
+
+    return mAs;
+}
+
+static void printLoop(const char* name, const Energy* energy) {
+    uint64_t total = 0;
+    uint8_t s;
+
+    printf("%-13s", name);
+    for(s = 0; s < State_Count; s++) {
+        printf(" %10.3f", (double)energy->us[s] / 1000 / BEACONS);
+        total += energy->us[s];
+    }
+    printf(" %10.4f %10.1f\n", charge(energy) / BEACONS,
+            charge(energy) * 1e9 / energy->elapsedUs);
+
+    //Every us of the run is in one state
+    CHECK(total == energy->elapsedUs);
+}
+
+int main(void) {
+    uint32_t bitRate = AirTime_bitRate(TAG_RATE_WORD, TAG_PRESCALE, 1);
+    uint16_t overhead = AirTime_overheadBits(TAG_PREAMBLE_BYTES, TAG_SYNC_WORD_BITS, true, true);
+    uint32_t airUs = AirTime_us(bitRate, overhead, TAG_PAYLOAD);
+    Energy postedAhead;
+    Energy lowPower;
+    uint8_t s;
+
+    runLoop(Loop_PostedAhead, airUs, &postedAhead);
+    runLoop(Loop_LowPower, airUs, &lowPower);
+
+    printf("ms per beacon in each state, %u us on air\n%-13s", airUs, "loop");
+    for(s = 0; s < State_Count; s++) {
+        printf(" %10s", stateNames[s]);
+    }
+    printf(" %10s %10s\n", "mA*s/beac", "mean uA");
+    printLoop("posted ahead", &postedAhead);
+    printLoop("low power", &lowPower);
+    printf("low power spends %.1f%% of the charge per beacon\n",
+            100.0 * charge(&lowPower) / charge(&postedAhead));
+
+    CHECK(postedAhead.elapsedUs == lowPower.elapsedUs);
+    CHECK(postedAhead.us[State_Standby] == 0);
+    //Most of the time in standby, a fraction of the charge
+    CHECK(lowPower.us[State_Standby] * 2 > lowPower.elapsedUs);
+    CHECK(charge(&lowPower) * 4 < charge(&postedAhead));
+
+    return CHECK_RESULT();
+}
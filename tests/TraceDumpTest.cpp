@@ -0,0 +1,188 @@
+/*
+ *  ======== TraceDumpTest.cpp ========
+ */
+#include <cstring>
+
+#include "Check.h"
+#include "TraceDump.h"
+
+/***** Defines *****/
+
+#define PACKETS         50
+#define PACKET_TICKS    10000
+#define EVENTS          9       // Per packet, see addPacket
+#define START_TIME      (0xFFFFFFFFu - 100000) // The RAT time wraps during the trace
+
+/* Each stage of a packet, in ticks */
+#define RF_TO_APP       80
+#define AIR_TO_APP      (400 + RF_TO_APP)
+#define APP_RX          80
+#define RING_WAIT       280
+#define RING_TO_UART    40
+#define UART_WRITE      4000
+#define TX              2000
+
+/***** Type declarations *****/
+
+/* The firmware's Trace, recorded as Trace_record does */
+typedef struct
+{
+    uint8_t bytes[TRACE_SIZE * 8 + 8];
+    uint32_t count;
+} Recorder;
+
+/***** Function definitions *****/
+
+static void putUint32(uint8_t* p, uint32_t value) {
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    p[2] = (uint8_t)(value >> 16);
+    p[3] = (uint8_t)(value >> 24);
+}
+
+static void record(Recorder* r, uint32_t time, uint8_t id, uint16_t arg) {
+    uint8_t* e = &r->bytes[(r->count & (TRACE_SIZE - 1)) * 8];
+
+    putUint32(e, time);
+    e[4] = id;
+    e[5] = 0;
+    e[6] = (uint8_t)arg;
+    e[7] = (uint8_t)(arg >> 8);
+    r->count++;
+    putUint32(&r->bytes[TRACE_SIZE * 8], r->count);
+    putUint32(&r->bytes[TRACE_SIZE * 8 + 4], 20);
+}
+
+/* A beacon through the central, then an uplink of an AP */
+static void addPacket(Recorder* r, uint32_t air) {
+    uint32_t t = air + AIR_TO_APP;
+
+    record(r, t - RF_TO_APP, TRACE_RF_RX_DONE, 0);
+    record(r, t, TRACE_APP_RX, (uint16_t)air);
+    record(r, t + 40, TRACE_RING_PUT, 1);
+    record(r, t + APP_RX, TRACE_APP_RX_DONE, 20);
+    t += 40 + RING_WAIT;
+    record(r, t, TRACE_RING_GET, 0);
+    t += RING_TO_UART;
+    record(r, t, TRACE_UART_WRITE, 42);
+    t += UART_WRITE;
+    record(r, t, TRACE_UART_WRITE_DONE, 42);
+    record(r, air + 6000, TRACE_APP_TX, 30);
+    record(r, air + 6000 + TX, TRACE_RF_TX_DONE, 0);
+}
+
+static void checkStage(const TraceDump_Stages& stages, TraceDump_Stage stage,
+        uint64_t count, int64_t ticks) {
+    const TraceDump_Histogram& h = stages.histogram(stage);
+
+    CHECK(h.count() == count);
+    CHECK(h.sum() == (int64_t)count * ticks);
+    CHECK(h.max() == ticks && h.percentile(0.5) == ticks && h.percentile(1) == ticks);
+}
+
+/* A full ring, older events overwritten, over the wrap of the RAT time */
+static void testWrapped(void) {
+    static Recorder r;
+    TraceDump_Dump dump;
+    TraceDump_Stages stages;
+    std::string error;
+    uint32_t full;
+    size_t i;
+    bool ordered = true;
+
+    memset(&r, 0, sizeof(r));
+    for(i = 0; i < PACKETS; i++) {
+        addPacket(&r, START_TIME + i * PACKET_TICKS);
+    }
+    CHECK(TraceDump_size(TRACE_SIZE) == sizeof(r.bytes));
+    CHECK(TraceDump_load(r.bytes, sizeof(r.bytes), TRACE_SIZE, &dump, &error));
+    CHECK(dump.count == PACKETS * EVENTS && dump.overhead == 20);
+    CHECK(dump.events.size() == TRACE_SIZE);
+    for(i = 1; i < dump.events.size(); i++) {
+        ordered = ordered && dump.events[i].time >= dump.events[i - 1].time;
+    }
+    CHECK(ordered);
+
+    //The oldest event kept is the UART write of packet 21, the packets after
+    //it are seen whole
+    CHECK((PACKETS * EVENTS - TRACE_SIZE) % EVENTS == 5);
+    CHECK(dump.events[0].id == TRACE_UART_WRITE);
+    CHECK(dump.events.back().time - dump.events[0].time == (PACKETS - 1 - 21) * PACKET_TICKS +
+            6000 + TX - (AIR_TO_APP + 40 + RING_WAIT + RING_TO_UART));
+    full = PACKETS - (PACKETS * EVENTS - TRACE_SIZE) / EVENTS - 1;
+    stages.add(dump);
+    checkStage(stages, TraceDump_Stage_AirToApp, full, AIR_TO_APP);
+    checkStage(stages, TraceDump_Stage_RfToApp, full, RF_TO_APP);
+    checkStage(stages, TraceDump_Stage_AppRx, full, APP_RX);
+    checkStage(stages, TraceDump_Stage_RingWait, full, RING_WAIT);
+    checkStage(stages, TraceDump_Stage_RingToUart, full, RING_TO_UART);
+    checkStage(stages, TraceDump_Stage_UartWrite, full + 1, UART_WRITE);
+    checkStage(stages, TraceDump_Stage_AirToUart, full,
+            AIR_TO_APP + 40 + RING_WAIT + RING_TO_UART + UART_WRITE);
+    checkStage(stages, TraceDump_Stage_Tx, full + 1, TX);
+    CHECK(stages.unmatched() == 0);
+
+    //1210 us end to end
+    CHECK(stages.histogram(TraceDump_Stage_AirToUart).bucket(11) == full);
+
+    //A second dump adds up
+    stages.add(dump);
+    CHECK(stages.histogram(TraceDump_Stage_Tx).count() == 2 * (full + 1));
+}
+
+/*
+ * A record put by the Swi between the UART task's release and its probe: the
+ * get counts it, it must still be matched with the record before it
+ */
+static void testRace(void) {
+    static Recorder r;
+    TraceDump_Dump dump;
+    TraceDump_Stages stages;
+    std::string error;
+
+    memset(&r, 0, sizeof(r));
+    record(&r, 1000, TRACE_APP_RX, 500);
+    record(&r, 1010, TRACE_RING_PUT, 1);
+    record(&r, 1020, TRACE_APP_RX_DONE, 20);
+    record(&r, 2000, TRACE_APP_RX, 1700);
+    record(&r, 2010, TRACE_RING_PUT, 1);
+    record(&r, 2020, TRACE_APP_RX_DONE, 20);
+    record(&r, 2030, TRACE_RING_GET, 1);
+    record(&r, 2040, TRACE_RING_GET, 0);
+    record(&r, 2100, TRACE_UART_WRITE, 84);
+    record(&r, 3100, TRACE_UART_WRITE_DONE, 84);
+    //A record put before the dump started
+    record(&r, 4000, TRACE_RING_GET, 0);
+
+    CHECK(TraceDump_load(r.bytes, sizeof(r.bytes), TRACE_SIZE, &dump, &error));
+    CHECK(dump.events.size() == 11);
+    stages.add(dump);
+    CHECK(stages.histogram(TraceDump_Stage_RingWait).count() == 2);
+    CHECK(stages.histogram(TraceDump_Stage_RingWait).sum() == (2030 - 1010) + (2040 - 2010));
+    CHECK(stages.histogram(TraceDump_Stage_AirToUart).sum() == (3100 - 500) + (3100 - 1700));
+    CHECK(stages.histogram(TraceDump_Stage_RfToApp).count() == 0);
+    CHECK(stages.unmatched() == 1);
+}
+
+static void testBadDump(void) {
+    static uint8_t bytes[TRACE_SIZE * 8 + 8];
+    TraceDump_Dump dump;
+    std::string error;
+
+    CHECK(!TraceDump_load(bytes, sizeof(bytes) - 1, TRACE_SIZE, &dump, &error));
+    CHECK(error.find("bytes") != std::string::npos);
+    CHECK(!TraceDump_load(bytes, sizeof(bytes), 100, &dump, &error));
+
+    //An empty trace
+    CHECK(TraceDump_load(bytes, sizeof(bytes), TRACE_SIZE, &dump, &error));
+    CHECK(dump.events.empty());
+    CHECK(TraceDump_load(bytes, TraceDump_size(TRACE_SIZE / 2), TRACE_SIZE / 2, &dump, &error));
+}
+
+int main(void) {
+    testWrapped();
+    testRace();
+    testBadDump();
+
+    return CHECK_RESULT();
+}
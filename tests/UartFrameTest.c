@@ -0,0 +1,147 @@
+/*
+ *  ======== UartFrameTest.c ========
+ */
+#include <string.h>
+
+#include "Check.h"
+#include "UartFrame.h"
+
+/***** Function definitions *****/
+
+/* Feeds size bytes to the decoder, returns the frames completed */
+static int decodeAll(UartFrame_Decoder* decoder, const uint8_t* data, uint16_t size) {
+    int frames = 0;
+    uint16_t i;
+
+    for(i = 0; i < size; i++) {
+        frames += UartFrame_decode(decoder, data[i]);
+    }
+
+    return frames;
+}
+
+static void testCrc(void) {
+    const uint8_t check[] = "123456789";
+
+    //CRC-16/CCITT-FALSE check value
+    CHECK(UartFrame_crc16(0xFFFF, check, 9) == 0x29B1);
+}
+
+static void testRoundTrip(void) {
+    uint8_t payload[UART_FRAME_MAX_PAYLOAD];
+    uint8_t frame[UART_FRAME_MAX_SIZE];
+    UartFrame_Decoder decoder;
+    uint16_t size;
+    uint16_t len;
+    uint16_t i;
+
+    for(i = 0; i < sizeof(payload); i++) {
+        payload[i] = (uint8_t)(i * 7 + 3);
+    }
+
+    for(len = 0; len <= UART_FRAME_MAX_PAYLOAD; len++) {
+        size = UartFrame_encode(frame, UART_FRAME_TYPE_AP_REPORT, (uint8_t)len,
+                payload, (uint8_t)len);
+        CHECK(size == len + UART_FRAME_OVERHEAD);
+        CHECK(frame[0] == UART_FRAME_SOF);
+
+        UartFrame_decoderInit(&decoder);
+        CHECK(decodeAll(&decoder, frame, size) == 1);
+        CHECK(decoder.type == UART_FRAME_TYPE_AP_REPORT);
+        CHECK(decoder.seq == (uint8_t)len);
+        CHECK(decoder.len == len);
+        CHECK(memcmp(decoder.payload, payload, len) == 0);
+        CHECK(decoder.crcErrors == 0);
+    }
+}
+
+static void testPrefixed(void) {
+    const uint8_t prefix[UART_FRAME_RX_TIME_SIZE] = {0x78, 0x56, 0x34, 0x12};
+    const uint8_t packet[] = {1, 2, 3, 4, 5};
+    uint8_t joined[sizeof(prefix) + sizeof(packet)];
+    uint8_t frame[UART_FRAME_MAX_SIZE];
+    uint8_t plain[UART_FRAME_MAX_SIZE];
+    uint16_t size;
+
+    memcpy(joined, prefix, sizeof(prefix));
+    memcpy(&joined[sizeof(prefix)], packet, sizeof(packet));
+
+    //Same bytes as encoding the concatenation
+    size = UartFrame_encodePrefixed(frame, UART_FRAME_TYPE_AP_REPORT_TIMED, 9,
+            prefix, sizeof(prefix), packet, sizeof(packet));
+    CHECK(size == UartFrame_encode(plain, UART_FRAME_TYPE_AP_REPORT_TIMED, 9,
+            joined, sizeof(joined)));
+    CHECK(memcmp(frame, plain, size) == 0);
+}
+
+static void testResync(void) {
+    const uint8_t payload[] = {UART_FRAME_SOF, 0x00, 0xFF, 0x42};
+    const uint8_t noise[] = {0x00, 0x13, 0x37};
+    uint8_t stream[3 * UART_FRAME_MAX_SIZE];
+    UartFrame_Decoder decoder;
+    uint16_t size = 0;
+    uint16_t frameSize;
+
+    //Noise, a frame with a flipped bit, then two good frames
+    memcpy(stream, noise, sizeof(noise));
+    size += sizeof(noise);
+    frameSize = UartFrame_encode(&stream[size], UART_FRAME_TYPE_STATUS, 1,
+            payload, sizeof(payload));
+    stream[size + UART_FRAME_HEADER_SIZE + 2] ^= 0x10;
+    size += frameSize;
+    size += UartFrame_encode(&stream[size], UART_FRAME_TYPE_STATUS, 2,
+            payload, sizeof(payload));
+    size += UartFrame_encode(&stream[size], UART_FRAME_TYPE_STATUS, 3,
+            payload, sizeof(payload));
+
+    UartFrame_decoderInit(&decoder);
+    CHECK(decodeAll(&decoder, stream, size) == 2);
+    CHECK(decoder.seq == 3);
+    CHECK(decoder.crcErrors == 1);
+}
+
+static void testFalseSof(void) {
+    const uint8_t payload[] = {0x11, UART_FRAME_SOF, 0x22};
+    uint8_t stream[2 * UART_FRAME_MAX_SIZE];
+    UartFrame_Decoder decoder;
+    uint16_t size = 0;
+
+    //A stray SOF takes the real one as its length byte, the frame after it
+    //must still complete at its last byte
+    stream[size++] = UART_FRAME_SOF;
+    size += UartFrame_encode(&stream[size], UART_FRAME_TYPE_AP_REPORT, 7,
+            payload, sizeof(payload));
+
+    UartFrame_decoderInit(&decoder);
+    CHECK(decodeAll(&decoder, stream, size - 1) == 0);
+    CHECK(UartFrame_decode(&decoder, stream[size - 1]) == 1);
+    CHECK(decoder.type == UART_FRAME_TYPE_AP_REPORT);
+    CHECK(decoder.seq == 7);
+    CHECK(decoder.len == sizeof(payload));
+    CHECK(memcmp(decoder.payload, payload, sizeof(payload)) == 0);
+    CHECK(decoder.crcErrors == 0);
+
+    //Same after a frame cut short, whose length runs over the next frame
+    UartFrame_encode(stream, UART_FRAME_TYPE_STATUS, 1, payload, sizeof(payload));
+    size = 3;
+    size += UartFrame_encode(&stream[size], UART_FRAME_TYPE_AP_REPORT, 8,
+            payload, sizeof(payload));
+    size += UartFrame_encode(&stream[size], UART_FRAME_TYPE_AP_REPORT, 9,
+            payload, sizeof(payload));
+
+    UartFrame_decoderInit(&decoder);
+    CHECK(decodeAll(&decoder, stream, size) == 2);
+    CHECK(decoder.seq == 9);
+    //The cut frame ends inside the next one and fails its CRC
+    CHECK(decoder.crcErrors == 1);
+}
+
+int main(void) {
+    testCrc();
+    testRoundTrip();
+    testPrefixed();
+    testResync();
+    testFalseSof();
+
+    return CHECK_RESULT();
+}
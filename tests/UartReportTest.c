@@ -0,0 +1,191 @@
+/*
+ *  ======== UartReportTest.c ========
+ */
+#include <string.h>
+
+#include "Check.h"
+#include "UartReport.h"
+
+/***** Function definitions *****/
+
+static void putUint32(uint8_t* p, uint32_t value) {
+    p[0] = (uint8_t)(value);
+    p[1] = (uint8_t)(value >> 8);
+    p[2] = (uint8_t)(value >> 16);
+    p[3] = (uint8_t)(value >> 24);
+}
+
+/* Feeds a frame to decoder, returns 1 if it completed on the last byte */
+static int feed(UartFrame_Decoder* decoder, const uint8_t* frame, uint16_t size) {
+    uint16_t i;
+
+    for(i = 0; i + 1 < size; i++) {
+        if(UartFrame_decode(decoder, frame[i])) {
+            return 0;
+        }
+    }
+
+    return UartFrame_decode(decoder, frame[size - 1]);
+}
+
+static void testStatus(void) {
+    UartFrame_Decoder decoder;
+    uint8_t frame[UART_FRAME_MAX_SIZE];
+    uint8_t payload[UART_FRAME_STATUS_SIZE];
+    UartReport report;
+    uint16_t size;
+
+    putUint32(&payload[0], 1000);
+    putUint32(&payload[4], 3);
+    putUint32(&payload[8], 0x12345678);
+    putUint32(&payload[12], 42);
+    size = UartFrame_encode(frame, UART_FRAME_TYPE_STATUS, 7, payload, sizeof(payload));
+
+    UartFrame_decoderInit(&decoder);
+    CHECK(feed(&decoder, frame, size));
+    CHECK(UartReport_parse(&report, &decoder) == 0);
+    CHECK(report.type == UART_FRAME_TYPE_STATUS);
+    CHECK(report.seq == 7);
+    CHECK(report.u.status.packets == 1000);
+    CHECK(report.u.status.drops == 3);
+    CHECK(report.u.status.bytesSent == 0x12345678);
+    CHECK(report.u.status.uplinksLost == 42);
+
+    //A short status frame is rejected
+    size = UartFrame_encode(frame, UART_FRAME_TYPE_STATUS, 8, payload, sizeof(payload) - 1);
+    CHECK(feed(&decoder, frame, size));
+    CHECK(UartReport_parse(&report, &decoder) == -1);
+}
+
+static void testRadioStats(void) {
+    UartFrame_Decoder decoder;
+    uint8_t frame[UART_FRAME_MAX_SIZE];
+    uint8_t payload[UART_FRAME_RADIO_STATS_SIZE];
+    UartReport report;
+    uint16_t size;
+    uint8_t i;
+
+    for(i = 0; i < 11; i++) {
+        putUint32(&payload[4 * i], 100000u * i + i);
+    }
+    payload[44] = (uint8_t)-87;
+    size = UartFrame_encode(frame, UART_FRAME_TYPE_RADIO_STATS, 1, payload, sizeof(payload));
+
+    UartFrame_decoderInit(&decoder);
+    CHECK(feed(&decoder, frame, size));
+    CHECK(UartReport_parse(&report, &decoder) == 0);
+    CHECK(report.u.radio.rxOk == 0);
+    CHECK(report.u.radio.rxNok == 100001);
+    CHECK(report.u.radio.rxBufFull == 300003);
+    CHECK(report.u.radio.rxErrors == 600006);
+    CHECK(report.u.radio.txOk == 700007);
+    CHECK(report.u.radio.busyErrors == 1000010);
+    CHECK(report.u.radio.lastRssi == -87);
+}
+
+static void testLinkStats(void) {
+    UartFrame_Decoder decoder;
+    uint8_t frame[UART_FRAME_MAX_SIZE];
+    uint8_t payload[UART_FRAME_LINK_STATS_SIZE];
+    UartReport report;
+    uint16_t size;
+    uint8_t i;
+
+    payload[0] = 3;
+    payload[1] = (uint8_t)987;
+    payload[2] = (uint8_t)(987 >> 8);
+    putUint32(&payload[3], 5000);
+    putUint32(&payload[7], 66);
+    putUint32(&payload[11], 2);
+    for(i = 0; i < LINKSTATS_GAP_BUCKETS; i++) {
+        putUint32(&payload[15 + 4 * i], 10 + i);
+    }
+    size = UartFrame_encode(frame, UART_FRAME_TYPE_LINK_STATS, 9, payload, sizeof(payload));
+
+    UartFrame_decoderInit(&decoder);
+    CHECK(feed(&decoder, frame, size));
+    CHECK(UartReport_parse(&report, &decoder) == 0);
+    CHECK(report.u.link.apId == 3);
+    CHECK(report.u.link.deliveryPermille == 987);
+    CHECK(report.u.link.stats.received == 5000);
+    CHECK(report.u.link.stats.lost == 66);
+    CHECK(report.u.link.stats.resyncs == 2);
+    for(i = 0; i < LINKSTATS_GAP_BUCKETS; i++) {
+        CHECK(report.u.link.stats.gaps[i] == 10u + i);
+    }
+}
+
+static void testApReport(uint8_t timed) {
+    UartFrame_Decoder decoder;
+    uint8_t frame[UART_FRAME_MAX_SIZE];
+    uint8_t payload[EASYLINK_MAX_DATA_LENGTH];
+    uint8_t rxTime[UART_FRAME_RX_TIME_SIZE];
+    Uplink_Measure measures[3];
+    Uplink_Measure m;
+    UartReport report;
+    uint8_t encoded;
+    uint8_t len;
+    uint16_t size;
+    uint8_t i;
+
+    memset(measures, 0, sizeof(measures));
+    for(i = 0; i < 3; i++) {
+        measures[i].id = (uint8_t)(10 + i);
+        measures[i].rssi = (uint8_t)(60 + i);
+        measures[i].delta = i;
+    }
+    len = Uplink_encode(payload, 2, UPLINK_FLAG_PACKED, 77, NULL, measures, 3, &encoded);
+    CHECK(encoded == 3);
+
+    if(timed) {
+        putUint32(rxTime, 0xDEADBEEF);
+        size = UartFrame_encodePrefixed(frame, UART_FRAME_TYPE_AP_REPORT_TIMED, 4,
+                rxTime, sizeof(rxTime), payload, len);
+    } else {
+        size = UartFrame_encode(frame, UART_FRAME_TYPE_AP_REPORT, 4, payload, len);
+    }
+
+    UartFrame_decoderInit(&decoder);
+    CHECK(feed(&decoder, frame, size));
+    CHECK(UartReport_parse(&report, &decoder) == 0);
+    CHECK(report.u.ap.timed == timed);
+    CHECK(report.u.ap.rxTime == (timed ? 0xDEADBEEF : 0));
+    CHECK(report.u.ap.uplink.apId == 2);
+    CHECK(report.u.ap.uplink.seq == 77);
+    for(i = 0; i < 3; i++) {
+        CHECK(Uplink_decodeNext(&report.u.ap.uplink, &m));
+        CHECK(m.id == 10 + i);
+        CHECK(m.rssi == 60 + i);
+        CHECK(m.delta == i);
+    }
+    CHECK(!Uplink_decodeNext(&report.u.ap.uplink, &m));
+}
+
+static void testUnknown(void) {
+    UartFrame_Decoder decoder;
+    uint8_t frame[UART_FRAME_MAX_SIZE];
+    uint8_t payload[2] = {0, 0};
+    UartReport report;
+    uint16_t size;
+
+    size = UartFrame_encode(frame, 0x7F, 0, payload, sizeof(payload));
+    UartFrame_decoderInit(&decoder);
+    CHECK(feed(&decoder, frame, size));
+    CHECK(UartReport_parse(&report, &decoder) == -1);
+
+    //A timed report too short for its rx time
+    size = UartFrame_encode(frame, UART_FRAME_TYPE_AP_REPORT_TIMED, 0, payload, sizeof(payload));
+    CHECK(feed(&decoder, frame, size));
+    CHECK(UartReport_parse(&report, &decoder) == -1);
+}
+
+int main(void) {
+    testStatus();
+    testRadioStats();
+    testLinkStats();
+    testApReport(0);
+    testApReport(1);
+    testUnknown();
+
+    return CHECK_RESULT();
+}
@@ -0,0 +1,252 @@
+/*
+ *  ======== UplinkBench.c ========
+ *
+ *  Packing density of the AP's uplink, plain records against the packed bit
+ *  stream, for 8 to 255 tags in range of the AP. Each round is a batch of
+ *  pending measures, one per tag, sent in as many uplinks as it takes. The
+ *  measures are as an AP takes them: tags at 1 to 30 m with the AP's path
+ *  loss and +-4 dB of fading, a burst of BEACON_BURST_SIZE beacons with one
+ *  lost now and then, ages of a few DELTA_TIME_UNIT_MS with the odd stale
+ *  one. Tag ids are spread over 1..255 as a deployment would have them.
+ *
+ *  Prints the most measures one uplink carried, payload bytes per measure
+ *  and the encode and decode cost per measure for each set of flags, the
+ *  packed ones capped at UPLINK_PACKED_MAX_MEASURES. Every uplink is decoded
+ *  back and checked against the measures it was given.
+ */
+#include <math.h>
+#include <string.h>
+#include <time.h>
+
+#include "Check.h"
+#include "Uplink.h"
+
+/***** Defines *****/
+
+#define ROUNDS          2000
+#define MAX_TAGS        255
+#define RSSI_1M         55
+#define PATH_LOSS       2.95
+#define BURST_SIZE      10      // BEACON_BURST_SIZE, beacons a measure aggregates
+
+/***** Type declarations *****/
+
+typedef struct
+{
+    uint32_t uplinks;
+    uint32_t measures;
+    uint32_t most;              // Most measures one uplink carried
+    uint64_t bytes;
+    uint64_t encodeNs;
+    uint64_t decodeNs;
+    uint32_t mismatches;
+} Result;
+
+/***** Variable declarations *****/
+
+static uint8_t deployment[MAX_TAGS];
+static volatile uint32_t sink;
+
+/***** Function definitions *****/
+
+static uint64_t nowNs(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+/* Next pseudo random number, the same run every time */
+static uint32_t nextRandom(uint32_t* state) {
+    *state = *state * 1664525u + 1013904223u;
+
+    return *state >> 8;
+}
+
+/* Picks count of the ids in random order */
+static void shuffle(uint8_t* ids, uint32_t count, uint32_t* random) {
+    uint32_t i;
+    uint32_t j;
+    uint8_t t;
+
+    for(i = count - 1; i > 0; i--) {
+        j = nextRandom(random) % (i + 1);
+        t = ids[i];
+        ids[i] = ids[j];
+        ids[j] = t;
+    }
+}
+
+static void makeMeasure(Uplink_Measure* m, uint8_t id, uint32_t* random) {
+    double meters = 1 + (nextRandom(random) % 2900) / 100.0;
+    int32_t rssi = (int32_t)(RSSI_1M + 10 * PATH_LOSS * log10(meters) + 0.5) +
+            (int32_t)(nextRandom(random) % 9) - 4;
+    uint8_t spread = (uint8_t)(nextRandom(random) % 5);
+
+    m->id = id;
+    m->rssi = (uint8_t)rssi;
+    //Sent within UPLINK_MAX_AGE_MS, 1 in 20 waited for a busy channel
+    m->delta = (uint16_t)(nextRandom(random) % 6);
+    if(nextRandom(random) % 20 == 0) {
+        m->delta += (uint16_t)(nextRandom(random) % 60);
+    }
+    m->rssiMin = (uint8_t)(rssi - spread);
+    m->rssiMax = (uint8_t)(rssi + spread + nextRandom(random) % 3);
+    m->rssiVariance = (uint8_t)(spread * spread / 2 + nextRandom(random) % 3);
+    m->distance = (uint16_t)(meters * 100);
+    m->beaconsLost = (nextRandom(random) % 8 == 0) ? (uint8_t)(1 + nextRandom(random) % 2) : 0;
+    m->beacons = (uint8_t)(BURST_SIZE - m->beaconsLost);
+}
+
+/* Compares the fields the flags carry */
+static bool sameMeasure(const Uplink_Measure* a, const Uplink_Measure* b, uint8_t flags) {
+    if(a->id != b->id || a->rssi != b->rssi || a->delta != b->delta) {
+        return false;
+    }
+    if((flags & UPLINK_FLAG_RSSI_STATS) && (a->rssiMin != b->rssiMin ||
+            a->rssiMax != b->rssiMax || a->rssiVariance != b->rssiVariance)) {
+        return false;
+    }
+    if((flags & UPLINK_FLAG_DISTANCE) && a->distance != b->distance) {
+        return false;
+    }
+    if((flags & UPLINK_FLAG_BEACON_LOSS) && (a->beacons != b->beacons ||
+            a->beaconsLost != b->beaconsLost)) {
+        return false;
+    }
+
+    return true;
+}
+
+/* Decodes an uplink back, each measure must be one of those encoded */
+static uint32_t decode(const uint8_t* payload, uint8_t len, const Uplink_Measure* sent,
+        uint8_t encoded, uint8_t flags, Result* result) {
+    bool used[UPLINK_PACKED_MAX_MEASURES];
+    Uplink_Decoder decoder;
+    Uplink_Measure m;
+    uint32_t decoded = 0;
+    uint64_t start;
+    uint8_t i;
+    bool found;
+
+    memset(used, 0, sizeof(used));
+    start = nowNs();
+    if(Uplink_decoderInit(&decoder, payload, len) != 0) {
+        return 0;
+    }
+    while(Uplink_decodeNext(&decoder, &m)) {
+        decoded++;
+        sink += m.rssi;
+        //Ids are unique in a batch
+        found = false;
+        for(i = 0; i < encoded && !found; i++) {
+            if(!used[i] && sent[i].id == m.id) {
+                used[i] = true;
+                found = sameMeasure(&sent[i], &m, flags);
+            }
+        }
+        if(!found) {
+            result->mismatches++;
+        }
+    }
+    result->decodeNs += nowNs() - start;
+
+    return decoded;
+}
+
+static void run(uint32_t tags, uint8_t flags, Result* result) {
+    Uplink_Measure batch[UPLINK_PACKED_MAX_MEASURES];
+    uint8_t payload[EASYLINK_MAX_DATA_LENGTH];
+    uint8_t ids[MAX_TAGS];
+    uint32_t random = tags;
+    uint32_t count = (tags < UPLINK_PACKED_MAX_MEASURES) ? tags : UPLINK_PACKED_MAX_MEASURES;
+    uint32_t round;
+    uint32_t next;
+    uint32_t i;
+    uint64_t start;
+    uint8_t encoded;
+    uint8_t len;
+
+    memset(result, 0, sizeof(*result));
+    memcpy(ids, deployment, tags);
+    for(round = 0; round < ROUNDS; round++) {
+        //The tags heard since the last uplinks, in the order they were heard
+        shuffle(ids, tags, &random);
+        for(i = 0; i < count; i++) {
+            makeMeasure(&batch[i], ids[i], &random);
+        }
+
+        for(next = 0; next < count; next += encoded) {
+            start = nowNs();
+            len = Uplink_encode(payload, 1, flags, (uint8_t)result->uplinks, NULL,
+                    &batch[next], (uint8_t)(count - next), &encoded);
+            result->encodeNs += nowNs() - start;
+            if(encoded == 0) {
+                result->mismatches++;
+                break;
+            }
+            if(decode(payload, len, &batch[next], encoded, flags, result) != encoded) {
+                result->mismatches++;
+            }
+            result->uplinks++;
+            result->measures += encoded;
+            if(encoded > result->most) {
+                result->most = encoded;
+            }
+            result->bytes += len;
+        }
+    }
+}
+
+int main(void) {
+    static const uint32_t tagCounts[] = {8, 32, 128, MAX_TAGS};
+    static const uint8_t flagSets[] = {
+        0,
+        UPLINK_FLAG_RSSI_STATS,
+        UPLINK_FLAG_RSSI_STATS | UPLINK_FLAG_DISTANCE | UPLINK_FLAG_BEACON_LOSS
+    };
+    static const char* flagNames[] = {"basic", "stats", "stats+dist+loss"};
+    uint32_t random = 7;
+    Result plain;
+    Result packed;
+    uint32_t t;
+    uint32_t i;
+    uint8_t f;
+
+    //A deployment of MAX_TAGS ids, fewer tags in range are the first of them
+    for(i = 0; i < MAX_TAGS; i++) {
+        deployment[i] = (uint8_t)(i + 1);
+    }
+    shuffle(deployment, MAX_TAGS, &random);
+
+    printf("%4s %-16s %8s %8s %8s %8s %9s %9s %9s %9s %6s\n", "tags", "flags",
+            "most/up", "packed", "B/m", "packed", "enc ns/m", "packed", "dec ns/m", "packed",
+            "gain");
+    for(t = 0; t < sizeof(tagCounts) / sizeof(tagCounts[0]); t++) {
+        for(f = 0; f < sizeof(flagSets); f++) {
+            run(tagCounts[t], flagSets[f], &plain);
+            run(tagCounts[t], flagSets[f] | UPLINK_FLAG_PACKED, &packed);
+
+            CHECK(plain.mismatches == 0);
+            CHECK(packed.mismatches == 0);
+            CHECK(plain.measures == packed.measures);
+
+            //A batch that fits plain fits packed, a bigger one takes fewer uplinks
+            CHECK(packed.uplinks <= plain.uplinks);
+            CHECK(packed.most >= plain.most);
+            CHECK(packed.bytes < plain.bytes);
+
+            printf("%4u %-16s %8u %8u %8.2f %8.2f %9.1f %9.1f %9.1f %9.1f %5.2fx\n",
+                    tagCounts[t], flagNames[f], plain.most, packed.most,
+                    (double)plain.bytes / plain.measures, (double)packed.bytes / packed.measures,
+                    (double)plain.encodeNs / plain.measures,
+                    (double)packed.encodeNs / packed.measures,
+                    (double)plain.decodeNs / plain.measures,
+                    (double)packed.decodeNs / packed.measures,
+                    (double)packed.most / plain.most);
+        }
+    }
+
+    return CHECK_RESULT();
+}
@@ -0,0 +1,282 @@
+/*
+ *  ======== UplinkLossTest.c ========
+ *
+ *  Beacon loss at the AP around its uplinks, discrete event simulation on
+ *  the fake RF core with the AP's EasyLink.c built as is. Tags beacon on
+ *  their BeaconScheduler, the AP sends an uplink every UPLINK_EVERY_MS:
+ *
+ *    blind       as the AP did before, Rx aborted, the uplink scheduled
+ *                BLIND_DELAY_MS ahead and Rx started again once it is sent
+ *    concurrent  as it does now, EasyLink_transmitAsync pauses the running
+ *                Rx for the packet's air time only and resumes it
+ *
+ *  A beacon is received if Rx ran over all of its air time and no other
+ *  beacon overlapped it. Prints the listen duty cycle and the beacons lost
+ *  to the uplinks and to collisions per scheme.
+ */
+#include <string.h>
+
+#include "Check.h"
+#include "EasyLink.h"
+#include "FakeRf.h"
+#include "AirTime.h"
+#include "BeaconScheduler.h"
+#include "Beacon.h"
+
+/***** Defines *****/
+
+#define SIM_SECONDS         60
+#define STEP_TICKS          400     // 100 us
+#define MAX_TAGS            32
+#define POWER_ON_SPREAD_MS  2000    // Tags are switched on at random within it
+#define UPLINK_EVERY_MS     1000
+#define UPLINK_BYTES        EASYLINK_MAX_DATA_LENGTH
+#define BLIND_DELAY_MS      100     // The old task's absolute time for the uplink
+#define AP_ADDR             0xAA
+
+/* The AP's radio setup, see smartrf_settings */
+#define AP_RATE_WORD        0x8000
+#define AP_PRESCALE         0xF
+#define AP_PREAMBLE_BYTES   4
+#define AP_SYNC_WORD_BITS   32
+
+/***** Type declarations *****/
+
+typedef enum
+{
+    Scheme_Blind,
+    Scheme_Concurrent
+} Scheme;
+
+/* A beacon on the air */
+typedef struct
+{
+    uint32_t end;
+    uint8_t seq;
+    bool onAir;
+    bool heardFromStart;        // Rx was on when it started
+    bool collided;
+} Flight;
+
+typedef struct
+{
+    uint32_t sent;
+    uint32_t delivered;
+    uint32_t blind;             // Lost while Rx was off for an uplink
+    uint32_t collided;
+    uint32_t uplinks;
+    uint64_t listening;         // Steps with Rx on
+    uint64_t steps;
+} Result;
+
+/***** Variable declarations *****/
+
+static uint32_t received;
+static bool txDone;
+static bool rxEnded;
+
+/***** Function definitions *****/
+
+/* Next pseudo random number, the same run every time */
+static uint32_t nextRandom(uint32_t* state) {
+    *state = *state * 1664525u + 1013904223u;
+
+    return *state >> 8;
+}
+
+static void rxViewCb(EasyLink_RxView* rxView, EasyLink_Status status) {
+    if(rxView == NULL) {
+        CHECK(status == EasyLink_Status_Aborted);
+        rxEnded = true;
+        return;
+    }
+    received++;
+    EasyLink_releaseRxView(rxView);
+}
+
+static void txDoneCb(EasyLink_Status status) {
+    CHECK(status == EasyLink_Status_Success);
+    txDone = true;
+}
+
+static bool listening(void) {
+    return FakeRf_activeCommand() == CMD_PROP_RX_ADV;
+}
+
+static void startRx(void) {
+    rxEnded = false;
+    CHECK(EasyLink_receiveContinuousViewAsync(rxViewCb, 0) == EasyLink_Status_Success);
+}
+
+/* Starts the uplink, returns the RAT time it is on the air until */
+static uint32_t startUplink(Scheme scheme, uint32_t now, uint32_t uplinkTicks) {
+    EasyLink_TxPacket txPacket;
+
+    memset(&txPacket, 0, sizeof(txPacket));
+    txPacket.dstAddr[0] = 0xBB;
+    txPacket.len = UPLINK_BYTES;
+    txDone = false;
+
+    if(scheme == Scheme_Blind) {
+        //Rx stopped for the whole Tx phase, the uplink sent at a set time
+        CHECK(EasyLink_abort() == EasyLink_Status_Success);
+        CHECK(rxEnded);
+        txPacket.absTime = now + EasyLink_ms_To_RadioTime(BLIND_DELAY_MS);
+        CHECK(EasyLink_transmitAsync(&txPacket, txDoneCb) == EasyLink_Status_Success);
+        return txPacket.absTime + uplinkTicks;
+    }
+
+    CHECK(EasyLink_transmitAsync(&txPacket, txDoneCb) == EasyLink_Status_Success);
+    return now + uplinkTicks;
+}
+
+/* A beacon leaves the air, received or lost */
+static void landBeacon(uint8_t tag, Flight* flight, Result* result) {
+    uint8_t pkt[1 + BEACON_SIZE];
+    uint32_t before = received;
+
+    flight->onAir = false;
+    if(flight->collided) {
+        result->collided++;
+        return;
+    }
+    if(!flight->heardFromStart || !listening()) {
+        result->blind++;
+        return;
+    }
+
+    pkt[0] = AP_ADDR;
+    Beacon_encode(&pkt[1], tag + 1, flight->seq, 0);
+    CHECK(FakeRf_receive(pkt, sizeof(pkt), -70, true) == FakeRf_Rx_Stored);
+    CHECK(received == before + 1);
+    result->delivered++;
+}
+
+static void simulate(Scheme scheme, uint8_t tags, Result* result) {
+    static BeaconScheduler schedulers[MAX_TAGS];
+    static Flight flights[MAX_TAGS];
+    uint32_t next[MAX_TAGS];
+    uint8_t ieeeAddr[8] = {0x00, 0x12, 0x4B, 0x00, 0x0A, 0x27, 0, 0};
+    uint32_t bitRate = AirTime_bitRate(AP_RATE_WORD, AP_PRESCALE, 1);
+    uint16_t overhead = AirTime_overheadBits(AP_PREAMBLE_BYTES, AP_SYNC_WORD_BITS, true, true);
+    uint32_t beaconTicks = AirTime_us(bitRate, overhead, 1 + BEACON_SIZE) * 4;
+    uint32_t uplinkTicks = AirTime_us(bitRate, overhead, 1 + UPLINK_BYTES) * 4;
+    uint32_t start = RF_getCurrentTime();
+    uint32_t end = start + EasyLink_ms_To_RadioTime((uint32_t)SIM_SECONDS * 1000);
+    uint32_t nextUplink = start + EasyLink_ms_To_RadioTime(UPLINK_EVERY_MS);
+    uint32_t txEnd = 0;
+    uint32_t random = tags;
+    bool txRunning = false;
+    uint32_t now;
+    uint8_t tag;
+    uint8_t other;
+
+    memset(result, 0, sizeof(*result));
+    memset(flights, 0, sizeof(flights));
+    for(tag = 0; tag < tags; tag++) {
+        ieeeAddr[7] = tag;
+        now = start + nextRandom(&random) % EasyLink_ms_To_RadioTime(POWER_ON_SPREAD_MS);
+        BeaconScheduler_init(&schedulers[tag], ieeeAddr, tag + 1, now);
+        next[tag] = BeaconScheduler_next(&schedulers[tag], now);
+    }
+    startRx();
+
+    for(now = start; (int32_t)(end - now) > 0; now = RF_getCurrentTime()) {
+        for(tag = 0; tag < tags; tag++) {
+            if(flights[tag].onAir && (int32_t)(now - flights[tag].end) >= 0) {
+                landBeacon(tag, &flights[tag], result);
+            }
+        }
+        for(tag = 0; tag < tags; tag++) {
+            if((int32_t)(now - next[tag]) < 0) {
+                continue;
+            }
+            flights[tag].onAir = true;
+            flights[tag].end = now + beaconTicks;
+            flights[tag].seq++;
+            flights[tag].heardFromStart = listening();
+            flights[tag].collided = false;
+            for(other = 0; other < tags; other++) {
+                if(other != tag && flights[other].onAir) {
+                    flights[other].collided = true;
+                    flights[tag].collided = true;
+                }
+            }
+            result->sent++;
+            next[tag] = BeaconScheduler_next(&schedulers[tag], now);
+        }
+
+        if(txRunning && (int32_t)(now - txEnd) >= 0) {
+            CHECK(FakeRf_completeTx());
+            CHECK(txDone);
+            txRunning = false;
+            result->uplinks++;
+            if(scheme == Scheme_Blind) {
+                startRx();
+            }
+        }
+        if(!txRunning && (int32_t)(now - nextUplink) >= 0) {
+            txEnd = startUplink(scheme, now, uplinkTicks);
+            txRunning = true;
+            nextUplink += EasyLink_ms_To_RadioTime(UPLINK_EVERY_MS);
+        }
+
+        result->steps++;
+        if(listening()) {
+            result->listening++;
+        }
+        FakeRf_advance(STEP_TICKS);
+    }
+
+    //Beacons still on the air are not counted
+    for(tag = 0; tag < tags; tag++) {
+        if(flights[tag].onAir) {
+            result->sent--;
+        }
+    }
+    if(txRunning) {
+        CHECK(FakeRf_completeTx());
+        if(scheme == Scheme_Blind) {
+            startRx();
+        }
+    }
+    CHECK(EasyLink_abort() == EasyLink_Status_Success);
+    CHECK(rxEnded);
+}
+
+int main(void) {
+    static const uint8_t tagCounts[] = {8, 32};
+    static const char* names[] = {"blind", "concurrent"};
+    EasyLink_Params params;
+    Result results[2];
+    Result* r;
+    uint8_t i;
+    uint8_t s;
+
+    FakeRf_reset();
+    EasyLink_Params_init(&params);
+    CHECK(EasyLink_init(&params) == EasyLink_Status_Success);
+
+    printf("%4s %-10s %7s %9s %7s %8s %7s %8s %7s\n", "tags", "scheme", "uplinks", "listen %",
+            "sent", "received", "blind", "collided", "loss %");
+    for(i = 0; i < sizeof(tagCounts) / sizeof(tagCounts[0]); i++) {
+        for(s = Scheme_Blind; s <= Scheme_Concurrent; s++) {
+            r = &results[s];
+            simulate((Scheme)s, tagCounts[i], r);
+
+            CHECK(r->sent > 0 && r->uplinks == SIM_SECONDS * 1000 / UPLINK_EVERY_MS - 1);
+            CHECK(r->delivered + r->blind + r->collided == r->sent);
+
+            printf("%4u %-10s %7u %9.2f %7u %8u %7u %8u %7.2f\n", tagCounts[i], names[s],
+                    r->uplinks, 100.0 * r->listening / r->steps, r->sent, r->delivered,
+                    r->blind, r->collided, 100.0 * (r->blind + r->collided) / r->sent);
+        }
+
+        //Rx is only off for the uplink's air time
+        CHECK(results[Scheme_Concurrent].blind < results[Scheme_Blind].blind);
+        CHECK(results[Scheme_Concurrent].listening * 100 >= results[Scheme_Concurrent].steps * 97);
+        CHECK(results[Scheme_Blind].listening * 100 < results[Scheme_Blind].steps * 92);
+    }
+
+    return CHECK_RESULT();
+}
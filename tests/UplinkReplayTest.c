@@ -0,0 +1,220 @@
+/*
+ *  ======== UplinkReplayTest.c ========
+ *
+ *  Replays a synthetic beacon trace through the AP's TaskManager.c, built as
+ *  is: tags beacon on their BeaconScheduler, a few beacons are lost at
+ *  random, the beacons go through rxDoneCb and the uplink is packed when
+ *  memStack is full or the oldest measure is due, as taskManagerFnx does.
+ *  Every uplink is decoded back. Prints the flushes, their occupancy and the
+ *  air time spent per measure at the AP's 50 kbps, which must fall as the
+ *  tags fill the uplinks. The fixed 30 byte uplink of 7 measures the AP sent
+ *  before is printed for reference, its records only held id, RSSI and delta.
+ *
+ *  RadioClock_now is wrapped at link time (--wrap) so the trace runs on its
+ *  own time rather than the simulation clock's.
+ */
+#include "Check.h"
+#include "SimClock.h"
+#include "BeaconScheduler.h"
+#include "easylink/AirTime.h"
+
+//The AP's TaskManager.c, for its rxDoneCb, packUplink and statics
+#include "TaskManager.c"
+
+/***** Defines *****/
+
+#define TRACE_SECONDS       600
+#define LOSS_PER_MILLE      50
+#define MAX_TAGS            64
+#define LEGACY_PAYLOAD      30      // Bytes of the fixed uplink
+#define LEGACY_MEASURES     7
+
+/* The AP's radio setup, see smartrf_settings */
+#define AP_RATE_WORD        0x8000
+#define AP_PRESCALE         0xF
+#define AP_PREAMBLE_BYTES   4
+#define AP_SYNC_WORD_BITS   32
+
+/***** Type declarations *****/
+
+typedef struct
+{
+    uint32_t beacons;           // Beacons delivered to rxDoneCb
+    uint32_t dropped;
+    uint32_t uplinks;
+    uint32_t bytes;             // Uplink payloads
+    uint64_t airUs;
+    uint32_t measures;          // Decoded from the uplinks
+    uint32_t beaconsSent;       // Beacons the decoded measures aggregate
+    uint32_t beaconsLost;
+    uint32_t tooLong;
+    uint32_t late;              // Measures older than UPLINK_MAX_AGE_MS when packed
+    uint32_t badUplinks;
+} Replay;
+
+/***** Variable declarations *****/
+
+static uint32_t traceNow;
+static uint32_t bitRate;
+static uint16_t overheadBits;
+
+/***** Function definitions *****/
+
+uint32_t __wrap_RadioClock_now(void) {
+    return traceNow;
+}
+
+/* Next pseudo random number, the same run every time */
+static uint32_t nextRandom(uint32_t* state) {
+    *state = *state * 1664525u + 1013904223u;
+
+    return *state >> 8;
+}
+
+static void resetAp(void) {
+    rx_counter = 0;
+    uplinkSeq = 0;
+    memset(measureTable, 0, sizeof(measureTable));
+    memset(tagSeen, 0, sizeof(tagSeen));
+    memset(&uplinkStats, 0, sizeof(uplinkStats));
+}
+
+/* Packs an uplink as the task does and checks it decodes */
+static void flush(Replay* replay) {
+    uint8_t payload[EASYLINK_MAX_DATA_LENGTH];
+    Uplink_Decoder decoder;
+    Uplink_Measure measure;
+    uint8_t len;
+
+    len = packUplink(payload);
+    replay->uplinks++;
+    replay->bytes += len;
+    //The AP's address byte goes on the air with the payload
+    replay->airUs += AirTime_us(bitRate, overheadBits, len + 1);
+    if(len > EASYLINK_MAX_DATA_LENGTH) {
+        replay->tooLong++;
+    }
+
+    if(Uplink_decoderInit(&decoder, payload, len) != 0) {
+        replay->badUplinks++;
+        return;
+    }
+    while(Uplink_decodeNext(&decoder, &measure)) {
+        replay->measures++;
+        replay->beaconsSent += measure.beacons;
+        replay->beaconsLost += measure.beaconsLost;
+        if(measure.delta > UPLINK_MAX_AGE_MS / DELTA_TIME_UNIT_MS) {
+            replay->late++;
+        }
+    }
+}
+
+/* Beacons of tags tags for TRACE_SECONDS, the uplinks as the task sends them */
+static void replayTrace(uint8_t tags, Replay* replay) {
+    static BeaconScheduler schedulers[MAX_TAGS];
+    uint32_t next[MAX_TAGS];
+    uint8_t seqs[MAX_TAGS] = {0};
+    uint8_t ieeeAddr[8] = {0x00, 0x12, 0x4B, 0x00, 0x0A, 0x27, 0, 0};
+    uint8_t dstAddr[EASYLINK_MAX_ADDR_SIZE] = {0xAA};
+    uint8_t payload[EASYLINK_MAX_DATA_LENGTH];
+    uint32_t end = EasyLink_ms_To_RadioTime((uint32_t)TRACE_SECONDS * 1000);
+    uint32_t maxAge = EasyLink_ms_To_RadioTime(UPLINK_MAX_AGE_MS);
+    uint32_t random = tags;
+    EasyLink_RxView view;
+    uint8_t first;
+    uint8_t tag;
+
+    memset(replay, 0, sizeof(*replay));
+    resetAp();
+    traceNow = 0;
+    for(tag = 0; tag < tags; tag++) {
+        ieeeAddr[7] = tag;
+        BeaconScheduler_init(&schedulers[tag], ieeeAddr, tag + 1, 0);
+        next[tag] = BeaconScheduler_next(&schedulers[tag], 0);
+    }
+
+    memset(&view, 0, sizeof(view));
+    view.dstAddr = dstAddr;
+    view.payload = payload;
+
+    while(traceNow < end) {
+        first = 0;
+        for(tag = 1; tag < tags; tag++) {
+            if((int32_t)(next[tag] - next[first]) < 0) {
+                first = tag;
+            }
+        }
+
+        //The task wakes up when the oldest measure is due, before the beacon
+        if(rx_counter > 0 && (int32_t)(next[first] - (memStack[0].local_time + maxAge)) >= 0) {
+            traceNow = memStack[0].local_time + maxAge;
+            flush(replay);
+            continue;
+        }
+
+        traceNow = next[first];
+        next[first] = BeaconScheduler_next(&schedulers[first], traceNow);
+        seqs[first]++;
+        if(nextRandom(&random) % 1000 < LOSS_PER_MILLE) {
+            replay->dropped++;
+            continue;
+        }
+
+        view.len = Beacon_encode(payload, first + 1, seqs[first], 0);
+        view.rssi = -50 - (int8_t)(nextRandom(&random) % 40);
+        view.absTime = traceNow;
+        rxDoneCb(&view, EasyLink_Status_Success);
+        replay->beacons++;
+        if(rx_counter == BUFFER_SIZE) {
+            flush(replay);
+        }
+    }
+
+    //What is left is packed in the last uplinks
+    while(rx_counter > 0) {
+        flush(replay);
+    }
+}
+
+int main(void) {
+    static const uint8_t tagCounts[] = {1, 4, 16, 64};
+    uint32_t legacyUs;
+    double usPerMeasure;
+    double lastUsPerMeasure = 0;
+    Replay replay;
+    uint8_t i;
+
+    SimClock_init(1, 0);
+    setUpRxSemaphore();
+    Distance_calibrate(RSSI_1M, (uint16_t)(ELECTROMAGNETIC_CTE * 256));
+
+    bitRate = AirTime_bitRate(AP_RATE_WORD, AP_PRESCALE, 1);
+    overheadBits = AirTime_overheadBits(AP_PREAMBLE_BYTES, AP_SYNC_WORD_BITS, true, true);
+    legacyUs = AirTime_us(bitRate, overheadBits, LEGACY_PAYLOAD + 1);
+
+    printf("%4s %8s %7s %5s %4s %8s %8s %8s %10s %10s\n", "tags", "beacons", "uplinks",
+            "full", "age", "mean occ", "min occ", "bytes", "us/measure", "fixed 30 B");
+    for(i = 0; i < sizeof(tagCounts) / sizeof(tagCounts[0]); i++) {
+        replayTrace(tagCounts[i], &replay);
+
+        CHECK(replay.beacons > 0 && replay.dropped > 0);
+        CHECK(replay.badUplinks == 0 && replay.tooLong == 0 && replay.late == 0);
+        CHECK(replay.uplinks == uplinkStats.flushes);
+        CHECK(replay.measures == uplinkStats.measures);
+        //Every beacon delivered is in exactly one measure sent
+        CHECK(replay.beaconsSent == replay.beacons);
+        CHECK(replay.beaconsLost <= replay.dropped);
+        //More tags, fuller uplinks, less air time per measure
+        usPerMeasure = (double)replay.airUs / replay.measures;
+        CHECK(i == 0 || usPerMeasure < lastUsPerMeasure);
+        lastUsPerMeasure = usPerMeasure;
+
+        printf("%4u %8u %7u %5u %4u %8.1f %8u %8.1f %10.0f %10.0f\n", tagCounts[i],
+                replay.beacons, replay.uplinks, uplinkStats.fullFlushes, uplinkStats.ageFlushes,
+                (double)replay.measures / replay.uplinks, uplinkStats.minOccupancy,
+                (double)replay.bytes / replay.uplinks, usPerMeasure,
+                (double)legacyUs / LEGACY_MEASURES);
+    }
+
+    return CHECK_RESULT();
+}
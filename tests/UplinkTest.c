@@ -0,0 +1,171 @@
+/*
+ *  ======== UplinkTest.c ========
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "Check.h"
+#include "Uplink.h"
+
+/***** Defines *****/
+
+#define FLAG_COMBINATIONS   32
+#define ROUNDS              200
+
+/***** Function definitions *****/
+
+/* A measure as an AP takes it, small values with the odd large one */
+static void randomMeasure(Uplink_Measure* m) {
+    m->id = (uint8_t)(rand() % 60 + 1);
+    m->rssi = (uint8_t)(50 + rand() % 60);
+    m->delta = (rand() % 20 == 0) ? (uint16_t)rand() : (uint16_t)(rand() % 6);
+    m->rssiMin = (uint8_t)(m->rssi - rand() % 6);
+    m->rssiMax = (uint8_t)(m->rssi + rand() % 6);
+    m->rssiVariance = (uint8_t)(rand() % 20);
+    m->distance = (uint16_t)rand();
+    m->beacons = (uint8_t)(rand() % 11);
+    m->beaconsLost = (uint8_t)(rand() % 4);
+}
+
+/* Compares the fields the flags carry */
+static int sameMeasure(const Uplink_Measure* a, const Uplink_Measure* b, uint8_t flags) {
+    if(a->id != b->id || a->rssi != b->rssi || a->delta != b->delta) {
+        return 0;
+    }
+    if((flags & UPLINK_FLAG_RSSI_STATS) && (a->rssiMin != b->rssiMin ||
+            a->rssiMax != b->rssiMax || a->rssiVariance != b->rssiVariance)) {
+        return 0;
+    }
+    if((flags & UPLINK_FLAG_DISTANCE) && a->distance != b->distance) {
+        return 0;
+    }
+    if((flags & UPLINK_FLAG_BEACON_LOSS) && (a->beacons != b->beacons ||
+            a->beaconsLost != b->beaconsLost)) {
+        return 0;
+    }
+
+    return 1;
+}
+
+static void testRoundTrip(void) {
+    const Uplink_Telemetry telemetry = {1, 2, 3, 4, 5, 6, 7, 0xBEEF};
+    Uplink_Measure measures[UPLINK_PACKED_MAX_MEASURES];
+    uint8_t payload[EASYLINK_MAX_DATA_LENGTH];
+    uint8_t used[UPLINK_PACKED_MAX_MEASURES];
+    Uplink_Decoder decoder;
+    Uplink_Measure m;
+    uint8_t flags;
+    uint8_t count;
+    uint8_t encoded;
+    uint8_t len;
+    int decoded;
+    int round;
+    int found;
+    int i;
+
+    srand(1);
+    for(flags = 0; flags < FLAG_COMBINATIONS; flags++) {
+        for(round = 0; round < ROUNDS; round++) {
+            count = (uint8_t)(rand() % (UPLINK_PACKED_MAX_MEASURES + 1));
+            for(i = 0; i < count; i++) {
+                randomMeasure(&measures[i]);
+            }
+
+            len = Uplink_encode(payload, 7, flags, (uint8_t)round,
+                    (flags & UPLINK_FLAG_TELEMETRY) ? &telemetry : NULL,
+                    measures, count, &encoded);
+            CHECK(len <= EASYLINK_MAX_DATA_LENGTH);
+            CHECK(encoded <= count);
+            if(!(flags & UPLINK_FLAG_PACKED)) {
+                CHECK(encoded == ((count < UPLINK_MAX_MEASURES(flags)) ?
+                        count : UPLINK_MAX_MEASURES(flags)));
+            }
+
+            CHECK(Uplink_decoderInit(&decoder, payload, len) == 0);
+            CHECK(decoder.apId == 7);
+            CHECK(decoder.flags == flags);
+            CHECK(decoder.seq == (uint8_t)round);
+            if(flags & UPLINK_FLAG_TELEMETRY) {
+                CHECK(memcmp(&decoder.telemetry, &telemetry, sizeof(telemetry)) == 0);
+            }
+
+            //The oldest encoded measures come back, packed ones sorted by id
+            memset(used, 0, sizeof(used));
+            decoded = 0;
+            while(Uplink_decodeNext(&decoder, &m)) {
+                found = 0;
+                for(i = 0; i < encoded && !found; i++) {
+                    if(!used[i] && sameMeasure(&measures[i], &m, flags)) {
+                        used[i] = 1;
+                        found = 1;
+                    }
+                }
+                CHECK(found);
+                decoded++;
+            }
+            CHECK(decoded == encoded);
+        }
+    }
+}
+
+static void testTelemetryFlag(void) {
+    Uplink_Measure measure = {3, 70, 1, 68, 72, 2, 150, 10, 0};
+    uint8_t payload[EASYLINK_MAX_DATA_LENGTH];
+    Uplink_Decoder decoder;
+    uint8_t encoded;
+    uint8_t len;
+
+    //The flag follows the telemetry argument, not the flags passed
+    len = Uplink_encode(payload, 1, UPLINK_FLAG_TELEMETRY, 0, NULL, &measure, 1, &encoded);
+    CHECK(len == UPLINK_HEADER_SIZE + UPLINK_MEASURE_SIZE);
+    CHECK(Uplink_decoderInit(&decoder, payload, len) == 0);
+    CHECK(!(decoder.flags & UPLINK_FLAG_TELEMETRY));
+}
+
+static void testPackedGain(void) {
+    Uplink_Measure measures[UPLINK_PACKED_MAX_MEASURES];
+    uint8_t payload[EASYLINK_MAX_DATA_LENGTH];
+    uint8_t flags;
+    uint8_t encoded;
+    int i;
+
+    //A busy AP's measures take fewer bits packed than in plain records
+    for(i = 0; i < UPLINK_PACKED_MAX_MEASURES; i++) {
+        measures[i].id = (uint8_t)(i + 1);
+        measures[i].rssi = 80;
+        measures[i].delta = (uint16_t)(i % 3);
+        measures[i].rssiMin = 78;
+        measures[i].rssiMax = 83;
+        measures[i].rssiVariance = 4;
+        measures[i].distance = 1234;
+        measures[i].beacons = 10;
+        measures[i].beaconsLost = 0;
+    }
+    for(flags = 0; flags < FLAG_COMBINATIONS; flags++) {
+        if(flags & UPLINK_FLAG_PACKED) {
+            continue;
+        }
+        Uplink_encode(payload, 1, flags | UPLINK_FLAG_PACKED, 0, NULL, measures,
+                UPLINK_PACKED_MAX_MEASURES, &encoded);
+        CHECK(encoded > UPLINK_MAX_MEASURES(flags));
+    }
+}
+
+static void testShort(void) {
+    const uint8_t payload[UPLINK_PACKED_HEADER_SIZE + UPLINK_TELEMETRY_SIZE] =
+            {1, UPLINK_FLAG_PACKED | UPLINK_FLAG_TELEMETRY, 0, 0};
+    Uplink_Decoder decoder;
+
+    CHECK(Uplink_decoderInit(&decoder, payload, UPLINK_HEADER_SIZE - 1) == -1);
+    CHECK(Uplink_decoderInit(&decoder, payload, sizeof(payload) - 1) == -1);
+    CHECK(Uplink_decoderInit(&decoder, payload, sizeof(payload)) == 0);
+}
+
+int main(void) {
+    testRoundTrip();
+    testTelemetryFlag();
+    testPackedGain();
+    testShort();
+
+    return CHECK_RESULT();
+}